@@ -0,0 +1,340 @@
+/**
+ * @file multilateration_benchmark.cpp
+ * @brief Monte Carlo accuracy and throughput benchmark for the multilateration solvers
+ *
+ * Usage: multilateration_benchmark [--trials N] [--receivers N] [--noise-ns X]
+ *            [--region M] [--threads N] [--seed N] [--divergence M]
+ *            [--methods ls,taylor,bayes,gd] [--output FILE] [--help]
+ *
+ * Results are written as JSON to stdout, or to FILE if given. meanIterations
+ * is only written for methods that report iterations (not the closed-form
+ * least squares solver).
+ */
+
+#include "tdoa/multilateration/multilateration_solver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using tdoa::multilateration::MultilaterationConfig;
+using tdoa::multilateration::MultilaterationSolver;
+using tdoa::multilateration::SolverMethod;
+
+/**
+ * @brief Benchmark parameters
+ */
+struct BenchmarkOptions {
+    size_t trials = 100000;             ///< Trials per method
+    int receivers = 4;                  ///< Receivers per geometry
+    double noiseNs = 3.0;               ///< TOA noise standard deviation in ns
+    double region = 2000.0;             ///< Side of the square region in meters
+    int threads = 0;                    ///< Worker threads (0 = hardware concurrency)
+    uint64_t seed = 1;                  ///< Base random seed
+    double divergence = 100.0;          ///< Error in meters counted as a divergence
+    std::vector<SolverMethod> methods = {
+        SolverMethod::LeastSquares, SolverMethod::TaylorSeries,
+        SolverMethod::Bayesian, SolverMethod::GradientDescent
+    };
+    std::string output;                 ///< Output file (empty = stdout)
+    bool help = false;                  ///< Print usage and exit
+};
+
+/**
+ * @brief Per-method results
+ */
+struct MethodResult {
+    SolverMethod method;
+    std::vector<double> errors;         ///< Errors of converged trials in meters
+    size_t diverged = 0;                ///< Invalid, non-finite or far-off solutions
+    double iterations = 0.0;            ///< Mean iterations over all trials
+    bool iterative = false;             ///< Whether the solver reported any iterations
+    double seconds = 0.0;               ///< Time in calculatePosition, summed over trials and divided by workers
+};
+
+const char* methodName(SolverMethod method) {
+    switch (method) {
+        case SolverMethod::LeastSquares: return "LeastSquares";
+        case SolverMethod::TaylorSeries: return "TaylorSeries";
+        case SolverMethod::Bayesian: return "Bayesian";
+        case SolverMethod::GradientDescent: return "GradientDescent";
+    }
+    return "Unknown";
+}
+
+bool parseMethods(const std::string& list, std::vector<SolverMethod>& methods) {
+    methods.clear();
+    std::stringstream ss(list);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+        if (name == "ls") {
+            methods.push_back(SolverMethod::LeastSquares);
+        } else if (name == "taylor") {
+            methods.push_back(SolverMethod::TaylorSeries);
+        } else if (name == "bayes") {
+            methods.push_back(SolverMethod::Bayesian);
+        } else if (name == "gd") {
+            methods.push_back(SolverMethod::GradientDescent);
+        } else {
+            std::cerr << "Unknown method: " << name << std::endl;
+            return false;
+        }
+    }
+    return !methods.empty();
+}
+
+void printUsage(std::ostream& out) {
+    out << "Usage: multilateration_benchmark [--trials N] [--receivers N] [--noise-ns X]\n"
+        << "           [--region M] [--threads N] [--seed N] [--divergence M]\n"
+        << "           [--methods ls,taylor,bayes,gd] [--output FILE] [--help]\n";
+}
+
+bool parseOptions(int argc, char* argv[], BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            options.help = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        try {
+            if (arg == "--trials") {
+                options.trials = std::stoull(value);
+            } else if (arg == "--receivers") {
+                options.receivers = std::stoi(value);
+            } else if (arg == "--noise-ns") {
+                options.noiseNs = std::stod(value);
+            } else if (arg == "--region") {
+                options.region = std::stod(value);
+            } else if (arg == "--threads") {
+                options.threads = std::stoi(value);
+            } else if (arg == "--seed") {
+                options.seed = std::stoull(value);
+            } else if (arg == "--divergence") {
+                options.divergence = std::stod(value);
+            } else if (arg == "--methods") {
+                if (!parseMethods(value, options.methods)) {
+                    return false;
+                }
+            } else if (arg == "--output") {
+                options.output = value;
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                printUsage(std::cerr);
+                return false;
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+            printUsage(std::cerr);
+            return false;
+        }
+    }
+    if (options.receivers < 3) {
+        std::cerr << "At least 3 receivers are required" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Randomized trial, reproducible from (seed, index) so every method sees the same data
+ */
+struct Trial {
+    std::map<std::string, tdoa::time_difference::SignalSource> receivers;
+    tdoa::time_difference::TimeDifferenceSet measurements;
+    double txX = 0.0;
+    double txY = 0.0;
+
+    void generate(const BenchmarkOptions& options, size_t index) {
+        const double c = 299792458.0;
+        std::mt19937_64 rng(options.seed * 0x9E3779B97F4A7C15ULL + index);
+        std::uniform_real_distribution<double> coordinate(-0.5 * options.region, 0.5 * options.region);
+        std::normal_distribution<double> noise(0.0, options.noiseNs * 1.0e-9);
+
+        receivers.clear();
+        for (int r = 0; r < options.receivers; ++r) {
+            tdoa::time_difference::SignalSource source;
+            source.id = "R" + std::to_string(r);
+            source.position.x = coordinate(rng);
+            source.position.y = coordinate(rng);
+            source.position.z = 0.0;
+            receivers[source.id] = source;
+        }
+        txX = coordinate(rng);
+        txY = coordinate(rng);
+
+        measurements = tdoa::time_difference::TimeDifferenceSet();
+        measurements.timestamp = index;
+        const auto& reference = receivers.begin()->second;
+        measurements.referenceId = reference.id;
+        const double referenceToa = std::hypot(txX - reference.position.x, txY - reference.position.y) / c
+                                  + noise(rng);
+        for (const auto& entry : receivers) {
+            if (entry.first == reference.id) {
+                continue;
+            }
+            const double toa = std::hypot(txX - entry.second.position.x, txY - entry.second.position.y) / c
+                             + noise(rng);
+            tdoa::time_difference::TimeDifference td;
+            td.sourceId = entry.first;
+            td.referenceId = reference.id;
+            td.timeDifference = toa - referenceToa;
+            td.uncertainty = std::sqrt(2.0) * options.noiseNs * 1.0e-9;
+            td.confidence = 0.95;
+            measurements.timeDifferences.push_back(td);
+        }
+    }
+};
+
+MethodResult runMethod(const BenchmarkOptions& options, SolverMethod method, int threads) {
+    MethodResult result;
+    result.method = method;
+
+    struct WorkerResult {
+        std::vector<double> errors;
+        size_t diverged = 0;
+        double iterations = 0.0;
+        double seconds = 0.0;
+    };
+    std::vector<WorkerResult> workers(threads);
+    std::atomic<size_t> next(0);
+    const size_t batch = 256;
+
+    auto work = [&](int id) {
+        MultilaterationConfig config;
+        config.method = method;
+        config.regionMinX = config.regionMinY = -0.5 * options.region;
+        config.regionMaxX = config.regionMaxY = 0.5 * options.region;
+        config.timingUncertainty = options.noiseNs * 1.0e-9;
+        config.numThreads = 1;  // Parallelism comes from the trial workers
+        MultilaterationSolver solver(config);
+
+        WorkerResult& out = workers[id];
+        Trial trial;
+        for (size_t start = next.fetch_add(batch); start < options.trials; start = next.fetch_add(batch)) {
+            const size_t end = std::min(options.trials, start + batch);
+            for (size_t i = start; i < end; ++i) {
+                trial.generate(options, i);
+                auto solveStart = std::chrono::steady_clock::now();
+                auto fix = solver.calculatePosition(trial.measurements, trial.receivers);
+                out.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+                const double error = std::hypot(fix.position.x - trial.txX, fix.position.y - trial.txY);
+                out.iterations += fix.iterations;
+                if (!fix.valid || !std::isfinite(error) || error > options.divergence) {
+                    out.diverged++;
+                } else {
+                    out.errors.push_back(error);
+                }
+            }
+        }
+    };
+
+    // Only calculatePosition is timed; generating a trial costs as much as a closed-form solve
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (auto& worker : workers) {
+        result.errors.insert(result.errors.end(), worker.errors.begin(), worker.errors.end());
+        result.diverged += worker.diverged;
+        result.iterations += worker.iterations;
+        result.seconds += worker.seconds;
+    }
+    result.seconds /= threads;
+    result.iterative = result.iterations > 0.0;
+    result.iterations /= std::max<size_t>(1, options.trials);
+    return result;
+}
+
+double percentile(std::vector<double>& values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void writeJson(std::ostream& out, const BenchmarkOptions& options, int threads,
+               std::vector<MethodResult>& results) {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"trials\": " << options.trials << ",\n";
+    out << "  \"receivers\": " << options.receivers << ",\n";
+    out << "  \"noiseNs\": " << options.noiseNs << ",\n";
+    out << "  \"region\": " << options.region << ",\n";
+    out << "  \"threads\": " << threads << ",\n";
+    out << "  \"seed\": " << options.seed << ",\n";
+    out << "  \"divergenceThreshold\": " << options.divergence << ",\n";
+    out << "  \"methods\": [\n";
+    for (size_t m = 0; m < results.size(); ++m) {
+        MethodResult& r = results[m];
+        out << "    {\n";
+        out << "      \"method\": \"" << methodName(r.method) << "\",\n";
+        out << "      \"cep50\": " << percentile(r.errors, 0.50) << ",\n";
+        out << "      \"cep95\": " << percentile(r.errors, 0.95) << ",\n";
+        out << "      \"divergenceRate\": " << static_cast<double>(r.diverged) / std::max<size_t>(1, options.trials) << ",\n";
+        if (r.iterative) {
+            out << "      \"meanIterations\": " << r.iterations << ",\n";
+        }
+        out << "      \"seconds\": " << r.seconds << ",\n";
+        out << "      \"solvesPerSecond\": " << (r.seconds > 0.0 ? options.trials / r.seconds : 0.0) << "\n";
+        out << "    }" << (m + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+/**
+ * @brief Main function
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    if (options.help) {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    const int threads = options.threads > 0 ? options.threads
+                                            : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<MethodResult> results;
+    for (SolverMethod method : options.methods) {
+        std::cerr << "Running " << methodName(method) << "..." << std::endl;
+        results.push_back(runMethod(options, method, threads));
+    }
+
+    if (options.output.empty()) {
+        writeJson(std::cout, options, threads, results);
+    } else {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "Failed to open " << options.output << std::endl;
+            return 1;
+        }
+        writeJson(file, options, threads, results);
+    }
+
+    return 0;
+}
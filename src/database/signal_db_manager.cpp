@@ -377,6 +377,50 @@ size_t SignalDBManager::countSignals(const QueryParams& params) const {
     return count;
 }
 
+int64_t SignalDBManager::insertGeolocation(GeolocationRecord geolocation, const utils::GeodeticPosition& position) {
+    geolocation.latitude = position.latitude;
+    geolocation.longitude = position.longitude;
+    geolocation.altitude = position.altitude;
+    return insertGeolocation(geolocation);
+}
+
+std::vector<int64_t> SignalDBManager::insertGeolocations(std::vector<GeolocationRecord> geolocations,
+                                                         const std::vector<utils::EnuPosition>& positions,
+                                                         const utils::LocalFrame& frame) {
+    if (geolocations.size() != positions.size()) {
+        return {};
+    }
+    
+    // Convert every fix through the frame in one batch
+    const size_t count = positions.size();
+    std::vector<double> enu(3 * count);
+    std::vector<double> geodetic(3 * count);
+    for (size_t i = 0; i < count; ++i) {
+        enu[i] = positions[i].east;
+        enu[count + i] = positions[i].north;
+        enu[2 * count + i] = positions[i].up;
+    }
+    frame.enuToGeodetic(enu.data(), enu.data() + count, enu.data() + 2 * count,
+                        geodetic.data(), geodetic.data() + count, geodetic.data() + 2 * count, count);
+    
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    bool transaction = beginTransaction();
+    
+    std::vector<int64_t> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        geolocations[i].latitude = geodetic[i];
+        geolocations[i].longitude = geodetic[count + i];
+        geolocations[i].altitude = geodetic[2 * count + i];
+        ids.push_back(insertGeolocation(geolocations[i]));
+    }
+    
+    if (transaction) {
+        commitTransaction();
+    }
+    return ids;
+}
+
 std::string SignalDBManager::buildSignalQuery(const QueryParams& params) const {
     std::stringstream ss;
     ss << "SELECT * FROM signals WHERE 1=1";
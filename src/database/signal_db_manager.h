@@ -1,6 +1,7 @@
 #pragma once
 
 #include "signal_db_schema.h"
+#include "tdoa/utils/geodetic.h"
 #include <sqlite3.h>
 #include <memory>
 #include <mutex>
@@ -30,6 +31,13 @@ public:
 
     // Geolocation operations
     int64_t insertGeolocation(const GeolocationRecord& geolocation);
+    // Insert with the position taken from a geodetic fix, overriding the record's coordinates
+    int64_t insertGeolocation(GeolocationRecord geolocation, const utils::GeodeticPosition& position);
+    // Insert fixes solved in a local frame; positions are converted in one batch
+    // and all records go in one transaction. Returns the IDs, -1 for failed rows.
+    std::vector<int64_t> insertGeolocations(std::vector<GeolocationRecord> geolocations,
+                                            const std::vector<utils::EnuPosition>& positions,
+                                            const utils::LocalFrame& frame);
     bool updateGeolocation(const GeolocationRecord& geolocation);
     bool deleteGeolocation(int64_t id);
     std::optional<GeolocationRecord> getGeolocation(int64_t id) const;
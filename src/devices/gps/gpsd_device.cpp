@@ -4,6 +4,7 @@
  */
 
 #include "gpsd_device.h"
+#include "../../signal_flow/thread_placement.h"
 #include <iostream>
 #include <sstream>
 #include <chrono>
@@ -180,6 +181,8 @@ bool GPSDDevice::configure(const std::string& configOption, const std::string& v
 }
 
 void GPSDDevice::gpsdThreadFunc() {
+    signal::ThreadPlacement::getInstance().placeCurrentThread(signal::ThreadClass::Io, "gpsd");
+    
 #ifdef HAVE_GPSD
     while (running_) {
         // Wait for data from GPSD
@@ -212,6 +215,9 @@ void GPSDDevice::gpsdThreadFunc() {
 }
 
 void GPSDDevice::ppsThreadFunc() {
+    // PPS edges are timestamped here, so the thread gets ingest priority
+    signal::ThreadPlacement::getInstance().placeCurrentThread(signal::ThreadClass::Ingest, "gps-pps");
+    
     // PPS signal monitoring loop
     while (running_ && ppsFileDescriptor_ >= 0) {
         // Wait for PPS event
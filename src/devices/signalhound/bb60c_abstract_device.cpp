@@ -615,10 +615,49 @@ bool BB60CAbstractDevice::validateParams(const BB60CParams& params) {
 
 // Callback function for BB60C device
 void BB60CAbstractDevice::deviceCallback(const void* data, size_t length, double timestamp) {
-    // Forward to user callback if set
-    if (userCallback_) {
-        userCallback_(data, length, timestamp, userData_);
+    if (!userCallback_) {
+        return;
     }
+
+    // Shed here, deliberately and counted, rather than wherever the pipeline overflows
+    std::shared_ptr<signal::ShedController> controller = std::atomic_load(&shedController_);
+    if (controller) {
+        blockCredit_ = controller->admit(length);
+        if (!blockCredit_) {
+            return;
+        }
+    }
+
+    // Forward to user callback
+    userCallback_(data, length, timestamp, userData_);
+
+    // Return the credit unless the callback took it with the block
+    blockCredit_.reset();
+}
+
+// Set the ingest shed controller
+void BB60CAbstractDevice::setShedController(std::shared_ptr<signal::ShedController> controller) {
+    // The streaming thread may be reading the controller
+    std::atomic_store(&shedController_, std::move(controller));
+}
+
+// Take the credit of the block being delivered
+signal::CreditChannel::Credit BB60CAbstractDevice::takeBlockCredit() {
+    return std::move(blockCredit_);
+}
+
+// Take the Signal of the block being delivered
+std::shared_ptr<signal::Signal> BB60CAbstractDevice::takeBlockSignal() {
+    return takeIngestSignal();
+}
+
+// Get the ingest shedding metrics
+signal::ShedMetrics BB60CAbstractDevice::getShedMetrics() const {
+    std::shared_ptr<signal::ShedController> controller = std::atomic_load(&shedController_);
+    if (!controller) {
+        return signal::ShedMetrics();
+    }
+    return controller->getMetrics();
 }
 
 // Calculate optimal decimation for a target sample rate
@@ -7,6 +7,8 @@
 
 #include "../signal_source_device.h"
 #include "../../../external/signalhound/wrapper/bb60c_device.h"
+#include "../../signal_flow/flow_control.h"
+#include "bb60c_ingest.h"
 #include <memory>
 #include <string>
 #include <map>
@@ -204,6 +206,45 @@ public:
      */
     OperationResult optimizeForUseCase(const std::string& useCase);
 
+    /**
+     * @brief Shed load at ingest according to downstream credit
+     *
+     * Every block from the device goes through the controller before the
+     * user callback. Blocks the controller sheds never reach the callback and
+     * are counted in getShedMetrics; blocks it admits carry a credit of the
+     * first stage's channel, which the callback can keep with takeBlockCredit.
+     * May be changed while streaming; the next block uses the new controller.
+     * @param controller Shed controller, or nullptr to forward every block
+     */
+    void setShedController(std::shared_ptr<signal::ShedController> controller);
+
+    /**
+     * @brief Take the credit of the block being delivered
+     *
+     * Only valid inside the streaming callback. A consumer that hands the
+     * block to another thread keeps the credit with the work and drops it
+     * when the first stage is done; if the callback does not take it, the
+     * credit is returned when the callback returns.
+     * @return Credit of the current block, nullptr if there is no shed controller
+     */
+    signal::CreditChannel::Credit takeBlockCredit();
+
+    /**
+     * @brief Take the block being delivered as a Signal
+     *
+     * Only valid inside the streaming callback. A consumer that keeps the
+     * block takes it here instead of copying from the data pointer; raw int16
+     * blocks are converted to ComplexFloat32 on the way.
+     * @return Signal of the current block, nullptr if already taken
+     */
+    std::shared_ptr<signal::Signal> takeBlockSignal();
+
+    /**
+     * @brief Get the ingest shedding metrics
+     * @return Shed metrics (all zero if there is no shed controller)
+     */
+    signal::ShedMetrics getShedMetrics() const;
+
 private:
     std::unique_ptr<BB60CDevice> device_;    ///< Underlying BB60C device
     BB60CParams currentParams_;              ///< Current device parameters
@@ -211,6 +252,8 @@ private:
     StreamingCallback userCallback_;         ///< User callback for I/Q data
     void* userData_;                         ///< User data for callback
     std::string profileDirectory_;           ///< Directory for configuration profiles
+    std::shared_ptr<signal::ShedController> shedController_; ///< Ingest shedding, null to forward everything (atomic_load/atomic_store only)
+    signal::CreditChannel::Credit blockCredit_; ///< Credit of the block in the user callback
     
     /**
      * @brief Validate streaming configuration parameters
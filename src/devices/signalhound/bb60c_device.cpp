@@ -13,43 +13,73 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
 #include <memory>
+#include <new>
+#include <algorithm>
 
 // Include the actual SignalHound BB60 API headers
 // The location may vary based on your project setup
 #include "bb_api.h"
 
+#include "../../signal_flow/buffer_pool.h"
+#include "../../signal_flow/sample_conversion.h"
+#include "../../signal_flow/signal_factory.h"
+#include "../../signal_flow/thread_placement.h"
+#include "bb60c_ingest.h"
+
 // Buffer size constants
 #define DEFAULT_BUFFER_SIZE 16384     // Default buffer size for I/Q samples (16K samples)
-#define MAX_BUFFER_COUNT 32           // Maximum number of buffers in the circular queue
 #define BB60C_MAX_BUFFER_SIZE 262144  // Max buffer size for a single fetch (from BB60C API docs)
+#define BB60C_BASE_SAMPLE_RATE 40.0e6 // I/Q sample rate before decimation
 
 namespace tdoa {
 namespace devices {
 
-// Structure for buffered I/Q data
-struct IQBuffer {
-    std::vector<float> data;      // For float mode
-    std::vector<int16_t> rawData; // For raw mode (16-bit shorts)
-    double timestamp;             // Timestamp for the first sample
-    bool isFloat;                 // Whether data is float or raw
-    size_t sampleCount;           // Number of I/Q samples (complex pairs)
-    
-    // Constructor for pre-allocated buffers
-    IQBuffer(size_t capacity, bool useFloat) 
-        : isFloat(useFloat)
-        , sampleCount(0)
-        , timestamp(0.0)
-    {
-        if (useFloat) {
-            data.resize(capacity * 2); // Complex samples have I and Q components
-        } else {
-            rawData.resize(capacity * 2);
-        }
-    }
+namespace {
+
+// Block in the I/Q callback on this streaming thread
+struct IngestBlock {
+    std::shared_ptr<uint8_t> buffer;    // Pooled block the device fetched into
+    signal::DataFormat format;          // Format of the fetched samples
+    size_t sampleCount;
+    double sampleRate;
+    double centerFreq;
+    double bandwidth;
+    double timestamp;
 };
 
+thread_local IngestBlock ingestBlock;
+
+} // namespace
+
+// Take the Signal of the block being delivered
+std::shared_ptr<signal::Signal> takeIngestSignal() {
+    if (!ingestBlock.buffer) {
+        return nullptr;
+    }
+    
+    std::shared_ptr<signal::Signal> result;
+    if (ingestBlock.format == signal::DataFormat::ComplexFloat32) {
+        // Already in the processing format: the block moves into the Signal
+        result = signal::SignalFactory::createSignalFromBuffer(
+            std::move(ingestBlock.buffer), ingestBlock.sampleCount * signal::getSampleSize(ingestBlock.format),
+            ingestBlock.format, ingestBlock.sampleCount,
+            ingestBlock.sampleRate, ingestBlock.centerFreq, ingestBlock.bandwidth);
+    } else {
+        // Raw int16 blocks are converted to the processing format in one pass
+        result = signal::SignalFactory::createConvertedSignal(
+            ingestBlock.buffer.get(), ingestBlock.format, ingestBlock.sampleCount,
+            signal::DataFormat::ComplexFloat32,
+            ingestBlock.sampleRate, ingestBlock.centerFreq, ingestBlock.bandwidth);
+        ingestBlock.buffer.reset();
+    }
+    
+    if (result) {
+        result->setTimestamp(ingestBlock.timestamp);
+    }
+    return result;
+}
+
 // Performance metrics for streaming
 struct StreamMetrics {
     std::atomic<uint64_t> totalSamples{0};
@@ -428,51 +458,45 @@ void BB60CDevice::reset() {
 
 // Streaming thread implementation
 void BB60CDevice::streamingThread() {
-    // Create a circular buffer of I/Q buffers
-    std::queue<std::shared_ptr<IQBuffer>> bufferQueue;
+    // Place the thread before allocating so its buffers are NUMA-local
+    signal::ThreadPlacement::getInstance().placeCurrentThread(signal::ThreadClass::Ingest, "bb60c-ingest");
     
-    // Create a pool of pre-allocated buffers
-    std::vector<std::shared_ptr<IQBuffer>> bufferPool;
-    for (int i = 0; i < MAX_BUFFER_COUNT; i++) {
-        bufferPool.push_back(std::make_shared<IQBuffer>(
-            bufferSize_, currentConfig_.useFloat));
-    }
+    const bool isFloat = currentConfig_.useFloat;
+    const signal::DataFormat format = isFloat ? signal::DataFormat::ComplexFloat32 : signal::DataFormat::ComplexInt16;
+    const size_t sampleSize = signal::getSampleSize(format);
+    const double sampleRate = BB60C_BASE_SAMPLE_RATE / std::max(currentConfig_.decimation, 1);
     
     // Main streaming loop
     while (!shouldStopStreaming_.load()) {
         try {
-            // Get a buffer from the pool (or create a new one if needed)
-            std::shared_ptr<IQBuffer> buffer;
-            if (!bufferPool.empty()) {
-                buffer = bufferPool.back();
-                bufferPool.pop_back();
-            } else {
-                // If pool is exhausted, create a new buffer
-                buffer = std::make_shared<IQBuffer>(
-                    bufferSize_, currentConfig_.useFloat);
-                
-                // Track dropped buffers (pool exhaustion indicates callback is too slow)
+            // Fetch straight into a pooled block. It returns to the pool (this
+            // thread's cache first) when the last reference to it is dropped.
+            std::shared_ptr<uint8_t> block = signal::BufferPool::getInstance().acquire(bufferSize_ * sampleSize);
+            if (!block) {
+                // Out of memory: consumers are holding on to too many blocks
                 metrics_->droppedBuffers++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                continue;
             }
             
             // Get I/Q data from the device
             int returnLen = 0;
             int status;
             
-            if (buffer->isFloat) {
+            if (isFloat) {
                 // Get floating-point data
                 status = bbFetchRaw(
                     handle_,
-                    buffer->data.data(),
-                    buffer->data.size() / 2,  // Complex sample count
+                    reinterpret_cast<float*>(block.get()),
+                    bufferSize_,  // Complex sample count
                     &returnLen
                 );
             } else {
                 // Get 16-bit integer data
                 status = bbFetchRaw16(
                     handle_,
-                    buffer->rawData.data(),
-                    buffer->rawData.size() / 2,  // Complex sample count
+                    reinterpret_cast<int16_t*>(block.get()),
+                    bufferSize_,  // Complex sample count
                     &returnLen
                 );
             }
@@ -486,33 +510,36 @@ void BB60CDevice::streamingThread() {
                 
                 std::cerr << "BB60C streaming error: " << bbGetErrorString(status) << std::endl;
                 
-                // Add buffer back to pool
-                bufferPool.push_back(buffer);
-                
                 // Small delay before retrying
                 std::this_thread::sleep_for(std::chrono::milliseconds(10));
                 continue;
             }
             
-            // Update buffer sample count (actual returned samples)
-            buffer->sampleCount = returnLen;
-            
-            // Get current timestamp
-            buffer->timestamp = 0.0;  // TODO: Implement actual GPS timestamping
+            const size_t sampleCount = static_cast<size_t>(returnLen);
             
             // Update metrics
-            metrics_->totalSamples += returnLen;
-            metrics_->totalBytes += returnLen * (buffer->isFloat ? sizeof(float) : sizeof(int16_t)) * 2;
+            metrics_->totalSamples += sampleCount;
+            metrics_->totalBytes += sampleCount * sampleSize;
             
-            // Process the buffer with the callback
+            // Process the block with the callback
             if (dataCallback_) {
                 auto startTime = std::chrono::high_resolution_clock::now();
                 
-                if (buffer->isFloat) {
-                    dataCallback_(buffer->data.data(), buffer->sampleCount, buffer->timestamp);
-                } else {
-                    dataCallback_(buffer->rawData.data(), buffer->sampleCount, buffer->timestamp);
-                }
+                // The callback can keep the block as a Signal with
+                // takeIngestSignal instead of copying from the pointer
+                const void* samples = block.get();
+                ingestBlock.buffer = std::move(block);
+                ingestBlock.format = format;
+                ingestBlock.sampleCount = sampleCount;
+                ingestBlock.sampleRate = sampleRate;
+                ingestBlock.centerFreq = currentConfig_.centerFreq;
+                ingestBlock.bandwidth = currentConfig_.bandwidth;
+                ingestBlock.timestamp = 0.0;  // TODO: Implement actual GPS timestamping
+                
+                dataCallback_(samples, sampleCount, ingestBlock.timestamp);
+                
+                // Return the block to the pool unless the callback took it
+                ingestBlock.buffer.reset();
                 
                 auto endTime = std::chrono::high_resolution_clock::now();
                 auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
@@ -522,20 +549,15 @@ void BB60CDevice::streamingThread() {
                 metrics_->callbackCount++;
             }
             
-            // Return buffer to the pool
-            bufferPool.push_back(buffer);
-            
         } catch (const std::exception& e) {
             std::cerr << "Exception in streaming thread: " << e.what() << std::endl;
+            ingestBlock.buffer.reset();
             
             // Small delay before retrying
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     }
     
-    // Clean up
-    bufferPool.clear();
-    
     // Signal that streaming is finished
     isStreaming_ = false;
 }
@@ -0,0 +1,29 @@
+/**
+ * @file bb60c_ingest.h
+ * @brief Zero-copy hand-off of BB60C ingest blocks
+ */
+
+#pragma once
+
+#include "../../signal_flow/signal.h"
+#include <memory>
+
+namespace tdoa {
+namespace devices {
+
+/**
+ * @brief Take the block being delivered to the I/Q callback as a Signal
+ *
+ * The BB60C streaming thread fetches every block into a pooled buffer and
+ * passes a pointer to it to the I/Q callback. A consumer that keeps the block
+ * takes it here as a ComplexFloat32 Signal instead of copying the samples:
+ * float blocks move into the Signal without a copy, raw int16 blocks are
+ * converted in one pass with SignalFactory::createConvertedSignal. Blocks
+ * that are not taken return to the pool when the callback returns. Only valid
+ * inside the I/Q callback, on the streaming thread.
+ * @return Signal of the current block, or nullptr outside the callback or if already taken
+ */
+std::shared_ptr<signal::Signal> takeIngestSignal();
+
+} // namespace devices
+} // namespace tdoa
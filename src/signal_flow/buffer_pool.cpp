@@ -0,0 +1,450 @@
+/**
+ * @file buffer_pool.cpp
+ * @brief Implementation of the BufferPool class
+ */
+
+#include "buffer_pool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+constexpr size_t MAX_SHIFT = 63;
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Smallest shift with (1 << shift) >= size
+size_t ceilLog2(size_t size) {
+    size_t shift = 0;
+    while (shift < MAX_SHIFT && (static_cast<size_t>(1) << shift) < size) {
+        shift++;
+    }
+    return shift;
+}
+
+size_t roundUp(size_t size, size_t multiple) {
+    return (size + multiple - 1) / multiple * multiple;
+}
+
+void* alignedAlloc(size_t alignment, size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+void alignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+} // namespace
+
+struct BufferPool::Impl {
+    /**
+     * @brief How a block's memory was obtained
+     */
+    enum class Backing {
+        Heap,           ///< Aligned heap allocation
+        Transparent,    ///< Aligned heap allocation advised for transparent huge pages
+        HugeTlb         ///< Anonymous mapping from the reserved huge page pool
+    };
+
+    struct Block {
+        uint8_t* data;
+        size_t size;
+        Backing backing;
+        bool oversize;
+    };
+
+    // Size class layout derived from the configuration
+    struct Layout {
+        size_t minShift;
+        size_t maxShift;
+        size_t threadCacheBlocks;
+        size_t maxCachedBytes;
+        bool useHugePages;
+        size_t hugePageThreshold;
+    };
+
+    // Free blocks owned by one thread; refreshed when the pool generation changes
+    struct ThreadCache {
+        Impl* owner;
+        uint64_t generation;
+        Layout layout;
+        size_t cachedBytes;     // Bytes in lists, bounded by layout.maxCachedBytes
+        std::array<std::vector<Block>, MAX_SHIFT + 1> lists;
+
+        explicit ThreadCache(Impl* impl) : owner(impl), generation(~0ULL), layout(), cachedBytes(0) {}
+        ~ThreadCache();
+    };
+
+    // Returns a block to the pool when the last shared_ptr drops it
+    struct Deleter {
+        Impl* impl;
+        Block block;
+
+        void operator()(uint8_t*) const { impl->release(block); }
+    };
+
+    mutable std::mutex mutex;
+    BufferPoolConfig config;
+    Layout layout;
+    std::atomic<uint64_t> generation;
+
+    std::array<std::vector<Block>, MAX_SHIFT + 1> freeLists;   // Guarded by mutex
+    size_t sharedCachedBytes;                                   // Guarded by mutex
+
+    std::array<std::atomic<size_t>, MAX_SHIFT + 1> inUse;
+    std::array<std::atomic<size_t>, MAX_SHIFT + 1> cached;
+    std::array<std::atomic<uint64_t>, MAX_SHIFT + 1> hits;
+    std::array<std::atomic<uint64_t>, MAX_SHIFT + 1> misses;
+    std::atomic<size_t> oversizeInUse;
+    std::atomic<size_t> oversizeBytes;
+    std::atomic<size_t> hugePageBlocks;
+
+    Impl()
+        : generation(0)
+        , sharedCachedBytes(0)
+        , oversizeInUse(0)
+        , oversizeBytes(0)
+        , hugePageBlocks(0)
+    {
+        for (size_t i = 0; i <= MAX_SHIFT; i++) {
+            inUse[i] = 0;
+            cached[i] = 0;
+            hits[i] = 0;
+            misses[i] = 0;
+        }
+        applyConfig(config);
+    }
+
+    static Layout makeLayout(const BufferPoolConfig& cfg) {
+        Layout result;
+        result.minShift = ceilLog2(cfg.minBlockSize);
+        result.maxShift = ceilLog2(cfg.maxBlockSize);
+        result.threadCacheBlocks = cfg.threadCacheBlocks;
+        result.maxCachedBytes = cfg.maxCachedBytes;
+        result.useHugePages = cfg.useHugePages;
+        result.hugePageThreshold = cfg.hugePageThreshold;
+        return result;
+    }
+
+    // Caller holds mutex, or is the constructor
+    void applyConfig(const BufferPoolConfig& cfg) {
+        config = cfg;
+        layout = makeLayout(cfg);
+        generation++;
+    }
+
+    // Set while this thread's cache is being or has been destroyed, so late releases bypass it
+    static bool& threadCacheDestroyed() {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    ThreadCache& threadCache() {
+        static thread_local ThreadCache cache(this);
+        if (cache.generation != generation.load(std::memory_order_acquire)) {
+            dropCached(cache);
+            std::lock_guard<std::mutex> lock(mutex);
+            cache.layout = layout;
+            cache.generation = generation.load(std::memory_order_relaxed);
+        }
+        return cache;
+    }
+
+    void dropCached(ThreadCache& cache) {
+        for (size_t shift = 0; shift <= MAX_SHIFT; shift++) {
+            for (const Block& block : cache.lists[shift]) {
+                cached[shift]--;
+                freeBlock(block);
+            }
+            cache.lists[shift].clear();
+        }
+        cache.cachedBytes = 0;
+    }
+
+    Block allocateBlock(size_t size, const Layout& current, bool oversize) {
+        Block block{nullptr, size, Backing::Heap, oversize};
+#ifndef _WIN32
+        if (current.useHugePages && size >= current.hugePageThreshold) {
+#ifdef MAP_HUGETLB
+            void* mapped = mmap(nullptr, roundUp(size, HUGE_PAGE_SIZE), PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mapped != MAP_FAILED) {
+                block.data = static_cast<uint8_t*>(mapped);
+                block.backing = Backing::HugeTlb;
+                hugePageBlocks++;
+                return block;
+            }
+#endif
+            // No reserved huge pages; fall back to transparent huge pages
+            block.data = static_cast<uint8_t*>(alignedAlloc(HUGE_PAGE_SIZE, roundUp(size, HUGE_PAGE_SIZE)));
+            if (block.data) {
+#ifdef MADV_HUGEPAGE
+                madvise(block.data, roundUp(size, HUGE_PAGE_SIZE), MADV_HUGEPAGE);
+#endif
+                block.backing = Backing::Transparent;
+                hugePageBlocks++;
+            }
+            return block;
+        }
+#endif
+        block.data = static_cast<uint8_t*>(alignedAlloc(ALIGNMENT, roundUp(size, ALIGNMENT)));
+        return block;
+    }
+
+    void freeBlock(const Block& block) {
+        if (block.backing != Backing::Heap) {
+            hugePageBlocks--;
+        }
+#ifndef _WIN32
+        if (block.backing == Backing::HugeTlb) {
+            munmap(block.data, roundUp(block.size, HUGE_PAGE_SIZE));
+            return;
+        }
+#endif
+        alignedFree(block.data);
+    }
+
+    std::shared_ptr<uint8_t> acquire(size_t size, bool zero) {
+        if (size == 0) {
+            return nullptr;
+        }
+
+        // Threads acquiring from thread_local destructors go straight to the shared free lists
+        ThreadCache* cache = threadCacheDestroyed() ? nullptr : &threadCache();
+        Layout current;
+        if (cache) {
+            current = cache->layout;
+        } else {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = layout;
+        }
+        Block block{nullptr, 0, Backing::Heap, false};
+
+        if (size > (static_cast<size_t>(1) << current.maxShift)) {
+            block = allocateBlock(size, current, true);
+            if (!block.data) {
+                return nullptr;
+            }
+            oversizeInUse++;
+            oversizeBytes += size;
+        } else {
+            const size_t shift = std::max(current.minShift, ceilLog2(size));
+            if (cache && !cache->lists[shift].empty()) {
+                block = cache->lists[shift].back();
+                cache->lists[shift].pop_back();
+                cache->cachedBytes -= block.size;
+            } else {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto& shared = freeLists[shift];
+                if (!shared.empty()) {
+                    block = shared.back();
+                    shared.pop_back();
+                    sharedCachedBytes -= block.size;
+                }
+            }
+
+            if (block.data) {
+                cached[shift]--;
+                hits[shift]++;
+            } else {
+                block = allocateBlock(static_cast<size_t>(1) << shift, current, false);
+                if (!block.data) {
+                    return nullptr;
+                }
+                misses[shift]++;
+            }
+            inUse[shift]++;
+        }
+
+        if (zero) {
+            std::memset(block.data, 0, size);
+        }
+        // If the control block cannot be allocated the deleter runs and the block is returned
+        return std::shared_ptr<uint8_t>(block.data, Deleter{this, block});
+    }
+
+    void release(const Block& block) {
+        if (block.oversize) {
+            oversizeInUse--;
+            oversizeBytes -= block.size;
+            freeBlock(block);
+            return;
+        }
+
+        const size_t shift = ceilLog2(block.size);
+        inUse[shift]--;
+
+        if (!threadCacheDestroyed()) {
+            ThreadCache& cache = threadCache();
+            if (shift < cache.layout.minShift || shift > cache.layout.maxShift) {
+                freeBlock(block);  // Size class no longer exists
+                return;
+            }
+            // Each thread's cache is bounded by maxCachedBytes like the shared lists,
+            // so a thread that releases many large blocks cannot pin them all
+            if (cache.lists[shift].size() < cache.layout.threadCacheBlocks &&
+                cache.cachedBytes + block.size <= cache.layout.maxCachedBytes) {
+                cache.lists[shift].push_back(block);
+                cache.cachedBytes += block.size;
+                cached[shift]++;
+                return;
+            }
+        }
+        releaseShared(block, shift);
+    }
+
+    void releaseShared(const Block& block, size_t shift) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (shift >= layout.minShift && shift <= layout.maxShift &&
+                sharedCachedBytes + block.size <= layout.maxCachedBytes) {
+                freeLists[shift].push_back(block);
+                sharedCachedBytes += block.size;
+                cached[shift]++;
+                return;
+            }
+        }
+        freeBlock(block);
+    }
+
+    void trimShared() {
+        std::array<std::vector<Block>, MAX_SHIFT + 1> released;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            released.swap(freeLists);
+            sharedCachedBytes = 0;
+        }
+        for (size_t shift = 0; shift <= MAX_SHIFT; shift++) {
+            for (const Block& block : released[shift]) {
+                cached[shift]--;
+                freeBlock(block);
+            }
+        }
+    }
+};
+
+// Hand the exiting thread's free blocks to the shared free lists
+BufferPool::Impl::ThreadCache::~ThreadCache() {
+    threadCacheDestroyed() = true;
+    for (size_t shift = 0; shift <= MAX_SHIFT; shift++) {
+        for (const Block& block : lists[shift]) {
+            owner->cached[shift]--;
+            owner->releaseShared(block, shift);
+        }
+    }
+}
+
+// Get the singleton instance
+BufferPool& BufferPool::getInstance() {
+    // Never destroyed: buffers held by other static objects may be released after main returns
+    static BufferPool* instance = new BufferPool();
+    return *instance;
+}
+
+// Private constructor for singleton
+BufferPool::BufferPool()
+    : pImpl(std::make_unique<Impl>())
+{
+}
+
+// Private destructor for singleton
+BufferPool::~BufferPool() = default;
+
+// Acquire a buffer
+std::shared_ptr<uint8_t> BufferPool::acquire(size_t size, bool zero) {
+    return pImpl->acquire(size, zero);
+}
+
+// Free cached blocks
+void BufferPool::trim() {
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->generation++;
+    }
+    pImpl->trimShared();
+    if (!Impl::threadCacheDestroyed()) {
+        pImpl->threadCache();  // Drops this thread's blocks for the new generation
+    }
+}
+
+// Get pool statistics
+BufferPoolStats BufferPool::getStats() const {
+    BufferPoolStats stats;
+    stats.bytesInUse = pImpl->oversizeBytes.load();
+    stats.bytesCached = 0;
+    stats.oversizeInUse = pImpl->oversizeInUse.load();
+    stats.hugePageBlocks = pImpl->hugePageBlocks.load();
+    stats.hits = 0;
+    stats.misses = 0;
+
+    Impl::Layout layout;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        layout = pImpl->layout;
+    }
+
+    for (size_t shift = 0; shift <= MAX_SHIFT; shift++) {
+        const size_t blockSize = static_cast<size_t>(1) << shift;
+        BufferSizeClassStats sizeClass;
+        sizeClass.blockSize = blockSize;
+        sizeClass.inUse = pImpl->inUse[shift].load();
+        sizeClass.cached = pImpl->cached[shift].load();
+        sizeClass.hits = pImpl->hits[shift].load();
+        sizeClass.misses = pImpl->misses[shift].load();
+
+        stats.bytesInUse += sizeClass.inUse * blockSize;
+        stats.bytesCached += sizeClass.cached * blockSize;
+        stats.hits += sizeClass.hits;
+        stats.misses += sizeClass.misses;
+
+        // Report the configured classes, plus older ones that still have blocks out
+        if ((shift >= layout.minShift && shift <= layout.maxShift) || sizeClass.inUse > 0 || sizeClass.cached > 0) {
+            stats.sizeClasses.push_back(sizeClass);
+        }
+    }
+    return stats;
+}
+
+// Get the configuration
+BufferPoolConfig BufferPool::getConfig() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->config;
+}
+
+// Set the configuration
+bool BufferPool::setConfig(const BufferPoolConfig& config) {
+    if (config.minBlockSize == 0 || config.maxBlockSize < config.minBlockSize ||
+        config.maxBlockSize > (static_cast<size_t>(1) << 40)) {
+        return false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->applyConfig(config);
+    }
+    trim();
+    return true;
+}
+
+} // namespace signal
+} // namespace tdoa
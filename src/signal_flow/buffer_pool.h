@@ -0,0 +1,148 @@
+/**
+ * @file buffer_pool.h
+ * @brief Size-classed pool of aligned sample buffers
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Buffer pool configuration
+ */
+struct BufferPoolConfig {
+    size_t minBlockSize;        ///< Smallest size class in bytes (rounded up to a power of two)
+    size_t maxBlockSize;        ///< Largest pooled size class; larger requests bypass the pool
+    size_t maxCachedBytes;      ///< Upper bound on free bytes held by the shared free lists, and by each thread's cache
+    size_t threadCacheBlocks;   ///< Free blocks kept per size class in each thread's cache
+    bool useHugePages;          ///< Back large blocks with huge pages where the OS allows it
+    size_t hugePageThreshold;   ///< Smallest block size that is huge-page backed
+
+    /**
+     * @brief Constructor with default values
+     */
+    BufferPoolConfig()
+        : minBlockSize(4096)                    // 4 KB
+        , maxBlockSize(64 * 1024 * 1024)        // 64 MB
+        , maxCachedBytes(256 * 1024 * 1024)     // 256 MB
+        , threadCacheBlocks(4)
+        , useHugePages(false)
+        , hugePageThreshold(2 * 1024 * 1024)    // 2 MB
+    {}
+};
+
+/**
+ * @brief Occupancy of one size class
+ */
+struct BufferSizeClassStats {
+    size_t blockSize;           ///< Block size in bytes
+    size_t inUse;               ///< Blocks handed out and not yet returned
+    size_t cached;              ///< Free blocks held in thread caches and shared free lists
+    uint64_t hits;              ///< Acquisitions served from a cache
+    uint64_t misses;            ///< Acquisitions that allocated a new block
+};
+
+/**
+ * @brief Buffer pool statistics
+ */
+struct BufferPoolStats {
+    std::vector<BufferSizeClassStats> sizeClasses; ///< Per size class occupancy
+    size_t bytesInUse;          ///< Bytes in blocks handed out, including oversize blocks
+    size_t bytesCached;         ///< Bytes in free blocks
+    size_t oversizeInUse;       ///< Oversize blocks handed out (allocated and freed directly)
+    size_t hugePageBlocks;      ///< Live blocks backed by huge pages
+    uint64_t hits;              ///< Acquisitions served from a cache
+    uint64_t misses;            ///< Acquisitions that allocated a new block
+
+    /**
+     * @brief Calculate the fraction of acquisitions served from a cache
+     * @return Hit rate (0.0 to 1.0)
+     */
+    double getHitRate() const {
+        return (hits + misses) > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+    }
+};
+
+/**
+ * @class BufferPool
+ * @brief Process-wide pool of 64-byte-aligned sample buffers
+ *
+ * Requests are rounded up to a power-of-two size class. Buffers are handed
+ * out as shared pointers whose deleter returns the block to the releasing
+ * thread's cache, or to the shared free lists once that cache is full, so a
+ * block is recycled when the last Signal referencing it is destroyed.
+ * Requests above maxBlockSize are allocated and freed directly.
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Alignment of every buffer in bytes (one cache line, enough for AVX-512)
+     */
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+     * @brief Get the singleton instance
+     * @return Reference to the singleton instance
+     */
+    static BufferPool& getInstance();
+
+    /**
+     * @brief Acquire a buffer
+     * @param size Required size in bytes
+     * @param zero Whether to zero the first size bytes
+     * @return Aligned buffer of at least size bytes, or nullptr if size is 0 or allocation fails
+     */
+    std::shared_ptr<uint8_t> acquire(size_t size, bool zero = false);
+
+    /**
+     * @brief Free all cached blocks in the shared free lists and the calling thread's cache
+     *
+     * Other threads drop their cached blocks on their next acquire or release.
+     */
+    void trim();
+
+    /**
+     * @brief Get pool statistics
+     * @return Statistics snapshot
+     */
+    BufferPoolStats getStats() const;
+
+    /**
+     * @brief Get the configuration
+     * @return Current configuration
+     */
+    BufferPoolConfig getConfig() const;
+
+    /**
+     * @brief Set the configuration and drop cached blocks
+     *
+     * Blocks handed out under the old configuration are freed on release if
+     * they no longer match a size class.
+     * @param config New configuration
+     * @return True if the configuration is valid and was applied
+     */
+    bool setConfig(const BufferPoolConfig& config);
+
+private:
+    /**
+     * @brief Private constructor for singleton
+     */
+    BufferPool();
+
+    /**
+     * @brief Private destructor for singleton
+     */
+    ~BufferPool();
+
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
@@ -0,0 +1,408 @@
+/**
+ * @file flow_control.cpp
+ * @brief Implementation of CreditChannel and ShedController classes
+ */
+
+#include "flow_control.h"
+#include <algorithm>
+#include <iostream>
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+// Links followed by getPressure; guards against a miswired cycle
+const size_t MAX_PIPELINE_DEPTH = 64;
+
+/**
+ * @brief Registry of live channels for getAllMetrics
+ */
+struct ChannelRegistry {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<CreditChannel>> channels;
+};
+
+ChannelRegistry& getRegistry() {
+    static ChannelRegistry registry;
+    return registry;
+}
+
+} // anonymous namespace
+
+// Convert a shed level to a string
+std::string shedLevelToString(ShedLevel level) {
+    switch (level) {
+        case ShedLevel::NONE: return "NONE";
+        case ShedLevel::REDUCE_BAND: return "REDUCE_BAND";
+        case ShedLevel::DECIMATE: return "DECIMATE";
+        case ShedLevel::DROP: return "DROP";
+        default: return "UNKNOWN";
+    }
+}
+
+// Create a channel
+std::shared_ptr<CreditChannel> CreditChannel::create(const std::string& name, size_t capacity) {
+    std::shared_ptr<CreditChannel> channel(new CreditChannel(name, capacity));
+
+    ChannelRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.channels.erase(
+        std::remove_if(registry.channels.begin(), registry.channels.end(),
+                       [](const std::weak_ptr<CreditChannel>& entry) { return entry.expired(); }),
+        registry.channels.end());
+    registry.channels.push_back(channel);
+
+    return channel;
+}
+
+// Constructor
+CreditChannel::CreditChannel(const std::string& name, size_t capacity)
+    : name_(name)
+    , capacity_(std::max<size_t>(1, capacity))
+    , inFlight_(0)
+    , peakInFlight_(0)
+    , granted_(0)
+    , refused_(0) {
+}
+
+// Destructor
+CreditChannel::~CreditChannel() {
+    size_t inFlight = inFlight_.load(std::memory_order_relaxed);
+    if (inFlight > 0) {
+        std::cerr << "Warning: Credit channel " << name_ << " destroyed with "
+                  << inFlight << " credits outstanding" << std::endl;
+    }
+}
+
+// Get the channel name
+const std::string& CreditChannel::getName() const {
+    return name_;
+}
+
+// Take credits
+bool CreditChannel::tryAcquire(size_t count) {
+    size_t inFlight = inFlight_.load(std::memory_order_relaxed);
+    do {
+        if (inFlight + count > capacity_.load(std::memory_order_relaxed)) {
+            refused_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!inFlight_.compare_exchange_weak(inFlight, inFlight + count,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+
+    granted_.fetch_add(count, std::memory_order_relaxed);
+
+    size_t peak = peakInFlight_.load(std::memory_order_relaxed);
+    size_t current = inFlight + count;
+    while (current > peak &&
+           !peakInFlight_.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+
+    return true;
+}
+
+// Take credits as a Credit
+CreditChannel::Credit CreditChannel::tryAcquireCredit(size_t count) {
+    if (!tryAcquire(count)) {
+        return nullptr;
+    }
+
+    // The credit keeps the channel alive until it is returned
+    std::shared_ptr<CreditChannel> channel = shared_from_this();
+    return Credit(static_cast<void*>(channel.get()),
+                  [channel, count](void*) { channel->release(count); });
+}
+
+// Return credits
+void CreditChannel::release(size_t count) {
+    size_t inFlight = inFlight_.load(std::memory_order_relaxed);
+    do {
+        if (count > inFlight) {
+            std::cerr << "Error: Credit channel " << name_ << " released "
+                      << count << " credits but only " << inFlight << " are held" << std::endl;
+            count = inFlight;
+        }
+    } while (!inFlight_.compare_exchange_weak(inFlight, inFlight - count,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+// Change the advertised capacity
+void CreditChannel::setCapacity(size_t capacity) {
+    capacity_.store(std::max<size_t>(1, capacity), std::memory_order_relaxed);
+}
+
+// Get the advertised capacity
+size_t CreditChannel::getCapacity() const {
+    return capacity_.load(std::memory_order_relaxed);
+}
+
+// Get the credits available now
+size_t CreditChannel::getAvailable() const {
+    size_t capacity = capacity_.load(std::memory_order_relaxed);
+    size_t inFlight = inFlight_.load(std::memory_order_relaxed);
+    return inFlight < capacity ? capacity - inFlight : 0;
+}
+
+// Link the next stage
+void CreditChannel::setDownstream(std::shared_ptr<CreditChannel> downstream) {
+    if (downstream.get() == this) {
+        std::cerr << "Error: Credit channel " << name_ << " cannot feed itself" << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(downstreamMutex_);
+    downstream_ = std::move(downstream);
+}
+
+// Get the next stage
+std::shared_ptr<CreditChannel> CreditChannel::getDownstream() const {
+    std::lock_guard<std::mutex> lock(downstreamMutex_);
+    return downstream_;
+}
+
+// Get the pressure of this channel
+double CreditChannel::getLocalPressure() const {
+    return static_cast<double>(inFlight_.load(std::memory_order_relaxed)) /
+           static_cast<double>(capacity_.load(std::memory_order_relaxed));
+}
+
+// Get the pressure to the end of the pipeline
+double CreditChannel::getPressure() const {
+    double pressure = getLocalPressure();
+    std::shared_ptr<CreditChannel> next = getDownstream();
+    for (size_t depth = 0; next && depth < MAX_PIPELINE_DEPTH; ++depth) {
+        pressure = std::max(pressure, next->getLocalPressure());
+        next = next->getDownstream();
+    }
+    return pressure;
+}
+
+// Get the channel metrics
+CreditChannelMetrics CreditChannel::getMetrics() const {
+    CreditChannelMetrics metrics;
+    metrics.name = name_;
+    std::shared_ptr<CreditChannel> downstream = getDownstream();
+    if (downstream) {
+        metrics.downstream = downstream->getName();
+    }
+    metrics.capacity = capacity_.load(std::memory_order_relaxed);
+    metrics.inFlight = inFlight_.load(std::memory_order_relaxed);
+    metrics.peakInFlight = peakInFlight_.load(std::memory_order_relaxed);
+    metrics.granted = granted_.load(std::memory_order_relaxed);
+    metrics.refused = refused_.load(std::memory_order_relaxed);
+    metrics.pressure = getPressure();
+    return metrics;
+}
+
+// Get the metrics of every live channel
+std::vector<CreditChannelMetrics> CreditChannel::getAllMetrics() {
+    std::vector<std::shared_ptr<CreditChannel>> channels;
+    {
+        ChannelRegistry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& entry : registry.channels) {
+            if (std::shared_ptr<CreditChannel> channel = entry.lock()) {
+                channels.push_back(channel);
+            }
+        }
+    }
+
+    std::vector<CreditChannelMetrics> metrics;
+    metrics.reserve(channels.size());
+    for (const auto& channel : channels) {
+        metrics.push_back(channel->getMetrics());
+    }
+    return metrics;
+}
+
+// Private implementation
+struct ShedController::Impl {
+    std::shared_ptr<CreditChannel> channel;     ///< Input channel of the first stage
+    ShedConfig config;                          ///< Shed thresholds
+    mutable std::mutex mutex;                   ///< Protects the fields below
+    LevelHandler handler;                       ///< Called on level changes
+    ShedMetrics metrics;                        ///< Metrics, level included
+    std::chrono::steady_clock::time_point levelSince; ///< When the current level was entered
+    std::chrono::steady_clock::time_point accounted;  ///< Time up to which secondsInLevel is counted
+    uint64_t decimationCounter = 0;             ///< Blocks offered since DECIMATE was entered
+
+    /**
+     * @brief Pressure that enters a level
+     */
+    double threshold(ShedLevel level) const {
+        switch (level) {
+            case ShedLevel::REDUCE_BAND: return config.reduceBandPressure;
+            case ShedLevel::DECIMATE: return config.decimatePressure;
+            case ShedLevel::DROP: return config.dropPressure;
+            default: return 0.0;
+        }
+    }
+
+    /**
+     * @brief Move along the ladder for the current pressure, with the mutex held
+     * @param previous Receives the level before the update
+     * @return True if the level changed
+     */
+    bool updateLevelLocked(ShedLevel& previous) {
+        auto now = std::chrono::steady_clock::now();
+        double pressure = channel->getPressure();
+        ShedLevel current = metrics.level;
+
+        metrics.secondsInLevel[static_cast<size_t>(current)] +=
+            std::chrono::duration<double>(now - accounted).count();
+        accounted = now;
+        metrics.pressure = pressure;
+
+        // Step up to the highest level reached, at once
+        ShedLevel target = ShedLevel::NONE;
+        for (ShedLevel level : {ShedLevel::REDUCE_BAND, ShedLevel::DECIMATE, ShedLevel::DROP}) {
+            if (pressure >= threshold(level)) {
+                target = level;
+            }
+        }
+
+        if (target < current) {
+            // Step down only below the recovery point, after the hold time
+            if (pressure >= threshold(current) * config.recoveryFactor ||
+                now - levelSince < config.minHoldMs) {
+                target = current;
+            } else {
+                target = static_cast<ShedLevel>(static_cast<int>(current) - 1);
+            }
+        }
+
+        if (target == current) {
+            return false;
+        }
+
+        previous = current;
+        metrics.level = target;
+        metrics.transitions++;
+        levelSince = now;
+        decimationCounter = 0;
+        return true;
+    }
+};
+
+// Constructor
+ShedController::ShedController(std::shared_ptr<CreditChannel> channel, const ShedConfig& config)
+    : pImpl(new Impl()) {
+    pImpl->channel = std::move(channel);
+    pImpl->config = config;
+    pImpl->config.decimationFactor = std::max<size_t>(1, config.decimationFactor);
+    pImpl->levelSince = std::chrono::steady_clock::now();
+    pImpl->accounted = pImpl->levelSince;
+}
+
+// Destructor
+ShedController::~ShedController() = default;
+
+// Set the level handler
+void ShedController::setLevelHandler(LevelHandler handler) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->handler = std::move(handler);
+}
+
+// Decide whether a block enters the pipeline
+CreditChannel::Credit ShedController::admit(size_t samples) {
+    // Without a channel there is no pressure to shed on, so every block is
+    // forwarded with a credit that returns nothing
+    if (!pImpl->channel) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        pImpl->metrics.blocksOffered++;
+        pImpl->metrics.blocksForwarded++;
+        return CreditChannel::Credit(pImpl.get(), [](void*) {});
+    }
+
+    CreditChannel::Credit credit;
+    ShedLevel previous = ShedLevel::NONE;
+    ShedLevel level;
+    LevelHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        bool changed = pImpl->updateLevelLocked(previous);
+        level = pImpl->metrics.level;
+        if (changed) {
+            handler = pImpl->handler;
+        }
+
+        ShedMetrics& metrics = pImpl->metrics;
+        metrics.blocksOffered++;
+
+        if (level == ShedLevel::DROP) {
+            metrics.blocksDropped++;
+            metrics.samplesShed += samples;
+        } else if (level == ShedLevel::DECIMATE &&
+                   pImpl->decimationCounter++ % pImpl->config.decimationFactor != 0) {
+            metrics.blocksDecimated++;
+            metrics.samplesShed += samples;
+        } else if ((credit = pImpl->channel->tryAcquireCredit(1))) {
+            metrics.blocksForwarded++;
+        } else {
+            metrics.blocksDropped++;
+            metrics.samplesShed += samples;
+        }
+    }
+
+    // Outside the lock so the handler may reconfigure the source or read metrics
+    if (handler) {
+        handler(previous, level);
+    }
+
+    return credit;
+}
+
+// Re-evaluate the level
+ShedLevel ShedController::evaluate() {
+    if (!pImpl->channel) {
+        return ShedLevel::NONE;
+    }
+
+    ShedLevel previous = ShedLevel::NONE;
+    ShedLevel level;
+    LevelHandler handler;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        if (pImpl->updateLevelLocked(previous)) {
+            handler = pImpl->handler;
+        }
+        level = pImpl->metrics.level;
+    }
+
+    if (handler) {
+        handler(previous, level);
+    }
+
+    return level;
+}
+
+// Get the current level
+ShedLevel ShedController::getLevel() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->metrics.level;
+}
+
+// Get the channel
+std::shared_ptr<CreditChannel> ShedController::getChannel() const {
+    return pImpl->channel;
+}
+
+// Get the shed thresholds
+const ShedConfig& ShedController::getConfig() const {
+    return pImpl->config;
+}
+
+// Get the shedding metrics
+ShedMetrics ShedController::getMetrics() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    ShedMetrics metrics = pImpl->metrics;
+    metrics.secondsInLevel[static_cast<size_t>(metrics.level)] +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - pImpl->accounted).count();
+    return metrics;
+}
+
+} // namespace signal
+} // namespace tdoa
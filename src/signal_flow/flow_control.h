@@ -0,0 +1,345 @@
+/**
+ * @file flow_control.h
+ * @brief Credit-based flow control between pipeline stages and deliberate load shedding at the source
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Shedding level, from no shedding to dropping whole blocks
+ */
+enum class ShedLevel {
+    NONE,           ///< Everything is forwarded
+    REDUCE_BAND,    ///< Downstream work is cut by narrowing the detection band
+    DECIMATE,       ///< Only one block in decimationFactor is forwarded
+    DROP            ///< Every block is dropped until the pipeline drains
+};
+
+/**
+ * @brief Convert a shed level to a string
+ * @param level Shed level
+ * @return String representation
+ */
+std::string shedLevelToString(ShedLevel level);
+
+/**
+ * @brief Metrics of one credit channel
+ */
+struct CreditChannelMetrics {
+    std::string name;           ///< Channel name
+    std::string downstream;     ///< Name of the downstream channel, empty if none
+    size_t capacity;            ///< Credits the stage advertises
+    size_t inFlight;            ///< Credits currently held by upstream
+    size_t peakInFlight;        ///< Highest inFlight seen
+    uint64_t granted;           ///< Credits granted
+    uint64_t refused;           ///< Acquire attempts refused for lack of credit
+    double pressure;            ///< Highest inFlight / capacity of this channel and all downstream channels
+
+    /**
+     * @brief Constructor with default values
+     */
+    CreditChannelMetrics()
+        : capacity(0)
+        , inFlight(0)
+        , peakInFlight(0)
+        , granted(0)
+        , refused(0)
+        , pressure(0.0)
+    {}
+};
+
+/**
+ * @class CreditChannel
+ * @brief Capacity a pipeline stage advertises to the stage feeding it
+ *
+ * A stage owns the channel on its input and sets its capacity to the work it
+ * can hold. Upstream takes a credit before handing over a unit of work and
+ * the stage returns it once the unit is finished, so inFlight never exceeds
+ * capacity and a slow stage stops its producer instead of growing a queue.
+ * Channels are linked with setDownstream, and getPressure reports the worst
+ * fill level from this channel to the end of the pipeline, which lets the
+ * source see a sink falling behind before the intermediate stages fill up.
+ *
+ * Acquire and release are lock-free and safe from any thread.
+ */
+class CreditChannel : public std::enable_shared_from_this<CreditChannel> {
+public:
+    /**
+     * @brief Credit held by upstream, returned to the channel when the last copy is destroyed
+     *
+     * A null credit means the acquire was refused.
+     */
+    using Credit = std::shared_ptr<void>;
+
+    /**
+     * @brief Create a channel and register it for getAllMetrics
+     * @param name Channel name, usually the name of the stage that owns it
+     * @param capacity Credits available (at least 1)
+     * @return New channel
+     */
+    static std::shared_ptr<CreditChannel> create(const std::string& name, size_t capacity);
+
+    /**
+     * @brief Destructor
+     */
+    ~CreditChannel();
+
+    /**
+     * @brief Get the channel name
+     * @return Channel name
+     */
+    const std::string& getName() const;
+
+    /**
+     * @brief Take credits if that many are available
+     * @param count Credits to take
+     * @return True if the credits were taken
+     */
+    bool tryAcquire(size_t count = 1);
+
+    /**
+     * @brief Take credits as a Credit that returns them when destroyed
+     * @param count Credits to take
+     * @return Credit, or nullptr if not enough credits are available
+     */
+    Credit tryAcquireCredit(size_t count = 1);
+
+    /**
+     * @brief Return credits taken with tryAcquire
+     * @param count Credits to return
+     */
+    void release(size_t count = 1);
+
+    /**
+     * @brief Change the advertised capacity
+     *
+     * Lowering the capacity below inFlight does not revoke credits; new
+     * acquires are refused until enough have been returned.
+     * @param capacity New capacity (at least 1)
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @brief Get the advertised capacity
+     * @return Capacity
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @brief Get the credits that can be acquired now
+     * @return Available credits
+     */
+    size_t getAvailable() const;
+
+    /**
+     * @brief Link the channel of the next stage
+     * @param downstream Channel of the stage this stage feeds, or nullptr to unlink
+     */
+    void setDownstream(std::shared_ptr<CreditChannel> downstream);
+
+    /**
+     * @brief Get the channel of the next stage
+     * @return Downstream channel, or nullptr if none
+     */
+    std::shared_ptr<CreditChannel> getDownstream() const;
+
+    /**
+     * @brief Get the pressure of this channel alone
+     * @return inFlight / capacity (can exceed 1.0 after the capacity was lowered)
+     */
+    double getLocalPressure() const;
+
+    /**
+     * @brief Get the highest pressure from this channel to the end of the pipeline
+     * @return Highest inFlight / capacity along the downstream links
+     */
+    double getPressure() const;
+
+    /**
+     * @brief Get the channel metrics
+     * @return Metrics
+     */
+    CreditChannelMetrics getMetrics() const;
+
+    /**
+     * @brief Get the metrics of every live channel
+     * @return Metrics, one entry per channel
+     */
+    static std::vector<CreditChannelMetrics> getAllMetrics();
+
+private:
+    /**
+     * @brief Constructor, use create
+     */
+    CreditChannel(const std::string& name, size_t capacity);
+
+    CreditChannel(const CreditChannel&) = delete;
+    CreditChannel& operator=(const CreditChannel&) = delete;
+
+    const std::string name_;                    ///< Channel name
+    std::atomic<size_t> capacity_;              ///< Advertised capacity
+    std::atomic<size_t> inFlight_;              ///< Credits held by upstream
+    std::atomic<size_t> peakInFlight_;          ///< Highest inFlight seen
+    std::atomic<uint64_t> granted_;             ///< Credits granted
+    std::atomic<uint64_t> refused_;             ///< Refused acquire attempts
+    mutable std::mutex downstreamMutex_;        ///< Protects downstream_
+    std::shared_ptr<CreditChannel> downstream_; ///< Channel of the next stage
+};
+
+/**
+ * @brief Thresholds of the shed ladder
+ *
+ * A level is entered when the pipeline pressure reaches its threshold and
+ * left when the pressure falls below threshold * recoveryFactor and the level
+ * has been held for minHoldMs, so the source does not flap between levels.
+ */
+struct ShedConfig {
+    double reduceBandPressure;      ///< Pressure that enters REDUCE_BAND
+    double decimatePressure;        ///< Pressure that enters DECIMATE
+    double dropPressure;            ///< Pressure that enters DROP
+    double recoveryFactor;          ///< Fraction of a threshold the pressure must fall below to leave the level
+    size_t decimationFactor;        ///< Blocks per forwarded block in DECIMATE
+    std::chrono::milliseconds minHoldMs; ///< Minimum time in a level before stepping down
+
+    /**
+     * @brief Constructor with default values
+     */
+    ShedConfig()
+        : reduceBandPressure(0.5)
+        , decimatePressure(0.75)
+        , dropPressure(0.9)
+        , recoveryFactor(0.8)
+        , decimationFactor(2)
+        , minHoldMs(250)
+    {}
+};
+
+/**
+ * @brief Shedding metrics of a source
+ */
+struct ShedMetrics {
+    ShedLevel level;                ///< Current level
+    double pressure;                ///< Pipeline pressure at the last evaluation
+    uint64_t transitions;           ///< Level changes
+    uint64_t blocksOffered;         ///< Blocks the source produced
+    uint64_t blocksForwarded;       ///< Blocks handed downstream
+    uint64_t blocksDecimated;       ///< Blocks skipped by DECIMATE
+    uint64_t blocksDropped;         ///< Blocks dropped in DROP or for lack of credit
+    uint64_t samplesShed;           ///< Samples in decimated and dropped blocks
+    std::vector<double> secondsInLevel; ///< Time spent in each level, indexed by ShedLevel
+
+    /**
+     * @brief Constructor with default values
+     */
+    ShedMetrics()
+        : level(ShedLevel::NONE)
+        , pressure(0.0)
+        , transitions(0)
+        , blocksOffered(0)
+        , blocksForwarded(0)
+        , blocksDecimated(0)
+        , blocksDropped(0)
+        , samplesShed(0)
+        , secondsInLevel(4, 0.0)
+    {}
+};
+
+/**
+ * @class ShedController
+ * @brief Decides at the source which blocks enter the pipeline
+ *
+ * admit is called once per block produced by the source. It reads the
+ * pressure of the first stage's channel and everything downstream of it,
+ * moves along the shed ladder and takes a credit for the block. Blocks are
+ * only ever dropped here, so the stages behind the source see whole blocks
+ * and every dropped sample is counted in the metrics. The level handler is
+ * where a source narrows the detection band or changes its own decimation;
+ * the controller itself skips blocks from DECIMATE up, drops every block in
+ * DROP and drops any block it cannot get a credit for.
+ *
+ * admit is meant for a single producer thread; the metrics can be read from
+ * any thread.
+ */
+class ShedController {
+public:
+    /**
+     * @brief Level handler, called on the admitting thread with the previous and new level
+     */
+    using LevelHandler = std::function<void(ShedLevel, ShedLevel)>;
+
+    /**
+     * @brief Constructor
+     * @param channel Input channel of the first stage, or nullptr to forward every block
+     * @param config Shed thresholds
+     */
+    explicit ShedController(std::shared_ptr<CreditChannel> channel, const ShedConfig& config = ShedConfig());
+
+    /**
+     * @brief Destructor
+     */
+    ~ShedController();
+
+    /**
+     * @brief Set the level handler
+     * @param handler Handler, or nullptr to remove it
+     */
+    void setLevelHandler(LevelHandler handler);
+
+    /**
+     * @brief Decide whether a block enters the pipeline
+     * @param samples Samples in the block, for the metrics
+     * @return Credit for the block, nullptr if the block is shed; without a
+     *         channel every block is admitted with a credit bound to no channel
+     */
+    CreditChannel::Credit admit(size_t samples);
+
+    /**
+     * @brief Re-evaluate the level without offering a block
+     * @return Current level
+     */
+    ShedLevel evaluate();
+
+    /**
+     * @brief Get the current level
+     * @return Shed level
+     */
+    ShedLevel getLevel() const;
+
+    /**
+     * @brief Get the channel the controller takes credit from
+     * @return Input channel of the first stage
+     */
+    std::shared_ptr<CreditChannel> getChannel() const;
+
+    /**
+     * @brief Get the shed thresholds
+     * @return Configuration
+     */
+    const ShedConfig& getConfig() const;
+
+    /**
+     * @brief Get the shedding metrics
+     * @return Metrics
+     */
+    ShedMetrics getMetrics() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
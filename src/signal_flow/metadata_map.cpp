@@ -0,0 +1,338 @@
+/**
+ * @file metadata_map.cpp
+ * @brief Implementation of interned strings, metadata maps and the provenance log
+ */
+
+#include "metadata_map.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+/**
+ * @brief Process-wide string table
+ */
+class StringTable {
+public:
+    StringTable() {
+        strings_.emplace_back();    // ID 0 is the empty string
+        ids_.emplace(std::string(), 0);
+    }
+
+    uint32_t intern(const std::string& value) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(value);
+            if (it != ids_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(value);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+        if (strings_.size() > UINT32_MAX) {
+            throw std::length_error("Interned string table is full");
+        }
+        uint32_t id = static_cast<uint32_t>(strings_.size());
+        strings_.push_back(value);
+        ids_.emplace(value, id);
+        return id;
+    }
+
+    uint32_t lookup(const std::string& value) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(value);
+        return it != ids_.end() ? it->second : 0;
+    }
+
+    const std::string& get(uint32_t id) const {
+        // Deque elements never move, so the reference outlives the lock
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return strings_[id];
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    std::deque<std::string> strings_;                   ///< Strings by ID
+    std::unordered_map<std::string, uint32_t> ids_;     ///< IDs by string
+};
+
+StringTable& stringTable() {
+    // Never destroyed: interned strings may be used by other static objects during shutdown
+    static StringTable* table = new StringTable();
+    return *table;
+}
+
+bool parseBool(const std::string& text, bool defaultValue) {
+    std::string value = text;
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    if (value == "true" || value == "1" || value == "yes" || value == "y") {
+        return true;
+    } else if (value == "false" || value == "0" || value == "no" || value == "n") {
+        return false;
+    }
+    return defaultValue;
+}
+
+bool parseDouble(const std::string& text, double& result) {
+    const char* begin = text.c_str();
+    char* end = nullptr;
+    result = std::strtod(begin, &end);
+    return end != begin;
+}
+
+bool entryKeyLess(const MetadataMap::Entry& entry, const MetadataKey& key) {
+    return entry.first < key;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// InternedString Implementation
+//-----------------------------------------------------------------------------
+
+InternedString::InternedString(const std::string& value)
+    : id_(value.empty() ? 0 : stringTable().intern(value)) {
+}
+
+InternedString::InternedString(const char* value)
+    : id_((value == nullptr || *value == '\0') ? 0 : stringTable().intern(value)) {
+}
+
+InternedString InternedString::lookup(const std::string& value) {
+    InternedString result;
+    result.id_ = stringTable().lookup(value);
+    return result;
+}
+
+const std::string& InternedString::str() const {
+    return stringTable().get(id_);
+}
+
+std::ostream& operator<<(std::ostream& stream, const InternedString& value) {
+    return stream << value.str();
+}
+
+//-----------------------------------------------------------------------------
+// MetadataValue Implementation
+//-----------------------------------------------------------------------------
+
+bool MetadataValue::asBool(bool defaultValue) const {
+    switch (getType()) {
+        case Type::Bool:
+            return std::get<bool>(value_);
+        case Type::Int:
+            return std::get<int64_t>(value_) != 0;
+        case Type::Double:
+            return std::get<double>(value_) != 0.0;
+        case Type::String:
+            return parseBool(std::get<std::string>(value_), defaultValue);
+        default:
+            return defaultValue;
+    }
+}
+
+int64_t MetadataValue::asInt(int64_t defaultValue) const {
+    switch (getType()) {
+        case Type::Bool:
+            return std::get<bool>(value_) ? 1 : 0;
+        case Type::Int:
+            return std::get<int64_t>(value_);
+        case Type::Double:
+            return static_cast<int64_t>(std::get<double>(value_));
+        case Type::String: {
+            double parsed = 0.0;
+            return parseDouble(std::get<std::string>(value_), parsed) ? static_cast<int64_t>(parsed) : defaultValue;
+        }
+        default:
+            return defaultValue;
+    }
+}
+
+double MetadataValue::asDouble(double defaultValue) const {
+    switch (getType()) {
+        case Type::Bool:
+            return std::get<bool>(value_) ? 1.0 : 0.0;
+        case Type::Int:
+            return static_cast<double>(std::get<int64_t>(value_));
+        case Type::Double:
+            return std::get<double>(value_);
+        case Type::String: {
+            double parsed = 0.0;
+            return parseDouble(std::get<std::string>(value_), parsed) ? parsed : defaultValue;
+        }
+        default:
+            return defaultValue;
+    }
+}
+
+std::string MetadataValue::toString() const {
+    switch (getType()) {
+        case Type::Bool:
+            return std::get<bool>(value_) ? "true" : "false";
+        case Type::Int:
+            return std::to_string(std::get<int64_t>(value_));
+        case Type::Double:
+            return std::to_string(std::get<double>(value_));
+        case Type::String:
+            return std::get<std::string>(value_);
+        default:
+            return "";
+    }
+}
+
+//-----------------------------------------------------------------------------
+// MetadataMap Implementation
+//-----------------------------------------------------------------------------
+
+void MetadataMap::set(const MetadataKey& key, MetadataValue value) {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key, entryKeyLess);
+    if (it != entries_.end() && it->first == key) {
+        it->second = std::move(value);
+    } else {
+        entries_.emplace(it, key, std::move(value));
+    }
+}
+
+const MetadataValue* MetadataMap::find(const MetadataKey& key) const {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key, entryKeyLess);
+    if (it != entries_.end() && it->first == key) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+const MetadataValue* MetadataMap::findByName(const std::string& key) const {
+    MetadataKey interned = MetadataKey::lookup(key);
+    if (interned.empty() && !key.empty()) {
+        return nullptr;  // Never interned, so no map can contain it
+    }
+    return find(interned);
+}
+
+bool MetadataMap::erase(const MetadataKey& key) {
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key, entryKeyLess);
+    if (it != entries_.end() && it->first == key) {
+        entries_.erase(it);
+        return true;
+    }
+    return false;
+}
+
+std::string MetadataMap::getString(const std::string& key, const std::string& defaultValue) const {
+    const MetadataValue* value = findByName(key);
+    return value ? value->toString() : defaultValue;
+}
+
+double MetadataMap::getDouble(const std::string& key, double defaultValue) const {
+    const MetadataValue* value = findByName(key);
+    return value ? value->asDouble(defaultValue) : defaultValue;
+}
+
+void MetadataMap::merge(const MetadataMap& other, bool overwrite) {
+    for (const auto& entry : other.entries_) {
+        if (overwrite || !contains(entry.first)) {
+            set(entry.first, entry.second);
+        }
+    }
+}
+
+std::map<std::string, std::string> MetadataMap::toStringMap() const {
+    std::map<std::string, std::string> result;
+    for (const auto& entry : entries_) {
+        result[entry.first.str()] = entry.second.toString();
+    }
+    return result;
+}
+
+MetadataMap MetadataMap::fromStringMap(const std::map<std::string, std::string>& values) {
+    MetadataMap result;
+    result.reserve(values.size());
+    for (const auto& pair : values) {
+        result.set(pair.first, pair.second);
+    }
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+// ProvenanceLog Implementation
+//-----------------------------------------------------------------------------
+
+ProvenanceEntry::ProvenanceEntry()
+    : timestamp(std::chrono::system_clock::now()) {
+}
+
+ProvenanceEntry::ProvenanceEntry(const InternedString& id, const InternedString& name, const InternedString& op)
+    : componentId(id)
+    , componentName(name)
+    , operation(op)
+    , timestamp(std::chrono::system_clock::now()) {
+}
+
+ProvenanceLog::ProvenanceLog(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity))
+    , head_(0)
+    , dropped_(0) {
+}
+
+ProvenanceEntry& ProvenanceLog::push(const ProvenanceEntry& entry) {
+    if (entries_.size() < capacity_) {
+        entries_.push_back(entry);
+        return entries_.back();
+    }
+    // Full: overwrite the oldest entry
+    ProvenanceEntry& slot = entries_[head_];
+    slot = entry;
+    head_ = (head_ + 1) % capacity_;
+    dropped_++;
+    return slot;
+}
+
+ProvenanceEntry& ProvenanceLog::push(const InternedString& componentId,
+                                     const InternedString& componentName,
+                                     const InternedString& operation) {
+    return push(ProvenanceEntry(componentId, componentName, operation));
+}
+
+void ProvenanceLog::append(const ProvenanceLog& other) {
+    dropped_ += other.dropped_;
+    for (size_t i = 0; i < other.size(); i++) {
+        push(other[i]);
+    }
+}
+
+const ProvenanceEntry& ProvenanceLog::operator[](size_t index) const {
+    return entries_[(head_ + index) % entries_.size()];
+}
+
+void ProvenanceLog::clear() {
+    entries_.clear();
+    head_ = 0;
+    dropped_ = 0;
+}
+
+std::string ProvenanceLog::toString(const std::string& separator) const {
+    std::string result;
+    for (size_t i = 0; i < size(); i++) {
+        if (i > 0) {
+            result += separator;
+        }
+        result += (*this)[i].componentId.str();
+    }
+    return result;
+}
+
+} // namespace signal
+} // namespace tdoa
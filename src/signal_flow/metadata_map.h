@@ -0,0 +1,382 @@
+/**
+ * @file metadata_map.h
+ * @brief Compact typed metadata: interned keys, flat maps and a bounded provenance log
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief String stored once per process and referred to by a 32-bit ID
+ *
+ * Used for metadata keys and low-cardinality values such as device and
+ * component IDs. Interned strings are never freed, so do not intern
+ * unbounded data such as per-signal IDs or free text.
+ */
+class InternedString {
+public:
+    /**
+     * @brief Create the empty string
+     */
+    InternedString() : id_(0) {}
+
+    /**
+     * @brief Intern a string
+     * @param value String value
+     */
+    InternedString(const std::string& value);
+
+    /**
+     * @brief Intern a C string
+     * @param value String value
+     */
+    InternedString(const char* value);
+
+    /**
+     * @brief Look up a string without interning it
+     * @param value String value
+     * @return Interned string, or the empty string if value was never interned
+     */
+    static InternedString lookup(const std::string& value);
+
+    /**
+     * @brief Get the string value
+     * @return Reference valid for the lifetime of the process
+     */
+    const std::string& str() const;
+
+    /**
+     * @brief Implicit conversion to the string value
+     */
+    operator const std::string&() const { return str(); }
+
+    /**
+     * @brief Get the interned ID (0 for the empty string)
+     * @return ID
+     */
+    uint32_t id() const { return id_; }
+
+    /**
+     * @brief Check if this is the empty string
+     * @return True if empty
+     */
+    bool empty() const { return id_ == 0; }
+
+    bool operator==(const InternedString& other) const { return id_ == other.id_; }
+    bool operator!=(const InternedString& other) const { return id_ != other.id_; }
+
+    /**
+     * @brief Order by ID, not lexicographically
+     */
+    bool operator<(const InternedString& other) const { return id_ < other.id_; }
+
+private:
+    uint32_t id_;   ///< Index into the process-wide string table
+};
+
+/**
+ * @brief Write an interned string to a stream
+ */
+std::ostream& operator<<(std::ostream& stream, const InternedString& value);
+
+/**
+ * @brief Metadata key
+ */
+using MetadataKey = InternedString;
+
+/**
+ * @brief Typed metadata value
+ */
+class MetadataValue {
+public:
+    /**
+     * @brief Value type enumeration
+     */
+    enum class Type {
+        None,       ///< No value
+        Bool,       ///< Boolean
+        Int,        ///< 64-bit signed integer
+        Double,     ///< Double precision floating point
+        String      ///< Text
+    };
+
+    MetadataValue() = default;
+    MetadataValue(bool value) : value_(value) {}
+    MetadataValue(double value) : value_(value) {}
+    MetadataValue(const char* value) : value_(std::string(value)) {}
+    MetadataValue(const std::string& value) : value_(value) {}
+    MetadataValue(std::string&& value) : value_(std::move(value)) {}
+
+    /**
+     * @brief Construct from any integer type other than bool
+     */
+    template <typename T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    MetadataValue(T value) : value_(static_cast<int64_t>(value)) {}
+
+    /**
+     * @brief Construct from float
+     */
+    MetadataValue(float value) : value_(static_cast<double>(value)) {}
+
+    /**
+     * @brief Get the value type
+     * @return Type of the stored value
+     */
+    Type getType() const { return static_cast<Type>(value_.index()); }
+
+    /**
+     * @brief Get the value as a boolean
+     *
+     * Numbers are true when non-zero; strings are parsed like ComponentConfig
+     * boolean parameters.
+     * @param defaultValue Value returned if there is no conversion
+     * @return Boolean value
+     */
+    bool asBool(bool defaultValue = false) const;
+
+    /**
+     * @brief Get the value as an integer (doubles are truncated, strings parsed)
+     * @param defaultValue Value returned if there is no conversion
+     * @return Integer value
+     */
+    int64_t asInt(int64_t defaultValue = 0) const;
+
+    /**
+     * @brief Get the value as a double (strings are parsed)
+     * @param defaultValue Value returned if there is no conversion
+     * @return Double value
+     */
+    double asDouble(double defaultValue = 0.0) const;
+
+    /**
+     * @brief Format the value as a string for storage or display
+     *
+     * Numbers use std::to_string and booleans "true"/"false", the same
+     * formatting ComponentConfig uses for its parameters.
+     * @return String representation (empty for None)
+     */
+    std::string toString() const;
+
+    bool operator==(const MetadataValue& other) const { return value_ == other.value_; }
+    bool operator!=(const MetadataValue& other) const { return value_ != other.value_; }
+
+private:
+    std::variant<std::monostate, bool, int64_t, double, std::string> value_;   ///< Order matches Type
+};
+
+/**
+ * @brief Small map from interned keys to typed values, stored as one sorted vector
+ *
+ * Lookups are a binary search over a contiguous array, and copying the map
+ * is a single allocation. Intended for the handful of entries carried by a
+ * signal; use toStringMap / fromStringMap at serialization boundaries.
+ */
+class MetadataMap {
+public:
+    using Entry = std::pair<MetadataKey, MetadataValue>;
+    using const_iterator = std::vector<Entry>::const_iterator;
+
+    /**
+     * @brief Set a value, replacing any existing value for the key
+     * @param key Metadata key
+     * @param value Metadata value
+     */
+    void set(const MetadataKey& key, MetadataValue value);
+
+    /**
+     * @brief Find a value
+     * @param key Metadata key
+     * @return Pointer to the value, or nullptr if not found
+     */
+    const MetadataValue* find(const MetadataKey& key) const;
+
+    /**
+     * @brief Find a value by string key without interning it
+     * @param key Metadata key
+     * @return Pointer to the value, or nullptr if not found
+     */
+    const MetadataValue* findByName(const std::string& key) const;
+
+    /**
+     * @brief Check if a key exists
+     * @param key Metadata key
+     * @return True if key exists
+     */
+    bool contains(const MetadataKey& key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Remove a key
+     * @param key Metadata key
+     * @return True if the key was removed
+     */
+    bool erase(const MetadataKey& key);
+
+    /**
+     * @brief Get a value as a string
+     * @param key Metadata key
+     * @param defaultValue Value returned if the key is not found
+     * @return String representation of the value
+     */
+    std::string getString(const std::string& key, const std::string& defaultValue = "") const;
+
+    /**
+     * @brief Get a value as a double
+     * @param key Metadata key
+     * @param defaultValue Value returned if the key is not found or not numeric
+     * @return Double value
+     */
+    double getDouble(const std::string& key, double defaultValue = 0.0) const;
+
+    /**
+     * @brief Merge entries from another map
+     * @param other Map to merge from
+     * @param overwrite Whether to overwrite existing values
+     */
+    void merge(const MetadataMap& other, bool overwrite = true);
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    void clear() { entries_.clear(); }
+    void reserve(size_t count) { entries_.reserve(count); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+    /**
+     * @brief Convert to a string map for serialization
+     * @return Map of key names to formatted values
+     */
+    std::map<std::string, std::string> toStringMap() const;
+
+    /**
+     * @brief Build from a string map (values are stored as strings)
+     * @param values Map of key names to values
+     * @return Metadata map
+     */
+    static MetadataMap fromStringMap(const std::map<std::string, std::string>& values);
+
+    bool operator==(const MetadataMap& other) const { return entries_ == other.entries_; }
+    bool operator!=(const MetadataMap& other) const { return entries_ != other.entries_; }
+
+private:
+    std::vector<Entry> entries_;    ///< Sorted by key ID
+};
+
+/**
+ * @brief One processing step recorded against a signal
+ */
+struct ProvenanceEntry {
+    InternedString componentId;     ///< ID of the processing component
+    InternedString componentName;   ///< Name of the processing component
+    InternedString operation;       ///< Description of the operation performed
+    std::chrono::system_clock::time_point timestamp; ///< Timestamp of the operation
+    std::shared_ptr<const MetadataMap> parameters;   ///< Parameters used, shared by all signals a configuration processed
+
+    /**
+     * @brief Default constructor, timestamped now
+     */
+    ProvenanceEntry();
+
+    /**
+     * @brief Constructor with core fields, timestamped now
+     * @param id ID of the processing component
+     * @param name Name of the processing component
+     * @param op Description of the operation performed
+     */
+    ProvenanceEntry(const InternedString& id, const InternedString& name, const InternedString& op);
+};
+
+/**
+ * @brief Bounded log of processing steps; the oldest entries are overwritten when full
+ */
+class ProvenanceLog {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 16;
+
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of entries retained (at least 1)
+     */
+    explicit ProvenanceLog(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Append an entry
+     * @param entry Entry to append
+     * @return Reference to the stored entry, valid until it is overwritten
+     */
+    ProvenanceEntry& push(const ProvenanceEntry& entry);
+
+    /**
+     * @brief Append an entry with core fields
+     * @param componentId ID of the processing component
+     * @param componentName Name of the processing component
+     * @param operation Description of the operation performed
+     * @return Reference to the stored entry for setting parameters
+     */
+    ProvenanceEntry& push(const InternedString& componentId,
+                          const InternedString& componentName,
+                          const InternedString& operation);
+
+    /**
+     * @brief Append all retained entries of another log, oldest first
+     * @param other Log to append
+     */
+    void append(const ProvenanceLog& other);
+
+    /**
+     * @brief Get an entry
+     * @param index Index from the oldest retained entry
+     * @return Entry
+     */
+    const ProvenanceEntry& operator[](size_t index) const;
+
+    /**
+     * @brief Get the most recent entry
+     * @return Entry (the log must not be empty)
+     */
+    const ProvenanceEntry& back() const { return (*this)[size() - 1]; }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Get the number of entries overwritten since the log was created
+     * @return Dropped entry count
+     */
+    uint64_t getDroppedCount() const { return dropped_; }
+
+    /**
+     * @brief Remove all entries
+     */
+    void clear();
+
+    /**
+     * @brief Format the retained component IDs, oldest first
+     * @param separator Separator between IDs
+     * @return Component IDs, e.g. "filter,detector"
+     */
+    std::string toString(const std::string& separator = ",") const;
+
+private:
+    std::vector<ProvenanceEntry> entries_;  ///< Ring storage, grows to capacity_
+    size_t capacity_;                       ///< Maximum retained entries
+    size_t head_;                           ///< Oldest entry once the ring is full
+    uint64_t dropped_;                      ///< Entries overwritten
+};
+
+} // namespace signal
+} // namespace tdoa
@@ -0,0 +1,155 @@
+/**
+ * @file mpmc_queue.h
+ * @brief Bounded lock-free multi-producer multi-consumer queue
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @class MpmcQueue
+ * @brief Bounded lock-free FIFO of small trivially copyable values
+ *
+ * Every cell carries a sequence number that says whether it is free or full
+ * for the current pass over the ring, so push and pop each cost one
+ * compare-and-swap on the tail or head and never block. Any thread may push
+ * or pop. The capacity is rounded up to a power of two.
+ */
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MpmcQueue values must be trivially copyable");
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of values the queue can hold
+     */
+    explicit MpmcQueue(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1)
+        , cells_(new Cell[mask_ + 1])
+        , head_(0)
+        , tail_(0) {
+        for (size_t i = 0; i <= mask_; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Append a value
+     * @param value Value to append
+     * @return True if the value was appended, false if the queue is full
+     */
+    bool push(const T& value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value.store(value, std::memory_order_relaxed);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Remove the oldest value
+     * @param value Receives the value
+     * @return True if a value was removed, false if the queue is empty
+     */
+    bool pop(T& value) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value.load(std::memory_order_relaxed);
+                    cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Read the oldest value without removing it
+     *
+     * The value may be popped by another thread at any moment, so the result
+     * is a hint.
+     * @param value Receives the value
+     * @return True if the queue was not empty
+     */
+    bool peek(T& value) const {
+        size_t position = head_.load(std::memory_order_acquire);
+        const Cell& cell = cells_[position & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1) {
+            return false;
+        }
+        value = cell.value.load(std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Get the number of values in the queue (approximate under contention)
+     * @return Value count
+     */
+    size_t size() const {
+        size_t tail = tail_.load(std::memory_order_acquire);
+        size_t head = head_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief Get the capacity
+     * @return Maximum number of values
+     */
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;           ///< Position this cell is next valid for
+        std::atomic<T> value;                   ///< Stored value
+    };
+
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t mask_;                         ///< Capacity minus one
+    std::unique_ptr<Cell[]> cells_;             ///< Ring of cells
+    alignas(64) std::atomic<size_t> head_;      ///< Next position to pop
+    alignas(64) std::atomic<size_t> tail_;      ///< Next position to push
+};
+
+} // namespace signal
+} // namespace tdoa
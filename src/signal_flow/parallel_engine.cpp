@@ -4,11 +4,13 @@
  */
 
 #include "parallel_engine.h"
+#include "mpmc_queue.h"
+#include "thread_placement.h"
 #include <iostream>
 #include <algorithm>
-#include <random>
-#include <sstream>
-#include <iomanip>
+#include <charconv>
+#include <deque>
+#include <map>
 
 namespace tdoa {
 namespace signal {
@@ -20,7 +22,8 @@ namespace signal {
 // Default constructor
 SignalTask::SignalTask()
     : priority(TaskPriority::NORMAL)
-    , timestamp(std::chrono::system_clock::now()) {
+    , timestamp(std::chrono::system_clock::now())
+    , deadline(std::chrono::steady_clock::time_point::max()) {
 }
 
 // Constructor with parameters
@@ -34,7 +37,8 @@ SignalTask::SignalTask(
     , process(proc)
     , priority(prio)
     , timestamp(std::chrono::system_clock::now())
-    , taskId(id) {
+    , taskId(id)
+    , deadline(std::chrono::steady_clock::time_point::max()) {
     
     // Set signal ID if signal is valid
     if (signal) {
@@ -53,36 +57,782 @@ bool SignalTask::operator<(const SignalTask& other) const {
     return timestamp > other.timestamp;
 }
 
+//-----------------------------------------------------------------------------
+// TaskHandle Implementation
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Shared state of a graph task
+ */
+struct TaskHandle::State {
+    ParallelEngine* engine;                             ///< Engine the task runs on
+    TaskPriority priority;                              ///< Task priority
+    std::function<std::shared_ptr<Signal>()> process;   ///< Processing function, released after it runs
+    std::atomic<size_t> remaining;                      ///< Unfinished dependencies, plus one while being created
+    std::mutex mutex;                                   ///< Protects dependents and the transition to done
+    std::atomic<bool> done;                             ///< Set once result is final
+    std::shared_ptr<Signal> result;                     ///< Task result
+    std::vector<std::shared_ptr<State>> dependents;     ///< Tasks waiting for this one
+    std::promise<std::shared_ptr<Signal>> promise;      ///< Promise for external waiters
+    std::shared_future<std::shared_ptr<Signal>> future; ///< Future for external waiters
+    
+    State(ParallelEngine* eng, TaskPriority prio, std::function<std::shared_ptr<Signal>()> proc)
+        : engine(eng)
+        , priority(prio)
+        , process(std::move(proc))
+        , remaining(0)
+        , done(false)
+        , future(promise.get_future().share()) {
+    }
+};
+
+TaskHandle::TaskHandle() {
+}
+
+TaskHandle::TaskHandle(std::shared_ptr<State> state)
+    : state_(std::move(state)) {
+}
+
+bool TaskHandle::valid() const {
+    return state_ != nullptr;
+}
+
+bool TaskHandle::isReady() const {
+    return state_ && state_->done.load(std::memory_order_acquire);
+}
+
+void TaskHandle::wait() const {
+    if (state_) {
+        state_->future.wait();
+    }
+}
+
+std::shared_ptr<Signal> TaskHandle::get() const {
+    if (!state_) {
+        return nullptr;
+    }
+    if (!state_->done.load(std::memory_order_acquire)) {
+        state_->future.wait();
+    }
+    return state_->result;
+}
+
+std::shared_future<std::shared_ptr<Signal>> TaskHandle::getFuture() const {
+    return state_ ? state_->future : std::shared_future<std::shared_ptr<Signal>>();
+}
+
+TaskHandle TaskHandle::then(
+    std::function<std::shared_ptr<Signal>(std::shared_ptr<Signal>)> continuation,
+    TaskPriority priority
+) const {
+    if (!state_ || !continuation) {
+        std::cerr << "Error: Invalid parameters for then" << std::endl;
+        return TaskHandle();
+    }
+    
+    std::shared_ptr<State> previous = state_;
+    return state_->engine->submitAfter({*this}, [previous, continuation]() {
+        return continuation(previous->result);
+    }, priority);
+}
+
+//-----------------------------------------------------------------------------
+// Scheduler Implementation
+//-----------------------------------------------------------------------------
+
+namespace {
+
+constexpr size_t PRIORITY_COUNT = 4;
+constexpr uint32_t NODE_CHUNK_SIZE = 1024;
+constexpr size_t MAX_NODE_CHUNKS = 4096;        // About 4M tasks queued or running
+constexpr size_t MIN_LANE_CAPACITY = 64;
+constexpr size_t MAX_LANE_CAPACITY = 65536;     // Larger queues spill to the overflow lists
+constexpr int IDLE_SPINS = 64;                  // Empty polls before a worker sleeps
+
+// Task node state: (ticket << 2) | state. Tickets increase with every submission.
+constexpr uint64_t STATE_FREE = 0;
+constexpr uint64_t STATE_QUEUED = 1;
+constexpr uint64_t STATE_CLAIMED = 2;
+constexpr uint64_t STATE_MASK = 3;
+
+size_t priorityIndex(TaskPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+void atomicAdd(std::atomic<double>& target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+bool registryAlive = false;                                     ///< False before and after the engine registry exists
+
+thread_local const ParallelEngine* currentEngine = nullptr;     ///< Engine this thread is a worker of
+thread_local size_t currentWorker = 0;                          ///< Worker index in that engine
+thread_local size_t nextLane = std::hash<std::thread::id>()(std::this_thread::get_id());
+thread_local const ParallelEngine* lastSubmitEngine = nullptr; // Engine lastSubmittedTaskId belongs to
+thread_local std::string lastSubmittedTaskId;                   // ID of this thread's last submitTask
+
+std::string formatTaskId(uint64_t ticket, uint32_t node) {
+    char buffer[48] = "task-";
+    char* end = std::to_chars(buffer + 5, buffer + sizeof(buffer), ticket, 16).ptr;
+    *end++ = '-';
+    end = std::to_chars(end, buffer + sizeof(buffer), node, 16).ptr;
+    return std::string(buffer, end);
+}
+
+bool parseTaskId(const std::string& taskId, uint64_t& ticket, uint32_t& node) {
+    const char* begin = taskId.data();
+    const char* end = begin + taskId.size();
+    if (taskId.compare(0, 5, "task-") != 0) {
+        return false;
+    }
+    auto result = std::from_chars(begin + 5, end, ticket, 16);
+    if (result.ec != std::errc() || result.ptr == end || *result.ptr != '-') {
+        return false;
+    }
+    result = std::from_chars(result.ptr + 1, end, node, 16);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+} // namespace
+
+/**
+ * @brief Per-worker priority lanes and the task node pool
+ *
+ * Tasks live in pooled nodes addressed by index, so lanes carry 32-bit
+ * indices and a node can be looked up from its task ID. A node holds two
+ * references while queued: one for its lane entry and one for ownership of
+ * the task. Whoever claims the task (a worker, a backpressure drop or
+ * cancelTask) owns it; a cancelled node stays in its lane until a worker
+ * pops and discards it. Tasks with a deadline are held in per-priority
+ * heaps instead of the lanes; a heap entry is a lane entry in every other
+ * respect.
+ */
+struct ParallelEngine::Scheduler {
+    struct TaskNode {
+        SignalTask task;                        ///< Task, valid while claimed or queued
+        std::atomic<uint64_t> state;            ///< (ticket << 2) | STATE_*
+        std::atomic<int> references;            ///< Lane entry and task ownership
+        std::atomic<uint32_t> next;             ///< Free list link (index + 1, 0 = none)
+        bool hasFuture;                         ///< Whether task.promise has a waiting future
+
+        TaskNode() : state(STATE_FREE), references(0), next(0), hasFuture(false) {}
+    };
+
+    using Lane = MpmcQueue<uint32_t>;
+
+    struct DeadlineEntry {
+        int64_t deadline;                       ///< Deadline in steady_clock ticks
+        uint64_t ticket;                        ///< Submission ticket, breaks ties in FIFO order
+        uint32_t index;                         ///< Task node index
+
+        // Heap order: the earliest deadline compares greatest
+        bool operator<(const DeadlineEntry& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : ticket > other.ticket;
+        }
+    };
+
+    std::unique_ptr<std::atomic<TaskNode*>[]> chunks;               ///< Node storage, never moved
+    std::atomic<size_t> chunkCount;                                 ///< Allocated chunks
+    std::mutex growMutex;                                           ///< Serializes chunk allocation
+    std::atomic<uint64_t> freeHead;                                 ///< (tag << 32) | (index + 1)
+
+    std::array<std::vector<std::unique_ptr<Lane>>, PRIORITY_COUNT> lanes;  ///< lanes[priority][worker]
+    std::array<std::deque<uint32_t>, PRIORITY_COUNT> overflow;      ///< Used when every lane of a priority is full
+    std::mutex overflowMutex;                                       ///< Protects overflow
+    std::atomic<size_t> overflowCount;                              ///< Entries in overflow
+
+    std::array<std::vector<DeadlineEntry>, PRIORITY_COUNT> deadlines;  ///< Earliest-deadline-first heaps
+    std::mutex deadlineMutex;                                       ///< Protects deadlines
+    std::atomic<size_t> deadlineCount;                              ///< Entries in deadlines
+
+    std::array<std::atomic<size_t>, PRIORITY_COUNT> pending;        ///< Lane entries, including cancelled tasks
+    std::atomic<size_t> queued;                                     ///< Tasks waiting to run
+    std::atomic<uint64_t> nextTicket;                               ///< Next submission ticket
+    std::atomic<size_t> submitters;                                 ///< Submissions in progress
+    std::atomic<size_t> workerCount;                                ///< Lanes per priority, one per worker
+
+    std::mutex sleepMutex;                                          ///< Guards sleeping and blocking
+    std::condition_variable workAvailable;                          ///< Wakes sleeping workers
+    std::condition_variable spaceAvailable;                         ///< Wakes blocked submitters
+    std::atomic<size_t> sleepingWorkers;                            ///< Workers waiting for work
+    std::atomic<size_t> blockedSubmitters;                          ///< Submitters waiting for space
+
+    Scheduler()
+        : chunks(new std::atomic<TaskNode*>[MAX_NODE_CHUNKS])
+        , chunkCount(0)
+        , freeHead(0)
+        , overflowCount(0)
+        , deadlineCount(0)
+        , queued(0)
+        , nextTicket(1)
+        , submitters(0)
+        , workerCount(0)
+        , sleepingWorkers(0)
+        , blockedSubmitters(0) {
+        for (size_t i = 0; i < MAX_NODE_CHUNKS; i++) {
+            chunks[i].store(nullptr, std::memory_order_relaxed);
+        }
+        for (auto& count : pending) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~Scheduler() {
+        size_t count = chunkCount.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; i++) {
+            delete[] chunks[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    TaskNode& node(uint32_t index) {
+        return chunks[index / NODE_CHUNK_SIZE].load(std::memory_order_acquire)[index % NODE_CHUNK_SIZE];
+    }
+
+    bool isValid(uint32_t index) const {
+        return index / NODE_CHUNK_SIZE < chunkCount.load(std::memory_order_acquire);
+    }
+
+    //-------------------------------------------------------------------------
+    // Node pool (Treiber stack with an ABA tag)
+    //-------------------------------------------------------------------------
+
+    void pushFree(uint32_t index) {
+        TaskNode& entry = node(index);
+        uint64_t head = freeHead.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            entry.next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            next = (((head >> 32) + 1) << 32) | (static_cast<uint64_t>(index) + 1);
+        } while (!freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    bool grow() {
+        std::lock_guard<std::mutex> lock(growMutex);
+        if (static_cast<uint32_t>(freeHead.load(std::memory_order_acquire)) != 0) {
+            return true;    // Another thread grew the pool
+        }
+        size_t count = chunkCount.load(std::memory_order_relaxed);
+        if (count == MAX_NODE_CHUNKS) {
+            return false;
+        }
+        chunks[count].store(new TaskNode[NODE_CHUNK_SIZE], std::memory_order_release);
+        chunkCount.store(count + 1, std::memory_order_release);
+        uint32_t first = static_cast<uint32_t>(count * NODE_CHUNK_SIZE);
+        for (uint32_t i = NODE_CHUNK_SIZE; i > 0; i--) {
+            pushFree(first + i - 1);
+        }
+        return true;
+    }
+
+    bool allocate(uint32_t& index) {
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t link = static_cast<uint32_t>(head);
+            if (link == 0) {
+                if (!grow()) {
+                    return false;
+                }
+                head = freeHead.load(std::memory_order_acquire);
+                continue;
+            }
+            // Node memory is never freed, so reading a stale link is safe; the tag rejects it
+            uint64_t next = (((head >> 32) + 1) << 32) | node(link - 1).next.load(std::memory_order_relaxed);
+            if (freeHead.compare_exchange_weak(head, next, std::memory_order_acquire, std::memory_order_acquire)) {
+                index = link - 1;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Drop one reference, returning the node to the pool with the last
+     */
+    void release(uint32_t index) {
+        TaskNode& entry = node(index);
+        if (entry.references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        entry.task.signal.reset();
+        entry.task.process = nullptr;
+        entry.task.discard = nullptr;
+        entry.task.deadline = std::chrono::steady_clock::time_point::max();
+        entry.state.store(STATE_FREE, std::memory_order_relaxed);
+        pushFree(index);
+    }
+
+    //-------------------------------------------------------------------------
+    // Lanes
+    //-------------------------------------------------------------------------
+
+    /**
+     * @brief Recreate the lanes; no task may be queued and no thread may be submitting
+     */
+    void resizeLanes(size_t workerCount, size_t capacity) {
+        capacity = std::min(std::max(capacity, MIN_LANE_CAPACITY), MAX_LANE_CAPACITY);
+        for (auto& row : lanes) {
+            row.clear();
+            for (size_t i = 0; i < workerCount; i++) {
+                row.push_back(std::make_unique<Lane>(capacity));
+            }
+        }
+        this->workerCount.store(workerCount);
+    }
+
+    void enqueue(uint32_t index, size_t priority, size_t preferredLane) {
+        auto& row = lanes[priority];
+        pending[priority].fetch_add(1);
+        for (size_t k = 0; k < row.size(); k++) {
+            if (row[(preferredLane + k) % row.size()]->push(index)) {
+                return;
+            }
+        }
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        overflow[priority].push_back(index);
+        overflowCount.fetch_add(1);
+    }
+
+    void enqueueDeadline(uint32_t index, size_t priority, int64_t deadline, uint64_t ticket) {
+        pending[priority].fetch_add(1);
+        std::lock_guard<std::mutex> lock(deadlineMutex);
+        auto& heap = deadlines[priority];
+        heap.push_back(DeadlineEntry{deadline, ticket, index});
+        std::push_heap(heap.begin(), heap.end());
+        deadlineCount.fetch_add(1);
+    }
+
+    /**
+     * @brief Pop the earliest deadline of one priority, or of any priority if it has expired
+     * @param priority Priority to pop, or PRIORITY_COUNT to pop only an expired entry
+     * @param now Current steady_clock ticks, used when priority is PRIORITY_COUNT
+     */
+    bool popDeadline(size_t priority, uint32_t& index, int64_t now = 0) {
+        if (deadlineCount.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(deadlineMutex);
+        size_t p = priority;
+        if (priority == PRIORITY_COUNT) {
+            for (p = 0; p < PRIORITY_COUNT; p++) {
+                if (!deadlines[p].empty() && deadlines[p].front().deadline < now) {
+                    break;
+                }
+            }
+            if (p == PRIORITY_COUNT) {
+                return false;
+            }
+        }
+        auto& heap = deadlines[p];
+        if (heap.empty()) {
+            return false;
+        }
+        std::pop_heap(heap.begin(), heap.end());
+        index = heap.back().index;
+        heap.pop_back();
+        deadlineCount.fetch_sub(1, std::memory_order_relaxed);
+        pending[p].fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool popLane(size_t priority, Lane& lane, uint32_t& index) {
+        if (!lane.pop(index)) {
+            return false;
+        }
+        pending[priority].fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool popOverflow(size_t priority, uint32_t& index) {
+        if (overflowCount.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        if (overflow[priority].empty()) {
+            return false;
+        }
+        index = overflow[priority].front();
+        overflow[priority].pop_front();
+        overflowCount.fetch_sub(1, std::memory_order_relaxed);
+        pending[priority].fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool hasPending() const {
+        for (const auto& count : pending) {
+            if (count.load() > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Claim a task popped from a lane, dropping the lane's reference
+     * @return True if the caller now owns the task, false if it had been cancelled
+     */
+    bool claim(uint32_t index) {
+        TaskNode& entry = node(index);
+        uint64_t state = entry.state.load(std::memory_order_acquire);
+        bool claimed = (state & STATE_MASK) == STATE_QUEUED &&
+            entry.state.compare_exchange_strong(state, (state & ~STATE_MASK) | STATE_CLAIMED,
+                                                std::memory_order_acq_rel);
+        release(index);
+        if (claimed) {
+            dequeued();
+        }
+        return claimed;
+    }
+
+    /**
+     * @brief Claim a queued task in place, leaving its lane entry behind
+     */
+    bool cancel(uint64_t ticket, uint32_t index) {
+        if (!isValid(index)) {
+            return false;
+        }
+        uint64_t expected = (ticket << 2) | STATE_QUEUED;
+        if (!node(index).state.compare_exchange_strong(expected, (ticket << 2) | STATE_CLAIMED,
+                                                       std::memory_order_acq_rel)) {
+            return false;
+        }
+        dequeued();
+        return true;
+    }
+
+    void dequeued() {
+        queued.fetch_sub(1);
+        if (blockedSubmitters.load() > 0) {
+            // Blocked submitters wait for different limits, so wake them all
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            spaceAvailable.notify_all();
+        }
+    }
+
+    /**
+     * @brief Take the task with the earliest deadline of one priority
+     */
+    bool takeDeadline(size_t priority, uint32_t& index) {
+        while (popDeadline(priority, index)) {
+            if (claim(index)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take the next task of one priority, starting with the given lane
+     * @param deadlinesFirst True to take tasks with deadlines before the FIFO lanes
+     */
+    bool take(size_t priority, size_t firstLane, uint32_t& index, bool deadlinesFirst = true) {
+        if (deadlinesFirst && takeDeadline(priority, index)) {
+            return true;
+        }
+        auto& row = lanes[priority];
+        for (size_t k = 0; k < row.size(); k++) {
+            Lane& lane = *row[(firstLane + k) % row.size()];
+            while (popLane(priority, lane, index)) {
+                if (claim(index)) {
+                    return true;
+                }
+            }
+        }
+        while (popOverflow(priority, index)) {
+            if (claim(index)) {
+                return true;
+            }
+        }
+        return !deadlinesFirst && takeDeadline(priority, index);
+    }
+
+    /**
+     * @brief Take one task whose deadline is earlier than now
+     */
+    bool takeExpired(int64_t now, uint32_t& index) {
+        while (popDeadline(PRIORITY_COUNT, index, now)) {
+            if (claim(index)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take the highest priority task, preferring the worker's own lanes
+     */
+    bool takeHighest(size_t worker, uint32_t& index) {
+        for (size_t p = PRIORITY_COUNT; p-- > 0;) {
+            if (pending[p].load(std::memory_order_relaxed) > 0 && take(p, worker, index)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take the oldest task of the lowest queued priority, sparing tasks with deadlines
+     */
+    bool takeLowest(uint32_t& index) {
+        for (size_t p = 0; p < PRIORITY_COUNT; p++) {
+            if (pending[p].load(std::memory_order_relaxed) > 0 && take(p, nextLane++, index, false)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Take the oldest queued task by comparing the front of every lane
+     */
+    bool takeOldest(uint32_t& index) {
+        for (int attempt = 0; attempt < 4; attempt++) {
+            Lane* oldestLane = nullptr;
+            size_t oldestPriority = PRIORITY_COUNT;
+            uint64_t oldestTicket = UINT64_MAX;
+            for (size_t p = 0; p < PRIORITY_COUNT; p++) {
+                if (pending[p].load(std::memory_order_relaxed) == 0) {
+                    continue;
+                }
+                for (auto& lane : lanes[p]) {
+                    uint32_t front;
+                    if (lane->peek(front)) {
+                        uint64_t ticket = node(front).state.load(std::memory_order_relaxed) >> 2;
+                        if (ticket < oldestTicket) {
+                            oldestTicket = ticket;
+                            oldestLane = lane.get();
+                            oldestPriority = p;
+                        }
+                    }
+                }
+            }
+            if (overflowCount.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(overflowMutex);
+                for (size_t p = 0; p < PRIORITY_COUNT; p++) {
+                    if (!overflow[p].empty()) {
+                        uint64_t ticket = node(overflow[p].front()).state.load(std::memory_order_relaxed) >> 2;
+                        if (ticket < oldestTicket) {
+                            oldestTicket = ticket;
+                            oldestLane = nullptr;
+                            oldestPriority = p;
+                        }
+                    }
+                }
+            }
+            if (oldestPriority == PRIORITY_COUNT) {
+                // Only tasks with deadlines are left; drop the lowest priority one
+                for (size_t p = 0; p < PRIORITY_COUNT; p++) {
+                    if (takeDeadline(p, index)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            // The front may have moved since the peek; any live task there is nearly as old
+            if (oldestLane) {
+                while (popLane(oldestPriority, *oldestLane, index)) {
+                    if (claim(index)) {
+                        return true;
+                    }
+                }
+            } else {
+                while (popOverflow(oldestPriority, index)) {
+                    if (claim(index)) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// ParallelLoop Implementation
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Shared state of one parallelFor call
+ *
+ * Participants claim chunks by advancing next. A participant counts itself
+ * in active before claiming, so once next has reached end and active is
+ * zero no chunk is running and none can start; helpers that start later
+ * find nothing to claim and never touch body, which lives on the caller's
+ * stack.
+ */
+struct ParallelEngine::ParallelLoop {
+    const std::function<void(size_t, size_t)>* body;    ///< Loop body, valid until the caller returns
+    size_t end;                                         ///< One past the last index
+    size_t grain;                                       ///< Smallest chunk size
+    size_t participants;                                ///< Helpers plus the caller
+    std::atomic<size_t> next;                           ///< First unclaimed index
+    std::atomic<size_t> active;                         ///< Participants inside run()
+    std::mutex mutex;                                   ///< Protects error and the completion wait
+    std::condition_variable finished;                   ///< Signalled when active drops to zero
+    std::exception_ptr error;                           ///< First exception thrown by body
+
+    ParallelLoop(const std::function<void(size_t, size_t)>* loopBody, size_t first, size_t last,
+                 size_t grainSize, size_t count)
+        : body(loopBody)
+        , end(last)
+        , grain(grainSize)
+        , participants(count)
+        , next(first)
+        , active(0) {
+    }
+
+    /**
+     * @brief Claim the next chunk, sized to a share of what remains
+     */
+    bool claim(size_t& chunkBegin, size_t& chunkEnd) {
+        size_t current = next.load();
+        for (;;) {
+            if (current >= end) {
+                return false;
+            }
+            size_t remaining = end - current;
+            size_t size = std::min(remaining, std::max(grain, remaining / (2 * participants)));
+            if (next.compare_exchange_weak(current, current + size)) {
+                chunkBegin = current;
+                chunkEnd = current + size;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Run chunks until none are left
+     */
+    void run() {
+        active.fetch_add(1);
+        size_t chunkBegin;
+        size_t chunkEnd;
+        while (claim(chunkBegin, chunkEnd)) {
+            try {
+                (*body)(chunkBegin, chunkEnd);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(end);
+            }
+        }
+        if (active.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+
+    /**
+     * @brief Wait until no participant is running a chunk; call after run()
+     */
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return active.load() == 0; });
+    }
+};
+
 //-----------------------------------------------------------------------------
 // ParallelEngine Implementation
 //-----------------------------------------------------------------------------
 
+/**
+ * @brief Named engines other than the default one
+ */
+struct ParallelEngine::Registry {
+    std::mutex mutex;                                   ///< Protects engines
+    std::map<std::string, ParallelEngine*> engines;     ///< Engines by name
+    
+    Registry() {
+        registryAlive = true;
+    }
+    
+    ~Registry() {
+        // Stops each engine's workers before the rest of the process is torn down;
+        // objects destroyed later see only the default engine
+        std::lock_guard<std::mutex> lock(mutex);
+        registryAlive = false;
+        for (auto& entry : engines) {
+            delete entry.second;
+        }
+    }
+};
+
 // Singleton instance accessor
 ParallelEngine& ParallelEngine::getInstance() {
-    static ParallelEngine instance;
+    static ParallelEngine instance("default");
     return instance;
 }
 
-// Private constructor for singleton
-ParallelEngine::ParallelEngine()
-    : running_(false)
+// Get the registry of named engines
+ParallelEngine::Registry& ParallelEngine::getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// Get a named engine, creating it if needed
+ParallelEngine& ParallelEngine::getEngine(const std::string& name) {
+    if (name.empty() || name == "default") {
+        return getInstance();
+    }
+    
+    Registry& registry = getRegistry();
+    if (!registryAlive) {
+        std::cerr << "Error: ParallelEngine " << name << " requested during shutdown" << std::endl;
+        return getInstance();
+    }
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    ParallelEngine*& engine = registry.engines[name];
+    if (!engine) {
+        engine = new ParallelEngine(name);
+    }
+    return *engine;
+}
+
+// Get the names of all engines
+std::vector<std::string> ParallelEngine::getEngineNames() {
+    std::vector<std::string> names(1, "default");
+    Registry& registry = getRegistry();
+    if (!registryAlive) {
+        return names;
+    }
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& entry : registry.engines) {
+        names.push_back(entry.first);
+    }
+    return names;
+}
+
+// Get the engine name
+const std::string& ParallelEngine::getName() const {
+    return name_;
+}
+
+// Private constructor
+ParallelEngine::ParallelEngine(const std::string& name)
+    : name_(name)
+    , scheduler_(std::make_unique<Scheduler>())
+    , running_(false)
     , activeThreads_(0)
     , maxQueueSize_(1000)
     , backpressurePolicy_(BackpressurePolicy::BLOCK)
     , totalProcessed_(0)
     , totalDropped_(0)
+    , deadlineMisses_(0)
+    , totalThrottled_(0)
     , peakQueueSize_(0)
     , totalProcessingTime_(0.0)
     , maxProcessingTime_(0.0) {
     
     // Initialize priority stats
-    priorityStats_[TaskPriority::LOW] = 0;
-    priorityStats_[TaskPriority::NORMAL] = 0;
-    priorityStats_[TaskPriority::HIGH] = 0;
-    priorityStats_[TaskPriority::CRITICAL] = 0;
+    for (auto& count : priorityStats_) {
+        count = 0;
+    }
 }
 
-// Private destructor for singleton
+// Private destructor
 ParallelEngine::~ParallelEngine() {
     // Ensure shutdown is called
     shutdown();
@@ -98,13 +848,13 @@ bool ParallelEngine::initialize(size_t numThreads, size_t maxQueueSize) {
         return false;
     }
     
-    // Set running flag
-    running_ = true;
-    
     // Set max queue size
     maxQueueSize_ = maxQueueSize;
     
-    // Auto-detect number of threads if not specified
+    // Auto-detect number of threads if not specified: one per DSP core, or per hardware thread
+    if (numThreads == 0) {
+        numThreads = ThreadPlacement::getInstance().getCoreCount(ThreadClass::Dsp);
+    }
     if (numThreads == 0) {
         numThreads = std::thread::hardware_concurrency();
         if (numThreads == 0) {
@@ -112,33 +862,36 @@ bool ParallelEngine::initialize(size_t numThreads, size_t maxQueueSize) {
         }
     }
     
+    // Lanes must exist before submitters can see the running flag
+    scheduler_->resizeLanes(numThreads, maxQueueSize);
+    running_ = true;
+    
     // Create worker threads
     for (size_t i = 0; i < numThreads; ++i) {
-        workers_.emplace_back(&ParallelEngine::workerFunction, this);
+        workers_.emplace_back(&ParallelEngine::workerFunction, this, i);
     }
     
-    // Reserve space for task queue
-    tasks_.reserve(maxQueueSize);
-    
     return true;
 }
 
 // Shutdown the engine
 void ParallelEngine::shutdown() {
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        // Check if already stopped
-        if (!running_) {
-            return;
-        }
-        
-        // Set running flag to false
-        running_ = false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Check if already stopped
+    if (!running_) {
+        return;
     }
     
-    // Notify all worker threads
-    condition_.notify_all();
+    // Set running flag to false
+    running_ = false;
+    
+    // Wake sleeping workers and blocked submitters
+    {
+        std::lock_guard<std::mutex> sleepLock(scheduler_->sleepMutex);
+        scheduler_->workAvailable.notify_all();
+        scheduler_->spaceAvailable.notify_all();
+    }
     
     // Wait for all worker threads to finish
     for (auto& worker : workers_) {
@@ -150,15 +903,17 @@ void ParallelEngine::shutdown() {
     // Clear worker threads
     workers_.clear();
     
-    // Clear tasks and reject all pending tasks
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        for (auto& task : tasks_) {
-            task.promise.set_value(nullptr);
+    // Wait for submissions that saw the engine running to finish queueing
+    while (scheduler_->submitters.load() > 0) {
+        std::this_thread::yield();
+    }
+    
+    // Reject all pending tasks
+    uint32_t index;
+    for (size_t p = 0; p < PRIORITY_COUNT; p++) {
+        while (scheduler_->take(p, 0, index)) {
+            discardTask(index);
         }
-        
-        tasks_.clear();
     }
 }
 
@@ -168,46 +923,123 @@ std::future<std::shared_ptr<Signal>> ParallelEngine::submitTask(
     std::function<std::shared_ptr<Signal>()> process,
     TaskPriority priority
 ) {
-    // Check if engine is running
+    std::future<std::shared_ptr<Signal>> future;
+    enqueue(std::move(signal), std::move(process), priority, nullptr, true, &future);
+    return future;
+}
+
+// Submit a signal processing task with a deadline
+std::future<std::shared_ptr<Signal>> ParallelEngine::submitTask(
+    std::shared_ptr<Signal> signal,
+    std::function<std::shared_ptr<Signal>()> process,
+    TaskPriority priority,
+    std::chrono::steady_clock::time_point deadline,
+    std::function<void()> onDropped
+) {
+    std::future<std::shared_ptr<Signal>> future;
+    enqueue(std::move(signal), std::move(process), priority, std::move(onDropped), true, &future, deadline);
+    return future;
+}
+
+// Queue a task
+bool ParallelEngine::enqueue(
+    std::shared_ptr<Signal> signal,
+    std::function<std::shared_ptr<Signal>()> process,
+    TaskPriority priority,
+    std::function<void()> discard,
+    bool applyBackpressure,
+    std::future<std::shared_ptr<Signal>>* future,
+    std::chrono::steady_clock::time_point deadline
+) {
+    Scheduler& scheduler = *scheduler_;
+    auto reject = [future]() {
+        if (future) {
+            std::promise<std::shared_ptr<Signal>> promise;
+            promise.set_value(nullptr);
+            *future = promise.get_future();
+            lastSubmitEngine = nullptr;
+        }
+        return false;
+    };
+    
+    // Check if engine is running; shutdown waits for counted submitters
+    scheduler.submitters.fetch_add(1);
     if (!running_) {
+        scheduler.submitters.fetch_sub(1);
         std::cerr << "Error: ParallelEngine is not running" << std::endl;
-        std::promise<std::shared_ptr<Signal>> promise;
-        promise.set_value(nullptr);
-        return promise.get_future();
+        return reject();
     }
     
-    // Create a new task
-    SignalTask task(signal, process, priority, generateTaskId());
+    // Measured system load refuses low priorities outright
+    if (applyBackpressure && !ResourceManager::getInstance().isAdmitted(priority)) {
+        scheduler.submitters.fetch_sub(1);
+        ++totalThrottled_;
+        return reject();
+    }
     
-    // Get the future before task is moved
-    std::future<std::shared_ptr<Signal>> future = task.promise.get_future();
+    // Handle backpressure if queue is full
+    uint32_t index = 0;
+    size_t queueLimit = applyBackpressure ? getQueueLimit(priority) : 0;
+    bool accepted = !applyBackpressure || scheduler.queued.load() < queueLimit || handleBackpressure(queueLimit);
+    if (accepted && !scheduler.allocate(index)) {
+        std::cerr << "Error: ParallelEngine task limit reached" << std::endl;
+        ++totalDropped_;
+        accepted = false;
+    }
+    if (!accepted) {
+        // Task was dropped or rejected
+        scheduler.submitters.fetch_sub(1);
+        return reject();
+    }
     
-    // Add task to queue
-    {
-        std::unique_lock<std::mutex> lock(mutex_);
-        
-        // Handle backpressure if queue is full
-        if (tasks_.size() >= maxQueueSize_) {
-            if (!handleBackpressure(task)) {
-                // Task was dropped or rejected
-                task.promise.set_value(nullptr);
-                return future;
-            }
-        }
-        
-        // Add task to queue
-        tasks_.push_back(std::move(task));
-        
-        // Update peak queue size
-        if (tasks_.size() > peakQueueSize_) {
-            peakQueueSize_ = tasks_.size();
-        }
+    // Fill in the pooled task
+    uint64_t ticket = scheduler.nextTicket.fetch_add(1, std::memory_order_relaxed);
+    Scheduler::TaskNode& node = scheduler.node(index);
+    SignalTask& task = node.task;
+    task.signalId = signal ? signal->getId() : std::string();
+    task.signal = std::move(signal);
+    task.process = std::move(process);
+    task.discard = std::move(discard);
+    task.priority = priority;
+    task.timestamp = std::chrono::system_clock::now();
+    task.deadline = deadline;
+    task.taskId = formatTaskId(ticket, index);
+    if (future) {
+        lastSubmitEngine = this;
+        lastSubmittedTaskId = task.taskId;
     }
     
-    // Notify a worker thread
-    condition_.notify_one();
+    // Only tasks with a waiter pay for a promise's shared state
+    node.hasFuture = (future != nullptr);
+    if (future) {
+        task.promise = std::promise<std::shared_ptr<Signal>>();
+        *future = task.promise.get_future();
+    }
+    node.references.store(2, std::memory_order_relaxed);
+    node.state.store((ticket << 2) | STATE_QUEUED, std::memory_order_relaxed);
     
-    return future;
+    // Update peak queue size
+    size_t depth = scheduler.queued.fetch_add(1) + 1;
+    size_t peak = peakQueueSize_.load(std::memory_order_relaxed);
+    while (depth > peak && !peakQueueSize_.compare_exchange_weak(peak, depth)) {
+    }
+    
+    // Workers queue follow-up work locally; other threads spread it across workers
+    if (deadline != std::chrono::steady_clock::time_point::max()) {
+        scheduler.enqueueDeadline(index, priorityIndex(priority), deadline.time_since_epoch().count(), ticket);
+    } else {
+        size_t lane = (currentEngine == this) ? currentWorker : nextLane++;
+        scheduler.enqueue(index, priorityIndex(priority), lane);
+    }
+    scheduler.submitters.fetch_sub(1);
+    
+    // Notify a worker thread if any are asleep
+    if (scheduler.sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(scheduler.sleepMutex);
+        scheduler.workAvailable.notify_one();
+    }
+    
+    return true;
 }
 
 // Submit a component processing task
@@ -233,6 +1065,167 @@ std::future<std::shared_ptr<Signal>> ParallelEngine::submitTask(
     return submitTask(signal, process, priority);
 }
 
+// Submit a task that runs after its dependencies
+TaskHandle ParallelEngine::submitAfter(
+    const std::vector<TaskHandle>& dependencies,
+    std::function<std::shared_ptr<Signal>()> process,
+    TaskPriority priority
+) {
+    if (!process) {
+        std::cerr << "Error: Invalid parameters for submitAfter" << std::endl;
+        return TaskHandle();
+    }
+    
+    return createGraphTask(dependencies, std::move(process), priority);
+}
+
+// Submit a task that combines the results of other tasks
+TaskHandle ParallelEngine::whenAll(
+    const std::vector<TaskHandle>& tasks,
+    std::function<std::shared_ptr<Signal>(const std::vector<std::shared_ptr<Signal>>&)> combine,
+    TaskPriority priority
+) {
+    if (!combine) {
+        std::cerr << "Error: Invalid parameters for whenAll" << std::endl;
+        return TaskHandle();
+    }
+    
+    // The results are complete by the time the combining task runs
+    return createGraphTask(tasks, [tasks, combine]() {
+        std::vector<std::shared_ptr<Signal>> results;
+        results.reserve(tasks.size());
+        for (const auto& task : tasks) {
+            results.push_back(task.state_ ? task.state_->result : nullptr);
+        }
+        return combine(results);
+    }, priority);
+}
+
+// Create a graph task
+TaskHandle ParallelEngine::createGraphTask(
+    const std::vector<TaskHandle>& dependencies,
+    std::function<std::shared_ptr<Signal>()> process,
+    TaskPriority priority
+) {
+    auto state = std::make_shared<TaskHandle::State>(this, priority, std::move(process));
+    
+    // Register with unfinished dependencies; the extra count keeps the task
+    // from being queued before registration is complete
+    state->remaining.store(dependencies.size() + 1);
+    size_t finished = 1;
+    for (const auto& dependency : dependencies) {
+        if (!dependency.state_) {
+            ++finished;
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(dependency.state_->mutex);
+        if (dependency.state_->done.load(std::memory_order_relaxed)) {
+            ++finished;
+        } else {
+            dependency.state_->dependents.push_back(state);
+        }
+    }
+    
+    if (state->remaining.fetch_sub(finished) == finished && !queueGraphTask(state, true)) {
+        finishGraphTask(state, nullptr);
+    }
+    
+    return TaskHandle(state);
+}
+
+// Queue a graph task whose dependencies have completed
+bool ParallelEngine::queueGraphTask(const std::shared_ptr<TaskHandle::State>& state, bool applyBackpressure) {
+    auto run = [state]() {
+        std::shared_ptr<Signal> result;
+        try {
+            result = state->process();
+        } catch (const std::exception& e) {
+            std::cerr << "Error processing graph task: " << e.what() << std::endl;
+        }
+        finishGraphTask(state, result);
+        return result;
+    };
+    auto discard = [state]() {
+        finishGraphTask(state, nullptr);
+    };
+    
+    // Dependents of a task that already ran were admitted with it, so they skip
+    // backpressure; otherwise a BLOCK policy could stall the worker finishing it
+    return enqueue(nullptr, run, state->priority, discard, applyBackpressure, nullptr);
+}
+
+// Publish a graph task's result and queue its ready dependents
+void ParallelEngine::finishGraphTask(std::shared_ptr<TaskHandle::State> state, std::shared_ptr<Signal> result) {
+    // Iterative so that long chains of rejected tasks do not recurse
+    std::vector<std::pair<std::shared_ptr<TaskHandle::State>, std::shared_ptr<Signal>>> finished;
+    finished.emplace_back(std::move(state), std::move(result));
+    
+    while (!finished.empty()) {
+        auto current = std::move(finished.back());
+        finished.pop_back();
+        TaskHandle::State& task = *current.first;
+        
+        std::vector<std::shared_ptr<TaskHandle::State>> dependents;
+        {
+            std::lock_guard<std::mutex> lock(task.mutex);
+            task.result = current.second;
+            task.done.store(true, std::memory_order_release);
+            dependents.swap(task.dependents);
+        }
+        task.process = nullptr;
+        task.promise.set_value(current.second);
+        
+        for (auto& dependent : dependents) {
+            if (dependent->remaining.fetch_sub(1) == 1 &&
+                !dependent->engine->queueGraphTask(dependent, false)) {
+                finished.emplace_back(std::move(dependent), nullptr);
+            }
+        }
+    }
+}
+
+// Run a loop over an index range in parallel
+void ParallelEngine::parallelFor(
+    size_t begin,
+    size_t end,
+    const std::function<void(size_t, size_t)>& body,
+    size_t grainSize,
+    TaskPriority priority
+) {
+    if (end <= begin || !body) {
+        return;
+    }
+    
+    // Helpers: one per worker, less the calling worker, and no more than there are chunks
+    Scheduler& scheduler = *scheduler_;
+    size_t count = end - begin;
+    size_t workers = running_ ? scheduler.workerCount.load() : 0;
+    size_t available = (currentEngine == this && workers > 0) ? workers - 1 : workers;
+    size_t grain = grainSize > 0 ? grainSize : std::max<size_t>(1, count / ((available + 1) * 16));
+    size_t helpers = std::min(available, (count - 1) / grain);
+    if (helpers == 0) {
+        body(begin, end);
+        return;
+    }
+    
+    auto loop = std::make_shared<ParallelLoop>(&body, begin, end, grain, helpers + 1);
+    for (size_t i = 0; i < helpers; i++) {
+        // Helpers are optional, so a full queue just leaves more work for the caller
+        if (scheduler.queued.load() >= maxQueueSize_ ||
+            !enqueue(nullptr, [loop]() { loop->run(); return std::shared_ptr<Signal>(); },
+                     priority, nullptr, false, nullptr)) {
+            break;
+        }
+    }
+    
+    loop->run();
+    loop->wait();
+    
+    if (loop->error) {
+        std::rethrow_exception(loop->error);
+    }
+}
+
 // Process a signal synchronously
 std::shared_ptr<Signal> ParallelEngine::processSync(
     std::shared_ptr<Signal> signal,
@@ -261,15 +1254,12 @@ std::shared_ptr<Signal> ParallelEngine::processSync(
 TaskStats ParallelEngine::getStats() const {
     TaskStats stats;
     
-    // Get the current queue size
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        stats.currentQueueSize = tasks_.size();
-    }
-    
     // Get atomic values
+    stats.currentQueueSize = scheduler_->queued;
     stats.totalProcessed = totalProcessed_;
     stats.totalDropped = totalDropped_;
+    stats.deadlineMisses = deadlineMisses_;
+    stats.totalThrottled = totalThrottled_;
     stats.peakQueueSize = peakQueueSize_;
     stats.activeThreads = activeThreads_;
     
@@ -282,10 +1272,10 @@ TaskStats ParallelEngine::getStats() const {
     stats.maxProcessingTime = maxProcessingTime_;
     
     // Get priority distribution
-    stats.priorityDistribution[TaskPriority::LOW] = priorityStats_[TaskPriority::LOW];
-    stats.priorityDistribution[TaskPriority::NORMAL] = priorityStats_[TaskPriority::NORMAL];
-    stats.priorityDistribution[TaskPriority::HIGH] = priorityStats_[TaskPriority::HIGH];
-    stats.priorityDistribution[TaskPriority::CRITICAL] = priorityStats_[TaskPriority::CRITICAL];
+    stats.priorityDistribution[TaskPriority::LOW] = priorityStats_[priorityIndex(TaskPriority::LOW)];
+    stats.priorityDistribution[TaskPriority::NORMAL] = priorityStats_[priorityIndex(TaskPriority::NORMAL)];
+    stats.priorityDistribution[TaskPriority::HIGH] = priorityStats_[priorityIndex(TaskPriority::HIGH)];
+    stats.priorityDistribution[TaskPriority::CRITICAL] = priorityStats_[priorityIndex(TaskPriority::CRITICAL)];
     
     return stats;
 }
@@ -294,14 +1284,15 @@ TaskStats ParallelEngine::getStats() const {
 void ParallelEngine::resetStats() {
     totalProcessed_ = 0;
     totalDropped_ = 0;
+    deadlineMisses_ = 0;
+    totalThrottled_ = 0;
     peakQueueSize_ = 0;
     totalProcessingTime_ = 0.0;
     maxProcessingTime_ = 0.0;
     
-    priorityStats_[TaskPriority::LOW] = 0;
-    priorityStats_[TaskPriority::NORMAL] = 0;
-    priorityStats_[TaskPriority::HIGH] = 0;
-    priorityStats_[TaskPriority::CRITICAL] = 0;
+    for (auto& count : priorityStats_) {
+        count = 0;
+    }
 }
 
 // Set the backpressure policy
@@ -321,11 +1312,8 @@ void ParallelEngine::setMaxQueueSize(size_t size) {
         return;
     }
     
+    // Lanes keep their capacity; tasks beyond it use the overflow lists
     maxQueueSize_ = size;
-    
-    // Reserve space for task queue
-    std::lock_guard<std::mutex> lock(mutex_);
-    tasks_.reserve(size);
 }
 
 // Get the maximum queue size
@@ -341,7 +1329,10 @@ bool ParallelEngine::setNumThreads(size_t numThreads) {
         return false;
     }
     
-    // Auto-detect number of threads if not specified
+    // Auto-detect number of threads if not specified: one per DSP core, or per hardware thread
+    if (numThreads == 0) {
+        numThreads = ThreadPlacement::getInstance().getCoreCount(ThreadClass::Dsp);
+    }
     if (numThreads == 0) {
         numThreads = std::thread::hardware_concurrency();
         if (numThreads == 0) {
@@ -366,42 +1357,31 @@ size_t ParallelEngine::getNumThreads() const {
 
 // Generate a unique task ID
 std::string ParallelEngine::generateTaskId() const {
-    // Generate a random ID
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 15);
-    
-    std::stringstream ss;
-    ss << "task-";
-    
-    // Generate a UUID-like string
-    for (int i = 0; i < 8; ++i) {
-        ss << std::hex << dis(gen);
-    }
-    
-    return ss.str();
+    uint64_t ticket = scheduler_->nextTicket.fetch_add(1, std::memory_order_relaxed);
+    char buffer[24] = "task-";
+    char* end = std::to_chars(buffer + 5, buffer + sizeof(buffer), ticket, 16).ptr;
+    return std::string(buffer, end);
+}
+
+// Get the ID of the calling thread's last submitted task
+std::string ParallelEngine::getLastSubmittedTaskId() const {
+    return lastSubmitEngine == this ? lastSubmittedTaskId : std::string();
 }
 
 // Cancel a task by ID
 bool ParallelEngine::cancelTask(const std::string& taskId) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Find the task in the queue
-    auto it = findTaskById(taskId);
-    if (it != tasks_.end()) {
-        // Set the promise to null
-        it->promise.set_value(nullptr);
-        
-        // Remove the task from the queue
-        tasks_.erase(it);
-        
-        // Increment dropped count
-        ++totalDropped_;
-        
-        return true;
+    // Task IDs name the task's node, so no search is needed
+    uint64_t ticket = 0;
+    uint32_t index = 0;
+    if (!parseTaskId(taskId, ticket, index) || !scheduler_->cancel(ticket, index)) {
+        return false;
     }
     
-    return false;
+    // The lane entry is discarded when a worker reaches it
+    discardTask(index);
+    ++totalDropped_;
+    
+    return true;
 }
 
 // Check if the engine is running
@@ -410,137 +1390,176 @@ bool ParallelEngine::isRunning() const {
 }
 
 // Worker thread function
-void ParallelEngine::workerFunction() {
+void ParallelEngine::workerFunction(size_t workerIndex) {
+    Scheduler& scheduler = *scheduler_;
+    currentEngine = this;
+    currentWorker = workerIndex;
+    ThreadPlacement::getInstance().placeCurrentThread(
+        ThreadClass::Dsp, (name_ == "default" ? std::string("dsp") : name_) + "-" + std::to_string(workerIndex));
+    int idlePolls = 0;
+    
     while (running_) {
-        SignalTask task;
-        bool hasTask = false;
-        
-        // Get a task from the queue
-        {
-            std::unique_lock<std::mutex> lock(mutex_);
-            
-            // Wait for a task or shutdown
-            condition_.wait(lock, [this] {
-                return !running_ || !tasks_.empty();
-            });
+        uint32_t index;
+        if (scheduler.takeHighest(workerIndex, index)) {
+            idlePolls = 0;
             
-            // Check if shutting down
-            if (!running_ && tasks_.empty()) {
-                break;
-            }
-            
-            // Check if the queue is empty
-            if (tasks_.empty()) {
-                continue;
+            // A task that can no longer start on time is dropped
+            const SignalTask& task = scheduler.node(index).task;
+            if (task.deadline != std::chrono::steady_clock::time_point::max() &&
+                task.deadline < std::chrono::steady_clock::now()) {
+                ++deadlineMisses_;
+                discardTask(index);
+            } else {
+                runTask(index);
             }
-            
-            // Get the highest priority task
-            auto highestPriorityIt = std::max_element(tasks_.begin(), tasks_.end());
-            task = std::move(*highestPriorityIt);
-            tasks_.erase(highestPriorityIt);
-            
-            hasTask = true;
-            
-            // Notify queue space available
-            queueSpace_.notify_one();
+            continue;
         }
         
-        // Process the task if we have one
-        if (hasTask) {
-            // Increment active threads
-            ++activeThreads_;
-            
-            // Process the task and time it
-            auto startTime = std::chrono::high_resolution_clock::now();
-            std::shared_ptr<Signal> result;
-            
-            try {
-                result = task.process();
-            } catch (const std::exception& e) {
-                std::cerr << "Error processing task " << task.taskId 
-                          << ": " << e.what() << std::endl;
-                result = nullptr;
-            }
-            
-            auto endTime = std::chrono::high_resolution_clock::now();
-            
-            // Calculate processing time in ms
-            double processingTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-            
-            // Update statistics
-            updateStats(processingTime, task.priority);
-            
-            // Set the promise value
-            task.promise.set_value(result);
-            
-            // Decrement active threads
-            --activeThreads_;
+        // Poll briefly before sleeping so bursts do not pay for a wakeup
+        if (++idlePolls < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
+        }
+        idlePolls = 0;
+        
+        // Submitters check sleepingWorkers after queueing, so one of us sees the other
+        std::unique_lock<std::mutex> lock(scheduler.sleepMutex);
+        scheduler.sleepingWorkers.fetch_add(1);
+        if (running_ && !scheduler.hasPending()) {
+            scheduler.workAvailable.wait(lock);
+        }
+        scheduler.sleepingWorkers.fetch_sub(1);
+    }
+    
+    currentEngine = nullptr;
+}
+
+// Run a claimed task
+void ParallelEngine::runTask(uint32_t index) {
+    SignalTask& task = scheduler_->node(index).task;
+    
+    // Increment active threads
+    ++activeThreads_;
+    
+    // Process the task and time it
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<Signal> result;
+    
+    try {
+        result = task.process();
+    } catch (const std::exception& e) {
+        std::cerr << "Error processing task " << task.taskId 
+                  << ": " << e.what() << std::endl;
+        result = nullptr;
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    
+    // Calculate processing time in ms
+    double processingTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    
+    // Update statistics
+    updateStats(processingTime, task.priority);
+    
+    // Set the promise value
+    if (scheduler_->node(index).hasFuture) {
+        task.promise.set_value(result);
+    }
+    
+    // Decrement active threads
+    --activeThreads_;
+    
+    // Return the node to the pool
+    scheduler_->release(index);
+}
+
+// Resolve a claimed task without running it
+void ParallelEngine::discardTask(uint32_t index) {
+    Scheduler::TaskNode& node = scheduler_->node(index);
+    SignalTask& task = node.task;
+    
+    // The callback runs before the future resolves, so waiters see its effects
+    if (task.discard) {
+        task.discard();
+    }
+    if (node.hasFuture) {
+        task.promise.set_value(nullptr);
+    }
+    scheduler_->release(index);
+}
+
+// Drop one expired task
+bool ParallelEngine::shedExpiredTask() {
+    uint32_t index;
+    int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+    if (!scheduler_->takeExpired(now, index)) {
+        return false;
+    }
+    
+    ++deadlineMisses_;
+    discardTask(index);
+    return true;
+}
+
+// Get the queue limit for a priority under the measured system load
+size_t ParallelEngine::getQueueLimit(TaskPriority priority) const {
+    size_t limit = maxQueueSize_;
+    if (priority == TaskPriority::LOW || priority == TaskPriority::NORMAL) {
+        double scale = ResourceManager::getInstance().getQueueScale();
+        if (scale < 1.0) {
+            limit = std::max<size_t>(1, static_cast<size_t>(limit * scale));
         }
     }
+    return limit;
 }
 
 // Handle backpressure
-bool ParallelEngine::handleBackpressure(const SignalTask& task) {
+bool ParallelEngine::handleBackpressure(size_t queueLimit) {
+    Scheduler& scheduler = *scheduler_;
+    
+    // Stale work goes first, whatever the policy
+    if (shedExpiredTask()) {
+        return true;
+    }
+    
     // Get the current policy
     BackpressurePolicy policy = backpressurePolicy_;
     
     switch (policy) {
         case BackpressurePolicy::BLOCK:
         {
-            // Wait for space in the queue
-            queueSpace_.wait(mutex_, [this] {
-                return tasks_.size() < maxQueueSize_ || !running_;
+            // Wait for space in the queue; workers notify when blockedSubmitters is set
+            std::unique_lock<std::mutex> lock(scheduler.sleepMutex);
+            scheduler.blockedSubmitters.fetch_add(1);
+            scheduler.spaceAvailable.wait(lock, [this, &scheduler, queueLimit] {
+                return scheduler.queued.load() < queueLimit || !running_;
             });
+            scheduler.blockedSubmitters.fetch_sub(1);
             
             // Check if shutting down
-            if (!running_) {
-                return false;
-            }
-            
-            // Now there is space in the queue
-            return true;
+            return running_;
         }
         
         case BackpressurePolicy::DROP_OLDEST:
-        {
-            // Find and remove the oldest task
-            auto oldestIt = findOldestTask();
-            if (oldestIt != tasks_.end()) {
-                // Set the promise to null
-                oldestIt->promise.set_value(nullptr);
-                
-                // Remove the task from the queue
-                tasks_.erase(oldestIt);
-                
-                // Increment dropped count
-                ++totalDropped_;
-                
-                return true;
-            }
-            
-            // Could not find a task to drop
-            return false;
-        }
-        
         case BackpressurePolicy::DROP_LOWEST_PRIORITY:
         {
-            // Find and remove the lowest priority task
-            auto lowestIt = findLowestPriorityTask();
-            if (lowestIt != tasks_.end()) {
-                // Set the promise to null
-                lowestIt->promise.set_value(nullptr);
-                
-                // Remove the task from the queue
-                tasks_.erase(lowestIt);
-                
-                // Increment dropped count
-                ++totalDropped_;
-                
-                return true;
+            // Claim the front of the chosen lane
+            uint32_t index;
+            bool claimed = (policy == BackpressurePolicy::DROP_OLDEST)
+                ? scheduler.takeOldest(index)
+                : scheduler.takeLowest(index);
+            if (!claimed) {
+                // Could not find a task to drop
+                return false;
             }
             
-            // Could not find a task to drop
-            return false;
+            // Set the promise to null
+            discardTask(index);
+            
+            // Increment dropped count
+            ++totalDropped_;
+            
+            return true;
         }
         
         case BackpressurePolicy::DROP_NEW:
@@ -563,49 +1582,13 @@ bool ParallelEngine::handleBackpressure(const SignalTask& task) {
     }
 }
 
-// Find lowest priority task in queue
-std::vector<SignalTask>::iterator ParallelEngine::findLowestPriorityTask() {
-    if (tasks_.empty()) {
-        return tasks_.end();
-    }
-    
-    // Find the lowest priority task
-    auto lowestIt = std::min_element(tasks_.begin(), tasks_.end());
-    return lowestIt;
-}
-
-// Find oldest task in queue
-std::vector<SignalTask>::iterator ParallelEngine::findOldestTask() {
-    if (tasks_.empty()) {
-        return tasks_.end();
-    }
-    
-    // Find the oldest task
-    auto oldestIt = std::min_element(tasks_.begin(), tasks_.end(),
-        [](const SignalTask& a, const SignalTask& b) {
-            return a.timestamp < b.timestamp;
-        });
-    
-    return oldestIt;
-}
-
-// Find task by ID
-std::vector<SignalTask>::iterator ParallelEngine::findTaskById(const std::string& taskId) {
-    auto it = std::find_if(tasks_.begin(), tasks_.end(),
-        [&](const SignalTask& task) {
-            return task.taskId == taskId;
-        });
-    
-    return it;
-}
-
 // Update task statistics
 void ParallelEngine::updateStats(double processingTime, TaskPriority priority) {
     // Increment processed count
     ++totalProcessed_;
     
     // Add to total processing time
-    totalProcessingTime_ += processingTime;
+    atomicAdd(totalProcessingTime_, processingTime);
     
     // Update maximum processing time
     double currentMax = maxProcessingTime_;
@@ -616,8 +1599,8 @@ void ParallelEngine::updateStats(double processingTime, TaskPriority priority) {
     }
     
     // Increment priority count
-    ++priorityStats_[priority];
+    ++priorityStats_[priorityIndex(priority)];
 }
 
 } // namespace signal
-} // namespace tdoa 
\ No newline at end of file
+} // namespace tdoa
@@ -8,9 +8,11 @@
 #include "signal.h"
 #include "processing_component.h"
 #include "resource_manager.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <vector>
-#include <queue>
 #include <functional>
 #include <thread>
 #include <mutex>
@@ -33,6 +35,8 @@ struct SignalTask {
     std::chrono::system_clock::time_point timestamp;  ///< Task creation timestamp
     std::string taskId;                               ///< Task ID
     std::string signalId;                             ///< Signal ID
+    std::function<void()> discard;                    ///< Called instead of process if the task is dropped, cancelled or abandoned
+    std::chrono::steady_clock::time_point deadline;   ///< Latest start time (max = none)
     
     /**
      * @brief Default constructor
@@ -67,6 +71,8 @@ struct SignalTask {
 struct TaskStats {
     size_t totalProcessed;          ///< Total tasks processed
     size_t totalDropped;            ///< Total tasks dropped due to overload
+    size_t deadlineMisses;          ///< Tasks dropped because their deadline had passed
+    size_t totalThrottled;          ///< Tasks refused because the measured system load was too high
     size_t currentQueueSize;        ///< Current queue size
     size_t peakQueueSize;           ///< Peak queue size
     size_t activeThreads;           ///< Number of currently active threads
@@ -86,8 +92,103 @@ enum class BackpressurePolicy {
     EXPAND_QUEUE        ///< Expand the queue (no backpressure)
 };
 
+class ParallelEngine;
+
+/**
+ * @brief Handle to a task in a task graph
+ *
+ * Returned by ParallelEngine::submitAfter, ParallelEngine::whenAll and
+ * then(). A graph task is queued only when all of its dependencies have
+ * completed, so no worker waits for another task. If a task is rejected,
+ * dropped or cancelled its result is null and its dependents still run.
+ * Handles are cheap to copy.
+ */
+class TaskHandle {
+public:
+    /**
+     * @brief Default constructor, creates an invalid handle
+     */
+    TaskHandle();
+    
+    /**
+     * @brief Check if the handle refers to a task
+     * @return True if valid
+     */
+    bool valid() const;
+    
+    /**
+     * @brief Check if the task has completed
+     * @return True if the result is available
+     */
+    bool isReady() const;
+    
+    /**
+     * @brief Wait for the task to complete
+     *
+     * Blocks the calling thread; inside a task, depend on the task instead.
+     */
+    void wait() const;
+    
+    /**
+     * @brief Get the result, waiting for the task if necessary
+     * @return Result signal (null if the task failed or did not run)
+     */
+    std::shared_ptr<Signal> get() const;
+    
+    /**
+     * @brief Get a future for the result
+     * @return Shared future that becomes ready when the task completes
+     */
+    std::shared_future<std::shared_ptr<Signal>> getFuture() const;
+    
+    /**
+     * @brief Run a function on this task's result once the task completes
+     * @param continuation Function receiving the result
+     * @param priority Priority of the continuation
+     * @return Handle of the continuation (invalid if this handle is invalid)
+     */
+    TaskHandle then(
+        std::function<std::shared_ptr<Signal>(std::shared_ptr<Signal>)> continuation,
+        TaskPriority priority = TaskPriority::NORMAL
+    ) const;
+    
+private:
+    friend class ParallelEngine;
+    
+    struct State;
+    
+    /**
+     * @brief Constructor from shared task state
+     * @param state Task state
+     */
+    explicit TaskHandle(std::shared_ptr<State> state);
+    
+    std::shared_ptr<State> state_;                      ///< Shared task state
+};
+
 /**
  * @brief Thread pool based parallel processing engine
+ *
+ * Each worker owns one lock-free FIFO lane per TaskPriority. Workers submit
+ * follow-up tasks to their own lanes and other threads spread submissions
+ * across workers, so submit and take touch no shared lock. A worker takes
+ * the highest priority task available, first from its own lane and then by
+ * stealing the oldest task from another worker's lane of that priority.
+ * Backpressure drops pop the front of one lane, so they cost O(workers)
+ * regardless of the queue length. Idle workers sleep on a condition
+ * variable that submitters only touch when a worker is asleep.
+ *
+ * Tasks with a deadline are kept in one earliest-deadline-first heap per
+ * priority, which workers drain before the FIFO lanes of that priority. A
+ * task whose deadline has passed when a worker takes it is dropped instead
+ * of run, and when the queue is full expired tasks are shed before the
+ * backpressure policy applies, so overload costs stale work rather than
+ * latency.
+ *
+ * getInstance() returns the default engine. Subsystems that must not share
+ * a queue with it get their own engine from getEngine(), each with its own
+ * workers, queue size and backpressure policy, so a burst of bulk work on
+ * one engine cannot delay latency-critical tasks on another.
  */
 class ParallelEngine {
 public:
@@ -97,6 +198,28 @@ public:
      */
     static ParallelEngine& getInstance();
     
+    /**
+     * @brief Get a named engine, creating it if needed
+     *
+     * A new engine is not running until initialize() is called on it. Engines
+     * live until the process exits, so the reference stays valid.
+     * @param name Engine name ("default" or empty for the default engine)
+     * @return Reference to the engine
+     */
+    static ParallelEngine& getEngine(const std::string& name);
+    
+    /**
+     * @brief Get the names of all engines created so far
+     * @return Engine names, starting with "default"
+     */
+    static std::vector<std::string> getEngineNames();
+    
+    /**
+     * @brief Get the engine name
+     * @return Engine name
+     */
+    const std::string& getName() const;
+    
     /**
      * @brief Initialize the engine
      * @param numThreads Number of worker threads (0 = auto-detect)
@@ -123,6 +246,29 @@ public:
         TaskPriority priority = TaskPriority::NORMAL
     );
     
+    /**
+     * @brief Submit a signal processing task that must start before a deadline
+     *
+     * Within its priority the task runs in earliest-deadline-first order,
+     * ahead of tasks without a deadline. If it has not started by the
+     * deadline it is dropped: onDropped is called (also if it is dropped by
+     * backpressure or cancelled), the future resolves to null and
+     * TaskStats::deadlineMisses is incremented.
+     * @param signal Input signal
+     * @param process Processing function
+     * @param priority Task priority
+     * @param deadline Latest time the task may start
+     * @param onDropped Called instead of process if the task does not run (may be null)
+     * @return Future for the result signal
+     */
+    std::future<std::shared_ptr<Signal>> submitTask(
+        std::shared_ptr<Signal> signal,
+        std::function<std::shared_ptr<Signal>()> process,
+        TaskPriority priority,
+        std::chrono::steady_clock::time_point deadline,
+        std::function<void()> onDropped = nullptr
+    );
+    
     /**
      * @brief Submit a component processing task
      * @param signal Input signal
@@ -136,6 +282,104 @@ public:
         TaskPriority priority = TaskPriority::NORMAL
     );
     
+    /**
+     * @brief Submit a task that runs once its dependencies have completed
+     *
+     * Use the dependencies' handles inside process to read their results;
+     * they are ready by then. With no dependencies the task is queued now.
+     * @param dependencies Tasks that must complete first
+     * @param process Processing function
+     * @param priority Task priority
+     * @return Handle of the new task
+     */
+    TaskHandle submitAfter(
+        const std::vector<TaskHandle>& dependencies,
+        std::function<std::shared_ptr<Signal>()> process,
+        TaskPriority priority = TaskPriority::NORMAL
+    );
+    
+    /**
+     * @brief Submit a task that combines the results of other tasks
+     * @param tasks Tasks to wait for
+     * @param combine Function receiving the results, in the order of tasks
+     * @param priority Task priority
+     * @return Handle of the combining task
+     */
+    TaskHandle whenAll(
+        const std::vector<TaskHandle>& tasks,
+        std::function<std::shared_ptr<Signal>(const std::vector<std::shared_ptr<Signal>>&)> combine,
+        TaskPriority priority = TaskPriority::NORMAL
+    );
+    
+    /**
+     * @brief Run a loop over an index range on the workers and the calling thread
+     *
+     * The range is split into chunks that shrink as the loop progresses
+     * (guided scheduling), so early chunks amortize overhead and late ones
+     * balance the load. At most one helper task per worker is queued, without
+     * a Signal or future; the calling thread runs chunks too and returns when
+     * every chunk has finished. Runs inline when the engine is not running or
+     * the range fits in one chunk. May be called from inside a task. The first
+     * exception thrown by body stops further chunks and is rethrown here.
+     * @param begin First index
+     * @param end One past the last index
+     * @param body Function called with each chunk's [begin, end)
+     * @param grainSize Smallest chunk size (0 = automatic)
+     * @param priority Priority of the helper tasks
+     */
+    void parallelFor(
+        size_t begin,
+        size_t end,
+        const std::function<void(size_t, size_t)>& body,
+        size_t grainSize = 0,
+        TaskPriority priority = TaskPriority::NORMAL
+    );
+    
+    /**
+     * @brief Reduce an index range in parallel
+     *
+     * The range is cut into fixed chunks whose partial results are combined
+     * in index order, so the result does not depend on the number of workers
+     * or on scheduling, even for floating point.
+     * @param begin First index
+     * @param end One past the last index
+     * @param identity Identity value of combine
+     * @param map Function returning the partial result of a chunk [begin, end)
+     * @param combine Associative function combining two partial results
+     * @param grainSize Chunk size (0 = automatic, at most 256 chunks)
+     * @param priority Priority of the helper tasks
+     * @return Combined result (identity for an empty range)
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(
+        size_t begin,
+        size_t end,
+        T identity,
+        Map map,
+        Combine combine,
+        size_t grainSize = 0,
+        TaskPriority priority = TaskPriority::NORMAL
+    );
+    
+    /**
+     * @brief Apply a function to every element of an array in parallel
+     * @param input Input elements
+     * @param output Output elements (may equal input)
+     * @param count Number of elements
+     * @param function Function mapping one input element to one output element
+     * @param grainSize Smallest chunk size (0 = automatic)
+     * @param priority Priority of the helper tasks
+     */
+    template <typename In, typename Out, typename Function>
+    void parallelTransform(
+        const In* input,
+        Out* output,
+        size_t count,
+        Function function,
+        size_t grainSize = 0,
+        TaskPriority priority = TaskPriority::NORMAL
+    );
+    
     /**
      * @brief Process a signal synchronously
      * @param signal Input signal
@@ -172,6 +416,10 @@ public:
     
     /**
      * @brief Set the maximum queue size
+     *
+     * While ResourceManager load sampling reports elevated or critical load,
+     * LOW and NORMAL tasks see this limit scaled down, and priorities the
+     * load level does not admit are refused (TaskStats::totalThrottled).
      * @param size Maximum queue size
      */
     void setMaxQueueSize(size_t size);
@@ -201,6 +449,15 @@ public:
      */
     std::string generateTaskId() const;
     
+    /**
+     * @brief Get the ID of the last task the calling thread queued with submitTask
+     *
+     * Read it right after submitTask to be able to cancel the task later.
+     * @return Task ID, or an empty string if the last submission on this
+     *         thread went to another engine or was not queued
+     */
+    std::string getLastSubmittedTaskId() const;
+    
     /**
      * @brief Cancel a task by ID
      * @param taskId Task ID to cancel
@@ -216,45 +473,110 @@ public:
     
 private:
     /**
-     * @brief Private constructor for singleton
+     * @brief Private constructor, engines are obtained from getInstance or getEngine
+     * @param name Engine name
      */
-    ParallelEngine();
+    explicit ParallelEngine(const std::string& name);
     
     /**
-     * @brief Private destructor for singleton
+     * @brief Private destructor
      */
     ~ParallelEngine();
     
+    struct Registry;
+    
+    /**
+     * @brief Get the registry of named engines
+     * @return Registry
+     */
+    static Registry& getRegistry();
+    
     /**
      * @brief Worker thread function
+     * @param workerIndex Index of the worker, which owns the lanes with that index
      */
-    void workerFunction();
+    void workerFunction(size_t workerIndex);
     
     /**
-     * @brief Handle backpressure
-     * @param task New task to add
-     * @return True if task was added to queue
+     * @brief Queue a task
+     * @param signal Input signal
+     * @param process Processing function
+     * @param priority Task priority
+     * @param discard Called instead of process if the queued task is later dropped or cancelled
+     * @param applyBackpressure False to queue the task even if the queue is full
+     * @param future Receives the result future (may be null)
+     * @param deadline Latest start time (max = none)
+     * @return True if queued; a rejected task's discard is not called
      */
-    bool handleBackpressure(const SignalTask& task);
+    bool enqueue(
+        std::shared_ptr<Signal> signal,
+        std::function<std::shared_ptr<Signal>()> process,
+        TaskPriority priority,
+        std::function<void()> discard,
+        bool applyBackpressure,
+        std::future<std::shared_ptr<Signal>>* future,
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max()
+    );
+    
+    /**
+     * @brief Resolve a claimed task to null without running it
+     * @param node Task node index
+     */
+    void discardTask(uint32_t node);
+    
+    /**
+     * @brief Create a graph task and queue it if its dependencies are complete
+     * @param dependencies Tasks that must complete first
+     * @param process Processing function
+     * @param priority Task priority
+     * @return Handle of the new task
+     */
+    TaskHandle createGraphTask(
+        const std::vector<TaskHandle>& dependencies,
+        std::function<std::shared_ptr<Signal>()> process,
+        TaskPriority priority
+    );
+    
+    /**
+     * @brief Queue a graph task whose dependencies have completed
+     * @param state Task state
+     * @param applyBackpressure False when queued by a completing task
+     * @return True if queued
+     */
+    bool queueGraphTask(const std::shared_ptr<TaskHandle::State>& state, bool applyBackpressure);
+    
+    /**
+     * @brief Publish a graph task's result and queue dependents that became ready
+     * @param state Task state
+     * @param result Task result
+     */
+    static void finishGraphTask(std::shared_ptr<TaskHandle::State> state, std::shared_ptr<Signal> result);
     
     /**
-     * @brief Find lowest priority task in queue
-     * @return Iterator to lowest priority task
+     * @brief Drop one queued task whose deadline has passed
+     * @return True if a task was dropped
+     */
+    bool shedExpiredTask();
+    
+    /**
+     * @brief Get the queue limit for a priority under the measured system load
+     * @param priority Task priority
+     * @return Queue limit (LOW and NORMAL shrink with ResourceManager::getQueueScale)
      */
-    std::vector<SignalTask>::iterator findLowestPriorityTask();
+    size_t getQueueLimit(TaskPriority priority) const;
     
     /**
-     * @brief Find oldest task in queue
-     * @return Iterator to oldest task
+     * @brief Handle backpressure when the queue is full
+     * @param queueLimit Queue limit that applies to the new task
+     * @return True if the new task may be queued
      */
-    std::vector<SignalTask>::iterator findOldestTask();
+    bool handleBackpressure(size_t queueLimit);
     
     /**
-     * @brief Find task by ID
-     * @param taskId Task ID to find
-     * @return Iterator to the task or tasks_.end() if not found
+     * @brief Run a task taken from the queue and release it
+     * @param node Task node index
      */
-    std::vector<SignalTask>::iterator findTaskById(const std::string& taskId);
+    void runTask(uint32_t node);
     
     /**
      * @brief Update task statistics
@@ -263,8 +585,12 @@ private:
      */
     void updateStats(double processingTime, TaskPriority priority);
     
+    struct Scheduler;
+    struct ParallelLoop;
+    
+    const std::string name_;                             ///< Engine name
     std::vector<std::thread> workers_;                   ///< Worker threads
-    std::vector<SignalTask> tasks_;                      ///< Task queue
+    std::unique_ptr<Scheduler> scheduler_;               ///< Task lanes and task storage
     std::atomic<bool> running_;                          ///< Running flag
     std::atomic<size_t> activeThreads_;                  ///< Number of active threads
     std::atomic<size_t> maxQueueSize_;                   ///< Maximum queue size
@@ -273,15 +599,72 @@ private:
     // Statistics
     std::atomic<size_t> totalProcessed_;                 ///< Total tasks processed
     std::atomic<size_t> totalDropped_;                   ///< Total tasks dropped
+    std::atomic<size_t> deadlineMisses_;                 ///< Tasks dropped after their deadline
+    std::atomic<size_t> totalThrottled_;                 ///< Tasks refused for measured system load
     std::atomic<size_t> peakQueueSize_;                  ///< Peak queue size
     std::atomic<double> totalProcessingTime_;            ///< Total processing time
     std::atomic<double> maxProcessingTime_;              ///< Maximum processing time
-    std::map<TaskPriority, std::atomic<size_t>> priorityStats_; ///< Priority statistics
+    std::array<std::atomic<size_t>, 4> priorityStats_;   ///< Tasks processed per priority
     
-    mutable std::mutex mutex_;                          ///< Mutex for thread safety
-    std::condition_variable condition_;                 ///< Condition variable for worker threads
-    std::condition_variable queueSpace_;                ///< Condition variable for queue space
+    mutable std::mutex mutex_;                          ///< Serializes initialize and shutdown
 };
 
+// Reduce an index range in parallel
+template <typename T, typename Map, typename Combine>
+T ParallelEngine::parallelReduce(
+    size_t begin,
+    size_t end,
+    T identity,
+    Map map,
+    Combine combine,
+    size_t grainSize,
+    TaskPriority priority
+) {
+    if (end <= begin) {
+        return identity;
+    }
+    
+    // Chunk boundaries depend only on the range, which keeps the result deterministic
+    size_t count = end - begin;
+    size_t grain = grainSize > 0 ? grainSize : std::max<size_t>(1, (count + 255) / 256);
+    size_t chunks = (count + grain - 1) / grain;
+    
+    // Wrapped so that T = bool does not select the packed vector<bool>
+    struct Partial {
+        T value;
+    };
+    std::vector<Partial> partials(chunks, Partial{identity});
+    
+    parallelFor(0, chunks, [&](size_t first, size_t last) {
+        for (size_t chunk = first; chunk < last; chunk++) {
+            size_t chunkBegin = begin + chunk * grain;
+            partials[chunk].value = map(chunkBegin, std::min(end, chunkBegin + grain));
+        }
+    }, 1, priority);
+    
+    T result = identity;
+    for (const auto& partial : partials) {
+        result = combine(result, partial.value);
+    }
+    return result;
+}
+
+// Apply a function to every element of an array in parallel
+template <typename In, typename Out, typename Function>
+void ParallelEngine::parallelTransform(
+    const In* input,
+    Out* output,
+    size_t count,
+    Function function,
+    size_t grainSize,
+    TaskPriority priority
+) {
+    parallelFor(0, count, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            output[i] = function(input[i]);
+        }
+    }, grainSize, priority);
+}
+
 } // namespace signal
 } // namespace tdoa 
\ No newline at end of file
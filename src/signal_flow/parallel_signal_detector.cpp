@@ -32,6 +32,8 @@ bool ParallelSignalDetector::initialize() {
         stats_["average_snr"] = 0;
         stats_["average_confidence"] = 0;
         stats_["processing_time"] = 0;
+        stats_["segments_refused"] = 0;
+        stats_["segments_dropped"] = 0;
 
         return true;
     }
@@ -46,50 +48,140 @@ std::vector<DetectedSignal> ParallelSignalDetector::processSegment(std::shared_p
         return {};
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto startTime = std::chrono::high_resolution_clock::now();
+    // Only the calling thread waits; bands and the merge run on the engine
+    auto results = std::make_shared<std::vector<DetectedSignal>>();
+    if (!submitSegment(signal, results).get()) {
+        recordDroppedSegment();
+        return {};
+    }
+    return *results;
+}
 
-    try {
-        std::vector<DetectedSignal> detectedSignals;
-
-        // Split frequency range into bands for parallel processing
-        const double totalBandwidth = config_.maxFrequency - config_.minFrequency;
-        const size_t numBands = std::thread::hardware_concurrency();
-        const double bandWidth = totalBandwidth / numBands;
-
-        // Process each band in parallel
-        std::vector<std::future<std::vector<DetectedSignal>>> futures;
-        for (size_t i = 0; i < numBands; ++i) {
-            double startFreq = config_.minFrequency + i * bandWidth;
-            double endFreq = startFreq + bandWidth;
-
-            // Submit band processing task
-            auto future = SignalFlow::getInstance().getParallelEngine().submitTask(
-                signal,
-                [this, signal, startFreq, endFreq]() {
-                    auto bandSignals = this->processBand(signal, startFreq, endFreq);
-                    return std::make_shared<Signal>(bandSignals);
-                },
-                TaskPriority::HIGH
-            );
-
-            futures.push_back(std::move(future));
+bool ParallelSignalDetector::processSegmentAsync(
+    std::shared_ptr<Signal> signal,
+    DetectionCallback callback,
+    CreditChannel::Credit credit) {
+    
+    if (!signal || !callback) {
+        return false;
+    }
+
+    if (!SignalFlow::getInstance().getParallelEngine().isRunning()) {
+        std::cerr << "Error in processSegmentAsync: ParallelEngine is not running" << std::endl;
+        return false;
+    }
+
+    // Hold a credit of the input channel until the callback has consumed the results
+    std::shared_ptr<CreditChannel> channel = getInputChannel();
+    if (channel && !credit) {
+        credit = channel->tryAcquireCredit();
+        if (!credit) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_["segments_refused"]++;
+            return false;
         }
+    }
 
-        // Collect results from all bands
-        for (auto& future : futures) {
-            auto result = future.get();
-            if (result) {
-                // Convert result back to DetectedSignal vector
-                // This is a placeholder - you would need to implement proper conversion
-                std::vector<DetectedSignal> bandSignals;
-                // ... convert result to bandSignals ...
-                detectedSignals.insert(detectedSignals.end(), 
-                                     bandSignals.begin(), 
-                                     bandSignals.end());
-            }
+    // Counts the segment as dropped when the continuation is destroyed without
+    // delivering, whether it saw an incomplete segment or never ran at all
+    auto delivered = std::shared_ptr<bool>(new bool(false), [this](bool* flag) {
+        if (!*flag) {
+            recordDroppedSegment();
         }
+        delete flag;
+    });
+
+    // The callback runs as a continuation of the merge, so no worker blocks
+    auto results = std::make_shared<std::vector<DetectedSignal>>();
+    submitSegment(signal, results).then(
+        [results, callback, credit, delivered](std::shared_ptr<Signal> input) {
+            // A null input means a band or the merge was dropped
+            if (!input) {
+                return input;
+            }
+            *delivered = true;
+            callback(*results);
+            return input;
+        },
+        TaskPriority::HIGH
+    );
+
+    return true;
+}
+
+void ParallelSignalDetector::recordDroppedSegment() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_["segments_dropped"]++;
+}
+
+void ParallelSignalDetector::setInputChannel(std::shared_ptr<CreditChannel> channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputChannel_ = std::move(channel);
+}
+
+std::shared_ptr<CreditChannel> ParallelSignalDetector::getInputChannel() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inputChannel_;
+}
+
+TaskHandle ParallelSignalDetector::submitSegment(
+    std::shared_ptr<Signal> signal,
+    std::shared_ptr<std::vector<DetectedSignal>> results) {
+
+    ParallelEngine& engine = SignalFlow::getInstance().getParallelEngine();
+    const DetectionConfig config = getConfig();
+    const auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Split frequency range into bands for parallel processing
+    const double totalBandwidth = config.maxFrequency - config.minFrequency;
+    const size_t numBands = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const double bandWidth = totalBandwidth / numBands;
+    auto bandSignals = std::make_shared<std::vector<std::vector<DetectedSignal>>>(numBands);
+
+    // Process each band in parallel
+    std::vector<TaskHandle> bands;
+    bands.reserve(numBands);
+    for (size_t i = 0; i < numBands; ++i) {
+        double startFreq = config.minFrequency + i * bandWidth;
+        double endFreq = startFreq + bandWidth;
+
+        bands.push_back(engine.submitAfter({},
+            [this, signal, bandSignals, i, startFreq, endFreq]() {
+                (*bandSignals)[i] = this->processBand(signal, startFreq, endFreq);
+                return signal;
+            },
+            TaskPriority::HIGH
+        ));
+    }
+
+    // Merge once every band has finished
+    return engine.whenAll(bands,
+        [this, signal, bandSignals, results, startTime](const std::vector<std::shared_ptr<Signal>>& inputs) {
+            // A band dropped by backpressure leaves the segment incomplete; do
+            // not report its partial detections
+            for (const auto& input : inputs) {
+                if (!input) {
+                    return std::shared_ptr<Signal>();
+                }
+            }
+            std::vector<DetectedSignal> detectedSignals;
+            for (const auto& band : *bandSignals) {
+                detectedSignals.insert(detectedSignals.end(), band.begin(), band.end());
+            }
+            *results = this->mergeDetections(std::move(detectedSignals), startTime);
+            return signal;
+        },
+        TaskPriority::HIGH
+    );
+}
 
+std::vector<DetectedSignal> ParallelSignalDetector::mergeDetections(
+    std::vector<DetectedSignal> detectedSignals,
+    std::chrono::high_resolution_clock::time_point startTime) {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    try {
         // Apply signal tracking if enabled
         if (config_.enableSignalTracking) {
             detectedSignals = trackSignals(detectedSignals);
@@ -133,34 +225,6 @@ std::vector<DetectedSignal> ParallelSignalDetector::processSegment(std::shared_p
     }
 }
 
-bool ParallelSignalDetector::processSegmentAsync(
-    std::shared_ptr<Signal> signal,
-    DetectionCallback callback) {
-    
-    if (!signal || !callback) {
-        return false;
-    }
-
-    try {
-        // Submit async processing task
-        SignalFlow::getInstance().getParallelEngine().submitTask(
-            signal,
-            [this, signal, callback]() {
-                auto detectedSignals = this->processSegment(signal);
-                callback(detectedSignals);
-                return signal;
-            },
-            TaskPriority::HIGH
-        );
-
-        return true;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "Error in processSegmentAsync: " << e.what() << std::endl;
-        return false;
-    }
-}
-
 std::vector<DetectedSignal> ParallelSignalDetector::processBand(
     std::shared_ptr<Signal> signal,
     double startFreq,
@@ -271,9 +335,9 @@ std::map<std::string, double> ParallelSignalDetector::getStats() const {
 }
 
 std::string ParallelSignalDetector::generateSignalId() const {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
+    // Per thread, since band tasks generate IDs concurrently
+    thread_local std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(0, 15);
 
     std::stringstream ss;
     ss << "sig-";
@@ -4,8 +4,10 @@
 #include "signal_flow.h"
 #include "signal_metadata.h"
 #include "processing_component.h"
+#include "flow_control.h"
 #include <memory>
 #include <vector>
+#include <chrono>
 #include <functional>
 #include <map>
 #include <mutex>
@@ -67,6 +69,10 @@ public:
 
     /**
      * @brief Process a signal segment for detection
+     *
+     * Waits for the result; from inside an engine task use processSegmentAsync.
+     * A segment whose bands or merge were dropped by engine backpressure is
+     * counted in segments_dropped and yields no detections.
      * @param signal Input signal segment
      * @return Vector of detected signals
      */
@@ -74,11 +80,36 @@ public:
 
     /**
      * @brief Process a signal segment asynchronously
+     *
+     * With an input channel set, each segment holds one credit until its
+     * callback has returned, and a segment that finds no credit is refused.
+     * A source that already took the credit, such as a block admitted by a
+     * ShedController on this detector's channel, passes it in and no second
+     * credit is taken. If engine backpressure drops any of the segment's band
+     * tasks or its merge, the callback is not called and the segment is
+     * counted in segments_dropped instead.
      * @param signal Input signal segment
      * @param callback Callback for detection results
+     * @param credit Credit of the input channel already held for the segment, or nullptr
      * @return True if processing started successfully
      */
-    bool processSegmentAsync(std::shared_ptr<Signal> signal, DetectionCallback callback);
+    bool processSegmentAsync(std::shared_ptr<Signal> signal, DetectionCallback callback,
+                             CreditChannel::Credit credit = nullptr);
+
+    /**
+     * @brief Advertise the detector's capacity to the stage feeding it
+     *
+     * Link the channel of the stage the callback feeds with setDownstream so
+     * that the source sees the whole pipeline's pressure.
+     * @param channel Input channel, or nullptr to accept every segment
+     */
+    void setInputChannel(std::shared_ptr<CreditChannel> channel);
+
+    /**
+     * @brief Get the detector's input channel
+     * @return Input channel, or nullptr if none
+     */
+    std::shared_ptr<CreditChannel> getInputChannel() const;
 
     /**
      * @brief Update detector configuration
@@ -112,6 +143,34 @@ private:
         double endFreq
     );
 
+    /**
+     * @brief Submit band detection and the merge for a segment as a task graph
+     * @param signal Input signal segment
+     * @param results Receives the detected signals when the returned task completes
+     * @return Handle of the merge task; its result is null, and results left
+     *         empty, if any band or the merge itself was dropped
+     */
+    TaskHandle submitSegment(
+        std::shared_ptr<Signal> signal,
+        std::shared_ptr<std::vector<DetectedSignal>> results
+    );
+
+    /**
+     * @brief Track, limit and count the detections of one segment
+     * @param detectedSignals Detections from all bands
+     * @param startTime Time the segment was submitted
+     * @return Final detections
+     */
+    std::vector<DetectedSignal> mergeDetections(
+        std::vector<DetectedSignal> detectedSignals,
+        std::chrono::high_resolution_clock::time_point startTime
+    );
+
+    /**
+     * @brief Count a segment that was dropped before its detections were complete
+     */
+    void recordDroppedSegment();
+
     /**
      * @brief Track signal continuity
      * @param newSignals Newly detected signals
@@ -127,10 +186,11 @@ private:
 
 private:
     DetectionConfig config_;
-    std::unique_ptr<ProcessingChain> detectionChain_;
+    std::shared_ptr<ProcessingChain> detectionChain_;
     std::map<std::string, DetectedSignal> signalHistory_;
     mutable std::mutex mutex_;
     std::map<std::string, double> stats_;
+    std::shared_ptr<CreditChannel> inputChannel_;
 };
 
 } // namespace signal
@@ -4,10 +4,17 @@
  */
 
 #include "processing_chain.h"
+#include "spsc_queue.h"
+#include "thread_placement.h"
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <set>
 #include <stdexcept>
+#include <thread>
 
 namespace tdoa {
 namespace signal {
@@ -16,13 +23,145 @@ namespace signal {
 // ProcessingChain Implementation
 //-----------------------------------------------------------------------------
 
+// Compiled execution plan
+struct ProcessingChain::ExecutionPlan {
+    std::vector<ProcessingComponent*> components;   ///< Components in topological order
+    std::vector<std::string> componentIds;          ///< IDs, indexed like components
+    std::vector<uint32_t> successorOffsets;         ///< Successors of step i are successors[offsets[i], offsets[i + 1])
+    std::vector<uint32_t> successors;               ///< Successor steps, in edge order
+    std::vector<std::vector<uint32_t>> reachable;   ///< Steps reachable from each step (itself included), in order
+    std::map<std::string, uint32_t> stepById;       ///< Step index of each component ID
+    std::vector<std::shared_ptr<Signal>> inputs;    ///< Input of each step while process() runs, empty otherwise
+    bool sequential = false;                        ///< Every step after the first takes the output of the step before it
+};
+
+namespace {
+
+constexpr int IDLE_SPINS = 64;                  // Empty polls before a stage thread sleeps
+
+/**
+ * @brief One pipeline stage: its components, input queue and thread
+ */
+struct PipelineStage {
+    std::vector<ProcessingComponent*> components;   ///< Components the stage runs, in plan order
+    std::vector<std::string> componentIds;          ///< IDs of the components
+    SpscQueue<std::shared_ptr<Signal>> input;       ///< Signals from the previous stage or the submitter
+    std::atomic<size_t> peakDepth;                  ///< Highest queue depth seen by the producer
+    std::atomic<uint64_t> processed;                ///< Signals finished
+    std::atomic<uint64_t> busyNanoseconds;          ///< Time spent running components
+    std::atomic<bool> done;                         ///< Thread has drained its queue and exited
+    std::mutex sleepMutex;                          ///< Guards sleeping on the condition variables
+    std::condition_variable dataAvailable;          ///< Wakes the stage thread
+    std::condition_variable spaceAvailable;         ///< Wakes a producer blocked on a full queue
+    std::atomic<bool> consumerSleeping;             ///< Stage thread waits for data
+    std::atomic<bool> producerWaiting;              ///< Producer waits for space
+    std::thread thread;                             ///< Stage thread
+
+    explicit PipelineStage(size_t queueCapacity)
+        : input(queueCapacity)
+        , peakDepth(0)
+        , processed(0)
+        , busyNanoseconds(0)
+        , done(false)
+        , consumerSleeping(false)
+        , producerWaiting(false) {
+    }
+
+    /**
+     * @brief Queue a signal, producer side
+     * @param signal Signal to queue, moved from on success
+     * @param wait Wait for room if the queue is full
+     * @return True if queued
+     */
+    bool push(std::shared_ptr<Signal>& signal, bool wait) {
+        int spins = 0;
+        while (!input.push(signal)) {
+            if (!wait) {
+                return false;
+            }
+            if (++spins < IDLE_SPINS) {
+                std::this_thread::yield();
+                continue;
+            }
+            spins = 0;
+
+            // The consumer checks producerWaiting after popping, so one of us sees the other
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            producerWaiting.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (input.size() >= input.capacity()) {
+                spaceAvailable.wait(lock);
+            }
+            producerWaiting.store(false);
+        }
+
+        size_t depth = input.size();
+        if (depth > peakDepth.load(std::memory_order_relaxed)) {
+            peakDepth.store(depth, std::memory_order_relaxed);
+        }
+
+        // Wake the stage thread if it is asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerSleeping.load()) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            dataAvailable.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Take the next signal, consumer side
+     * @param signal Receives the signal
+     * @return True if a signal was taken
+     */
+    bool pop(std::shared_ptr<Signal>& signal) {
+        if (!input.pop(signal)) {
+            return false;
+        }
+
+        // Wake a producer blocked on the full queue
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producerWaiting.load()) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            spaceAvailable.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wake the stage thread regardless of the queue, for shutdown
+     */
+    void wake() {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        dataAvailable.notify_one();
+    }
+};
+
+} // anonymous namespace
+
+// Stage threads and queues of pipelined execution
+struct ProcessingChain::Pipeline {
+    std::vector<std::unique_ptr<PipelineStage>> stages; ///< Stages in plan order
+    PipelineOutput output;                              ///< Receives signals after the last stage
+    ProcessingCallback callback;                        ///< Processing callback at start time
+    std::atomic<bool> stopping;                         ///< No more signals will be submitted
+
+    Pipeline()
+        : stopping(false) {
+    }
+};
+
 // Constructor with optional name
 ProcessingChain::ProcessingChain(const std::string& name)
-    : name_(name) {
+    : name_(name)
+    , planDirty_(true) {
 }
 
 // Destructor
 ProcessingChain::~ProcessingChain() {
+    // Stop stage threads before the components they run go away
+    stopPipeline();
+    
     // Clear components and edges
     components_.clear();
     edges_.clear();
@@ -32,6 +171,12 @@ ProcessingChain::~ProcessingChain() {
 bool ProcessingChain::addComponent(std::shared_ptr<ProcessingComponent> component) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    if (pipeline_) {
+        std::cerr << "Error: Cannot change processing chain '" << name_ 
+                  << "' while it is pipelined" << std::endl;
+        return false;
+    }
+    
     if (!component) {
         std::cerr << "Error: Cannot add null component to processing chain" << std::endl;
         return false;
@@ -46,6 +191,7 @@ bool ProcessingChain::addComponent(std::shared_ptr<ProcessingComponent> componen
     
     // Add component
     components_[component->getId()] = component;
+    planDirty_ = true;
     
     return true;
 }
@@ -54,6 +200,12 @@ bool ProcessingChain::addComponent(std::shared_ptr<ProcessingComponent> componen
 bool ProcessingChain::removeComponent(const std::string& componentId) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    if (pipeline_) {
+        std::cerr << "Error: Cannot change processing chain '" << name_ 
+                  << "' while it is pipelined" << std::endl;
+        return false;
+    }
+    
     // Check if component exists
     if (components_.find(componentId) == components_.end()) {
         std::cerr << "Error: Component with ID '" << componentId 
@@ -73,6 +225,7 @@ bool ProcessingChain::removeComponent(const std::string& componentId) {
     
     // Remove component
     components_.erase(componentId);
+    planDirty_ = true;
     
     return true;
 }
@@ -85,6 +238,12 @@ bool ProcessingChain::connectComponents(
 ) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    if (pipeline_) {
+        std::cerr << "Error: Cannot change processing chain '" << name_ 
+                  << "' while it is pipelined" << std::endl;
+        return false;
+    }
+    
     // Check if components exist
     if (components_.find(sourceComponentId) == components_.end()) {
         std::cerr << "Error: Source component with ID '" << sourceComponentId 
@@ -122,6 +281,8 @@ bool ProcessingChain::connectComponents(
         return false;
     }
     
+    planDirty_ = true;
+    
     return true;
 }
 
@@ -132,6 +293,12 @@ bool ProcessingChain::disconnectComponents(
 ) {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    if (pipeline_) {
+        std::cerr << "Error: Cannot change processing chain '" << name_ 
+                  << "' while it is pipelined" << std::endl;
+        return false;
+    }
+    
     // Find and remove the edge
     auto it = std::find_if(edges_.begin(), edges_.end(), 
         [&](const ProcessingEdge& edge) {
@@ -141,6 +308,7 @@ bool ProcessingChain::disconnectComponents(
     
     if (it != edges_.end()) {
         edges_.erase(it);
+        planDirty_ = true;
         return true;
     }
     
@@ -258,53 +426,284 @@ std::shared_ptr<Signal> ProcessingChain::process(
         return nullptr;
     }
     
+    if (pipeline_) {
+        std::cerr << "Error: Processing chain '" << name_ 
+                  << "' is pipelined, use submit" << std::endl;
+        return nullptr;
+    }
+    
     // Check if the chain is empty
     if (components_.empty()) {
         std::cerr << "Error: Processing chain is empty" << std::endl;
         return signal;
     }
     
-    // Determine the source component(s) to start from
-    std::vector<std::string> startComponentIds;
+    // Compile the topology once, not per signal
+    std::string errorMsg;
+    if (!compilePlanLocked(errorMsg)) {
+        std::cerr << errorMsg << std::endl;
+        return nullptr;
+    }
+    ExecutionPlan& plan = *plan_;
     
+    // Determine the steps to run: all of them, or those reachable from the given source
+    const std::vector<uint32_t>* steps = nullptr;
     if (!sourceComponentId.empty()) {
-        // Check if the specified source component exists
-        if (components_.find(sourceComponentId) == components_.end()) {
+        auto it = plan.stepById.find(sourceComponentId);
+        if (it == plan.stepById.end()) {
             std::cerr << "Error: Source component with ID '" << sourceComponentId 
                     << "' not found in processing chain" << std::endl;
             return nullptr;
         }
+        steps = &plan.reachable[it->second];
+    }
+    
+    // Run the steps in order, each on the output of its predecessor that ran
+    // last; the start steps, which have none, take the input signal
+    std::shared_ptr<Signal> result;
+    const size_t stepCount = steps ? steps->size() : plan.components.size();
+    
+    for (size_t i = 0; i < stepCount; ++i) {
+        const uint32_t step = steps ? (*steps)[i] : static_cast<uint32_t>(i);
+        ProcessingComponent* component = plan.components[step];
+        result = plan.inputs[step] ? std::move(plan.inputs[step]) : signal;
         
-        startComponentIds.push_back(sourceComponentId);
-    } else {
-        // Use all source components (no incoming edges)
-        startComponentIds = getSourceComponentIds();
-        
-        if (startComponentIds.empty()) {
-            // If there are no source components, the graph might have cycles
-            // Just use the first component as a starting point
-            if (!components_.empty()) {
-                startComponentIds.push_back(components_.begin()->first);
-            } else {
-                return signal;
+        // Disabled components pass the signal through
+        if (component->isEnabled()) {
+            result = component->process(result);
+            
+            // Call the processing callback if set
+            if (processingCallback_) {
+                processingCallback_(result, component->getState());
+            }
+            
+            if (!result) {
+                std::cerr << "Error: Processing failed at component '" << plan.componentIds[step] << "'" << std::endl;
+                std::fill(plan.inputs.begin(), plan.inputs.end(), nullptr);
+                return nullptr;
             }
         }
+        
+        for (uint32_t k = plan.successorOffsets[step]; k < plan.successorOffsets[step + 1]; ++k) {
+            plan.inputs[plan.successors[k]] = result;
+        }
     }
     
-    // Process through each starting component
-    std::shared_ptr<Signal> result = signal;
+    // The last step in plan order is a sink
+    return result;
+}
+
+// Run the chain as a pipeline
+bool ProcessingChain::startPipeline(PipelineOutput output, const PipelineConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    if (pipeline_) {
+        std::cerr << "Error: Processing chain '" << name_ << "' is already pipelined" << std::endl;
+        return false;
+    }
+    
+    if (components_.empty()) {
+        std::cerr << "Error: Processing chain is empty" << std::endl;
+        return false;
+    }
+    
+    std::string errorMsg;
+    if (!compilePlanLocked(errorMsg)) {
+        std::cerr << errorMsg << std::endl;
+        return false;
+    }
+    const ExecutionPlan& plan = *plan_;
+    
+    // Stages hand one signal on, so every step must take the previous step's output
+    if (!plan.sequential) {
+        std::cerr << "Error: Processing chain '" << name_ 
+                  << "' branches and cannot be pipelined" << std::endl;
+        return false;
+    }
+    
+    for (const auto& id : config.stageStarts) {
+        if (plan.stepById.find(id) == plan.stepById.end()) {
+            std::cerr << "Error: Stage start component with ID '" << id 
+                      << "' not found in processing chain" << std::endl;
+            return false;
+        }
+    }
+    
+    // Cut the plan into stages
+    std::unique_ptr<Pipeline> pipeline(new Pipeline());
+    pipeline->output = std::move(output);
+    pipeline->callback = processingCallback_;
+    const std::set<std::string> starts(config.stageStarts.begin(), config.stageStarts.end());
+    for (size_t step = 0; step < plan.components.size(); ++step) {
+        const std::string& id = plan.componentIds[step];
+        if (pipeline->stages.empty() || starts.empty() || starts.count(id) > 0) {
+            pipeline->stages.emplace_back(new PipelineStage(std::max<size_t>(2, config.queueCapacity)));
+        }
+        pipeline->stages.back()->components.push_back(plan.components[step]);
+        pipeline->stages.back()->componentIds.push_back(id);
+    }
     
-    for (const auto& componentId : startComponentIds) {
-        std::set<std::string> visited;
-        result = processComponent(result, componentId, visited);
+    // Start one thread per stage
+    Pipeline& running = *pipeline;
+    for (size_t i = 0; i < running.stages.size(); ++i) {
+        running.stages[i]->thread = std::thread(&ProcessingChain::stageFunction, this, std::ref(running), i);
+    }
+    
+    pipeline_ = std::move(pipeline);
+    
+    return true;
+}
+
+// Feed a signal into the pipeline
+bool ProcessingChain::submit(std::shared_ptr<Signal> signal, bool wait) {
+    Pipeline* pipeline = pipeline_.get();
+    if (!pipeline || pipeline->stopping.load()) {
+        std::cerr << "Error: Processing chain '" << name_ << "' is not pipelined" << std::endl;
+        return false;
+    }
+    
+    if (!signal) {
+        std::cerr << "Error: Cannot process null signal" << std::endl;
+        return false;
+    }
+    
+    return pipeline->stages.front()->push(signal, wait);
+}
+
+// Finish the queued signals and stop the stage threads
+void ProcessingChain::stopPipeline() {
+    Pipeline* pipeline;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pipeline = pipeline_.get();
+        if (!pipeline) {
+            return;
+        }
+    }
+    
+    // Stages drain in order: each exits once its queue is empty and the one before it is done
+    pipeline->stopping.store(true);
+    for (auto& stage : pipeline->stages) {
+        stage->wake();
+    }
+    for (auto& stage : pipeline->stages) {
+        if (stage->thread.joinable()) {
+            stage->thread.join();
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    pipeline_.reset();
+}
+
+// Check whether the chain runs as a pipeline
+bool ProcessingChain::isPipelined() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pipeline_ != nullptr;
+}
+
+// Get per-stage queue depths and timing
+std::vector<PipelineStageStats> ProcessingChain::getPipelineStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::vector<PipelineStageStats> stats;
+    if (!pipeline_) {
+        return stats;
+    }
+    
+    for (const auto& stage : pipeline_->stages) {
+        PipelineStageStats entry;
+        entry.componentIds = stage->componentIds;
+        entry.queueDepth = stage->input.size();
+        entry.peakQueueDepth = stage->peakDepth.load(std::memory_order_relaxed);
+        entry.queueCapacity = stage->input.capacity();
+        entry.processed = stage->processed.load(std::memory_order_relaxed);
+        entry.busySeconds = stage->busyNanoseconds.load(std::memory_order_relaxed) * 1e-9;
+        stats.push_back(entry);
+    }
+    
+    return stats;
+}
+
+// Stage thread function
+void ProcessingChain::stageFunction(Pipeline& pipeline, size_t stageIndex) {
+    PipelineStage& stage = *pipeline.stages[stageIndex];
+    PipelineStage* next = stageIndex + 1 < pipeline.stages.size() ? pipeline.stages[stageIndex + 1].get() : nullptr;
+    const PipelineStage* previous = stageIndex > 0 ? pipeline.stages[stageIndex - 1].get() : nullptr;
+    ThreadPlacement::getInstance().placeCurrentThread(
+        ThreadClass::Dsp, name_ + "-" + std::to_string(stageIndex));
+    int idlePolls = 0;
+    
+    for (;;) {
+        std::shared_ptr<Signal> signal;
+        if (stage.pop(signal)) {
+            idlePolls = 0;
+            
+            // A signal that failed upstream passes through as null to keep the order
+            if (signal) {
+                auto startTime = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < stage.components.size() && signal; ++i) {
+                    ProcessingComponent* component = stage.components[i];
+                    
+                    // Disabled components pass the signal through
+                    if (!component->isEnabled()) {
+                        continue;
+                    }
+                    
+                    signal = component->process(signal);
+                    
+                    if (pipeline.callback) {
+                        pipeline.callback(signal, component->getState());
+                    }
+                    
+                    if (!signal) {
+                        std::cerr << "Error: Processing failed at component '" << stage.componentIds[i] << "'" << std::endl;
+                    }
+                }
+                stage.busyNanoseconds.fetch_add(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - startTime).count()),
+                    std::memory_order_relaxed);
+            }
+            stage.processed.fetch_add(1, std::memory_order_relaxed);
+            
+            if (next) {
+                next->push(signal, true);
+            } else if (pipeline.output) {
+                pipeline.output(signal);
+            }
+            continue;
+        }
         
-        if (!result) {
-            std::cerr << "Error: Processing failed at component '" << componentId << "'" << std::endl;
-            return nullptr;
+        // Exit once nothing more can arrive
+        bool upstreamDone = previous ? previous->done.load() : pipeline.stopping.load();
+        if (upstreamDone && stage.input.empty()) {
+            break;
+        }
+        
+        // Poll briefly before sleeping so bursts do not pay for a wakeup
+        if (++idlePolls < IDLE_SPINS) {
+            std::this_thread::yield();
+            continue;
         }
+        idlePolls = 0;
+        
+        // Producers check consumerSleeping after pushing, so one of us sees the other
+        std::unique_lock<std::mutex> lock(stage.sleepMutex);
+        stage.consumerSleeping.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        upstreamDone = previous ? previous->done.load() : pipeline.stopping.load();
+        if (!upstreamDone && stage.input.empty()) {
+            stage.dataAvailable.wait(lock);
+        }
+        stage.consumerSleeping.store(false);
     }
     
-    return result;
+    // Let the next stage see that nothing more will come
+    stage.done.store(true);
+    if (next) {
+        next->wake();
+    }
 }
 
 // Set a callback for signal processing
@@ -326,7 +725,11 @@ void ProcessingChain::reset() {
 // Validate the chain topology
 bool ProcessingChain::validate(std::string& errorMsg) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    
+    return validateLocked(errorMsg);
+}
+
+// Validate the chain topology with the mutex held
+bool ProcessingChain::validateLocked(std::string& errorMsg) const {
     // Check if all components in edges exist
     for (const auto& edge : edges_) {
         if (components_.find(edge.sourceComponentId) == components_.end()) {
@@ -401,77 +804,114 @@ bool ProcessingChain::findCycleDFS(
     return false;
 }
 
-// Process a signal through a specific component and its successors
-std::shared_ptr<Signal> ProcessingChain::processComponent(
-    std::shared_ptr<Signal> signal,
-    const std::string& componentId,
-    std::set<std::string>& visited
-) {
-    // Avoid processing the same component multiple times (could happen in DAGs with multiple paths)
-    if (visited.find(componentId) != visited.end()) {
-        return signal;
+// Rebuild the execution plan if the topology changed
+bool ProcessingChain::compilePlanLocked(std::string& errorMsg) {
+    if (!planDirty_ && plan_) {
+        return true;
     }
     
-    visited.insert(componentId);
+    if (!validateLocked(errorMsg)) {
+        return false;
+    }
     
-    // Get the component
-    auto component = components_[componentId];
+    // Number the components and build integer adjacency
+    std::map<std::string, uint32_t> indexById;
+    std::vector<std::string> ids;
+    for (const auto& component : components_) {
+        indexById[component.first] = static_cast<uint32_t>(ids.size());
+        ids.push_back(component.first);
+    }
     
-    // Skip disabled components
-    if (!component->isEnabled()) {
-        // Get the next components
-        auto nextIds = getNextComponentIds(componentId);
-        
-        // If there are no next components, return the signal as is
-        if (nextIds.empty()) {
-            return signal;
+    const size_t count = ids.size();
+    std::vector<std::vector<uint32_t>> next(count);
+    std::vector<uint32_t> inDegree(count, 0);
+    for (const auto& edge : edges_) {
+        uint32_t source = indexById[edge.sourceComponentId];
+        uint32_t target = indexById[edge.targetComponentId];
+        next[source].push_back(target);
+        inDegree[target]++;
+    }
+    
+    // Topological order (Kahn), sources in ID order and successors in edge order
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (inDegree[i] == 0) {
+            order.push_back(i);
         }
-        
-        // Process through each next component
-        std::shared_ptr<Signal> result = signal;
-        
-        for (const auto& nextId : nextIds) {
-            result = processComponent(result, nextId, visited);
-            
-            if (!result) {
-                return nullptr;
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        for (uint32_t target : next[order[head]]) {
+            if (--inDegree[target] == 0) {
+                order.push_back(target);
             }
         }
-        
-        return result;
     }
     
-    // Process the signal
-    auto result = component->process(signal);
-    
-    // Call the processing callback if set
-    if (processingCallback_) {
-        processingCallback_(result, component->getState());
+    if (order.size() != count) {
+        errorMsg = "Error: Processing chain contains cycles";
+        return false;
     }
     
-    // If processing failed, return null
-    if (!result) {
-        return nullptr;
+    // Lay the plan out by step
+    std::vector<uint32_t> stepOf(count);
+    for (uint32_t step = 0; step < count; ++step) {
+        stepOf[order[step]] = step;
+    }
+    
+    std::unique_ptr<ExecutionPlan> plan(new ExecutionPlan());
+    plan->components.reserve(count);
+    plan->componentIds.reserve(count);
+    plan->successorOffsets.reserve(count + 1);
+    plan->successors.reserve(edges_.size());
+    for (uint32_t step = 0; step < count; ++step) {
+        const uint32_t index = order[step];
+        plan->components.push_back(components_[ids[index]].get());
+        plan->componentIds.push_back(ids[index]);
+        plan->stepById[ids[index]] = step;
+        plan->successorOffsets.push_back(static_cast<uint32_t>(plan->successors.size()));
+        for (uint32_t target : next[index]) {
+            plan->successors.push_back(stepOf[target]);
+        }
     }
+    plan->successorOffsets.push_back(static_cast<uint32_t>(plan->successors.size()));
+    plan->inputs.resize(count);
     
-    // Get the next components
-    auto nextIds = getNextComponentIds(componentId);
-    
-    // If there are no next components, return the processed signal
-    if (nextIds.empty()) {
-        return result;
+    // Threading one signal through the steps gives each step the output of
+    // its last predecessor only if that is always the step before it
+    std::vector<uint32_t> lastPredecessor(count, static_cast<uint32_t>(count));
+    for (uint32_t step = 0; step < count; ++step) {
+        for (uint32_t k = plan->successorOffsets[step]; k < plan->successorOffsets[step + 1]; ++k) {
+            lastPredecessor[plan->successors[k]] = step;
+        }
     }
-    
-    // Process through each next component
-    for (const auto& nextId : nextIds) {
-        result = processComponent(result, nextId, visited);
-        
-        if (!result) {
-            return nullptr;
+    plan->sequential = true;
+    for (uint32_t step = 1; step < count; ++step) {
+        plan->sequential = plan->sequential && lastPredecessor[step] == step - 1;
+    }
+    
+    // Steps reachable from each step; successors always come later, so one
+    // forward sweep from the start marks them
+    plan->reachable.resize(count);
+    std::vector<char> marked(count);
+    for (uint32_t start = 0; start < count; ++start) {
+        std::fill(marked.begin(), marked.end(), 0);
+        marked[start] = 1;
+        for (uint32_t step = start; step < count; ++step) {
+            if (!marked[step]) {
+                continue;
+            }
+            plan->reachable[start].push_back(step);
+            for (uint32_t k = plan->successorOffsets[step]; k < plan->successorOffsets[step + 1]; ++k) {
+                marked[plan->successors[k]] = 1;
+            }
         }
     }
     
-    return result;
+    plan_ = std::move(plan);
+    planDirty_ = false;
+    
+    return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -10,8 +10,10 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <set>
 #include <functional>
 #include <mutex>
+#include <cstdint>
 
 namespace tdoa {
 namespace signal {
@@ -33,6 +35,51 @@ struct ProcessingEdge {
     }
 };
 
+/**
+ * @brief Configuration of pipelined execution
+ */
+struct PipelineConfig {
+    std::vector<std::string> stageStarts;   ///< Components that begin a new stage (empty = one stage per component)
+    size_t queueCapacity;                   ///< Signals each stage's input queue holds
+
+    /**
+     * @brief Constructor with default values
+     */
+    PipelineConfig()
+        : queueCapacity(64)
+    {}
+};
+
+/**
+ * @brief Statistics of one pipeline stage
+ */
+struct PipelineStageStats {
+    std::vector<std::string> componentIds;  ///< Components the stage runs, in order
+    size_t queueDepth;                      ///< Signals waiting in the stage's input queue
+    size_t peakQueueDepth;                  ///< Highest queue depth seen
+    size_t queueCapacity;                   ///< Capacity of the input queue
+    uint64_t processed;                     ///< Signals the stage has finished
+    double busySeconds;                     ///< Time spent running components
+
+    /**
+     * @brief Constructor with default values
+     */
+    PipelineStageStats()
+        : queueDepth(0)
+        , peakQueueDepth(0)
+        , queueCapacity(0)
+        , processed(0)
+        , busySeconds(0.0)
+    {}
+};
+
+/**
+ * @brief Receives the signals leaving a pipelined chain, in submission order
+ *
+ * A null signal means processing failed for the corresponding submission.
+ */
+using PipelineOutput = std::function<void(std::shared_ptr<Signal>)>;
+
 /**
  * @brief Class managing the processing chain topology and execution
  */
@@ -134,15 +181,67 @@ public:
     
     /**
      * @brief Process a signal through the chain
+     *
+     * Runs the compiled execution plan: every component reachable from the
+     * start runs once, after all of its predecessors, on the output of its
+     * predecessor. A component with several predecessors takes the output of
+     * the one that runs last in plan order; the start components take the
+     * input signal. The plan is rebuilt on the first call after the topology
+     * changed.
      * @param signal Input signal
      * @param sourceComponentId Optional source component ID to start processing from
-     * @return Output signal or nullptr if processing failed
+     * @return Output of the last sink in plan order, or nullptr if processing failed
      */
     std::shared_ptr<Signal> process(
         std::shared_ptr<Signal> signal,
         const std::string& sourceComponentId = ""
     );
     
+    /**
+     * @brief Run the chain as a pipeline with one worker thread per stage
+     *
+     * The execution plan is cut into stages, each run by its own thread and
+     * fed by a bounded lock-free SPSC queue from the stage before it, so
+     * throughput is bounded by the slowest stage rather than the sum of all
+     * of them. Signals leave in the order they were submitted. Stages hand a
+     * single signal on, so only chains in which every component takes the
+     * output of the one before it in plan order can be pipelined; a chain
+     * that branches is refused. The topology cannot change and process() is
+     * refused until stopPipeline.
+     * @param output Receives each signal after the last stage, on the last stage's thread
+     * @param config Stage layout and queue capacity
+     * @return True if the pipeline started
+     */
+    bool startPipeline(PipelineOutput output, const PipelineConfig& config = PipelineConfig());
+    
+    /**
+     * @brief Feed a signal into the pipeline
+     *
+     * Call from one producer thread at a time, between startPipeline and
+     * stopPipeline.
+     * @param signal Input signal
+     * @param wait Wait for room if the first stage's queue is full
+     * @return True if the signal was queued, false if the queue was full or the chain is not pipelined
+     */
+    bool submit(std::shared_ptr<Signal> signal, bool wait = true);
+    
+    /**
+     * @brief Finish the queued signals and stop the stage threads
+     */
+    void stopPipeline();
+    
+    /**
+     * @brief Check whether the chain runs as a pipeline
+     * @return True between startPipeline and stopPipeline
+     */
+    bool isPipelined() const;
+    
+    /**
+     * @brief Get per-stage queue depths and timing
+     * @return Statistics in stage order, empty if the chain is not pipelined
+     */
+    std::vector<PipelineStageStats> getPipelineStats() const;
+    
     /**
      * @brief Set a callback for signal processing
      * @param callback Callback function
@@ -194,23 +293,44 @@ private:
     ) const;
     
     /**
-     * @brief Process a signal through a specific component and its successors
-     * @param signal Input signal
-     * @param componentId Component ID to process
-     * @param visited Set of already visited components to avoid cycles
-     * @return Output signal or nullptr if processing failed
+     * @brief Validate the chain topology with the mutex held
+     * @param errorMsg Error message if validation fails
+     * @return True if chain is valid
      */
-    std::shared_ptr<Signal> processComponent(
-        std::shared_ptr<Signal> signal,
-        const std::string& componentId,
-        std::set<std::string>& visited
-    );
+    bool validateLocked(std::string& errorMsg) const;
+    
+    /**
+     * @brief Rebuild the execution plan if the topology changed, with the mutex held
+     * @param errorMsg Error message if the chain is invalid
+     * @return True if the plan is ready
+     */
+    bool compilePlanLocked(std::string& errorMsg);
+    
+    /**
+     * @brief Components in topological order with integer adjacency
+     */
+    struct ExecutionPlan;
+    
+    /**
+     * @brief Stage threads and queues of pipelined execution
+     */
+    struct Pipeline;
+    
+    /**
+     * @brief Stage thread function
+     * @param pipeline Running pipeline
+     * @param stageIndex Stage the thread runs
+     */
+    void stageFunction(Pipeline& pipeline, size_t stageIndex);
     
     std::string name_;                                                  ///< Chain name
     std::map<std::string, std::shared_ptr<ProcessingComponent>> components_; ///< Components by ID
     std::vector<ProcessingEdge> edges_;                                 ///< Edges between components
     ProcessingCallback processingCallback_;                             ///< Callback for signal processing
     mutable std::mutex mutex_;                                          ///< Mutex for thread safety
+    std::unique_ptr<ExecutionPlan> plan_;                               ///< Compiled plan, rebuilt when planDirty_ is set
+    bool planDirty_;                                                    ///< Topology changed since the plan was compiled
+    std::unique_ptr<Pipeline> pipeline_;                                ///< Stage threads, null unless pipelined
 };
 
 /**
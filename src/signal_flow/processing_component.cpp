@@ -17,21 +17,25 @@ namespace signal {
 // Set a string parameter
 void ComponentConfig::setParameter(const std::string& key, const std::string& value) {
     parameters_[key] = value;
+    updateSnapshot();
 }
 
 // Set an integer parameter
 void ComponentConfig::setParameter(const std::string& key, int value) {
     parameters_[key] = std::to_string(value);
+    updateSnapshot();
 }
 
 // Set a double parameter
 void ComponentConfig::setParameter(const std::string& key, double value) {
     parameters_[key] = std::to_string(value);
+    updateSnapshot();
 }
 
 // Set a boolean parameter
 void ComponentConfig::setParameter(const std::string& key, bool value) {
     parameters_[key] = value ? "true" : "false";
+    updateSnapshot();
 }
 
 // Get a string parameter
@@ -99,6 +103,11 @@ const std::map<std::string, std::string>& ComponentConfig::getAllParameters() co
     return parameters_;
 }
 
+// Rebuild the parameter snapshot
+void ComponentConfig::updateSnapshot() {
+    snapshot_ = std::make_shared<const MetadataMap>(MetadataMap::fromStringMap(parameters_));
+}
+
 //-----------------------------------------------------------------------------
 // ProcessingComponent Implementation
 //-----------------------------------------------------------------------------
@@ -221,48 +230,14 @@ void ProcessingComponent::addProcessingHistory(
         return;
     }
     
-    // Add metadata to track processing history
-    if (output->hasMetadata("metadata")) {
-        // Get existing metadata
-        std::string metadataStr = output->getMetadata("metadata");
-        std::shared_ptr<SignalMetadata> metadata;
-        
-        // TODO: Deserialize metadata from string
-        
-        // Add processing history entry
-        auto& entry = metadata->addProcessingHistoryEntry(id_, name_, operation);
-        
-        // Add parameters from config
-        for (const auto& param : config_.getAllParameters()) {
-            entry.parameters[param.first] = param.second;
-        }
-        
-        // TODO: Serialize metadata back to string
-        // output->setMetadata("metadata", serializedStr);
-    } else {
-        // Create new metadata if none exists
-        auto metadata = std::make_shared<SignalMetadata>();
-        
-        // Add processing history entry
-        auto& entry = metadata->addProcessingHistoryEntry(id_, name_, operation);
-        
-        // Add parameters from config
-        for (const auto& param : config_.getAllParameters()) {
-            entry.parameters[param.first] = param.second;
-        }
-        
-        // TODO: Serialize metadata to string
-        // output->setMetadata("metadata", serializedStr);
+    // Continue the input's history on a new output signal
+    if (output != input) {
+        output->inheritProvenance(*input);
     }
     
-    // Add component ID to processing chain
-    std::string processingChain = input->getMetadata("processing_chain");
-    if (!processingChain.empty()) {
-        processingChain += "," + id_;
-    } else {
-        processingChain = id_;
-    }
-    output->setMetadata("processing_chain", processingChain);
+    // Record this stage; parameters are shared with every signal processed under this configuration
+    auto& entry = output->addProvenance(id_, name_, operation);
+    entry.parameters = config_.getParameterSnapshot();
 }
 
 } // namespace signal
@@ -107,8 +107,23 @@ public:
      */
     const std::map<std::string, std::string>& getAllParameters() const;
     
+    /**
+     * @brief Get an immutable snapshot of all parameters
+     * 
+     * Rebuilt only when a parameter changes, so provenance entries for every
+     * signal processed under one configuration share a single map.
+     * @return Shared parameter map (nullptr if there are no parameters)
+     */
+    std::shared_ptr<const MetadataMap> getParameterSnapshot() const { return snapshot_; }
+    
 private:
+    /**
+     * @brief Rebuild the parameter snapshot after a change
+     */
+    void updateSnapshot();
+    
     std::map<std::string, std::string> parameters_;   ///< Parameter storage
+    std::shared_ptr<const MetadataMap> snapshot_;     ///< Shared copy of parameters_
 };
 
 /**
@@ -9,6 +9,8 @@
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include <cmath>
+#include <iterator>
 
 namespace tdoa {
 namespace signal {
@@ -64,6 +66,71 @@ TaskPriority stringToTaskPriority(const std::string& priorityStr) {
     }
 }
 
+// Convert LoadLevel to string
+std::string loadLevelToString(LoadLevel level) {
+    switch (level) {
+        case LoadLevel::NORMAL:
+            return "NORMAL";
+        case LoadLevel::ELEVATED:
+            return "ELEVATED";
+        case LoadLevel::CRITICAL:
+            return "CRITICAL";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+namespace {
+
+/**
+ * @brief Load level a measurement calls for
+ * @param scale Threshold multiplier (below 1.0 when deciding whether to leave a level)
+ */
+LoadLevel classifyLoad(const SystemLoad& load, const LoadAdmissionConfig& config, double scale) {
+    if (!load.valid) {
+        return LoadLevel::NORMAL;
+    }
+    
+    double freeFraction = (load.memoryLimitMB > 0.0) ? load.memoryAvailableMB / load.memoryLimitMB : 1.0;
+    if (load.memoryFullPressure >= config.criticalMemoryFullPressure * scale ||
+        load.memoryPressure >= config.criticalMemoryPressure * scale ||
+        load.cpuPressure >= config.criticalCpuPressure * scale ||
+        freeFraction <= config.criticalMemoryFreeFraction / scale) {
+        return LoadLevel::CRITICAL;
+    }
+    if (load.memoryPressure >= config.elevatedMemoryPressure * scale ||
+        load.cpuPressure >= config.elevatedCpuPressure * scale ||
+        freeFraction <= config.elevatedMemoryFreeFraction / scale) {
+        return LoadLevel::ELEVATED;
+    }
+    return LoadLevel::NORMAL;
+}
+
+/**
+ * @brief Fixed-point units per resource unit in the lock-free counters
+ */
+constexpr double COUNTER_SCALE = 1e6;
+
+/**
+ * @brief Number of standard resource types (CPU to DISK)
+ */
+constexpr size_t STANDARD_RESOURCE_COUNT = static_cast<size_t>(ResourceType::CUSTOM);
+
+int64_t toCounter(double amount) {
+    return static_cast<int64_t>(std::llround(amount * COUNTER_SCALE));
+}
+
+double fromCounter(int64_t value) {
+    return static_cast<double>(value) / COUNTER_SCALE;
+}
+
+size_t standardIndex(ResourceType type) {
+    size_t index = static_cast<size_t>(type);
+    return index < STANDARD_RESOURCE_COUNT ? index : STANDARD_RESOURCE_COUNT;
+}
+
+} // anonymous namespace
+
 //-----------------------------------------------------------------------------
 // ResourceRequest Implementation
 //-----------------------------------------------------------------------------
@@ -118,6 +185,126 @@ ResourceAllocation::ResourceAllocation(
 // ResourceManager Implementation
 //-----------------------------------------------------------------------------
 
+// Lock-free counters of the standard resources and the reservation pool
+struct ResourceManager::Counters {
+    /**
+     * @brief Amounts of one resource in fixed point
+     */
+    struct Counter {
+        std::atomic<int64_t> total{0};
+        std::atomic<int64_t> reserved{0};
+        std::atomic<int64_t> peak{0};
+    };
+    
+    /**
+     * @brief Pooled fast-path reservation
+     */
+    struct Slot {
+        std::atomic<uint32_t> handle{0};     ///< Live handle, 0 when free
+        std::atomic<uint32_t> next{0};       ///< Free list link (index + 1)
+        uint32_t generation = 0;             ///< Generation of the last handle, owned by the holder
+        int64_t amounts[STANDARD_RESOURCE_COUNT] = {}; ///< Reserved amounts, written before handle is published
+    };
+    
+    static constexpr uint32_t SLOT_BITS = 12;
+    static constexpr uint32_t SLOT_COUNT = 1u << SLOT_BITS;
+    static constexpr uint32_t SLOT_MASK = SLOT_COUNT - 1;
+    
+    Counter counters[STANDARD_RESOURCE_COUNT];
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> freeHead;          ///< (ABA tag << 32) | (index + 1), 0 = empty
+    std::atomic<size_t> reservations;        ///< Live reservations
+    
+    Counters()
+        : slots(new Slot[SLOT_COUNT])
+        , freeHead(0)
+        , reservations(0) {
+        for (uint32_t i = SLOT_COUNT; i-- > 0;) {
+            pushSlot(i);
+        }
+    }
+    
+    int64_t available(size_t type) const {
+        return counters[type].total.load(std::memory_order_relaxed) -
+               counters[type].reserved.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Reserve an amount if it fits under the total
+     */
+    bool take(size_t type, int64_t amount) {
+        Counter& counter = counters[type];
+        int64_t reserved = counter.reserved.load(std::memory_order_relaxed);
+        do {
+            if (amount > 0 && reserved + amount > counter.total.load(std::memory_order_relaxed)) {
+                return false;
+            }
+        } while (!counter.reserved.compare_exchange_weak(reserved, reserved + amount,
+                                                         std::memory_order_acq_rel, std::memory_order_relaxed));
+        
+        int64_t peak = counter.peak.load(std::memory_order_relaxed);
+        while (reserved + amount > peak &&
+               !counter.peak.compare_exchange_weak(peak, reserved + amount, std::memory_order_relaxed)) {
+        }
+        return true;
+    }
+    
+    void give(size_t type, int64_t amount) {
+        // Reserved amounts dropped by reset must not go negative
+        Counter& counter = counters[type];
+        int64_t reserved = counter.reserved.load(std::memory_order_relaxed);
+        while (!counter.reserved.compare_exchange_weak(reserved, std::max<int64_t>(0, reserved - amount),
+                                                       std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+    }
+    
+    /**
+     * @brief Reserve all amounts or none
+     */
+    bool takeAll(const int64_t (&amounts)[STANDARD_RESOURCE_COUNT]) {
+        for (size_t type = 0; type < STANDARD_RESOURCE_COUNT; type++) {
+            if (amounts[type] != 0 && !take(type, amounts[type])) {
+                while (type-- > 0) {
+                    if (amounts[type] != 0) {
+                        give(type, amounts[type]);
+                    }
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    void giveAll(const int64_t (&amounts)[STANDARD_RESOURCE_COUNT]) {
+        for (size_t type = 0; type < STANDARD_RESOURCE_COUNT; type++) {
+            if (amounts[type] != 0) {
+                give(type, amounts[type]);
+            }
+        }
+    }
+    
+    bool popSlot(uint32_t& index) {
+        uint64_t head = freeHead.load(std::memory_order_acquire);
+        while ((head & 0xffffffffu) != 0) {
+            index = static_cast<uint32_t>(head & 0xffffffffu) - 1;
+            uint64_t next = ((head >> 32) + 1) << 32 | slots[index].next.load(std::memory_order_relaxed);
+            if (freeHead.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void pushSlot(uint32_t index) {
+        uint64_t head = freeHead.load(std::memory_order_relaxed);
+        uint64_t next;
+        do {
+            slots[index].next.store(static_cast<uint32_t>(head & 0xffffffffu), std::memory_order_relaxed);
+            next = ((head >> 32) + 1) << 32 | (index + 1);
+        } while (!freeHead.compare_exchange_weak(head, next, std::memory_order_release, std::memory_order_relaxed));
+    }
+};
+
 // Singleton instance accessor
 ResourceManager& ResourceManager::getInstance() {
     static ResourceManager instance;
@@ -126,8 +313,16 @@ ResourceManager& ResourceManager::getInstance() {
 
 // Private constructor for singleton
 ResourceManager::ResourceManager()
-    : nextCallbackId_(0)
-    , preemptionEnabled_(false) {
+    : counters_(new Counters())
+    , nextCallbackId_(0)
+    , preemptionEnabled_(false)
+    , resourceWaiters_(0)
+    , loadLevel_(static_cast<int>(LoadLevel::NORMAL))
+    , queueScale_(1.0)
+    , measuredMemoryMB_(-1.0)
+    , samplingActive_(false)
+    , callbackCount_(0)
+    , callbackStopping_(false) {
     
     // Initialize with default resources
     ResourceUsage cpuUsage = {0.0, 0.0, 0.0, 0.0, "cores"};
@@ -145,6 +340,17 @@ ResourceManager::ResourceManager()
 
 // Private destructor for singleton
 ResourceManager::~ResourceManager() {
+    // Stop the sampling and callback threads
+    stopLoadSampling();
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        callbackStopping_ = true;
+    }
+    callbackCV_.notify_all();
+    if (callbackThread_.joinable()) {
+        callbackThread_.join();
+    }
+    
     // Clean up all allocations
     reset();
 }
@@ -162,35 +368,33 @@ bool ResourceManager::initialize(int cpuCores, double memoryMB, double gpuMemory
     }
     
     if (memoryMB <= 0.0) {
-        // Default to 4GB if detection fails
-        memoryMB = 4096.0;
+        // Use the memory limit of the process's cgroup or machine
+        SystemLoad load = SystemLoadSampler().sample();
+        memoryMB = load.valid ? std::floor(load.memoryLimitMB) : 0.0;
+        if (memoryMB <= 0.0) {
+            // Default to 4GB if detection fails
+            memoryMB = 4096.0;
+        }
     }
     
-    // Set CPU resource
-    resources_[ResourceType::CPU].total = static_cast<double>(cpuCores);
-    resources_[ResourceType::CPU].available = static_cast<double>(cpuCores);
-    resources_[ResourceType::CPU].unit = "cores";
+    // Totals live in the lock-free counters; reservations already made are kept
+    auto setTotal = [this](ResourceType type, double amount, const char* unit) {
+        counters_->counters[standardIndex(type)].total.store(toCounter(amount));
+        resources_[type].unit = unit;
+    };
     
-    // Set memory resource
-    resources_[ResourceType::MEMORY].total = memoryMB;
-    resources_[ResourceType::MEMORY].available = memoryMB;
-    resources_[ResourceType::MEMORY].unit = "MB";
+    // Set CPU and memory resources
+    setTotal(ResourceType::CPU, static_cast<double>(cpuCores), "cores");
+    setTotal(ResourceType::MEMORY, memoryMB, "MB");
     
     // Set GPU resource if provided
     if (gpuMemoryMB > 0.0) {
-        resources_[ResourceType::GPU].total = gpuMemoryMB;
-        resources_[ResourceType::GPU].available = gpuMemoryMB;
-        resources_[ResourceType::GPU].unit = "MB";
+        setTotal(ResourceType::GPU, gpuMemoryMB, "MB");
     }
     
     // Set default network and disk resources
-    resources_[ResourceType::NETWORK].total = 100.0;
-    resources_[ResourceType::NETWORK].available = 100.0;
-    resources_[ResourceType::NETWORK].unit = "MB/s";
-    
-    resources_[ResourceType::DISK].total = 100.0;
-    resources_[ResourceType::DISK].available = 100.0;
-    resources_[ResourceType::DISK].unit = "MB/s";
+    setTotal(ResourceType::NETWORK, 100.0, "MB/s");
+    setTotal(ResourceType::DISK, 100.0, "MB/s");
     
     return true;
 }
@@ -204,17 +408,17 @@ bool ResourceManager::setResourceTotal(ResourceType type, double amount, const s
         return false;
     }
     
-    // Get the current usage
-    auto& resource = resources_[type];
-    double currentUsage = resource.total - resource.available;
+    if (standardIndex(type) == STANDARD_RESOURCE_COUNT) {
+        std::cerr << "Error: Use addCustomResource for custom resources" << std::endl;
+        return false;
+    }
     
-    // Update the resource
-    resource.total = amount;
-    resource.available = std::max(0.0, amount - currentUsage);
+    // Update the total; current reservations are kept
+    counters_->counters[standardIndex(type)].total.store(toCounter(amount));
     
     // Update the unit if provided
     if (!unit.empty()) {
-        resource.unit = unit;
+        resources_[type].unit = unit;
     }
     
     return true;
@@ -255,9 +459,8 @@ bool ResourceManager::addCustomResource(const std::string& name, double amount,
 ResourceUsage ResourceManager::getResourceUsage(ResourceType type) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = resources_.find(type);
-    if (it != resources_.end()) {
-        return it->second;
+    if (standardIndex(type) != STANDARD_RESOURCE_COUNT) {
+        return getStandardUsage(type);
     }
     
     // Return default resource usage if not found
@@ -280,7 +483,12 @@ ResourceUsage ResourceManager::getCustomResourceUsage(const std::string& name) c
 // Get all resource usage
 std::map<ResourceType, ResourceUsage> ResourceManager::getAllResourceUsage() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return resources_;
+    
+    std::map<ResourceType, ResourceUsage> usage;
+    for (const auto& pair : resources_) {
+        usage[pair.first] = getStandardUsage(pair.first);
+    }
+    return usage;
 }
 
 // Get all custom resource usage
@@ -293,15 +501,23 @@ std::map<std::string, ResourceUsage> ResourceManager::getAllCustomResourceUsage(
 ResourceAllocation ResourceManager::requestAllocation(const ResourceRequest& request) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    // Check if we can allocate the resources
-    if (canAllocate(request)) {
+    // Check if we can allocate the resources; the counters may still refuse
+    // if fast-path reservations took them in the meantime
+    if (canAllocateLocked(request)) {
         // Allocate the resources
-        return allocateResources(request);
-    } else if (preemptionEnabled_) {
+        ResourceAllocation allocation = allocateResources(request);
+        if (allocation.success) {
+            return allocation;
+        }
+    }
+    if (preemptionEnabled_ && isAdmitted(request.priority)) {
         // Try to preempt lower priority allocations
         if (tryPreemption(request)) {
             // Retry allocation after preemption
-            return allocateResources(request);
+            ResourceAllocation allocation = allocateResources(request);
+            if (allocation.success) {
+                return allocation;
+            }
         }
     }
     
@@ -326,7 +542,11 @@ ResourceAllocation ResourceManager::requestAllocation(const ResourceRequest& req
 // Release allocated resources
 bool ResourceManager::releaseAllocation(const std::string& allocationId) {
     std::lock_guard<std::mutex> lock(mutex_);
-    
+    return releaseAllocationLocked(allocationId);
+}
+
+// Release allocated resources with mutex_ held
+bool ResourceManager::releaseAllocationLocked(const std::string& allocationId) {
     // Find the allocation
     auto it = activeAllocations_.find(allocationId);
     if (it == activeAllocations_.end()) {
@@ -339,17 +559,9 @@ bool ResourceManager::releaseAllocation(const std::string& allocationId) {
     
     // Release the resources
     for (const auto& pair : allocation.allocated) {
-        ResourceType type = pair.first;
-        double amount = pair.second;
-        
-        // Update the resource
-        auto& resource = resources_[type];
-        resource.available += amount;
-        resource.reserved -= amount;
-        
-        // Ensure we don't exceed the total
-        if (resource.available > resource.total) {
-            resource.available = resource.total;
+        size_t type = standardIndex(pair.first);
+        if (type != STANDARD_RESOURCE_COUNT) {
+            counters_->give(type, toCounter(pair.second));
         }
     }
     
@@ -365,6 +577,15 @@ bool ResourceManager::releaseAllocation(const std::string& allocationId) {
 // Check if an allocation can be made
 bool ResourceManager::canAllocate(const ResourceRequest& request) const {
     std::lock_guard<std::mutex> lock(mutex_);
+    return canAllocateLocked(request);
+}
+
+// Check if an allocation can be made with mutex_ held
+bool ResourceManager::canAllocateLocked(const ResourceRequest& request) const {
+    // Measured load refuses low priorities before the bookkeeping runs out
+    if (!isAdmitted(request.priority)) {
+        return false;
+    }
     
     // Check each required resource
     for (const auto& pair : request.requirements) {
@@ -372,13 +593,18 @@ bool ResourceManager::canAllocate(const ResourceRequest& request) const {
         double amount = pair.second;
         
         // Check if we have this resource
-        auto it = resources_.find(type);
-        if (it == resources_.end()) {
+        size_t index = standardIndex(type);
+        if (index == STANDARD_RESOURCE_COUNT) {
             return false;
         }
         
         // Check if we have enough available
-        if (it->second.available < amount) {
+        if (counters_->available(index) < toCounter(amount)) {
+            return false;
+        }
+        
+        // Never hand out memory the system does not actually have
+        if (!fitsMeasuredLoad(type, amount, request.priority)) {
             return false;
         }
     }
@@ -391,21 +617,28 @@ bool ResourceManager::waitForResources(const ResourceRequest& request, int timeo
     std::unique_lock<std::mutex> lock(mutex_);
     
     // If resources are already available, return immediately
-    if (canAllocate(request)) {
+    if (canAllocateLocked(request)) {
         return true;
     }
     
+    // Fast-path releases only notify while someone is waiting
+    resourceWaiters_.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    
     // Wait for resources to become available
+    bool available = true;
     if (timeout_ms > 0) {
         // Wait with timeout
-        return resourceAvailableCV_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
-            [this, &request]() { return canAllocate(request); });
+        available = resourceAvailableCV_.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+            [this, &request]() { return canAllocateLocked(request); });
     } else {
         // Wait indefinitely
         resourceAvailableCV_.wait(lock,
-            [this, &request]() { return canAllocate(request); });
-        return true;
+            [this, &request]() { return canAllocateLocked(request); });
     }
+    
+    resourceWaiters_.fetch_sub(1);
+    return available;
 }
 
 // Get current active allocations
@@ -422,7 +655,7 @@ std::vector<ResourceRequest> ResourceManager::getPendingRequests() const {
 
 // Register a callback for allocation events
 int ResourceManager::registerAllocationCallback(std::function<void(const ResourceAllocation&)> callback) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     
     if (!callback) {
         std::cerr << "Error: Cannot register null callback" << std::endl;
@@ -431,13 +664,19 @@ int ResourceManager::registerAllocationCallback(std::function<void(const Resourc
     
     int id = nextCallbackId_++;
     allocationCallbacks_[id] = callback;
+    callbackCount_.store(allocationCallbacks_.size());
+    
+    // Start the callback thread on first use
+    if (!callbackThread_.joinable()) {
+        callbackThread_ = std::thread(&ResourceManager::callbackFunction, this);
+    }
     
     return id;
 }
 
 // Unregister an allocation callback
 bool ResourceManager::unregisterAllocationCallback(int callbackId) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::lock_guard<std::mutex> lock(callbackMutex_);
     
     auto it = allocationCallbacks_.find(callbackId);
     if (it == allocationCallbacks_.end()) {
@@ -446,6 +685,7 @@ bool ResourceManager::unregisterAllocationCallback(int callbackId) {
     }
     
     allocationCallbacks_.erase(it);
+    callbackCount_.store(allocationCallbacks_.size());
     return true;
 }
 
@@ -469,22 +709,15 @@ bool ResourceManager::adjustAllocation(ResourceType type, double factor) {
     }
     
     // Check if we have this resource
-    auto it = resources_.find(type);
-    if (it == resources_.end()) {
+    size_t index = standardIndex(type);
+    if (index == STANDARD_RESOURCE_COUNT) {
         std::cerr << "Error: Resource type not found" << std::endl;
         return false;
     }
     
-    // Get the current usage
-    auto& resource = it->second;
-    double currentUsage = resource.total - resource.available;
-    
-    // Adjust the total
-    double newTotal = resource.total * factor;
-    resource.total = newTotal;
-    
-    // Adjust the available
-    resource.available = std::max(0.0, newTotal - currentUsage);
+    // Adjust the total; current reservations are kept
+    auto& total = counters_->counters[index].total;
+    total.store(toCounter(fromCounter(total.load()) * factor));
     
     return true;
 }
@@ -514,11 +747,18 @@ std::string ResourceManager::generateAllocationId() const {
 void ResourceManager::reset() {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    // Invalidate fast-path reservations; releasing their handles later fails
+    for (uint32_t i = 0; i < Counters::SLOT_COUNT; i++) {
+        if (counters_->slots[i].handle.exchange(0, std::memory_order_acq_rel) != 0) {
+            counters_->reservations.fetch_sub(1, std::memory_order_relaxed);
+            counters_->pushSlot(i);
+        }
+    }
+    
     // Reset all resources
-    for (auto& pair : resources_) {
-        pair.second.available = pair.second.total;
-        pair.second.reserved = 0.0;
-        pair.second.peak = 0.0;
+    for (auto& counter : counters_->counters) {
+        counter.reserved.store(0);
+        counter.peak.store(0);
     }
     
     // Reset all custom resources
@@ -536,6 +776,127 @@ void ResourceManager::reset() {
     resourceAvailableCV_.notify_all();
 }
 
+// Start sampling the measured system load
+bool ResourceManager::startLoadSampling(const LoadAdmissionConfig& config) {
+    std::lock_guard<std::mutex> lock(loadMutex_);
+    if (samplingActive_) {
+        std::cerr << "Error: Load sampling is already running" << std::endl;
+        return false;
+    }
+    
+    loadConfig_ = config;
+    if (loadConfig_.sampleIntervalMs <= 0) {
+        loadConfig_.sampleIntervalMs = LoadAdmissionConfig().sampleIntervalMs;
+    }
+    samplingActive_ = true;
+    samplingThread_ = std::thread(&ResourceManager::samplingFunction, this);
+    return true;
+}
+
+// Stop sampling
+void ResourceManager::stopLoadSampling() {
+    {
+        std::lock_guard<std::mutex> lock(loadMutex_);
+        if (!samplingActive_) {
+            return;
+        }
+        samplingActive_ = false;
+    }
+    samplingCV_.notify_all();
+    if (samplingThread_.joinable()) {
+        samplingThread_.join();
+    }
+    
+    // Without measurements every priority is admitted again
+    updateSystemLoad(SystemLoad());
+}
+
+// Check if load sampling is running
+bool ResourceManager::isLoadSampling() const {
+    std::lock_guard<std::mutex> lock(loadMutex_);
+    return samplingActive_;
+}
+
+// Apply a load measurement
+void ResourceManager::updateSystemLoad(const SystemLoad& load) {
+    LoadLevel previous;
+    LoadLevel level;
+    {
+        std::lock_guard<std::mutex> lock(loadMutex_);
+        systemLoad_ = load;
+        
+        // Leaving a level needs the measurements to clear it with a margin
+        previous = getLoadLevel();
+        level = classifyLoad(load, loadConfig_, 1.0);
+        if (level < previous) {
+            level = std::min(previous, classifyLoad(load, loadConfig_, loadConfig_.recoveryFactor));
+        }
+        
+        double scale = 1.0;
+        if (level == LoadLevel::ELEVATED) {
+            scale = loadConfig_.elevatedQueueScale;
+        } else if (level == LoadLevel::CRITICAL) {
+            scale = loadConfig_.criticalQueueScale;
+        }
+        queueScale_.store(std::min(1.0, std::max(0.0, scale)), std::memory_order_relaxed);
+        measuredMemoryMB_.store(load.valid ? std::max(0.0, load.memoryAvailableMB - loadConfig_.memoryHeadroomMB) : -1.0,
+                                std::memory_order_relaxed);
+        loadLevel_.store(static_cast<int>(level), std::memory_order_release);
+    }
+    
+    if (level != previous) {
+        std::cerr << "Warning: System load level " << loadLevelToString(previous)
+                  << " -> " << loadLevelToString(level) << std::endl;
+    }
+    
+    // Requests refused for load may fit now
+    if (level < previous) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        resourceAvailableCV_.notify_all();
+    }
+}
+
+// Get the last load measurement
+SystemLoad ResourceManager::getSystemLoad() const {
+    std::lock_guard<std::mutex> lock(loadMutex_);
+    return systemLoad_;
+}
+
+// Get the current load level
+LoadLevel ResourceManager::getLoadLevel() const {
+    return static_cast<LoadLevel>(loadLevel_.load(std::memory_order_acquire));
+}
+
+// Check if the load level admits work of a priority
+bool ResourceManager::isAdmitted(TaskPriority priority) const {
+    switch (getLoadLevel()) {
+        case LoadLevel::ELEVATED:
+            return priority != TaskPriority::LOW;
+        case LoadLevel::CRITICAL:
+            return priority == TaskPriority::HIGH || priority == TaskPriority::CRITICAL;
+        default:
+            return true;
+    }
+}
+
+// Get the queue limit multiplier for LOW and NORMAL work
+double ResourceManager::getQueueScale() const {
+    return queueScale_.load(std::memory_order_relaxed);
+}
+
+// Sampling thread function
+void ResourceManager::samplingFunction() {
+    SystemLoadSampler sampler;
+    std::unique_lock<std::mutex> lock(loadMutex_);
+    while (samplingActive_) {
+        std::chrono::milliseconds interval(loadConfig_.sampleIntervalMs);
+        lock.unlock();
+        updateSystemLoad(sampler.sample());
+        lock.lock();
+        samplingCV_.wait_for(lock, interval, [this] { return !samplingActive_; });
+    }
+}
+
 // Allocate resources for a request
 ResourceAllocation ResourceManager::allocateResources(const ResourceRequest& request) {
     // Generate a unique allocation ID
@@ -550,21 +911,19 @@ ResourceAllocation ResourceManager::allocateResources(const ResourceRequest& req
         request.clientId
     );
     
-    // Update resources
+    // Reserve the resources on the shared counters, all or none
+    int64_t amounts[STANDARD_RESOURCE_COUNT] = {};
     for (const auto& pair : request.requirements) {
-        ResourceType type = pair.first;
-        double amount = pair.second;
-        
-        // Update the resource
-        auto& resource = resources_[type];
-        resource.available -= amount;
-        resource.reserved += amount;
-        
-        // Update peak usage
-        double currentUsage = resource.total - resource.available;
-        if (currentUsage > resource.peak) {
-            resource.peak = currentUsage;
+        size_t type = standardIndex(pair.first);
+        if (type == STANDARD_RESOURCE_COUNT) {
+            allocation.success = false;
+            return allocation;
         }
+        amounts[type] += toCounter(pair.second);
+    }
+    if (!counters_->takeAll(amounts)) {
+        allocation.success = false;
+        return allocation;
     }
     
     // Add to active allocations
@@ -590,9 +949,9 @@ bool ResourceManager::tryPreemption(const ResourceRequest& request) {
         double amount = pair.second;
         
         // Calculate how much more we need
-        auto it = resources_.find(type);
-        if (it != resources_.end()) {
-            double available = it->second.available;
+        size_t index = standardIndex(type);
+        if (index != STANDARD_RESOURCE_COUNT) {
+            double available = fromCounter(counters_->available(index));
             if (amount > available) {
                 neededResources[type] = amount - available;
             }
@@ -721,7 +1080,7 @@ bool ResourceManager::tryPreemption(const ResourceRequest& request) {
     
     // Release the preempted allocations
     for (const auto& allocationId : allocationsToRelease) {
-        releaseAllocation(allocationId);
+        releaseAllocationLocked(allocationId);
     }
     
     return true;
@@ -732,23 +1091,164 @@ void ResourceManager::updateResourceUsage() {
     // Nothing to do here for now
 }
 
-// Notify allocation callbacks
+// Queue an allocation for the callback thread
 void ResourceManager::notifyAllocationCallbacks(const ResourceAllocation& allocation) {
-    // Copy the callbacks to avoid mutex deadlock
-    std::map<int, std::function<void(const ResourceAllocation&)>> callbacks;
+    if (callbackCount_.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
     {
-        std::lock_guard<std::mutex> lock(mutex_);
-        callbacks = allocationCallbacks_;
+        std::lock_guard<std::mutex> lock(callbackMutex_);
+        callbackQueue_.push_back(allocation);
+    }
+    callbackCV_.notify_one();
+}
+
+// Callback thread function
+void ResourceManager::callbackFunction() {
+    std::unique_lock<std::mutex> lock(callbackMutex_);
+    while (true) {
+        callbackCV_.wait(lock, [this] { return callbackStopping_ || !callbackQueue_.empty(); });
+        if (callbackQueue_.empty()) {
+            return;
+        }
+        
+        // Call the callbacks without holding the lock so they may re-enter
+        ResourceAllocation allocation = std::move(callbackQueue_.front());
+        callbackQueue_.pop_front();
+        auto callbacks = allocationCallbacks_;
+        lock.unlock();
+        
+        for (const auto& pair : callbacks) {
+            try {
+                pair.second(allocation);
+            } catch (const std::exception& e) {
+                std::cerr << "Error in allocation callback: " << e.what() << std::endl;
+            }
+        }
+        
+        lock.lock();
+    }
+}
+
+// Reserve a standard resource without locking
+ReservationHandle ResourceManager::reserve(ResourceType type, double amount, TaskPriority priority) {
+    return reserve({{type, amount}}, priority);
+}
+
+// Reserve several standard resources without locking
+ReservationHandle ResourceManager::reserve(
+    std::initializer_list<std::pair<ResourceType, double>> amounts,
+    TaskPriority priority
+) {
+    // Measured load refuses low priorities before the counters run out
+    if (!isAdmitted(priority)) {
+        return 0;
+    }
+    
+    int64_t counts[STANDARD_RESOURCE_COUNT] = {};
+    for (const auto& pair : amounts) {
+        size_t type = standardIndex(pair.first);
+        if (type == STANDARD_RESOURCE_COUNT || pair.second < 0.0) {
+            std::cerr << "Error: Only standard resources can be reserved" << std::endl;
+            return 0;
+        }
+        if (!fitsMeasuredLoad(pair.first, pair.second, priority)) {
+            return 0;
+        }
+        counts[type] += toCounter(pair.second);
+    }
+    
+    // Take a handle first; an exhausted pool must not leak counter reservations
+    uint32_t index;
+    if (!counters_->popSlot(index)) {
+        return 0;
+    }
+    if (!counters_->takeAll(counts)) {
+        counters_->pushSlot(index);
+        return 0;
     }
     
-    // Call the callbacks
-    for (const auto& pair : callbacks) {
-        try {
-            pair.second(allocation);
-        } catch (const std::exception& e) {
-            std::cerr << "Error in allocation callback: " << e.what() << std::endl;
+    // Publish the handle; generations keep stale handles from matching
+    Counters::Slot& slot = counters_->slots[index];
+    std::copy(std::begin(counts), std::end(counts), slot.amounts);
+    slot.generation = (slot.generation + 1) & (0xffffffffu >> Counters::SLOT_BITS);
+    if (slot.generation == 0) {
+        slot.generation = 1;
+    }
+    ReservationHandle handle = (slot.generation << Counters::SLOT_BITS) | index;
+    slot.handle.store(handle, std::memory_order_release);
+    counters_->reservations.fetch_add(1, std::memory_order_relaxed);
+    
+    // Only build an allocation record if someone is listening
+    if (callbackCount_.load(std::memory_order_relaxed) > 0) {
+        std::map<ResourceType, double> allocated;
+        for (const auto& pair : amounts) {
+            allocated[pair.first] += pair.second;
         }
+        notifyAllocationCallbacks(ResourceAllocation("reservation-" + std::to_string(handle), "", allocated));
+    }
+    
+    return handle;
+}
+
+// Release a fast-path reservation
+bool ResourceManager::release(ReservationHandle handle) {
+    if (handle == 0) {
+        return false;
+    }
+    
+    // Only one release can clear the live handle
+    uint32_t index = handle & Counters::SLOT_MASK;
+    Counters::Slot& slot = counters_->slots[index];
+    uint32_t expected = handle;
+    if (!slot.handle.compare_exchange_strong(expected, 0, std::memory_order_acq_rel)) {
+        std::cerr << "Error: Reservation " << handle << " not found" << std::endl;
+        return false;
+    }
+    
+    counters_->giveAll(slot.amounts);
+    counters_->reservations.fetch_sub(1, std::memory_order_relaxed);
+    counters_->pushSlot(index);
+    
+    // Wake requests waiting for resources only if there are any
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (resourceWaiters_.load(std::memory_order_relaxed) > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        resourceAvailableCV_.notify_all();
+    }
+    return true;
+}
+
+// Get the number of live fast-path reservations
+size_t ResourceManager::getReservationCount() const {
+    return counters_->reservations.load(std::memory_order_relaxed);
+}
+
+// Check an amount against measured available memory
+bool ResourceManager::fitsMeasuredLoad(ResourceType type, double amount, TaskPriority priority) const {
+    if (type != ResourceType::MEMORY || priority == TaskPriority::CRITICAL) {
+        return true;
+    }
+    double measured = measuredMemoryMB_.load(std::memory_order_relaxed);
+    return measured < 0.0 || amount <= measured;
+}
+
+// Build the usage statistics of a standard resource from its counters
+ResourceUsage ResourceManager::getStandardUsage(ResourceType type) const {
+    ResourceUsage usage = {0.0, 0.0, 0.0, 0.0, ""};
+    auto it = resources_.find(type);
+    if (it != resources_.end()) {
+        usage.unit = it->second.unit;
+    }
+    size_t index = standardIndex(type);
+    if (index != STANDARD_RESOURCE_COUNT) {
+        const Counters::Counter& counter = counters_->counters[index];
+        usage.total = fromCounter(counter.total.load(std::memory_order_relaxed));
+        usage.reserved = fromCounter(counter.reserved.load(std::memory_order_relaxed));
+        usage.available = std::max(0.0, usage.total - usage.reserved);
+        usage.peak = fromCounter(counter.peak.load(std::memory_order_relaxed));
     }
+    return usage;
 }
 
 } // namespace signal
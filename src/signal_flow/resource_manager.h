@@ -15,6 +15,10 @@
 #include <functional>
 #include <condition_variable>
 #include <chrono>
+#include <cstdint>
+#include <deque>
+#include <initializer_list>
+#include "system_load.h"
 
 namespace tdoa {
 namespace signal {
@@ -90,6 +94,68 @@ std::string taskPriorityToString(TaskPriority priority);
  */
 TaskPriority stringToTaskPriority(const std::string& priorityStr);
 
+/**
+ * @brief Handle of a fast-path resource reservation (0 = no reservation)
+ */
+using ReservationHandle = uint32_t;
+
+/**
+ * @brief Measured load level, which decides the priorities admitted
+ */
+enum class LoadLevel {
+    NORMAL,     ///< All priorities admitted
+    ELEVATED,   ///< LOW priority work refused
+    CRITICAL    ///< LOW and NORMAL priority work refused
+};
+
+/**
+ * @brief Convert LoadLevel to string
+ * @param level LoadLevel to convert
+ * @return String representation
+ */
+std::string loadLevelToString(LoadLevel level);
+
+/**
+ * @brief Thresholds for measured-load admission control
+ *
+ * Pressure thresholds are PSI avg10 percentages; free fractions are
+ * measured available memory divided by the memory limit. A level is
+ * entered when any of its thresholds is crossed and left only when the
+ * measurements fall below the thresholds multiplied by recoveryFactor.
+ */
+struct LoadAdmissionConfig {
+    int sampleIntervalMs;               ///< Time between samples
+    double elevatedCpuPressure;         ///< CPU some pressure that refuses LOW work
+    double criticalCpuPressure;         ///< CPU some pressure that refuses NORMAL work
+    double elevatedMemoryPressure;      ///< Memory some pressure that refuses LOW work
+    double criticalMemoryPressure;      ///< Memory some pressure that refuses NORMAL work
+    double criticalMemoryFullPressure;  ///< Memory full pressure that refuses NORMAL work
+    double elevatedMemoryFreeFraction;  ///< Free memory fraction below which LOW work is refused
+    double criticalMemoryFreeFraction;  ///< Free memory fraction below which NORMAL work is refused
+    double recoveryFactor;              ///< Threshold multiplier for leaving a level (hysteresis)
+    double memoryHeadroomMB;            ///< Measured memory kept free by canAllocate
+    double elevatedQueueScale;          ///< ParallelEngine queue limit multiplier for LOW/NORMAL when elevated
+    double criticalQueueScale;          ///< ParallelEngine queue limit multiplier for LOW/NORMAL when critical
+
+    /**
+     * @brief Constructor with default values
+     */
+    LoadAdmissionConfig()
+        : sampleIntervalMs(500)
+        , elevatedCpuPressure(40.0)
+        , criticalCpuPressure(80.0)
+        , elevatedMemoryPressure(5.0)
+        , criticalMemoryPressure(20.0)
+        , criticalMemoryFullPressure(5.0)
+        , elevatedMemoryFreeFraction(0.10)
+        , criticalMemoryFreeFraction(0.04)
+        , recoveryFactor(0.8)
+        , memoryHeadroomMB(256.0)
+        , elevatedQueueScale(0.5)
+        , criticalQueueScale(0.25)
+    {}
+};
+
 /**
  * @brief Resource allocation request
  */
@@ -238,6 +304,45 @@ public:
      */
     bool canAllocate(const ResourceRequest& request) const;
     
+    /**
+     * @brief Reserve a standard resource without locking
+     *
+     * Fast path for per-task accounting: a compare-and-swap on the
+     * resource's reserved counter and a small integer handle from a fixed
+     * pool, instead of a string ID and a map entry under the mutex.
+     * Reservations share capacity with requestAllocation and obey load
+     * admission, but are never queued or preempted. Allocation callbacks
+     * are notified asynchronously.
+     * @param type Resource type (not CUSTOM)
+     * @param amount Amount to reserve
+     * @param priority Priority for load admission
+     * @return Handle, or 0 if the amount is not available, the priority is
+     *         not admitted or all reservation handles are in use
+     */
+    ReservationHandle reserve(ResourceType type, double amount, TaskPriority priority = TaskPriority::NORMAL);
+    
+    /**
+     * @brief Reserve several standard resources at once without locking
+     * @param amounts Amount per resource type; all or none are reserved
+     * @param priority Priority for load admission
+     * @return Handle, or 0 if the reservation failed
+     */
+    ReservationHandle reserve(std::initializer_list<std::pair<ResourceType, double>> amounts,
+                              TaskPriority priority = TaskPriority::NORMAL);
+    
+    /**
+     * @brief Release a fast-path reservation
+     * @param handle Handle returned by reserve
+     * @return True if released; false for unknown or already released handles
+     */
+    bool release(ReservationHandle handle);
+    
+    /**
+     * @brief Get the number of live fast-path reservations
+     * @return Reservation count
+     */
+    size_t getReservationCount() const;
+    
     /**
      * @brief Wait for resources to become available
      * @param request Resource request
@@ -260,6 +365,9 @@ public:
     
     /**
      * @brief Register a callback for allocation events
+     *
+     * Callbacks run on a separate thread in allocation order, so they may
+     * call back into the resource manager.
      * @param callback Callback function that takes an allocation
      * @return Callback ID
      */
@@ -303,6 +411,66 @@ public:
      */
     void reset();
     
+    /**
+     * @brief Start sampling the measured system load
+     *
+     * A background thread samples CPU and memory pressure, available memory
+     * and cgroup limits. The resulting load level refuses LOW, then NORMAL
+     * priority requests in canAllocate and isAdmitted, and scales the
+     * ParallelEngine queue limit for those priorities, so work is shed
+     * before the OOM killer or sample loss intervene. HIGH and CRITICAL
+     * requests are only limited by measured available memory.
+     * @param config Admission thresholds
+     * @return True if sampling started (false if already running)
+     */
+    bool startLoadSampling(const LoadAdmissionConfig& config = LoadAdmissionConfig());
+    
+    /**
+     * @brief Stop sampling and admit all priorities again
+     */
+    void stopLoadSampling();
+    
+    /**
+     * @brief Check if load sampling is running
+     * @return True if sampling
+     */
+    bool isLoadSampling() const;
+    
+    /**
+     * @brief Apply a load measurement
+     *
+     * Called by the sampling thread; may also be called directly to feed
+     * measurements from elsewhere. Uses the configuration of the last
+     * startLoadSampling call, or the defaults.
+     * @param load Measured load
+     */
+    void updateSystemLoad(const SystemLoad& load);
+    
+    /**
+     * @brief Get the last load measurement
+     * @return Measured load (valid is false before the first sample)
+     */
+    SystemLoad getSystemLoad() const;
+    
+    /**
+     * @brief Get the current load level (lock-free)
+     * @return Load level
+     */
+    LoadLevel getLoadLevel() const;
+    
+    /**
+     * @brief Check if the load level admits work of a priority (lock-free)
+     * @param priority Work priority
+     * @return True if admitted
+     */
+    bool isAdmitted(TaskPriority priority) const;
+    
+    /**
+     * @brief Get the queue limit multiplier for LOW and NORMAL work (lock-free)
+     * @return Multiplier between 0.0 and 1.0
+     */
+    double getQueueScale() const;
+    
 private:
     /**
      * @brief Private constructor for singleton
@@ -328,28 +496,91 @@ private:
      */
     bool tryPreemption(const ResourceRequest& request);
     
+    /**
+     * @brief Check if an allocation can be made; mutex_ must be held
+     * @param request Resource request
+     * @return True if allocation is possible
+     */
+    bool canAllocateLocked(const ResourceRequest& request) const;
+    
+    /**
+     * @brief Release allocated resources; mutex_ must be held
+     * @param allocationId Allocation ID to release
+     * @return True if resources were released
+     */
+    bool releaseAllocationLocked(const std::string& allocationId);
+    
+    /**
+     * @brief Check an amount against measured available memory
+     * @param type Resource type
+     * @param amount Requested amount
+     * @param priority Request priority (CRITICAL is not limited)
+     * @return True if the amount fits
+     */
+    bool fitsMeasuredLoad(ResourceType type, double amount, TaskPriority priority) const;
+    
+    /**
+     * @brief Build the usage statistics of a standard resource from its counters
+     * @param type Resource type
+     * @return Resource usage statistics
+     */
+    ResourceUsage getStandardUsage(ResourceType type) const;
+    
+    /**
+     * @brief Callback thread function
+     */
+    void callbackFunction();
+    
+    /**
+     * @brief Sampling thread function
+     */
+    void samplingFunction();
+    
     /**
      * @brief Update resource usage after allocation or release
      */
     void updateResourceUsage();
     
     /**
-     * @brief Notify allocation callbacks
+     * @brief Queue an allocation for the callback thread
      * @param allocation Allocation to notify about
      */
     void notifyAllocationCallbacks(const ResourceAllocation& allocation);
     
-    std::map<ResourceType, ResourceUsage> resources_;                  ///< Standard resources
+    struct Counters;
+    
+    std::map<ResourceType, ResourceUsage> resources_;                  ///< Standard resource units (amounts live in counters_)
+    std::unique_ptr<Counters> counters_;                               ///< Lock-free standard resource counters and reservations
     std::map<std::string, ResourceUsage> customResources_;             ///< Custom resources
     std::map<std::string, ResourceAllocation> activeAllocations_;      ///< Active allocations
     std::vector<ResourceRequest> pendingRequests_;                     ///< Pending requests
-    std::map<int, std::function<void(const ResourceAllocation&)>> allocationCallbacks_; ///< Allocation callbacks
+    std::map<int, std::function<void(const ResourceAllocation&)>> allocationCallbacks_; ///< Allocation callbacks; guarded by callbackMutex_
     
     std::atomic<int> nextCallbackId_;                               ///< Next callback ID
     std::atomic<bool> preemptionEnabled_;                           ///< Preemption flag
     
     mutable std::mutex mutex_;                                      ///< Mutex for thread safety
     std::condition_variable resourceAvailableCV_;                   ///< Condition variable for resource availability
+    std::atomic<size_t> resourceWaiters_;                           ///< Threads in waitForResources
+    
+    // Measured load
+    LoadAdmissionConfig loadConfig_;                                ///< Admission thresholds
+    SystemLoad systemLoad_;                                         ///< Last load measurement
+    std::atomic<int> loadLevel_;                                    ///< Current LoadLevel
+    std::atomic<double> queueScale_;                                ///< Queue limit multiplier for LOW/NORMAL
+    std::atomic<double> measuredMemoryMB_;                          ///< Allocatable measured memory (-1 = unknown)
+    std::thread samplingThread_;                                    ///< Load sampling thread
+    bool samplingActive_;                                           ///< Sampling thread running; guarded by loadMutex_
+    mutable std::mutex loadMutex_;                                  ///< Guards the measured load and configuration
+    std::condition_variable samplingCV_;                            ///< Wakes the sampling thread to stop
+    
+    // Asynchronous callbacks
+    std::deque<ResourceAllocation> callbackQueue_;                  ///< Allocations waiting to be notified
+    std::atomic<size_t> callbackCount_;                             ///< Registered callbacks, read without locking
+    std::thread callbackThread_;                                    ///< Callback thread, started by the first registration
+    bool callbackStopping_;                                         ///< Stop flag; guarded by callbackMutex_
+    std::mutex callbackMutex_;                                      ///< Guards callbacks and the callback queue
+    std::condition_variable callbackCV_;                            ///< Wakes the callback thread
 };
 
 } // namespace signal
@@ -0,0 +1,530 @@
+/**
+ * @file sample_conversion.cpp
+ * @brief Implementation of the sample conversion kernels
+ */
+
+#include "sample_conversion.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TDOA_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(TDOA_HAVE_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TDOA_HAVE_AVX 1
+#include <immintrin.h>
+#endif
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+constexpr float INT16_SCALE = 32767.0f;
+constexpr float INT8_SCALE = 127.0f;
+
+//-----------------------------------------------------------------------------
+// Scalar kernels, also used for the tails of the vector kernels
+//-----------------------------------------------------------------------------
+
+void int16ToFloatScalar(const int16_t* src, float* dst, size_t count) {
+    const float scale = 1.0f / INT16_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]) * scale;
+    }
+}
+
+void floatToInt16Scalar(const float* src, int16_t* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float value = std::max(-1.0f, std::min(1.0f, src[i]));
+        dst[i] = static_cast<int16_t>(value * INT16_SCALE);
+    }
+}
+
+void int8ToFloatScalar(const int8_t* src, float* dst, size_t count) {
+    const float scale = 1.0f / INT8_SCALE;
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<float>(src[i]) * scale;
+    }
+}
+
+void floatToInt8Scalar(const float* src, int8_t* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float value = std::max(-1.0f, std::min(1.0f, src[i]));
+        dst[i] = static_cast<int8_t>(value * INT8_SCALE);
+    }
+}
+
+void int16ToInt8Scalar(const int16_t* src, int8_t* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<int8_t>(src[i] >> 8);
+    }
+}
+
+void int8ToInt16Scalar(const int8_t* src, int16_t* dst, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        dst[i] = static_cast<int16_t>(static_cast<uint16_t>(static_cast<uint8_t>(src[i])) << 8);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// SSE2 kernels
+//-----------------------------------------------------------------------------
+
+#ifdef TDOA_HAVE_SSE2
+
+// Clamp to [-1, 1]; min returns its second operand for NaN, matching std::min(1.0f, x)
+inline __m128 clampUnitSse(__m128 value) {
+    return _mm_max_ps(_mm_min_ps(value, _mm_set1_ps(1.0f)), _mm_set1_ps(-1.0f));
+}
+
+void int16ToFloatSse2(const int16_t* src, float* dst, size_t count) {
+    const __m128 scale = _mm_set1_ps(1.0f / INT16_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+void floatToInt16Sse2(const float* src, int16_t* dst, size_t count) {
+    const __m128 scale = _mm_set1_ps(INT16_SCALE);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i a = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i)), scale));
+        __m128i b = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i + 4)), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(a, b));
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+void int8ToFloatSse2(const int8_t* src, float* dst, size_t count) {
+    const __m128 scale = _mm_set1_ps(1.0f / INT8_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo16 = _mm_unpacklo_epi8(in, in);
+        __m128i hi16 = _mm_unpackhi_epi8(in, in);
+        __m128i words[4] = {
+            _mm_srai_epi32(_mm_unpacklo_epi16(lo16, lo16), 24),
+            _mm_srai_epi32(_mm_unpackhi_epi16(lo16, lo16), 24),
+            _mm_srai_epi32(_mm_unpacklo_epi16(hi16, hi16), 24),
+            _mm_srai_epi32(_mm_unpackhi_epi16(hi16, hi16), 24)
+        };
+        for (int k = 0; k < 4; k++) {
+            _mm_storeu_ps(dst + i + 4 * k, _mm_mul_ps(_mm_cvtepi32_ps(words[k]), scale));
+        }
+    }
+    int8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+void floatToInt8Sse2(const float* src, int8_t* dst, size_t count) {
+    const __m128 scale = _mm_set1_ps(INT8_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i)), scale));
+        __m128i b = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i + 4)), scale));
+        __m128i c = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i + 8)), scale));
+        __m128i d = _mm_cvttps_epi32(_mm_mul_ps(clampUnitSse(_mm_loadu_ps(src + i + 12)), scale));
+        __m128i packed = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+    floatToInt8Scalar(src + i, dst + i, count - i);
+}
+
+void int16ToInt8Sse2(const int16_t* src, int8_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i a = _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), 8);
+        __m128i b = _mm_srai_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi16(a, b));
+    }
+    int16ToInt8Scalar(src + i, dst + i, count - i);
+}
+
+void int8ToInt16Sse2(const int8_t* src, int16_t* dst, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // Interleaving zero below each byte places it in the high byte of a word
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(zero, in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(zero, in));
+    }
+    int8ToInt16Scalar(src + i, dst + i, count - i);
+}
+
+#endif // TDOA_HAVE_SSE2
+
+//-----------------------------------------------------------------------------
+// AVX2 kernels
+//-----------------------------------------------------------------------------
+
+#ifdef TDOA_HAVE_AVX
+
+#define TDOA_TARGET_AVX2 __attribute__((target("avx2")))
+#define TDOA_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+TDOA_TARGET_AVX2 inline __m256 clampUnitAvx2(__m256 value) {
+    return _mm256_max_ps(_mm256_min_ps(value, _mm256_set1_ps(1.0f)), _mm256_set1_ps(-1.0f));
+}
+
+TDOA_TARGET_AVX2 void int16ToFloatAvx2(const int16_t* src, float* dst, size_t count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / INT16_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(lo)), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(hi)), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX2 void floatToInt16Avx2(const float* src, int16_t* dst, size_t count) {
+    const __m256 scale = _mm256_set1_ps(INT16_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i a = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i)), scale));
+        __m256i b = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i + 8)), scale));
+        // Packing works per 128-bit lane; restore the order of the 64-bit groups
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX2 void int8ToFloatAvx2(const int8_t* src, float* dst, size_t count) {
+    const __m256 scale = _mm256_set1_ps(1.0f / INT8_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m256i lo = _mm256_cvtepi8_epi32(in);
+        __m256i hi = _mm256_cvtepi8_epi32(_mm_srli_si128(in, 8));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+        _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+    }
+    int8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX2 void floatToInt8Avx2(const float* src, int8_t* dst, size_t count) {
+    const __m256 scale = _mm256_set1_ps(INT8_SCALE);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i a = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i)), scale));
+        __m256i b = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i + 8)), scale));
+        __m256i c = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i + 16)), scale));
+        __m256i d = _mm256_cvttps_epi32(_mm256_mul_ps(clampUnitAvx2(_mm256_loadu_ps(src + i + 24)), scale));
+        __m256i packed = _mm256_packs_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+        packed = _mm256_permutevar8x32_epi32(packed, order);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    floatToInt8Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX2 void int16ToInt8Avx2(const int16_t* src, int8_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i a = _mm256_srai_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), 8);
+        __m256i b = _mm256_srai_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16)), 8);
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+    }
+    int16ToInt8Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX2 void int8ToInt16Avx2(const int8_t* src, int16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256i in = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_slli_epi16(in, 8));
+    }
+    int8ToInt16Scalar(src + i, dst + i, count - i);
+}
+
+//-----------------------------------------------------------------------------
+// AVX-512 kernels
+//-----------------------------------------------------------------------------
+
+// GCC 12's AVX-512 intrinsics start from _mm512_undefined_* vectors, which
+// -Wmaybe-uninitialized reports as "__Y may be used uninitialized" once inlined
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+TDOA_TARGET_AVX512 inline __m512 clampUnitAvx512(__m512 value) {
+    return _mm512_max_ps(_mm512_min_ps(value, _mm512_set1_ps(1.0f)), _mm512_set1_ps(-1.0f));
+}
+
+TDOA_TARGET_AVX512 void int16ToFloatAvx512(const int16_t* src, float* dst, size_t count) {
+    const __m512 scale = _mm512_set1_ps(1.0f / INT16_SCALE);
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(lo)), scale));
+        _mm512_storeu_ps(dst + i + 16, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(hi)), scale));
+    }
+    int16ToFloatScalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX512 void floatToInt16Avx512(const float* src, int16_t* dst, size_t count) {
+    const __m512 scale = _mm512_set1_ps(INT16_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = _mm512_cvttps_epi32(_mm512_mul_ps(clampUnitAvx512(_mm512_loadu_ps(src + i)), scale));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_cvtsepi32_epi16(value));
+    }
+    floatToInt16Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX512 void int8ToFloatAvx512(const int8_t* src, float* dst, size_t count) {
+    const __m512 scale = _mm512_set1_ps(1.0f / INT8_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = _mm512_cvtepi8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        _mm512_storeu_ps(dst + i, _mm512_mul_ps(_mm512_cvtepi32_ps(value), scale));
+    }
+    int8ToFloatScalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX512 void floatToInt8Avx512(const float* src, int8_t* dst, size_t count) {
+    const __m512 scale = _mm512_set1_ps(INT8_SCALE);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i value = _mm512_cvttps_epi32(_mm512_mul_ps(clampUnitAvx512(_mm512_loadu_ps(src + i)), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm512_cvtsepi32_epi8(value));
+    }
+    floatToInt8Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX512 void int16ToInt8Avx512(const int16_t* src, int8_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m512i value = _mm512_srai_epi16(_mm512_loadu_si512(src + i), 8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_cvtsepi16_epi8(value));
+    }
+    int16ToInt8Scalar(src + i, dst + i, count - i);
+}
+
+TDOA_TARGET_AVX512 void int8ToInt16Avx512(const int8_t* src, int16_t* dst, size_t count) {
+    size_t i = 0;
+    for (; i + 32 <= count; i += 32) {
+        __m512i value = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        _mm512_storeu_si512(dst + i, _mm512_slli_epi16(value, 8));
+    }
+    int8ToInt16Scalar(src + i, dst + i, count - i);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif // TDOA_HAVE_AVX
+
+//-----------------------------------------------------------------------------
+// Dispatch
+//-----------------------------------------------------------------------------
+
+struct KernelTable {
+    SimdLevel level;
+    void (*int16ToFloat)(const int16_t*, float*, size_t);
+    void (*floatToInt16)(const float*, int16_t*, size_t);
+    void (*int8ToFloat)(const int8_t*, float*, size_t);
+    void (*floatToInt8)(const float*, int8_t*, size_t);
+    void (*int16ToInt8)(const int16_t*, int8_t*, size_t);
+    void (*int8ToInt16)(const int8_t*, int16_t*, size_t);
+};
+
+const KernelTable SCALAR_KERNELS = {
+    SimdLevel::Scalar,
+    int16ToFloatScalar, floatToInt16Scalar, int8ToFloatScalar,
+    floatToInt8Scalar, int16ToInt8Scalar, int8ToInt16Scalar
+};
+
+#ifdef TDOA_HAVE_SSE2
+const KernelTable SSE2_KERNELS = {
+    SimdLevel::SSE2,
+    int16ToFloatSse2, floatToInt16Sse2, int8ToFloatSse2,
+    floatToInt8Sse2, int16ToInt8Sse2, int8ToInt16Sse2
+};
+#endif
+
+#ifdef TDOA_HAVE_AVX
+const KernelTable AVX2_KERNELS = {
+    SimdLevel::AVX2,
+    int16ToFloatAvx2, floatToInt16Avx2, int8ToFloatAvx2,
+    floatToInt8Avx2, int16ToInt8Avx2, int8ToInt16Avx2
+};
+
+const KernelTable AVX512_KERNELS = {
+    SimdLevel::AVX512,
+    int16ToFloatAvx512, floatToInt16Avx512, int8ToFloatAvx512,
+    floatToInt8Avx512, int16ToInt8Avx512, int8ToInt16Avx512
+};
+#endif
+
+// Best level supported by both this build and the CPU
+SimdLevel detectSimdLevel() {
+#ifdef TDOA_HAVE_AVX
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+#ifdef TDOA_HAVE_SSE2
+    return SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+const KernelTable* kernelsFor(SimdLevel level) {
+    switch (level) {
+#ifdef TDOA_HAVE_AVX
+        case SimdLevel::AVX512:
+            return &AVX512_KERNELS;
+        case SimdLevel::AVX2:
+            return &AVX2_KERNELS;
+#endif
+#ifdef TDOA_HAVE_SSE2
+        case SimdLevel::SSE2:
+            return &SSE2_KERNELS;
+#endif
+        default:
+            return &SCALAR_KERNELS;
+    }
+}
+
+SimdLevel detectedSimdLevel() {
+    static const SimdLevel detected = detectSimdLevel();
+    return detected;
+}
+
+std::atomic<const KernelTable*>& activeKernels() {
+    static std::atomic<const KernelTable*> active(kernelsFor(detectedSimdLevel()));
+    return active;
+}
+
+inline const KernelTable& kernels() {
+    return *activeKernels().load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+// Convert SimdLevel to string
+std::string simdLevelToString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar:
+            return "Scalar";
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::AVX512:
+            return "AVX512";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+// Get the active SIMD level
+SimdLevel getSimdLevel() {
+    return kernels().level;
+}
+
+// Cap the SIMD level
+SimdLevel setSimdLevelLimit(SimdLevel level) {
+    SimdLevel effective = std::min(level, detectedSimdLevel());
+    activeKernels().store(kernelsFor(effective), std::memory_order_relaxed);
+    return effective;
+}
+
+void convertInt16ToFloat(const int16_t* src, float* dst, size_t count) {
+    kernels().int16ToFloat(src, dst, count);
+}
+
+void convertFloatToInt16(const float* src, int16_t* dst, size_t count) {
+    kernels().floatToInt16(src, dst, count);
+}
+
+void convertInt8ToFloat(const int8_t* src, float* dst, size_t count) {
+    kernels().int8ToFloat(src, dst, count);
+}
+
+void convertFloatToInt8(const float* src, int8_t* dst, size_t count) {
+    kernels().floatToInt8(src, dst, count);
+}
+
+void convertInt16ToInt8(const int16_t* src, int8_t* dst, size_t count) {
+    kernels().int16ToInt8(src, dst, count);
+}
+
+void convertInt8ToInt16(const int8_t* src, int16_t* dst, size_t count) {
+    kernels().int8ToInt16(src, dst, count);
+}
+
+// Get the size of one sample in bytes
+size_t getSampleSize(DataFormat format) {
+    switch (format) {
+        case DataFormat::ComplexFloat32:
+            return sizeof(std::complex<float>);
+        case DataFormat::ComplexInt16:
+            return sizeof(std::complex<int16_t>);
+        case DataFormat::ComplexInt8:
+            return sizeof(std::complex<int8_t>);
+        case DataFormat::Raw:
+        default:
+            return 1;
+    }
+}
+
+// Convert samples into a caller-provided buffer
+bool convertSamples(const void* src, DataFormat srcFormat, void* dst, DataFormat dstFormat, size_t sampleCount) {
+    if (sampleCount == 0) {
+        return true;
+    }
+
+    // Identical formats and anything involving Raw are byte copies
+    if (srcFormat == dstFormat || srcFormat == DataFormat::Raw || dstFormat == DataFormat::Raw) {
+        size_t bytes = sampleCount * std::min(getSampleSize(srcFormat), getSampleSize(dstFormat));
+        if (src != dst) {
+            std::memcpy(dst, src, bytes);
+        }
+        return true;
+    }
+
+    const size_t count = sampleCount * 2;  // I and Q components
+    const KernelTable& table = kernels();
+    if (srcFormat == DataFormat::ComplexInt16 && dstFormat == DataFormat::ComplexFloat32) {
+        table.int16ToFloat(static_cast<const int16_t*>(src), static_cast<float*>(dst), count);
+    } else if (srcFormat == DataFormat::ComplexFloat32 && dstFormat == DataFormat::ComplexInt16) {
+        table.floatToInt16(static_cast<const float*>(src), static_cast<int16_t*>(dst), count);
+    } else if (srcFormat == DataFormat::ComplexInt8 && dstFormat == DataFormat::ComplexFloat32) {
+        table.int8ToFloat(static_cast<const int8_t*>(src), static_cast<float*>(dst), count);
+    } else if (srcFormat == DataFormat::ComplexFloat32 && dstFormat == DataFormat::ComplexInt8) {
+        table.floatToInt8(static_cast<const float*>(src), static_cast<int8_t*>(dst), count);
+    } else if (srcFormat == DataFormat::ComplexInt16 && dstFormat == DataFormat::ComplexInt8) {
+        table.int16ToInt8(static_cast<const int16_t*>(src), static_cast<int8_t*>(dst), count);
+    } else if (srcFormat == DataFormat::ComplexInt8 && dstFormat == DataFormat::ComplexInt16) {
+        table.int8ToInt16(static_cast<const int8_t*>(src), static_cast<int16_t*>(dst), count);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace signal
+} // namespace tdoa
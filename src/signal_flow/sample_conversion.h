@@ -0,0 +1,110 @@
+/**
+ * @file sample_conversion.h
+ * @brief Vectorized conversion kernels between I/Q sample formats
+ */
+
+#pragma once
+
+#include "signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Instruction set used by the conversion kernels
+ */
+enum class SimdLevel {
+    Scalar,     ///< Portable C++ loops
+    SSE2,       ///< 128-bit SSE2
+    AVX2,       ///< 256-bit AVX2
+    AVX512      ///< 512-bit AVX-512 (F and BW)
+};
+
+/**
+ * @brief Convert SimdLevel to string
+ * @param level SimdLevel to convert
+ * @return String representation
+ */
+std::string simdLevelToString(SimdLevel level);
+
+/**
+ * @brief Get the instruction set the kernels currently dispatch to
+ *
+ * Detected once from the CPU at first use, and capped by setSimdLevelLimit.
+ * AVX2 and AVX-512 kernels are only built with GCC or Clang on x86.
+ * @return Active SIMD level
+ */
+SimdLevel getSimdLevel();
+
+/**
+ * @brief Cap the instruction set used by the kernels (for testing and benchmarks)
+ * @param level Highest level to use; the CPU's best level is used if it is lower
+ * @return Active SIMD level after the change
+ */
+SimdLevel setSimdLevelLimit(SimdLevel level);
+
+/**
+ * @brief Convert int16 components to float, scaling by 1/32767
+ * @param src Source components (I and Q interleaved)
+ * @param dst Destination components
+ * @param count Number of components (twice the complex sample count)
+ */
+void convertInt16ToFloat(const int16_t* src, float* dst, size_t count);
+
+/**
+ * @brief Convert float components to int16, saturating to [-1.0, 1.0] and scaling by 32767
+ *
+ * Scaled values are truncated toward zero; NaN converts to full scale.
+ */
+void convertFloatToInt16(const float* src, int16_t* dst, size_t count);
+
+/**
+ * @brief Convert int8 components to float, scaling by 1/127
+ */
+void convertInt8ToFloat(const int8_t* src, float* dst, size_t count);
+
+/**
+ * @brief Convert float components to int8, saturating to [-1.0, 1.0] and scaling by 127
+ *
+ * Scaled values are truncated toward zero; NaN converts to full scale.
+ */
+void convertFloatToInt8(const float* src, int8_t* dst, size_t count);
+
+/**
+ * @brief Convert int16 components to int8 by keeping the high byte
+ */
+void convertInt16ToInt8(const int16_t* src, int8_t* dst, size_t count);
+
+/**
+ * @brief Convert int8 components to int16 by shifting into the high byte
+ */
+void convertInt8ToInt16(const int8_t* src, int16_t* dst, size_t count);
+
+/**
+ * @brief Get the size of one sample in bytes
+ * @param format Data format
+ * @return Bytes per complex sample (1 for Raw, whose samples are bytes)
+ */
+size_t getSampleSize(DataFormat format);
+
+/**
+ * @brief Convert samples between formats into a caller-provided buffer
+ *
+ * Lets ingest paths convert straight from a device buffer into a signal's
+ * storage in one pass. Conversions to or from Raw copy bytes, truncated to
+ * the smaller of the two buffers. Source and destination must not overlap
+ * unless the formats are equal and the buffers are identical.
+ * @param src Source samples
+ * @param srcFormat Source data format
+ * @param dst Destination buffer, large enough for sampleCount samples of dstFormat
+ * @param dstFormat Destination data format
+ * @param sampleCount Number of complex samples (bytes for Raw)
+ * @return True if the conversion is supported
+ */
+bool convertSamples(const void* src, DataFormat srcFormat, void* dst, DataFormat dstFormat, size_t sampleCount);
+
+} // namespace signal
+} // namespace tdoa
@@ -0,0 +1,877 @@
+/**
+ * @file scenario_generator.cpp
+ * @brief Implementation of the synthetic multi-node scenario generator
+ */
+
+#include "scenario_generator.h"
+#include "signal_factory.h"
+#include "sample_conversion.h"
+#include "buffer_pool.h"
+#include "parallel_engine.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <iostream>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TDOA_HAVE_AVX 1
+#define TDOA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+#if defined(__GNUC__)
+#define TDOA_ALWAYS_INLINE __attribute__((always_inline)) inline
+#else
+#define TDOA_ALWAYS_INLINE inline
+#endif
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+constexpr double SPEED_OF_LIGHT = 299792458.0;  // m/s
+constexpr double TWO_PI = 2.0 * M_PI;
+
+constexpr size_t BLOCK = 256;           ///< Samples per kernel call and per delay/phase update
+constexpr size_t LANES = 8;             ///< Independent phasor recurrences per block
+constexpr int DELAY_TAPS = 16;          ///< Fractional-delay filter length
+constexpr int DELAY_LEAD = 7;           ///< Taps before the interpolated sample
+constexpr int DELAY_PHASES = 256;       ///< Fractional-delay table resolution (interpolated)
+constexpr int SHAPING_TAPS = 31;        ///< Noise waveform low-pass filter length
+constexpr int SHAPING_LEAD = SHAPING_TAPS / 2;
+
+size_t roundUpToBlock(size_t count) {
+    return (count + BLOCK - 1) / BLOCK * BLOCK;
+}
+
+uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+//-----------------------------------------------------------------------------
+// Block kernels
+//
+// Every kernel processes exactly BLOCK samples so the loops have a fixed trip
+// count and vectorize at -O2. The bodies are compiled twice, for the baseline
+// ISA and for AVX2 with FMA, and picked at run time.
+//-----------------------------------------------------------------------------
+
+TDOA_ALWAYS_INLINE uint32_t mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x85EBCA6Bu;
+    x ^= x >> 13;
+    x *= 0xC2B2AE35u;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Natural logarithm of a positive, finite, normal float
+ *
+ * Branch-free Cephes logf (about 1 ulp), so loops calling it vectorize.
+ */
+TDOA_ALWAYS_INLINE float logPositive(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 126);
+    // 1 if the mantissa is below sqrt(0.5), from the sign of the difference:
+    // GCC does not if-convert a compare-and-select here, which blocks vectorization
+    const float low = static_cast<float>(static_cast<int32_t>(((bits & 0x007FFFFFu) - 0x003504F3u) >> 31));
+    bits = (bits & 0x007FFFFFu) | 0x3F000000u;     // Mantissa in [0.5, 1)
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    exponent -= low;
+    const float x = m * (1.0f + low) - 1.0f;        // m + m - 1 or m - 1, both exact
+    const float z = x * x;
+    float y = 7.0376836292e-2f;
+    y = y * x - 1.1514610310e-1f;
+    y = y * x + 1.1676998740e-1f;
+    y = y * x - 1.2420140846e-1f;
+    y = y * x + 1.4249322787e-1f;
+    y = y * x - 1.6668057665e-1f;
+    y = y * x + 2.0000714765e-1f;
+    y = y * x - 2.4999993993e-1f;
+    y = y * x + 3.3333331174e-1f;
+    y = y * x * z - 2.12194440e-4f * exponent - 0.5f * z;
+    return x + y + 0.693359375f * exponent;
+}
+
+/**
+ * @brief Complex Gaussian noise from a counter-based hash
+ *
+ * Box-Muller with polynomial log/sin/cos so the loop vectorizes (the sqrt
+ * needs -fno-math-errno): two hashes per sample give a radius from 24 bits
+ * and an angle from 26 bits. The
+ * smallest radius uniform is 2^-24, so the magnitude is bounded at
+ * sqrt(48 ln 2) = 5.77 sigma per component (the missing tail has
+ * probability 6e-8); between those bounds the components are Gaussian to
+ * float precision.
+ */
+TDOA_ALWAYS_INLINE void noiseBody(uint32_t key, uint32_t counter, float factor,
+                                  float* __restrict outI, float* __restrict outQ) {
+    const float HALF_PI = 1.57079632679f;
+    for (uint32_t j = 0; j < BLOCK; j++) {
+        uint32_t c = counter + j * 2;
+        uint32_t h0 = mix32(c ^ key);
+        uint32_t h1 = mix32((c + 1) ^ key);
+
+        // Radius from a uniform in (0, 1]
+        float u = static_cast<float>(static_cast<int32_t>((h0 >> 8) + 1)) * (1.0f / 16777216.0f);
+        float r = std::sqrt(-2.0f * logPositive(u)) * factor;
+
+        // Angle: a quadrant from the top two bits, an offset in [-pi/4, pi/4) from 24 more
+        uint32_t quadrant = h1 >> 30;
+        float a = (static_cast<float>(static_cast<int32_t>(h1 & 0x00FFFFFFu)) * (1.0f / 16777216.0f) - 0.5f) * HALF_PI;
+        float z = a * a;
+        float sinA = a + a * z * (-1.6666654611e-1f + z * (8.3321608736e-3f + z * -1.9515295891e-4f));
+        float cosA = 1.0f - 0.5f * z + z * z * (4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f));
+
+        // Rotate by quadrant * pi / 2
+        float cosQ = (quadrant & 1) ? -sinA : cosA;
+        float sinQ = (quadrant & 1) ? cosA : sinA;
+        cosQ = (quadrant & 2) ? -cosQ : cosQ;
+        sinQ = (quadrant & 2) ? -sinQ : sinQ;
+
+        outI[j] = r * cosQ;
+        outQ[j] = r * sinQ;
+    }
+}
+
+/**
+ * @brief Real-tap FIR on complex samples: out[j] = sum_k taps[k] src[j + k]
+ */
+template <int TAPS>
+TDOA_ALWAYS_INLINE void firBody(const float* __restrict taps,
+                                const float* __restrict srcI, const float* __restrict srcQ,
+                                float* __restrict outI, float* __restrict outQ) {
+    for (size_t j = 0; j < BLOCK; j++) {
+        float sumI = 0.0f;
+        float sumQ = 0.0f;
+#pragma GCC unroll 32
+        for (int k = 0; k < TAPS; k++) {
+            sumI += taps[k] * srcI[j + k];
+            sumQ += taps[k] * srcQ[j + k];
+        }
+        outI[j] = sumI;
+        outQ[j] = sumQ;
+    }
+}
+
+/**
+ * @brief Phasors from LANES interleaved recurrences
+ *
+ * lanes holds LANES starting phasors (I then Q) followed by LANES per-lane
+ * rotations (I then Q). Each lane advances LANES samples at a time, and its
+ * rotation is itself multiplied by step, which gives a quadratic phase for chirps.
+ */
+TDOA_ALWAYS_INLINE void phasorBody(const float* __restrict lanes, float stepI, float stepQ,
+                                   float* __restrict outI, float* __restrict outQ,
+                                   float* __restrict rotI, float* __restrict rotQ) {
+    for (size_t l = 0; l < LANES; l++) {
+        outI[l] = lanes[l];
+        outQ[l] = lanes[LANES + l];
+        rotI[l] = lanes[2 * LANES + l];
+        rotQ[l] = lanes[3 * LANES + l];
+    }
+    for (size_t k = 0; k < BLOCK - LANES; k++) {
+        outI[k + LANES] = outI[k] * rotI[k] - outQ[k] * rotQ[k];
+        outQ[k + LANES] = outI[k] * rotQ[k] + outQ[k] * rotI[k];
+        rotI[k + LANES] = rotI[k] * stepI - rotQ[k] * stepQ;
+        rotQ[k + LANES] = rotI[k] * stepQ + rotQ[k] * stepI;
+    }
+}
+
+/**
+ * @brief acc += x * phasor
+ */
+TDOA_ALWAYS_INLINE void mixBody(const float* __restrict xI, const float* __restrict xQ,
+                                const float* __restrict pI, const float* __restrict pQ,
+                                float* __restrict accI, float* __restrict accQ) {
+    for (size_t j = 0; j < BLOCK; j++) {
+        accI[j] += xI[j] * pI[j] - xQ[j] * pQ[j];
+        accQ[j] += xI[j] * pQ[j] + xQ[j] * pI[j];
+    }
+}
+
+/**
+ * @brief x *= phasor
+ */
+TDOA_ALWAYS_INLINE void rotateBody(float* __restrict xI, float* __restrict xQ,
+                                   const float* __restrict pI, const float* __restrict pQ) {
+    for (size_t j = 0; j < BLOCK; j++) {
+        float re = xI[j] * pI[j] - xQ[j] * pQ[j];
+        float im = xI[j] * pQ[j] + xQ[j] * pI[j];
+        xI[j] = re;
+        xQ[j] = im;
+    }
+}
+
+TDOA_ALWAYS_INLINE void interleaveBody(const float* __restrict srcI, const float* __restrict srcQ,
+                                       float* __restrict out) {
+    for (size_t j = 0; j < BLOCK; j++) {
+        out[2 * j] = srcI[j];
+        out[2 * j + 1] = srcQ[j];
+    }
+}
+
+void noiseGeneric(uint32_t key, uint32_t counter, float factor, float* outI, float* outQ) {
+    noiseBody(key, counter, factor, outI, outQ);
+}
+
+void delayFilterGeneric(const float* taps, const float* srcI, const float* srcQ, float* outI, float* outQ) {
+    firBody<DELAY_TAPS>(taps, srcI, srcQ, outI, outQ);
+}
+
+void shapingFilterGeneric(const float* taps, const float* srcI, const float* srcQ, float* outI, float* outQ) {
+    firBody<SHAPING_TAPS>(taps, srcI, srcQ, outI, outQ);
+}
+
+void phasorsGeneric(const float* lanes, float stepI, float stepQ, float* outI, float* outQ, float* rotI, float* rotQ) {
+    phasorBody(lanes, stepI, stepQ, outI, outQ, rotI, rotQ);
+}
+
+void mixGeneric(const float* xI, const float* xQ, const float* pI, const float* pQ, float* accI, float* accQ) {
+    mixBody(xI, xQ, pI, pQ, accI, accQ);
+}
+
+void rotateGeneric(float* xI, float* xQ, const float* pI, const float* pQ) {
+    rotateBody(xI, xQ, pI, pQ);
+}
+
+void interleaveGeneric(const float* srcI, const float* srcQ, float* out) {
+    interleaveBody(srcI, srcQ, out);
+}
+
+#ifdef TDOA_HAVE_AVX
+
+TDOA_TARGET_AVX2 void noiseAvx2(uint32_t key, uint32_t counter, float factor, float* outI, float* outQ) {
+    noiseBody(key, counter, factor, outI, outQ);
+}
+
+TDOA_TARGET_AVX2 void delayFilterAvx2(const float* taps, const float* srcI, const float* srcQ, float* outI, float* outQ) {
+    firBody<DELAY_TAPS>(taps, srcI, srcQ, outI, outQ);
+}
+
+TDOA_TARGET_AVX2 void shapingFilterAvx2(const float* taps, const float* srcI, const float* srcQ, float* outI, float* outQ) {
+    firBody<SHAPING_TAPS>(taps, srcI, srcQ, outI, outQ);
+}
+
+TDOA_TARGET_AVX2 void phasorsAvx2(const float* lanes, float stepI, float stepQ, float* outI, float* outQ, float* rotI, float* rotQ) {
+    phasorBody(lanes, stepI, stepQ, outI, outQ, rotI, rotQ);
+}
+
+TDOA_TARGET_AVX2 void mixAvx2(const float* xI, const float* xQ, const float* pI, const float* pQ, float* accI, float* accQ) {
+    mixBody(xI, xQ, pI, pQ, accI, accQ);
+}
+
+TDOA_TARGET_AVX2 void rotateAvx2(float* xI, float* xQ, const float* pI, const float* pQ) {
+    rotateBody(xI, xQ, pI, pQ);
+}
+
+TDOA_TARGET_AVX2 void interleaveAvx2(const float* srcI, const float* srcQ, float* out) {
+    interleaveBody(srcI, srcQ, out);
+}
+
+#endif // TDOA_HAVE_AVX
+
+struct ScenarioKernels {
+    void (*noise)(uint32_t, uint32_t, float, float*, float*);
+    void (*delayFilter)(const float*, const float*, const float*, float*, float*);
+    void (*shapingFilter)(const float*, const float*, const float*, float*, float*);
+    void (*phasors)(const float*, float, float, float*, float*, float*, float*);
+    void (*mix)(const float*, const float*, const float*, const float*, float*, float*);
+    void (*rotate)(float*, float*, const float*, const float*);
+    void (*interleave)(const float*, const float*, float*);
+};
+
+const ScenarioKernels GENERIC_KERNELS = {
+    noiseGeneric, delayFilterGeneric, shapingFilterGeneric, phasorsGeneric,
+    mixGeneric, rotateGeneric, interleaveGeneric
+};
+
+#ifdef TDOA_HAVE_AVX
+const ScenarioKernels AVX2_KERNELS = {
+    noiseAvx2, delayFilterAvx2, shapingFilterAvx2, phasorsAvx2,
+    mixAvx2, rotateAvx2, interleaveAvx2
+};
+#endif
+
+/**
+ * @brief Kernels for the active SIMD level (shares the sample conversion limit)
+ */
+const ScenarioKernels& kernels() {
+#ifdef TDOA_HAVE_AVX
+    if (getSimdLevel() >= SimdLevel::AVX2) {
+        return AVX2_KERNELS;
+    }
+#endif
+    return GENERIC_KERNELS;
+}
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+/**
+ * @brief Complex Gaussian noise for sample indices [start, start + count) of a stream
+ *
+ * Counter-based, so any range can be regenerated independently of the rest.
+ * @param count Number of samples, a multiple of BLOCK
+ * @param scale Standard deviation of each component
+ */
+void gaussianNoise(uint64_t stream, int64_t start, size_t count, float scale, float* outI, float* outQ) {
+    const ScenarioKernels& k = kernels();
+    const uint64_t EPOCH = 1ULL << 31;   // Samples per key; the 32-bit counter holds 2 per sample
+    float spliceI[BLOCK];
+    float spliceQ[BLOCK];
+    for (size_t j = 0; j < count; j += BLOCK) {
+        uint64_t index = static_cast<uint64_t>(start) + j;
+        uint64_t epoch = index / EPOCH;
+        uint64_t offset = index % EPOCH;
+        uint32_t counter = static_cast<uint32_t>(offset * 2);
+        k.noise(static_cast<uint32_t>(splitMix64(stream ^ splitMix64(epoch))), counter, scale, outI + j, outQ + j);
+        if (offset + BLOCK > EPOCH) {
+            // Samples past the epoch boundary use the next key; the counter wraps to their offset
+            size_t split = static_cast<size_t>(EPOCH - offset);
+            k.noise(static_cast<uint32_t>(splitMix64(stream ^ splitMix64(epoch + 1))), counter, scale, spliceI, spliceQ);
+            std::copy(spliceI + split, spliceI + BLOCK, outI + j + split);
+            std::copy(spliceQ + split, spliceQ + BLOCK, outQ + j + split);
+        }
+    }
+}
+
+/**
+ * @brief Windowed-sinc fractional-delay taps
+ *
+ * y[j] = sum_k h[k] x[j + k - DELAY_LEAD] interpolates x at j + mu.
+ */
+void computeDelayTaps(double mu, float* taps) {
+    double sinPiMu = std::sin(M_PI * mu);
+    double values[DELAY_TAPS];
+    double sum = 0.0;
+    for (int k = 0; k < DELAY_TAPS; k++) {
+        double u = static_cast<double>(k - DELAY_LEAD) - mu;
+        double sinc = std::fabs(u) < 1e-9 ? 1.0
+            : (((k - DELAY_LEAD) & 1) ? sinPiMu : -sinPiMu) / (M_PI * u);
+        double window = 0.42 + 0.5 * std::cos(M_PI * u / 8.0) + 0.08 * std::cos(2.0 * M_PI * u / 8.0);
+        values[k] = sinc * window;
+        sum += values[k];
+    }
+    for (int k = 0; k < DELAY_TAPS; k++) {
+        taps[k] = static_cast<float>(values[k] / sum);
+    }
+}
+
+/**
+ * @brief Fractional-delay taps interpolated from a table computed once
+ */
+void delayTaps(double mu, float* taps) {
+    static const std::vector<float> table = [] {
+        std::vector<float> rows((DELAY_PHASES + 1) * DELAY_TAPS);
+        for (int p = 0; p <= DELAY_PHASES; p++) {
+            computeDelayTaps(static_cast<double>(p) / DELAY_PHASES, rows.data() + p * DELAY_TAPS);
+        }
+        return rows;
+    }();
+    double position = mu * DELAY_PHASES;
+    int row = std::min(static_cast<int>(position), DELAY_PHASES - 1);
+    float weight = static_cast<float>(position - row);
+    const float* lower = table.data() + row * DELAY_TAPS;
+    const float* upper = lower + DELAY_TAPS;
+    for (int k = 0; k < DELAY_TAPS; k++) {
+        taps[k] = lower[k] + weight * (upper[k] - lower[k]);
+    }
+}
+
+/**
+ * @brief Fill the lane seeds for a phase that starts at phase0 and advances by
+ *        step0, step0 * curve, step0 * curve^2, ... per sample
+ * @return Rotation applied to each lane's rotation every LANES samples (curve^(LANES^2))
+ */
+std::complex<double> phasorLanes(std::complex<double> start, std::complex<double> step,
+                                 std::complex<double> curve, float* lanes) {
+    std::complex<double> phasor = start;
+    std::complex<double> laneRotation(1.0, 0.0);
+    std::complex<double> rotation = step;
+    for (size_t l = 0; l < LANES; l++) {
+        lanes[l] = static_cast<float>(phasor.real());
+        lanes[LANES + l] = static_cast<float>(phasor.imag());
+        phasor *= rotation;
+        laneRotation *= rotation;
+        rotation *= curve;
+    }
+    // laneRotation is the product of the first LANES steps; each later lane's is curve^LANES times the previous
+    std::complex<double> curveLanes = std::pow(curve, static_cast<double>(LANES));
+    for (size_t l = 0; l < LANES; l++) {
+        lanes[2 * LANES + l] = static_cast<float>(laneRotation.real());
+        lanes[3 * LANES + l] = static_cast<float>(laneRotation.imag());
+        laneRotation *= curveLanes;
+    }
+    return std::pow(curveLanes, static_cast<double>(LANES));
+}
+
+/**
+ * @brief Per-thread scratch buffers, reused across blocks
+ */
+struct Scratch {
+    std::vector<float> i;
+    std::vector<float> q;
+    float blockI[BLOCK];
+    float blockQ[BLOCK];
+    float phasorI[BLOCK];
+    float phasorQ[BLOCK];
+    float rotationI[BLOCK];
+    float rotationQ[BLOCK];
+
+    void reserve(size_t count) {
+        if (i.size() < count) {
+            i.resize(count);
+            q.resize(count);
+        }
+    }
+};
+
+Scratch& scratch() {
+    thread_local Scratch instance;
+    return instance;
+}
+
+/**
+ * @brief Run function(0) .. function(count - 1) on the ParallelEngine, one index per chunk
+ */
+template <typename Function>
+void runParallel(size_t count, const Function& function) {
+    ParallelEngine::getInstance().parallelFor(0, count, [&function](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            function(i);
+        }
+    }, 1);
+}
+
+utils::EnuPosition positionAt(const utils::EnuPosition& position, const utils::EnuPosition& velocity, double elapsed) {
+    return utils::EnuPosition(position.east + velocity.east * elapsed,
+                              position.north + velocity.north * elapsed,
+                              position.up + velocity.up * elapsed);
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// ScenarioGenerator Implementation
+//-----------------------------------------------------------------------------
+
+struct ScenarioGenerator::Impl {
+    /**
+     * @brief Emitter with its precomputed constants and current waveform block
+     */
+    struct EmitterState {
+        ScenarioEmitter emitter;
+        uint64_t stream;                        ///< Noise stream key
+        double sweepRate;                       ///< Chirp sweep rate in Hz/s (0 for other waveforms)
+        std::complex<double> curve;             ///< Per-sample change of the phase step
+        float shaping[SHAPING_TAPS];            ///< Noise low-pass taps, unit power gain
+        int64_t first;                          ///< Waveform index of I[0]
+        std::vector<float> I;                   ///< Waveform block, in phase
+        std::vector<float> Q;                   ///< Waveform block, quadrature
+    };
+
+    struct ReceiverState {
+        ScenarioReceiver receiver;
+        uint64_t stream;                        ///< Noise stream key
+    };
+
+    ScenarioConfig config;
+    utils::LocalFrame frame;
+    std::vector<EmitterState> emitters;
+    std::vector<ReceiverState> receivers;
+    uint64_t samplePosition;
+
+    explicit Impl(const ScenarioConfig& cfg)
+        : config(cfg)
+        , frame(cfg.origin)
+        , samplePosition(0) {
+        if (config.startTime <= 0.0) {
+            config.startTime = std::chrono::duration<double>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    /**
+     * @brief True time, relative to the start, of a receiver's sample
+     */
+    double elapsedAt(const ScenarioReceiver& receiver, double sample) const {
+        return (sample / config.sampleRate - receiver.clockOffset) / (1.0 + receiver.clockDrift);
+    }
+
+    double delayAt(const ScenarioEmitter& emitter, const ScenarioReceiver& receiver, double elapsed) const {
+        utils::EnuPosition e = positionAt(emitter.position, emitter.velocity, elapsed);
+        utils::EnuPosition r = positionAt(receiver.position, receiver.velocity, elapsed);
+        double dx = e.east - r.east;
+        double dy = e.north - r.north;
+        double dz = e.up - r.up;
+        return std::sqrt(dx * dx + dy * dy + dz * dz) / SPEED_OF_LIGHT;
+    }
+
+    /**
+     * @brief Waveform index received at a receiver sample over a path with excess delay
+     */
+    double sourceIndex(const ScenarioEmitter& emitter, const ScenarioReceiver& receiver,
+                       double excessDelay, double sample) const {
+        double elapsed = elapsedAt(receiver, sample);
+        return (elapsed - delayAt(emitter, receiver, elapsed) - excessDelay) * config.sampleRate;
+    }
+
+    /**
+     * @brief Receiver baseband phase in cycles: the carrier delay plus the LO error from clock offset and drift
+     */
+    double carrierCycles(const ScenarioReceiver& receiver, double delay, double sample) const {
+        double clockError = (-receiver.clockOffset - receiver.clockDrift * sample / config.sampleRate)
+                            / (1.0 + receiver.clockDrift);
+        return config.centerFrequency * (clockError - delay);
+    }
+
+    /**
+     * @brief Exact phase of an emitter's carrier offset and chirp at the given waveform index, in cycles
+     */
+    double emitterCycles(const EmitterState& state, int64_t index, double& sweepTime) const {
+        const ScenarioEmitter& emitter = state.emitter;
+        double t = static_cast<double>(index) / config.sampleRate;
+        sweepTime = 0.0;
+        if (state.sweepRate > 0.0) {
+            sweepTime = std::fmod(t, emitter.chirpPeriod);
+            if (sweepTime < 0.0) {
+                sweepTime += emitter.chirpPeriod;
+            }
+        }
+        double sweep = state.sweepRate > 0.0 ? emitter.bandwidth : 0.0;
+        return emitter.frequencyOffset * t - 0.5 * sweep * sweepTime + 0.5 * state.sweepRate * sweepTime * sweepTime;
+    }
+
+    /**
+     * @brief Unit phasors of an emitter's offset and chirp for BLOCK samples from index
+     */
+    void emitterPhasors(const EmitterState& state, int64_t index, float* outI, float* outQ) const {
+        const ScenarioEmitter& emitter = state.emitter;
+        Scratch& buffers = scratch();
+        double sweepTime = 0.0;
+        double cycles = emitterCycles(state, index, sweepTime);
+
+        if (state.sweepRate > 0.0 && sweepTime + BLOCK / config.sampleRate >= emitter.chirpPeriod) {
+            // The sweep restarts inside this block; evaluate each sample exactly
+            for (size_t j = 0; j < BLOCK; j++) {
+                double sampleCycles = emitterCycles(state, index + static_cast<int64_t>(j), sweepTime);
+                double phase = TWO_PI * (sampleCycles - std::floor(sampleCycles));
+                outI[j] = static_cast<float>(std::cos(phase));
+                outQ[j] = static_cast<float>(std::sin(phase));
+            }
+            return;
+        }
+
+        double sweep = state.sweepRate > 0.0 ? emitter.bandwidth : 0.0;
+        double step = TWO_PI * ((emitter.frequencyOffset - 0.5 * sweep) / config.sampleRate
+                                + 0.5 * state.sweepRate * (2.0 * sweepTime / config.sampleRate
+                                                           + 1.0 / (config.sampleRate * config.sampleRate)));
+        float lanes[4 * LANES];
+        std::complex<double> laneStep = phasorLanes(std::polar(1.0, TWO_PI * (cycles - std::floor(cycles))),
+                                                    std::polar(1.0, step), state.curve, lanes);
+        kernels().phasors(lanes, static_cast<float>(laneStep.real()), static_cast<float>(laneStep.imag()),
+                          outI, outQ, buffers.rotationI, buffers.rotationQ);
+    }
+
+    /**
+     * @brief Generate an emitter's waveform for indices [first, first + count)
+     * @param count Number of samples, a multiple of BLOCK
+     */
+    void generateWaveform(EmitterState& state, int64_t first, size_t count) {
+        const ScenarioKernels& k = kernels();
+        const ScenarioEmitter& emitter = state.emitter;
+        Scratch& buffers = scratch();
+        state.first = first;
+        state.I.resize(count);
+        state.Q.resize(count);
+
+        if (emitter.waveform != ScenarioWaveform::Noise) {
+            for (size_t j = 0; j < count; j += BLOCK) {
+                emitterPhasors(state, first + static_cast<int64_t>(j), state.I.data() + j, state.Q.data() + j);
+            }
+            return;
+        }
+
+        // White noise with enough lead and tail for the shaping filter
+        buffers.reserve(count + BLOCK);
+        gaussianNoise(state.stream, first - SHAPING_LEAD, count + BLOCK, static_cast<float>(std::sqrt(0.5)),
+                      buffers.i.data(), buffers.q.data());
+        for (size_t j = 0; j < count; j += BLOCK) {
+            float* outI = state.I.data() + j;
+            float* outQ = state.Q.data() + j;
+            k.shapingFilter(state.shaping, buffers.i.data() + j, buffers.q.data() + j, outI, outQ);
+            if (emitter.frequencyOffset != 0.0) {
+                emitterPhasors(state, first + static_cast<int64_t>(j), buffers.phasorI, buffers.phasorQ);
+                k.rotate(outI, outQ, buffers.phasorI, buffers.phasorQ);
+            }
+        }
+    }
+
+    /**
+     * @brief Add one propagation path of one emitter to a receiver's block
+     * @param count Number of samples, a multiple of BLOCK
+     */
+    void renderPath(const EmitterState& state, const ScenarioReceiver& receiver,
+                    double excessDelay, std::complex<double> tapGain,
+                    uint64_t blockStart, size_t count, float* accI, float* accQ) const {
+        const ScenarioKernels& k = kernels();
+        const ScenarioEmitter& emitter = state.emitter;
+        Scratch& buffers = scratch();
+        float taps[DELAY_TAPS];
+        float lanes[4 * LANES];
+
+        for (size_t j0 = 0; j0 < count; j0 += BLOCK) {
+            const double startSample = static_cast<double>(blockStart + j0);
+            const double centerSample = startSample + 0.5 * BLOCK;
+            const double endSample = startSample + BLOCK;
+
+            // Delay is held constant across the block, taken at its center
+            double centerElapsed = elapsedAt(receiver, centerSample);
+            double centerDelay = delayAt(emitter, receiver, centerElapsed) + excessDelay;
+            double firstIndex = (centerElapsed - centerDelay) * config.sampleRate - 0.5 * BLOCK;
+            double integerIndex = std::floor(firstIndex);
+            delayTaps(firstIndex - integerIndex, taps);
+            const int64_t base = static_cast<int64_t>(integerIndex) - DELAY_LEAD - state.first;
+            k.delayFilter(taps, state.I.data() + base, state.Q.data() + base, buffers.blockI, buffers.blockQ);
+
+            // Carrier phase is linear across the block, which carries Doppler and LO drift
+            double startDelay = delayAt(emitter, receiver, elapsedAt(receiver, startSample)) + excessDelay;
+            double endDelay = delayAt(emitter, receiver, elapsedAt(receiver, endSample)) + excessDelay;
+            double startCycles = carrierCycles(receiver, startDelay, startSample);
+            double stepCycles = (carrierCycles(receiver, endDelay, endSample) - startCycles) / BLOCK;
+            startCycles -= std::floor(startCycles);
+
+            double distance = centerDelay * SPEED_OF_LIGHT;
+            double pathGain = config.pathLossExponent > 0.0
+                ? std::pow(config.referenceDistance / std::max(distance, 1.0), config.pathLossExponent) : 1.0;
+            double amplitude = std::sqrt(config.noisePower * std::pow(10.0, emitter.snrDb / 10.0) * pathGain);
+
+            std::complex<double> laneStep = phasorLanes(amplitude * tapGain * std::polar(1.0, TWO_PI * startCycles),
+                                                        std::polar(1.0, TWO_PI * stepCycles),
+                                                        std::complex<double>(1.0, 0.0), lanes);
+            k.phasors(lanes, static_cast<float>(laneStep.real()), static_cast<float>(laneStep.imag()),
+                      buffers.phasorI, buffers.phasorQ, buffers.rotationI, buffers.rotationQ);
+            k.mix(buffers.blockI, buffers.blockQ, buffers.phasorI, buffers.phasorQ, accI + j0, accQ + j0);
+        }
+    }
+
+    std::shared_ptr<Signal> renderReceiver(const ReceiverState& state, uint64_t blockStart, size_t count) const {
+        const ScenarioKernels& k = kernels();
+        const ScenarioReceiver& receiver = state.receiver;
+        const size_t byteCount = count * sizeof(std::complex<float>);
+        auto buffer = BufferPool::getInstance().acquire(byteCount);
+        if (!buffer) {
+            std::cerr << "ScenarioGenerator: Failed to allocate a receiver buffer" << std::endl;
+            return nullptr;
+        }
+
+        const size_t padded = roundUpToBlock(count);
+        Scratch& buffers = scratch();
+        buffers.reserve(padded);
+        float* accI = buffers.i.data();
+        float* accQ = buffers.q.data();
+        gaussianNoise(state.stream, static_cast<int64_t>(blockStart), padded,
+                      static_cast<float>(std::sqrt(config.noisePower / 2.0)), accI, accQ);
+
+        for (const EmitterState& emitter : emitters) {
+            renderPath(emitter, receiver, 0.0, 1.0, blockStart, padded, accI, accQ);
+            for (const MultipathTap& tap : receiver.multipath) {
+                renderPath(emitter, receiver, tap.delay, std::polar(tap.gain, tap.phase),
+                           blockStart, padded, accI, accQ);
+            }
+        }
+
+        float* interleaved = reinterpret_cast<float*>(buffer.get());
+        size_t j = 0;
+        for (; j + BLOCK <= count; j += BLOCK) {
+            k.interleave(accI + j, accQ + j, interleaved + 2 * j);
+        }
+        for (; j < count; j++) {
+            interleaved[2 * j] = accI[j];
+            interleaved[2 * j + 1] = accQ[j];
+        }
+
+        std::shared_ptr<Signal> signal;
+        if (config.format == DataFormat::ComplexFloat32) {
+            signal = SignalFactory::createSignalFromBuffer(std::move(buffer), byteCount, DataFormat::ComplexFloat32,
+                                                           count, config.sampleRate, config.centerFrequency,
+                                                           config.sampleRate);
+        } else {
+            signal = SignalFactory::createConvertedSignal(buffer.get(), DataFormat::ComplexFloat32, count,
+                                                          config.format, config.sampleRate,
+                                                          config.centerFrequency, config.sampleRate);
+        }
+        if (!signal) {
+            return nullptr;
+        }
+
+        // Timestamps are what the receiver's own clock reads at the first sample
+        double elapsed = elapsedAt(receiver, static_cast<double>(blockStart));
+        signal->setTimestamp(config.startTime + static_cast<double>(blockStart) / config.sampleRate);
+        signal->setMetadata("signal_type", "scenario");
+        signal->setMetadataValue("true_timestamp", config.startTime + elapsed);
+
+        utils::GeodeticPosition location = frame.enuToGeodetic(
+            positionAt(receiver.position, receiver.velocity, elapsed));
+        SourceInfo info;
+        info.deviceType = "Simulated";
+        info.deviceId = receiver.id;
+        info.latitude = location.latitude;
+        info.longitude = location.longitude;
+        info.altitude = location.altitude;
+        signal->setSourceInfo(info);
+        return signal;
+    }
+};
+
+ScenarioGenerator::ScenarioGenerator(const ScenarioConfig& config)
+    : pImpl(std::make_unique<Impl>(config)) {
+}
+
+ScenarioGenerator::~ScenarioGenerator() = default;
+
+bool ScenarioGenerator::addEmitter(const ScenarioEmitter& emitter) {
+    const double sampleRate = pImpl->config.sampleRate;
+    if (emitter.waveform != ScenarioWaveform::Tone &&
+        (emitter.bandwidth <= 0.0 || emitter.bandwidth > 0.8 * sampleRate)) {
+        std::cerr << "ScenarioGenerator: Emitter bandwidth must be between 0 and 80% of the sample rate" << std::endl;
+        return false;
+    }
+    if (emitter.waveform == ScenarioWaveform::Chirp && emitter.chirpPeriod * sampleRate < 2.0 * BLOCK) {
+        std::cerr << "ScenarioGenerator: Chirp period must be at least " << 2 * BLOCK << " samples" << std::endl;
+        return false;
+    }
+    double occupied = emitter.waveform == ScenarioWaveform::Tone ? 0.0 : emitter.bandwidth;
+    if (std::fabs(emitter.frequencyOffset) + 0.5 * occupied > 0.5 * sampleRate) {
+        std::cerr << "ScenarioGenerator: Emitter does not fit in the receiver bandwidth" << std::endl;
+        return false;
+    }
+
+    Impl::EmitterState state;
+    state.emitter = emitter;
+    state.stream = splitMix64(pImpl->config.seed ^ splitMix64(0x100000000ULL + pImpl->emitters.size()));
+    state.sweepRate = emitter.waveform == ScenarioWaveform::Chirp ? emitter.bandwidth / emitter.chirpPeriod : 0.0;
+    state.curve = std::polar(1.0, TWO_PI * state.sweepRate / (sampleRate * sampleRate));
+    state.first = 0;
+    std::fill(state.shaping, state.shaping + SHAPING_TAPS, 0.0f);
+    if (emitter.waveform == ScenarioWaveform::Noise) {
+        // Windowed-sinc low-pass at half the bandwidth, scaled for unit output power
+        double cutoff = 0.5 * emitter.bandwidth / sampleRate;
+        double taps[SHAPING_TAPS];
+        double energy = 0.0;
+        for (int k = 0; k < SHAPING_TAPS; k++) {
+            double m = static_cast<double>(k - SHAPING_LEAD);
+            double sinc = m == 0.0 ? 2.0 * cutoff : std::sin(TWO_PI * cutoff * m) / (M_PI * m);
+            double window = 0.42 - 0.5 * std::cos(TWO_PI * k / (SHAPING_TAPS - 1))
+                            + 0.08 * std::cos(2.0 * TWO_PI * k / (SHAPING_TAPS - 1));
+            taps[k] = sinc * window;
+            energy += taps[k] * taps[k];
+        }
+        for (int k = 0; k < SHAPING_TAPS; k++) {
+            state.shaping[k] = static_cast<float>(taps[k] / std::sqrt(energy));
+        }
+    }
+    pImpl->emitters.push_back(std::move(state));
+    return true;
+}
+
+bool ScenarioGenerator::addReceiver(const ScenarioReceiver& receiver) {
+    if (receiver.clockDrift <= -0.5 || receiver.clockDrift >= 0.5) {
+        std::cerr << "ScenarioGenerator: Receiver clock drift out of range" << std::endl;
+        return false;
+    }
+    for (const MultipathTap& tap : receiver.multipath) {
+        if (tap.delay < 0.0) {
+            std::cerr << "ScenarioGenerator: Multipath delays must not be negative" << std::endl;
+            return false;
+        }
+    }
+
+    Impl::ReceiverState state;
+    state.receiver = receiver;
+    state.stream = splitMix64(pImpl->config.seed ^ splitMix64(pImpl->receivers.size()));
+    pImpl->receivers.push_back(std::move(state));
+    return true;
+}
+
+std::vector<std::shared_ptr<Signal>> ScenarioGenerator::generate(size_t sampleCount) {
+    std::vector<std::shared_ptr<Signal>> signals(pImpl->receivers.size());
+    if (pImpl->receivers.empty() || sampleCount == 0) {
+        return signals;
+    }
+    const uint64_t blockStart = pImpl->samplePosition;
+    const size_t padded = roundUpToBlock(sampleCount);
+
+    // Waveform span each emitter must cover for every receiver and path in this block
+    std::vector<std::pair<int64_t, size_t>> spans(pImpl->emitters.size());
+    for (size_t e = 0; e < pImpl->emitters.size(); e++) {
+        const ScenarioEmitter& emitter = pImpl->emitters[e].emitter;
+        double low = std::numeric_limits<double>::max();
+        double high = std::numeric_limits<double>::lowest();
+        for (const auto& receiverState : pImpl->receivers) {
+            const ScenarioReceiver& receiver = receiverState.receiver;
+            std::vector<double> delays(1, 0.0);
+            for (const MultipathTap& tap : receiver.multipath) {
+                delays.push_back(tap.delay);
+            }
+            for (double delay : delays) {
+                double first = pImpl->sourceIndex(emitter, receiver, delay, static_cast<double>(blockStart));
+                double last = pImpl->sourceIndex(emitter, receiver, delay, static_cast<double>(blockStart + padded));
+                low = std::min(low, std::min(first, last));
+                high = std::max(high, std::max(first, last));
+            }
+        }
+        // Margin covers the filter taps and the per-block rounding of the delay
+        int64_t first = static_cast<int64_t>(std::floor(low)) - DELAY_LEAD - 2;
+        int64_t last = static_cast<int64_t>(std::ceil(high)) + DELAY_TAPS + 2;
+        spans[e] = std::make_pair(first, roundUpToBlock(static_cast<size_t>(last - first)));
+    }
+
+    runParallel(pImpl->emitters.size(), [this, &spans](size_t e) {
+        pImpl->generateWaveform(pImpl->emitters[e], spans[e].first, spans[e].second);
+    });
+    runParallel(pImpl->receivers.size(), [this, &signals, blockStart, sampleCount](size_t r) {
+        signals[r] = pImpl->renderReceiver(pImpl->receivers[r], blockStart, sampleCount);
+    });
+
+    pImpl->samplePosition += sampleCount;
+    return signals;
+}
+
+void ScenarioGenerator::reset() {
+    pImpl->samplePosition = 0;
+}
+
+double ScenarioGenerator::getPropagationDelay(size_t emitterIndex, size_t receiverIndex, double time) const {
+    if (emitterIndex >= pImpl->emitters.size() || receiverIndex >= pImpl->receivers.size()) {
+        return -1.0;
+    }
+    return pImpl->delayAt(pImpl->emitters[emitterIndex].emitter, pImpl->receivers[receiverIndex].receiver,
+                          time - pImpl->config.startTime);
+}
+
+double ScenarioGenerator::getStartTime() const {
+    return pImpl->config.startTime;
+}
+
+uint64_t ScenarioGenerator::getSamplePosition() const {
+    return pImpl->samplePosition;
+}
+
+const ScenarioConfig& ScenarioGenerator::getConfig() const {
+    return pImpl->config;
+}
+
+} // namespace signal
+} // namespace tdoa
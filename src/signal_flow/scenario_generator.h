@@ -0,0 +1,205 @@
+/**
+ * @file scenario_generator.h
+ * @brief Synthetic multi-node TDOA scenarios: time-aligned I/Q for several receivers
+ */
+
+#pragma once
+
+#include "signal.h"
+#include "../tdoa/utils/geodetic.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Emitter waveform enumeration
+ */
+enum class ScenarioWaveform {
+    Noise,      ///< Band-limited Gaussian noise (wideband, correlates sharply)
+    Chirp,      ///< Repeating linear frequency sweep across the bandwidth
+    Tone        ///< Continuous wave at the frequency offset
+};
+
+/**
+ * @brief Emitter in a scenario
+ */
+struct ScenarioEmitter {
+    std::string id;                     ///< Emitter ID
+    utils::EnuPosition position;        ///< Position at the scenario start in meters
+    utils::EnuPosition velocity;        ///< Velocity in m/s
+    ScenarioWaveform waveform;          ///< Waveform type
+    double frequencyOffset;             ///< Offset from the scenario center frequency in Hz
+    double bandwidth;                   ///< Occupied bandwidth (Noise) or sweep width (Chirp) in Hz
+    double chirpPeriod;                 ///< Sweep period for Chirp in seconds
+    double snrDb;                       ///< SNR at referenceDistance, or at every receiver without path loss
+
+    /**
+     * @brief Constructor with default values
+     */
+    ScenarioEmitter()
+        : waveform(ScenarioWaveform::Noise)
+        , frequencyOffset(0.0)
+        , bandwidth(5e6)                // 5 MHz
+        , chirpPeriod(1e-3)             // 1 ms
+        , snrDb(10.0)
+    {}
+};
+
+/**
+ * @brief Multipath component relative to the direct path
+ */
+struct MultipathTap {
+    double delay;                       ///< Excess delay in seconds
+    double gain;                        ///< Amplitude relative to the direct path
+    double phase;                       ///< Phase shift in radians
+};
+
+/**
+ * @brief Receiver in a scenario
+ */
+struct ScenarioReceiver {
+    std::string id;                     ///< Receiver (node) ID, used as the source device ID
+    utils::EnuPosition position;        ///< Position at the scenario start in meters
+    utils::EnuPosition velocity;        ///< Velocity in m/s
+    double clockOffset;                 ///< Local clock minus true time at the scenario start in seconds
+    double clockDrift;                  ///< Fractional clock frequency error (1e-6 = 1 ppm), applied to sampling and LO
+    std::vector<MultipathTap> multipath; ///< Multipath taps applied to every emitter
+
+    /**
+     * @brief Constructor with default values
+     */
+    ScenarioReceiver()
+        : clockOffset(0.0)
+        , clockDrift(0.0)
+    {}
+};
+
+/**
+ * @brief Scenario configuration
+ */
+struct ScenarioConfig {
+    utils::GeodeticPosition origin;     ///< Geodetic origin of the scenario's ENU frame
+    double sampleRate;                  ///< Sample rate in samples per second
+    double centerFrequency;             ///< Receiver center frequency in Hz
+    double startTime;                   ///< Scenario start in seconds since epoch (0 = now)
+    double noisePower;                  ///< Receiver noise power per complex sample (full scale is 1.0)
+    double pathLossExponent;            ///< Path loss exponent (0 = same SNR at every receiver)
+    double referenceDistance;           ///< Distance at which an emitter has its nominal SNR in meters
+    DataFormat format;                  ///< Output data format
+    uint64_t seed;                      ///< Seed for the emitter waveforms and receiver noise
+
+    /**
+     * @brief Constructor with default values
+     */
+    ScenarioConfig()
+        : sampleRate(40e6)              // 40 MS/s, the BB60C full rate
+        , centerFrequency(915e6)        // 915 MHz
+        , startTime(0.0)
+        , noisePower(1e-4)              // -40 dBFS, leaves ~35 dB SNR before int16 clipping
+        , pathLossExponent(0.0)
+        , referenceDistance(1000.0)     // 1 km
+        , format(DataFormat::ComplexFloat32)
+        , seed(1)
+    {}
+};
+
+/**
+ * @class ScenarioGenerator
+ * @brief Synthesizes what N receivers would capture from M emitters
+ *
+ * Each call to generate() returns the next block of samples for every
+ * receiver, continuous with the previous block. For each receiver sample the
+ * generator finds the true time from the receiver's clock offset and drift,
+ * subtracts the propagation delay of the direct path and every multipath
+ * tap, and interpolates the emitter waveform there with a 16-tap windowed
+ * sinc fractional-delay filter. The carrier phase follows the delay, so
+ * moving emitters and receivers produce Doppler, and clock drift appears as
+ * an LO offset. Receiver noise is AWGN at the configured power.
+ *
+ * Signal timestamps are receiver clock readings, so clock errors appear as
+ * TDOA errors exactly as they would in the field. The true time of the first
+ * sample is stored in the "true_timestamp" metadata value.
+ *
+ * Waveforms and noise come from a counter-based generator, so output depends
+ * only on the configuration and seed. Emitter waveforms are generated once
+ * per block and shared by all receivers; emitters and receivers are rendered
+ * in parallel on the ParallelEngine when it is running.
+ */
+class ScenarioGenerator {
+public:
+    /**
+     * @brief Constructor
+     * @param config Scenario configuration
+     */
+    explicit ScenarioGenerator(const ScenarioConfig& config = ScenarioConfig());
+
+    /**
+     * @brief Destructor
+     */
+    ~ScenarioGenerator();
+
+    /**
+     * @brief Add an emitter
+     * @param emitter Emitter description
+     * @return True if the emitter is valid and was added
+     */
+    bool addEmitter(const ScenarioEmitter& emitter);
+
+    /**
+     * @brief Add a receiver
+     * @param receiver Receiver description
+     * @return True if the receiver is valid and was added
+     */
+    bool addReceiver(const ScenarioReceiver& receiver);
+
+    /**
+     * @brief Generate the next block of samples for every receiver
+     * @param sampleCount Number of complex samples per receiver
+     * @return One signal per receiver, in the order they were added (empty if there are no receivers)
+     */
+    std::vector<std::shared_ptr<Signal>> generate(size_t sampleCount);
+
+    /**
+     * @brief Restart the scenario from its start time
+     */
+    void reset();
+
+    /**
+     * @brief Get the true propagation delay of the direct path
+     * @param emitterIndex Emitter index
+     * @param receiverIndex Receiver index
+     * @param time True time in seconds since epoch
+     * @return Delay in seconds, or a negative value if an index is out of range
+     */
+    double getPropagationDelay(size_t emitterIndex, size_t receiverIndex, double time) const;
+
+    /**
+     * @brief Get the scenario start time
+     * @return Start time in seconds since epoch
+     */
+    double getStartTime() const;
+
+    /**
+     * @brief Get the number of samples generated per receiver since the start
+     * @return Sample count
+     */
+    uint64_t getSamplePosition() const;
+
+    /**
+     * @brief Get the configuration
+     * @return Scenario configuration
+     */
+    const ScenarioConfig& getConfig() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
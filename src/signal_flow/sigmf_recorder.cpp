@@ -0,0 +1,532 @@
+/**
+ * @file sigmf_recorder.cpp
+ * @brief Implementation of the SigMF recording sink
+ */
+
+#include "sigmf_recorder.h"
+#include "sample_conversion.h"
+#include "thread_placement.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+/**
+ * @brief One mapped window of the data file
+ */
+struct Segment {
+    uint8_t* base = nullptr;    ///< Mapping address
+    size_t size = 0;            ///< Mapping length
+    uint64_t fileOffset = 0;    ///< Offset of the mapping in the data file
+    size_t used = 0;            ///< Bytes written
+};
+
+/**
+ * @brief Contiguous run of samples
+ */
+struct Capture {
+    uint64_t sampleStart;       ///< Index of the first sample
+    double frequency;           ///< Center frequency in Hz
+    double timestamp;           ///< Timestamp of the first sample in seconds since epoch
+};
+
+std::string jsonString(const std::string& value) {
+    std::ostringstream out;
+    out << '"';
+    for (unsigned char c : value) {
+        switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                        << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+std::string jsonNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "null";
+    }
+    std::ostringstream out;
+    out << std::setprecision(17) << value;
+    return out.str();
+}
+
+/**
+ * @brief Format a timestamp as an ISO 8601 UTC datetime with nanoseconds
+ */
+std::string formatDatetime(double timestamp) {
+    double wholeSeconds = std::floor(timestamp);
+    int nanoseconds = static_cast<int>(std::lround((timestamp - wholeSeconds) * 1e9));
+    if (nanoseconds >= 1000000000) {
+        wholeSeconds += 1.0;
+        nanoseconds -= 1000000000;
+    }
+    std::time_t seconds = static_cast<std::time_t>(wholeSeconds);
+    std::tm utc;
+    gmtime_r(&seconds, &utc);
+
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", &utc);
+    char result[64];
+    std::snprintf(result, sizeof(result), "%s.%09dZ", date, nanoseconds);
+    return result;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// SigMFRecorder Implementation
+//-----------------------------------------------------------------------------
+
+struct SigMFRecorder::Impl {
+    SigMFRecorderConfig config;
+    size_t pageSize;
+    size_t segmentSize;
+    std::string dataPath;
+    std::string metaPath;
+    int fd;
+    std::atomic<bool> isOpen;
+
+    // Ingest side, guarded by ingestMutex
+    std::mutex ingestMutex;
+    Segment current;
+    bool hasFormat;
+    DataFormat format;
+    double sampleRate;
+    SourceInfo source;
+    std::vector<Capture> captures;
+    bool discontinuity;
+
+    // Shared with the background thread, guarded by queueMutex
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::deque<Segment> ready;
+    std::deque<Segment> full;
+    bool stopping;
+
+    // Background thread only
+    std::thread worker;
+    uint64_t nextOffset;
+
+    // Statistics
+    std::atomic<uint64_t> bytesWritten;
+    std::atomic<uint64_t> samplesWritten;
+    std::atomic<uint64_t> samplesDropped;
+    std::atomic<uint64_t> signalsDropped;
+    std::atomic<uint64_t> signalsRejected;
+    std::atomic<uint64_t> segmentsMapped;
+    std::atomic<uint64_t> segmentsFlushed;
+    std::atomic<size_t> captureCount;
+
+    explicit Impl(const SigMFRecorderConfig& cfg)
+        : config(cfg)
+        , fd(-1)
+        , isOpen(false)
+        , hasFormat(false)
+        , format(DataFormat::Raw)
+        , sampleRate(0.0)
+        , discontinuity(false)
+        , stopping(false)
+        , nextOffset(0) {
+        pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t requested = std::max(config.segmentSize, pageSize);
+        segmentSize = (requested + pageSize - 1) / pageSize * pageSize;
+        config.segmentsAhead = std::max<size_t>(1, config.segmentsAhead);
+        resetStats();
+    }
+
+    void resetStats() {
+        bytesWritten = 0;
+        samplesWritten = 0;
+        samplesDropped = 0;
+        signalsDropped = 0;
+        signalsRejected = 0;
+        segmentsMapped = 0;
+        segmentsFlushed = 0;
+        captureCount = 0;
+    }
+
+    bool mapSegment(uint64_t offset, Segment& segment) {
+        int result = posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(segmentSize));
+        if (result != 0) {
+            std::cerr << "SigMFRecorder: Failed to preallocate " << dataPath << ": " << std::strerror(result) << std::endl;
+            return false;
+        }
+        void* base = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd, static_cast<off_t>(offset));
+        if (base == MAP_FAILED) {
+            std::cerr << "SigMFRecorder: Failed to map " << dataPath << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        // MAP_POPULATE maps shared pages read-only; write each page here so the
+        // ingest thread's copies never take a write fault
+        volatile uint8_t* pages = static_cast<volatile uint8_t*>(base);
+        for (size_t i = 0; i < segmentSize; i += pageSize) {
+            pages[i] = 0;
+        }
+        segment.base = static_cast<uint8_t*>(base);
+        segment.size = segmentSize;
+        segment.fileOffset = offset;
+        segment.used = 0;
+        segmentsMapped++;
+        return true;
+    }
+
+    void flushSegment(const Segment& segment) {
+        if (segment.used > 0 && msync(segment.base, segment.used, MS_SYNC) != 0) {
+            std::cerr << "SigMFRecorder: Failed to write back " << dataPath << ": " << std::strerror(errno) << std::endl;
+        }
+        munmap(segment.base, segment.size);
+        if (config.dropPageCache && segment.used > 0) {
+            posix_fadvise(fd, static_cast<off_t>(segment.fileOffset), static_cast<off_t>(segment.used),
+                          POSIX_FADV_DONTNEED);
+        }
+        segmentsFlushed++;
+    }
+
+    void workerLoop() {
+        ThreadPlacement::getInstance().placeCurrentThread(ThreadClass::Io, "sigmf-writer");
+        std::unique_lock<std::mutex> lock(queueMutex);
+        while (true) {
+            if (!full.empty()) {
+                Segment segment = full.front();
+                full.pop_front();
+                lock.unlock();
+                flushSegment(segment);
+                lock.lock();
+                continue;
+            }
+            if (stopping) {
+                break;
+            }
+            if (ready.size() < config.segmentsAhead) {
+                uint64_t offset = nextOffset;
+                lock.unlock();
+                Segment segment;
+                bool mapped = mapSegment(offset, segment);
+                lock.lock();
+                if (mapped) {
+                    nextOffset += segmentSize;
+                    ready.push_back(segment);
+                } else {
+                    // Out of space or mappings; retry later and let the writer drop in the meantime
+                    queueCondition.wait_for(lock, std::chrono::seconds(1));
+                }
+                continue;
+            }
+            queueCondition.wait(lock);
+        }
+        // Unused segments are cut off by the final truncate
+        for (const Segment& segment : ready) {
+            munmap(segment.base, segment.size);
+        }
+        ready.clear();
+    }
+
+    /**
+     * @brief Check that enough mapped space is ready for a write, without waiting
+     */
+    bool reserve(size_t bytes) {
+        size_t available = current.base ? current.size - current.used : 0;
+        if (bytes <= available) {
+            return true;
+        }
+        size_t segmentsNeeded = (bytes - available + segmentSize - 1) / segmentSize;
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return ready.size() >= segmentsNeeded;
+    }
+
+    void write(const uint8_t* data, size_t bytes) {
+        while (bytes > 0) {
+            if (current.base == nullptr || current.used == current.size) {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                if (current.base != nullptr) {
+                    full.push_back(current);
+                }
+                current = ready.front();
+                ready.pop_front();
+                queueCondition.notify_one();
+            }
+            size_t count = std::min(bytes, current.size - current.used);
+            std::memcpy(current.base + current.used, data, count);
+            current.used += count;
+            data += count;
+            bytes -= count;
+        }
+    }
+
+    void updateCaptures(const Signal& signal) {
+        double frequency = signal.getCenterFrequency();
+        double timestamp = signal.getTimestamp();
+        uint64_t sampleIndex = samplesWritten;
+
+        bool startCapture = captures.empty() || discontinuity || frequency != captures.back().frequency;
+        if (!startCapture && timestamp > 0.0 && captures.back().timestamp > 0.0 && sampleRate > 0.0) {
+            const Capture& last = captures.back();
+            double expected = last.timestamp + static_cast<double>(sampleIndex - last.sampleStart) / sampleRate;
+            // Epoch timestamps in a double resolve to about 0.25 us
+            double tolerance = std::max(0.5 / sampleRate, 1e-6);
+            startCapture = std::fabs(timestamp - expected) > tolerance;
+        }
+        if (startCapture) {
+            captures.push_back({sampleIndex, frequency, timestamp});
+            captureCount = captures.size();
+        }
+        discontinuity = false;
+    }
+
+    bool writeMetadata() const {
+        std::ostringstream json;
+        json << "{\n  \"global\": {\n";
+        json << "    \"core:version\": \"1.0.0\",\n";
+        json << "    \"core:datatype\": " << jsonString(getDatatype(format)) << ",\n";
+        json << "    \"core:sample_rate\": " << jsonNumber(sampleRate) << ",\n";
+        json << "    \"core:recorder\": \"tdoa-signal-flow\",\n";
+        std::string hardware = config.hardware.empty() ? source.deviceType.str() : config.hardware;
+        if (!hardware.empty()) {
+            json << "    \"core:hw\": " << jsonString(hardware) << ",\n";
+        }
+        if (!config.description.empty()) {
+            json << "    \"core:description\": " << jsonString(config.description) << ",\n";
+        }
+        if (source.latitude != 0.0 || source.longitude != 0.0) {
+            json << "    \"core:geolocation\": {\"type\": \"Point\", \"coordinates\": ["
+                 << jsonNumber(source.longitude) << ", " << jsonNumber(source.latitude) << ", "
+                 << jsonNumber(source.altitude) << "]},\n";
+        }
+        json << "    \"core:extensions\": [{\"name\": \"tdoa\", \"version\": \"1.0.0\", \"optional\": true}],\n";
+        json << "    \"tdoa:node_id\": " << jsonString(config.nodeId) << ",\n";
+        json << "    \"tdoa:device_id\": " << jsonString(source.deviceId.str()) << ",\n";
+        json << "    \"tdoa:samples_dropped\": " << samplesDropped << "\n";
+        json << "  },\n  \"captures\": [";
+        for (size_t i = 0; i < captures.size(); i++) {
+            const Capture& capture = captures[i];
+            json << (i > 0 ? ",\n" : "\n");
+            json << "    {\"core:sample_start\": " << capture.sampleStart
+                 << ", \"core:frequency\": " << jsonNumber(capture.frequency);
+            if (capture.timestamp > 0.0) {
+                // core:datetime for readers; tdoa:timestamp keeps the full double used for TDOA
+                json << ", \"core:datetime\": " << jsonString(formatDatetime(capture.timestamp))
+                     << ", \"tdoa:timestamp\": " << jsonNumber(capture.timestamp);
+            }
+            json << "}";
+        }
+        json << (captures.empty() ? "" : "\n  ") << "],\n  \"annotations\": []\n}\n";
+
+        std::string tempPath = metaPath + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            if (!file) {
+                std::cerr << "SigMFRecorder: Failed to create " << tempPath << std::endl;
+                return false;
+            }
+            file << json.str();
+            if (!file) {
+                std::cerr << "SigMFRecorder: Failed to write " << tempPath << std::endl;
+                return false;
+            }
+        }
+        if (std::rename(tempPath.c_str(), metaPath.c_str()) != 0) {
+            std::cerr << "SigMFRecorder: Failed to rename " << tempPath << ": " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+};
+
+SigMFRecorder::SigMFRecorder(const SigMFRecorderConfig& config)
+    : pImpl(std::make_unique<Impl>(config)) {
+}
+
+SigMFRecorder::~SigMFRecorder() {
+    close();
+}
+
+bool SigMFRecorder::open(const std::string& name) {
+    std::lock_guard<std::mutex> guard(pImpl->ingestMutex);
+    if (pImpl->isOpen) {
+        std::cerr << "SigMFRecorder: Recording already open: " << pImpl->dataPath << std::endl;
+        return false;
+    }
+
+    std::string base = pImpl->config.directory.empty() ? name : pImpl->config.directory + "/" + name;
+    pImpl->dataPath = base + ".sigmf-data";
+    pImpl->metaPath = base + ".sigmf-meta";
+    pImpl->fd = ::open(pImpl->dataPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (pImpl->fd < 0) {
+        std::cerr << "SigMFRecorder: Failed to create " << pImpl->dataPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    pImpl->current = Segment();
+    pImpl->hasFormat = false;
+    pImpl->format = DataFormat::Raw;
+    pImpl->sampleRate = 0.0;
+    pImpl->source = SourceInfo();
+    pImpl->captures.clear();
+    pImpl->discontinuity = false;
+    pImpl->stopping = false;
+    pImpl->nextOffset = 0;
+    pImpl->resetStats();
+
+    // Map the first segments before returning so the first signals are not dropped
+    while (pImpl->ready.size() < pImpl->config.segmentsAhead) {
+        Segment segment;
+        if (!pImpl->mapSegment(pImpl->nextOffset, segment)) {
+            break;
+        }
+        pImpl->nextOffset += pImpl->segmentSize;
+        pImpl->ready.push_back(segment);
+    }
+
+    pImpl->worker = std::thread(&Impl::workerLoop, pImpl.get());
+    pImpl->isOpen = true;
+    return true;
+}
+
+bool SigMFRecorder::record(const Signal& signal) {
+    std::lock_guard<std::mutex> guard(pImpl->ingestMutex);
+    if (!pImpl->isOpen) {
+        return false;
+    }
+
+    if (!pImpl->hasFormat) {
+        if (getDatatype(signal.getFormat()).empty()) {
+            std::cerr << "SigMFRecorder: Cannot record Raw data" << std::endl;
+            pImpl->signalsRejected++;
+            return false;
+        }
+        pImpl->format = signal.getFormat();
+        pImpl->sampleRate = signal.getSampleRate();
+        pImpl->source = signal.getSourceInfo();
+        pImpl->hasFormat = true;
+    } else if (signal.getFormat() != pImpl->format || signal.getSampleRate() != pImpl->sampleRate) {
+        pImpl->signalsRejected++;
+        return false;
+    }
+
+    size_t sampleCount = signal.getSampleCount();
+    size_t bytes = std::min(sampleCount * getSampleSize(pImpl->format), signal.getBufferSize());
+    if (bytes == 0) {
+        return true;
+    }
+    if (!pImpl->reserve(bytes)) {
+        pImpl->samplesDropped += sampleCount;
+        pImpl->signalsDropped++;
+        pImpl->discontinuity = true;
+        return false;
+    }
+
+    pImpl->updateCaptures(signal);
+    pImpl->write(static_cast<const uint8_t*>(signal.data()), bytes);
+    pImpl->bytesWritten += bytes;
+    pImpl->samplesWritten += sampleCount;
+    return true;
+}
+
+bool SigMFRecorder::close() {
+    std::lock_guard<std::mutex> guard(pImpl->ingestMutex);
+    if (!pImpl->isOpen) {
+        return false;
+    }
+    pImpl->isOpen = false;
+
+    {
+        std::lock_guard<std::mutex> lock(pImpl->queueMutex);
+        if (pImpl->current.base != nullptr) {
+            pImpl->full.push_back(pImpl->current);
+            pImpl->current = Segment();
+        }
+        pImpl->stopping = true;
+    }
+    pImpl->queueCondition.notify_one();
+    pImpl->worker.join();
+
+    bool success = true;
+    if (ftruncate(pImpl->fd, static_cast<off_t>(pImpl->bytesWritten.load())) != 0 || fsync(pImpl->fd) != 0) {
+        std::cerr << "SigMFRecorder: Failed to finish " << pImpl->dataPath << ": " << std::strerror(errno) << std::endl;
+        success = false;
+    }
+    ::close(pImpl->fd);
+    pImpl->fd = -1;
+
+    if (pImpl->hasFormat && !pImpl->writeMetadata()) {
+        success = false;
+    }
+    return success;
+}
+
+bool SigMFRecorder::isOpen() const {
+    return pImpl->isOpen;
+}
+
+std::string SigMFRecorder::getDataPath() const {
+    std::lock_guard<std::mutex> guard(pImpl->ingestMutex);
+    return pImpl->dataPath;
+}
+
+std::string SigMFRecorder::getMetaPath() const {
+    std::lock_guard<std::mutex> guard(pImpl->ingestMutex);
+    return pImpl->metaPath;
+}
+
+SigMFRecorderStats SigMFRecorder::getStats() const {
+    SigMFRecorderStats stats;
+    stats.bytesWritten = pImpl->bytesWritten;
+    stats.samplesWritten = pImpl->samplesWritten;
+    stats.samplesDropped = pImpl->samplesDropped;
+    stats.signalsDropped = pImpl->signalsDropped;
+    stats.signalsRejected = pImpl->signalsRejected;
+    stats.segmentsMapped = pImpl->segmentsMapped;
+    stats.segmentsFlushed = pImpl->segmentsFlushed;
+    stats.captureCount = pImpl->captureCount;
+    return stats;
+}
+
+std::string SigMFRecorder::getDatatype(DataFormat format) {
+    switch (format) {
+        case DataFormat::ComplexFloat32:
+            return "cf32_le";
+        case DataFormat::ComplexInt16:
+            return "ci16_le";
+        case DataFormat::ComplexInt8:
+            return "ci8";
+        default:
+            return "";
+    }
+}
+
+} // namespace signal
+} // namespace tdoa
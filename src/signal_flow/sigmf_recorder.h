@@ -0,0 +1,148 @@
+/**
+ * @file sigmf_recorder.h
+ * @brief Recording sink that writes signal streams as SigMF recordings
+ */
+
+#pragma once
+
+#include "signal.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief SigMF recorder configuration
+ */
+struct SigMFRecorderConfig {
+    std::string directory;      ///< Directory the recording files are created in (must exist)
+    std::string nodeId;         ///< Node ID written to the metadata
+    std::string hardware;       ///< Hardware description (defaults to the source device type)
+    std::string description;    ///< Free-text description of the recording
+    size_t segmentSize;         ///< Bytes per memory-mapped segment (rounded up to the page size)
+    size_t segmentsAhead;       ///< Segments preallocated and mapped ahead of the writer
+    bool dropPageCache;         ///< Drop flushed segments from the page cache
+
+    /**
+     * @brief Constructor with default values
+     */
+    SigMFRecorderConfig()
+        : directory(".")
+        , segmentSize(32 * 1024 * 1024)     // 32 MB
+        , segmentsAhead(4)                  // 128 MB, about 1.6 s at 80 MB/s
+        , dropPageCache(true)
+    {}
+};
+
+/**
+ * @brief SigMF recorder statistics
+ */
+struct SigMFRecorderStats {
+    uint64_t bytesWritten;      ///< Sample bytes copied into the data file
+    uint64_t samplesWritten;    ///< Complex samples recorded
+    uint64_t samplesDropped;    ///< Complex samples dropped because no segment was ready
+    uint64_t signalsDropped;    ///< Signals dropped because no segment was ready
+    uint64_t signalsRejected;   ///< Signals rejected because their format or sample rate differed
+    uint64_t segmentsMapped;    ///< Segments preallocated and mapped
+    uint64_t segmentsFlushed;   ///< Segments written back and unmapped
+    size_t captureCount;        ///< SigMF captures (contiguous runs of samples)
+};
+
+/**
+ * @class SigMFRecorder
+ * @brief Records raw I/Q from the pipeline as a SigMF data file and JSON metadata
+ *
+ * record() copies a signal's samples into a preallocated, pre-faulted
+ * memory-mapped segment of the data file and returns; it never waits for
+ * the disk. A background thread keeps segmentsAhead segments mapped ahead of
+ * the writer, and writes back and unmaps full segments. If the writer
+ * catches up with the background thread, whole signals are dropped and
+ * counted instead of blocking the caller, and recording resumes in a new
+ * capture.
+ *
+ * The first recorded signal fixes the datatype and sample rate. A new
+ * capture, carrying the center frequency and GPS timestamp, starts whenever
+ * the center frequency changes or a signal's timestamp does not follow on
+ * from the previous one. The .sigmf-meta file is written by close().
+ */
+class SigMFRecorder {
+public:
+    /**
+     * @brief Constructor
+     * @param config Recorder configuration
+     */
+    explicit SigMFRecorder(const SigMFRecorderConfig& config = SigMFRecorderConfig());
+
+    /**
+     * @brief Destructor, closes any open recording
+     */
+    ~SigMFRecorder();
+
+    /**
+     * @brief Start a recording
+     *
+     * Creates <directory>/<name>.sigmf-data and starts the background thread.
+     * @param name Recording name, without extension
+     * @return True if the recording was started
+     */
+    bool open(const std::string& name);
+
+    /**
+     * @brief Record a signal's samples
+     *
+     * Safe to call from one ingest thread while another thread reads the stats.
+     * @param signal Signal to record (ComplexFloat32, ComplexInt16 or ComplexInt8)
+     * @return True if the samples were recorded, false if the signal was rejected or dropped
+     */
+    bool record(const Signal& signal);
+
+    /**
+     * @brief Finish the recording
+     *
+     * Writes back the remaining segments, truncates the data file to the
+     * recorded length and writes <directory>/<name>.sigmf-meta.
+     * @return True if the recording was finished successfully
+     */
+    bool close();
+
+    /**
+     * @brief Check if a recording is open
+     * @return True if open
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Get the data file path
+     * @return Path of the current or last recording's data file
+     */
+    std::string getDataPath() const;
+
+    /**
+     * @brief Get the metadata file path
+     * @return Path of the current or last recording's metadata file
+     */
+    std::string getMetaPath() const;
+
+    /**
+     * @brief Get recorder statistics
+     * @return Statistics for the current or last recording
+     */
+    SigMFRecorderStats getStats() const;
+
+    /**
+     * @brief Get the SigMF datatype for a data format
+     * @param format Data format
+     * @return Datatype such as "ci16_le", or empty string if the format cannot be recorded
+     */
+    static std::string getDatatype(DataFormat format);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
@@ -4,9 +4,12 @@
  */
 
 #include "signal.h"
+#include "buffer_pool.h"
+#include "sample_conversion.h"
 #include <stdexcept>
 #include <algorithm>
 #include <cstring>
+#include <new>
 
 namespace tdoa {
 namespace signal {
@@ -27,19 +30,42 @@ static size_t calculateBufferSize(DataFormat format, size_t sampleCount) {
     }
 }
 
+// Acquire pooled storage, throwing std::bad_alloc if the pool cannot allocate
+static std::shared_ptr<uint8_t> acquireStorage(size_t size, bool zero = false) {
+    auto storage = BufferPool::getInstance().acquire(size, zero);
+    if (!storage && size > 0) {
+        throw std::bad_alloc();
+    }
+    return storage;
+}
+
+// Shared empty metadata map; signals only allocate their own on the first setMetadata
+static const std::shared_ptr<MetadataMap>& emptyMetadata() {
+    static const auto empty = std::make_shared<MetadataMap>();
+    return empty;
+}
+
+// Shared empty provenance log; signals only allocate their own on the first addProvenance
+static const std::shared_ptr<ProvenanceLog>& emptyProvenance() {
+    static const auto empty = std::make_shared<ProvenanceLog>();
+    return empty;
+}
+
 // Constructor with pre-allocated buffer
 Signal::Signal(DataFormat format, size_t sampleCount)
     : format_(format)
     , sampleCount_(sampleCount)
     , bufferSize_(calculateBufferSize(format, sampleCount))
-    , dataBuffer_(bufferSize_)
+    , storage_(acquireStorage(bufferSize_, true))  // Zero-initialized
+    , byteOffset_(0)
+    , sliceOffset_(0)
     , centerFrequency_(0.0)
     , sampleRate_(0.0)
     , bandwidth_(0.0)
     , timestamp_(0.0)
+    , metadata_(emptyMetadata())
+    , provenance_(emptyProvenance())
 {
-    // Zero-initialize the buffer
-    std::fill(dataBuffer_.begin(), dataBuffer_.end(), 0);
 }
 
 // Constructor with existing data
@@ -47,11 +73,14 @@ Signal::Signal(const void* data, size_t dataSize, DataFormat format, size_t samp
     : format_(format)
     , sampleCount_(sampleCount)
     , bufferSize_(calculateBufferSize(format, sampleCount))
-    , dataBuffer_(bufferSize_)
+    , byteOffset_(0)
+    , sliceOffset_(0)
     , centerFrequency_(0.0)
     , sampleRate_(0.0)
     , bandwidth_(0.0)
     , timestamp_(0.0)
+    , metadata_(emptyMetadata())
+    , provenance_(emptyProvenance())
 {
     // Check if dataSize matches the expected buffer size
     if (dataSize != bufferSize_) {
@@ -59,70 +88,109 @@ Signal::Signal(const void* data, size_t dataSize, DataFormat format, size_t samp
     }
     
     // Copy the data
-    std::memcpy(dataBuffer_.data(), data, dataSize);
+    storage_ = acquireStorage(bufferSize_);
+    if (dataSize > 0) {
+        std::memcpy(storage_.get(), data, dataSize);
+    }
+}
+
+// Constructor adopting an existing buffer
+Signal::Signal(std::shared_ptr<uint8_t> buffer, size_t dataSize, DataFormat format, size_t sampleCount)
+    : format_(format)
+    , sampleCount_(sampleCount)
+    , bufferSize_(calculateBufferSize(format, sampleCount))
+    , storage_(std::move(buffer))
+    , byteOffset_(0)
+    , sliceOffset_(0)
+    , centerFrequency_(0.0)
+    , sampleRate_(0.0)
+    , bandwidth_(0.0)
+    , timestamp_(0.0)
+    , metadata_(emptyMetadata())
+    , provenance_(emptyProvenance())
+{
+    if (dataSize != bufferSize_) {
+        throw std::runtime_error("Data size does not match expected buffer size for the given format and sample count");
+    }
+    if (!storage_ && bufferSize_ > 0) {
+        throw std::invalid_argument("Signal buffer is null");
+    }
 }
 
 // Destructor
 Signal::~Signal() {
-    // Vector destructor will handle cleanup
+    // Shared storage is released with the last signal referencing it
 }
 
-// Get raw data pointer
-void* Signal::data() {
-    return dataBuffer_.data();
+// Copy this signal's window out of shared storage before it is modified
+void Signal::detach() {
+    if (storage_.use_count() > 1) {
+        auto copy = acquireStorage(bufferSize_);
+        if (bufferSize_ > 0) {
+            std::memcpy(copy.get(), storage_.get() + byteOffset_, bufferSize_);
+        }
+        storage_ = std::move(copy);
+        byteOffset_ = 0;
+    }
 }
 
-// Get raw data pointer (const version)
+// Get raw data pointer for reading
 const void* Signal::data() const {
-    return dataBuffer_.data();
+    return window();
 }
 
-// Get data as complex float samples
-std::complex<float>* Signal::complexFloat() {
+// Get data as complex float samples for reading
+const std::complex<float>* Signal::complexFloat() const {
     if (format_ != DataFormat::ComplexFloat32) {
         return nullptr;
     }
-    return reinterpret_cast<std::complex<float>*>(dataBuffer_.data());
+    return reinterpret_cast<const std::complex<float>*>(window());
 }
 
-// Get data as complex float samples (const version)
-const std::complex<float>* Signal::complexFloat() const {
-    if (format_ != DataFormat::ComplexFloat32) {
+// Get data as complex int16 samples for reading
+const std::complex<int16_t>* Signal::complexInt16() const {
+    if (format_ != DataFormat::ComplexInt16) {
         return nullptr;
     }
-    return reinterpret_cast<const std::complex<float>*>(dataBuffer_.data());
+    return reinterpret_cast<const std::complex<int16_t>*>(window());
 }
 
-// Get data as complex int16 samples
-std::complex<int16_t>* Signal::complexInt16() {
-    if (format_ != DataFormat::ComplexInt16) {
+// Get data as complex int8 samples for reading
+const std::complex<int8_t>* Signal::complexInt8() const {
+    if (format_ != DataFormat::ComplexInt8) {
         return nullptr;
     }
-    return reinterpret_cast<std::complex<int16_t>*>(dataBuffer_.data());
+    return reinterpret_cast<const std::complex<int8_t>*>(window());
 }
 
-// Get data as complex int16 samples (const version)
-const std::complex<int16_t>* Signal::complexInt16() const {
-    if (format_ != DataFormat::ComplexInt16) {
+// Get raw data pointer for writing
+void* Signal::mutableData() {
+    detach();
+    return window();
+}
+
+// Get complex float samples for writing
+std::complex<float>* Signal::mutableComplexFloat() {
+    if (format_ != DataFormat::ComplexFloat32) {
         return nullptr;
     }
-    return reinterpret_cast<const std::complex<int16_t>*>(dataBuffer_.data());
+    return static_cast<std::complex<float>*>(mutableData());
 }
 
-// Get data as complex int8 samples
-std::complex<int8_t>* Signal::complexInt8() {
-    if (format_ != DataFormat::ComplexInt8) {
+// Get complex int16 samples for writing
+std::complex<int16_t>* Signal::mutableComplexInt16() {
+    if (format_ != DataFormat::ComplexInt16) {
         return nullptr;
     }
-    return reinterpret_cast<std::complex<int8_t>*>(dataBuffer_.data());
+    return static_cast<std::complex<int16_t>*>(mutableData());
 }
 
-// Get data as complex int8 samples (const version)
-const std::complex<int8_t>* Signal::complexInt8() const {
+// Get complex int8 samples for writing
+std::complex<int8_t>* Signal::mutableComplexInt8() {
     if (format_ != DataFormat::ComplexInt8) {
         return nullptr;
     }
-    return reinterpret_cast<const std::complex<int8_t>*>(dataBuffer_.data());
+    return static_cast<std::complex<int8_t>*>(mutableData());
 }
 
 // Convert signal to a different data format
@@ -132,8 +200,12 @@ std::shared_ptr<Signal> Signal::convertToFormat(DataFormat targetFormat) const {
         return clone();
     }
     
-    // Create a new signal with the target format
-    auto result = std::make_shared<Signal>(targetFormat, sampleCount_);
+    // Raw samples are bytes, so a raw result keeps every byte of this signal
+    size_t resultCount = (targetFormat == DataFormat::Raw) ? bufferSize_ : sampleCount_;
+    size_t resultSize = calculateBufferSize(targetFormat, resultCount);
+    
+    // Create a new signal with the target format; every byte is written below
+    auto result = std::make_shared<Signal>(acquireStorage(resultSize), resultSize, targetFormat, resultCount);
     
     // Copy metadata
     result->setCenterFrequency(centerFrequency_);
@@ -143,115 +215,48 @@ std::shared_ptr<Signal> Signal::convertToFormat(DataFormat targetFormat) const {
     result->setSourceInfo(sourceInfo_);
     result->setId(id_);
     
-    // Copy all metadata
-    for (const auto& pair : metadata_) {
-        result->setMetadata(pair.first, pair.second);
-    }
+    // Share metadata and provenance; they are copied if either signal modifies them
+    result->metadata_ = metadata_;
+    result->provenance_ = provenance_;
     
-    // Convert the data based on source and target formats
-    // This is a simplified implementation - in real code you'd need more robust conversion
-    
-    // Source is ComplexFloat32
-    if (format_ == DataFormat::ComplexFloat32) {
-        const auto* srcData = complexFloat();
-        
-        if (targetFormat == DataFormat::ComplexInt16) {
-            auto* dstData = result->complexInt16();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale float [-1.0, 1.0] to int16 range
-                float real = std::max(-1.0f, std::min(1.0f, srcData[i].real()));
-                float imag = std::max(-1.0f, std::min(1.0f, srcData[i].imag()));
-                dstData[i] = std::complex<int16_t>(
-                    static_cast<int16_t>(real * 32767.0f),
-                    static_cast<int16_t>(imag * 32767.0f)
-                );
-            }
+    if (format_ == DataFormat::Raw || targetFormat == DataFormat::Raw) {
+        // Byte copy; a shorter raw source leaves the rest of the result zeroed
+        size_t copySize = std::min(bufferSize_, resultSize);
+        if (copySize > 0) {
+            std::memcpy(result->storage_.get(), data(), copySize);
         }
-        else if (targetFormat == DataFormat::ComplexInt8) {
-            auto* dstData = result->complexInt8();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale float [-1.0, 1.0] to int8 range
-                float real = std::max(-1.0f, std::min(1.0f, srcData[i].real()));
-                float imag = std::max(-1.0f, std::min(1.0f, srcData[i].imag()));
-                dstData[i] = std::complex<int8_t>(
-                    static_cast<int8_t>(real * 127.0f),
-                    static_cast<int8_t>(imag * 127.0f)
-                );
-            }
+        if (resultSize > copySize) {
+            std::memset(result->storage_.get() + copySize, 0, resultSize - copySize);
         }
-        else if (targetFormat == DataFormat::Raw) {
-            // For raw format, just copy the bytes
-            std::memcpy(result->data(), data(), bufferSize_);
+        if (format_ == DataFormat::Raw) {
+            // Set a metadata flag indicating this was converted from raw
+            result->setMetadata("converted_from_raw", "true");
         }
+    } else {
+        convertSamples(data(), format_, result->storage_.get(), targetFormat, sampleCount_);
     }
-    // Source is ComplexInt16
-    else if (format_ == DataFormat::ComplexInt16) {
-        const auto* srcData = complexInt16();
-        
-        if (targetFormat == DataFormat::ComplexFloat32) {
-            auto* dstData = result->complexFloat();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale int16 to float [-1.0, 1.0]
-                dstData[i] = std::complex<float>(
-                    static_cast<float>(srcData[i].real()) / 32767.0f,
-                    static_cast<float>(srcData[i].imag()) / 32767.0f
-                );
-            }
-        }
-        else if (targetFormat == DataFormat::ComplexInt8) {
-            auto* dstData = result->complexInt8();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale int16 to int8 (with potential quality loss)
-                dstData[i] = std::complex<int8_t>(
-                    static_cast<int8_t>(srcData[i].real() >> 8),
-                    static_cast<int8_t>(srcData[i].imag() >> 8)
-                );
-            }
-        }
-        else if (targetFormat == DataFormat::Raw) {
-            // For raw format, just copy the bytes
-            std::memcpy(result->data(), data(), bufferSize_);
-        }
+    
+    return result;
+}
+
+// Convert into an existing signal's buffer
+bool Signal::convertInto(Signal& destination) const {
+    if (destination.sampleCount_ != sampleCount_) {
+        std::cerr << "Cannot convert signal with " << sampleCount_ << " samples into one with "
+                  << destination.sampleCount_ << " samples" << std::endl;
+        return false;
     }
-    // Source is ComplexInt8
-    else if (format_ == DataFormat::ComplexInt8) {
-        const auto* srcData = complexInt8();
-        
-        if (targetFormat == DataFormat::ComplexFloat32) {
-            auto* dstData = result->complexFloat();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale int8 to float [-1.0, 1.0]
-                dstData[i] = std::complex<float>(
-                    static_cast<float>(srcData[i].real()) / 127.0f,
-                    static_cast<float>(srcData[i].imag()) / 127.0f
-                );
-            }
-        }
-        else if (targetFormat == DataFormat::ComplexInt16) {
-            auto* dstData = result->complexInt16();
-            for (size_t i = 0; i < sampleCount_; i++) {
-                // Scale int8 to int16
-                dstData[i] = std::complex<int16_t>(
-                    static_cast<int16_t>(srcData[i].real()) << 8,
-                    static_cast<int16_t>(srcData[i].imag()) << 8
-                );
-            }
-        }
-        else if (targetFormat == DataFormat::Raw) {
-            // For raw format, just copy the bytes
-            std::memcpy(result->data(), data(), bufferSize_);
-        }
+    
+    // mutableData() detaches the destination, so it never overlaps this signal's window
+    void* target = destination.mutableData();
+    if (target == data()) {
+        return true;
     }
-    // Source is Raw
-    else if (format_ == DataFormat::Raw) {
-        // For raw source, just copy the bytes
-        std::memcpy(result->data(), data(), bufferSize_);
-        
-        // Set a metadata flag indicating this was converted from raw
-        result->setMetadata("converted_from_raw", "true");
+    if (!convertSamples(data(), format_, target, destination.format_, sampleCount_)) {
+        std::cerr << "Unsupported sample conversion" << std::endl;
+        return false;
     }
-    
-    return result;
+    return true;
 }
 
 // Create a slice of this signal (shallow copy with offset)
@@ -261,61 +266,24 @@ std::shared_ptr<Signal> Signal::slice(size_t startSample, size_t sliceSampleCoun
         throw std::out_of_range("Slice range is out of bounds");
     }
     
-    // Create a new signal
-    auto result = std::make_shared<Signal>(format_, sliceSampleCount);
-    
-    // Copy metadata
-    result->setCenterFrequency(centerFrequency_);
-    result->setSampleRate(sampleRate_);
-    result->setBandwidth(bandwidth_);
-    result->setSourceInfo(sourceInfo_);
+    // Share storage and metadata; only the window differs
+    auto result = std::make_shared<Signal>(*this);
+    result->sampleCount_ = sliceSampleCount;
+    result->bufferSize_ = calculateBufferSize(format_, sliceSampleCount);
+    result->byteOffset_ = byteOffset_ + calculateBufferSize(format_, startSample);
+    result->sliceOffset_ = sliceOffset_ + startSample;
     
     // Adjust timestamp based on the start sample offset
     double timeOffset = (sampleRate_ > 0.0) ? (static_cast<double>(startSample) / sampleRate_) : 0.0;
-    result->setTimestamp(timestamp_ + timeOffset);
-    
-    // Set ID with slice info
-    result->setId(id_ + "_slice_" + std::to_string(startSample) + "_" + std::to_string(sliceSampleCount));
-    
-    // Copy all metadata
-    for (const auto& pair : metadata_) {
-        result->setMetadata(pair.first, pair.second);
-    }
-    
-    // Set slice metadata
-    result->setMetadata("slice_start", std::to_string(startSample));
-    result->setMetadata("slice_count", std::to_string(sliceSampleCount));
-    result->setMetadata("original_id", id_);
-    
-    // Copy the data slice
-    size_t bytesPerSample = 0;
-    switch (format_) {
-        case DataFormat::ComplexFloat32:
-            bytesPerSample = sizeof(std::complex<float>);
-            break;
-        case DataFormat::ComplexInt16:
-            bytesPerSample = sizeof(std::complex<int16_t>);
-            break;
-        case DataFormat::ComplexInt8:
-            bytesPerSample = sizeof(std::complex<int8_t>);
-            break;
-        case DataFormat::Raw:
-            bytesPerSample = 1; // For raw format, 1 byte per sample
-            break;
-    }
-    
-    size_t byteOffset = startSample * bytesPerSample;
-    size_t byteCount = sliceSampleCount * bytesPerSample;
-    
-    std::memcpy(result->data(), static_cast<const uint8_t*>(data()) + byteOffset, byteCount);
+    result->timestamp_ = timestamp_ + timeOffset;
     
     return result;
 }
 
 // Clone this signal (deep copy)
 std::shared_ptr<Signal> Signal::clone() const {
-    // Create a new signal with the same format and sample count
-    auto result = std::make_shared<Signal>(format_, sampleCount_);
+    // Create a new signal with a copy of the data
+    auto result = std::make_shared<Signal>(data(), bufferSize_, format_, sampleCount_);
     
     // Copy metadata
     result->setCenterFrequency(centerFrequency_);
@@ -325,30 +293,13 @@ std::shared_ptr<Signal> Signal::clone() const {
     result->setSourceInfo(sourceInfo_);
     result->setId(id_ + "_clone");
     
-    // Copy all metadata
-    for (const auto& pair : metadata_) {
-        result->setMetadata(pair.first, pair.second);
-    }
-    
-    // Copy the data
-    std::memcpy(result->data(), data(), bufferSize_);
+    // Share metadata and provenance; they are copied if either signal modifies them
+    result->metadata_ = metadata_;
+    result->provenance_ = provenance_;
     
     return result;
 }
 
-// Get a reference to a sample by index (for ComplexFloat32 format only)
-std::complex<float>& Signal::sampleAt(size_t index) {
-    if (format_ != DataFormat::ComplexFloat32) {
-        throw std::runtime_error("Signal format is not ComplexFloat32");
-    }
-    
-    if (index >= sampleCount_) {
-        throw std::out_of_range("Sample index out of range");
-    }
-    
-    return complexFloat()[index];
-}
-
 // Get a const reference to a sample by index (for ComplexFloat32 format only)
 const std::complex<float>& Signal::sampleAt(size_t index) const {
     if (format_ != DataFormat::ComplexFloat32) {
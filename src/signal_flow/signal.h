@@ -13,6 +13,7 @@
 #include <chrono>
 #include <functional>
 #include <iostream>
+#include "metadata_map.h"
 
 namespace tdoa {
 namespace signal {
@@ -31,9 +32,9 @@ enum class DataFormat {
  * @brief Signal source information
  */
 struct SourceInfo {
-    std::string deviceType;     ///< Type of device that produced the signal
-    std::string deviceId;       ///< Unique identifier for the source device
-    std::string locationId;     ///< Identifier for the location of the device
+    InternedString deviceType;  ///< Type of device that produced the signal
+    InternedString deviceId;    ///< Unique identifier for the source device
+    InternedString locationId;  ///< Identifier for the location of the device
     double latitude;            ///< Latitude of the device in degrees
     double longitude;           ///< Longitude of the device in degrees
     double altitude;            ///< Altitude of the device in meters
@@ -42,10 +43,7 @@ struct SourceInfo {
      * @brief Default constructor with empty values
      */
     SourceInfo()
-        : deviceType("")
-        , deviceId("")
-        , locationId("")
-        , latitude(0.0)
+        : latitude(0.0)
         , longitude(0.0)
         , altitude(0.0)
     {}
@@ -57,6 +55,18 @@ struct SourceInfo {
  * This class represents a chunk of signal data with associated metadata,
  * such as timestamp, frequency, and other parameters. It supports different
  * data formats and provides methods for accessing and manipulating the data.
+ * 
+ * Sample storage, the metadata map and the provenance log are reference
+ * counted. Copies and slices share them. Reads (data, complexFloat, sampleAt,
+ * ...) never modify the signal, so any number of threads can read one signal
+ * concurrently. Writes go through the mutable accessors (mutableData,
+ * mutableComplexFloat, ...), setMetadata and addProvenance, which detach a
+ * shared signal with a private copy of just its own window; they need
+ * exclusive access to the Signal object. A pointer returned by a mutable
+ * accessor is only private until the signal is next copied or sliced, so
+ * call the accessor again after sharing the signal. Storage comes from
+ * BufferPool, so sample data is 64-byte aligned and recycled when the last
+ * signal referencing it is gone.
  */
 class Signal {
 public:
@@ -77,57 +87,66 @@ public:
     Signal(const void* data, size_t dataSize, DataFormat format, size_t sampleCount);
     
     /**
-     * @brief Destructor
+     * @brief Create a signal that adopts an existing buffer without copying
+     * @param buffer Sample buffer, typically from BufferPool; shared, not copied
+     * @param dataSize Size of the samples in buffer in bytes
+     * @param format Data format
+     * @param sampleCount Number of complex samples in the data
      */
-    virtual ~Signal();
+    Signal(std::shared_ptr<uint8_t> buffer, size_t dataSize, DataFormat format, size_t sampleCount);
     
     /**
-     * @brief Get raw data pointer
-     * @return Pointer to raw data
+     * @brief Destructor
      */
-    void* data();
+    virtual ~Signal();
     
     /**
-     * @brief Get raw data pointer (const version)
+     * @brief Get raw data pointer for reading
      * @return Const pointer to raw data
      */
     const void* data() const;
     
     /**
-     * @brief Get data as complex float samples
-     * @return Pointer to complex float samples or nullptr if format doesn't match
+     * @brief Get data as complex float samples for reading
+     * @return Const pointer to complex float samples or nullptr if format doesn't match
      */
-    std::complex<float>* complexFloat();
+    const std::complex<float>* complexFloat() const;
     
     /**
-     * @brief Get data as complex float samples (const version)
-     * @return Const pointer to complex float samples or nullptr if format doesn't match
+     * @brief Get data as complex int16 samples for reading
+     * @return Const pointer to complex int16 samples or nullptr if format doesn't match
      */
-    const std::complex<float>* complexFloat() const;
+    const std::complex<int16_t>* complexInt16() const;
     
     /**
-     * @brief Get data as complex int16 samples
-     * @return Pointer to complex int16 samples or nullptr if format doesn't match
+     * @brief Get data as complex int8 samples for reading
+     * @return Const pointer to complex int8 samples or nullptr if format doesn't match
      */
-    std::complex<int16_t>* complexInt16();
+    const std::complex<int8_t>* complexInt8() const;
     
     /**
-     * @brief Get data as complex int16 samples (const version)
-     * @return Const pointer to complex int16 samples or nullptr if format doesn't match
+     * @brief Get raw data pointer for writing, detaching shared storage first
+     * @return Pointer to this signal's private samples
      */
-    const std::complex<int16_t>* complexInt16() const;
+    void* mutableData();
     
     /**
-     * @brief Get data as complex int8 samples
-     * @return Pointer to complex int8 samples or nullptr if format doesn't match
+     * @brief Get complex float samples for writing, detaching shared storage first
+     * @return Pointer to complex float samples or nullptr if format doesn't match
      */
-    std::complex<int8_t>* complexInt8();
+    std::complex<float>* mutableComplexFloat();
     
     /**
-     * @brief Get data as complex int8 samples (const version)
-     * @return Const pointer to complex int8 samples or nullptr if format doesn't match
+     * @brief Get complex int16 samples for writing, detaching shared storage first
+     * @return Pointer to complex int16 samples or nullptr if format doesn't match
      */
-    const std::complex<int8_t>* complexInt8() const;
+    std::complex<int16_t>* mutableComplexInt16();
+    
+    /**
+     * @brief Get complex int8 samples for writing, detaching shared storage first
+     * @return Pointer to complex int8 samples or nullptr if format doesn't match
+     */
+    std::complex<int8_t>* mutableComplexInt8();
     
     /**
      * @brief Convert signal to a different data format
@@ -136,6 +155,15 @@ public:
      */
     std::shared_ptr<Signal> convertToFormat(DataFormat format) const;
     
+    /**
+     * @brief Convert this signal's samples into an existing signal without allocating
+     * 
+     * Destination keeps its own format and metadata; only its samples are written.
+     * @param destination Signal with the same sample count to receive the samples
+     * @return True if the conversion succeeded
+     */
+    bool convertInto(Signal& destination) const;
+    
     /**
      * @brief Get the data format
      * @return Data format enumeration
@@ -232,20 +260,47 @@ public:
      * @param value Metadata value
      */
     void setMetadata(const std::string& key, const std::string& value) {
-        metadata_[key] = value;
+        setMetadataValue(key, value);
+    }
+    
+    /**
+     * @brief Set a typed metadata value
+     * @param key Metadata key (intern frequently used keys once and reuse them)
+     * @param value Metadata value
+     */
+    void setMetadataValue(const MetadataKey& key, MetadataValue value) {
+        if (metadata_.use_count() > 1) {
+            metadata_ = std::make_shared<MetadataMap>(*metadata_);
+        }
+        metadata_->set(key, std::move(value));
     }
     
     /**
      * @brief Get a metadata value
      * @param key Metadata key
-     * @return Metadata value or empty string if not found
+     * @return Metadata value formatted as a string, or empty string if not found
      */
     std::string getMetadata(const std::string& key) const {
-        auto it = metadata_.find(key);
-        if (it != metadata_.end()) {
-            return it->second;
-        }
-        return "";
+        return metadata_->getString(key);
+    }
+    
+    /**
+     * @brief Get a metadata value with a default
+     * @param key Metadata key
+     * @param defaultValue Value returned if the key is not found
+     * @return Metadata value formatted as a string, or defaultValue if not found
+     */
+    std::string getMetadata(const std::string& key, const std::string& defaultValue) const {
+        return metadata_->getString(key, defaultValue);
+    }
+    
+    /**
+     * @brief Get a typed metadata value
+     * @param key Metadata key
+     * @return Pointer to the value, or nullptr if not found
+     */
+    const MetadataValue* getMetadataValue(const MetadataKey& key) const {
+        return metadata_->find(key);
     }
     
     /**
@@ -254,19 +309,54 @@ public:
      * @return True if key exists
      */
     bool hasMetadata(const std::string& key) const {
-        return metadata_.find(key) != metadata_.end();
+        return metadata_->findByName(key) != nullptr;
     }
     
     /**
      * @brief Get all metadata
-     * @return Metadata map
+     * @return Metadata map (use toStringMap() to serialize)
+     */
+    const MetadataMap& getMetadata() const {
+        return *metadata_;
+    }
+    
+    /**
+     * @brief Get the processing steps applied to this signal
+     * @return Bounded provenance log, oldest first
+     */
+    const ProvenanceLog& getProvenance() const {
+        return *provenance_;
+    }
+    
+    /**
+     * @brief Record a processing step
+     * @param componentId ID of the processing component
+     * @param componentName Name of the processing component
+     * @param operation Description of the operation performed
+     * @return Reference to the new entry for setting parameters
      */
-    const std::map<std::string, std::string>& getMetadata() const {
-        return metadata_;
+    ProvenanceEntry& addProvenance(const InternedString& componentId,
+                                   const InternedString& componentName,
+                                   const InternedString& operation) {
+        if (provenance_.use_count() > 1) {
+            provenance_ = std::make_shared<ProvenanceLog>(*provenance_);
+        }
+        return provenance_->push(componentId, componentName, operation);
+    }
+    
+    /**
+     * @brief Share another signal's provenance log (copied on the next addProvenance)
+     * @param other Signal whose processing steps this signal continues
+     */
+    void inheritProvenance(const Signal& other) {
+        provenance_ = other.provenance_;
     }
     
     /**
      * @brief Create a slice of this signal (shallow copy)
+     * 
+     * O(1): the slice shares this signal's storage and metadata, keeps its ID
+     * and has its timestamp advanced to the first sample.
      * @param startSample Starting sample index
      * @param sampleCount Number of samples in the slice
      * @return New signal object sharing the same data buffer
@@ -279,6 +369,18 @@ public:
      */
     std::shared_ptr<Signal> clone() const;
     
+    /**
+     * @brief Get the offset of this signal's first sample in the buffer it was sliced from
+     * @return Sample offset (0 for signals that are not slices)
+     */
+    size_t getSliceOffset() const { return sliceOffset_; }
+    
+    /**
+     * @brief Check whether the sample storage is shared with other signals
+     * @return True if a mutable accessor would copy the samples
+     */
+    bool isStorageShared() const { return storage_.use_count() > 1; }
+    
     /**
      * @brief Calculate the duration of the signal
      * @return Duration in seconds
@@ -287,14 +389,6 @@ public:
         return sampleRate_ > 0.0 ? static_cast<double>(sampleCount_) / sampleRate_ : 0.0;
     }
     
-    /**
-     * @brief Get a reference to a sample by index (for ComplexFloat32 format only)
-     * @param index Sample index
-     * @return Reference to sample
-     * @throws std::runtime_error if format is not ComplexFloat32
-     */
-    std::complex<float>& sampleAt(size_t index);
-    
     /**
      * @brief Get a const reference to a sample by index (for ComplexFloat32 format only)
      * @param index Sample index
@@ -304,10 +398,23 @@ public:
     const std::complex<float>& sampleAt(size_t index) const;
     
 private:
+    /**
+     * @brief Give this signal a private copy of its samples if storage is shared
+     */
+    void detach();
+    
+    /**
+     * @brief Get this signal's window in storage without detaching
+     * @return Pointer to the first sample
+     */
+    uint8_t* window() const { return storage_.get() + byteOffset_; }
+    
     DataFormat format_;               ///< Data format
     size_t sampleCount_;              ///< Number of complex samples
-    size_t bufferSize_;               ///< Size of the data buffer in bytes
-    std::vector<uint8_t> dataBuffer_; ///< Data buffer
+    size_t bufferSize_;               ///< Size of this signal's window in bytes
+    std::shared_ptr<uint8_t> storage_; ///< Shared, pooled sample storage
+    size_t byteOffset_;               ///< Offset of this signal's window in storage_
+    size_t sliceOffset_;              ///< Sample offset in the originating buffer
     
     double centerFrequency_;          ///< Center frequency in Hz
     double sampleRate_;               ///< Sample rate in samples per second
@@ -316,7 +423,8 @@ private:
     
     SourceInfo sourceInfo_;           ///< Signal source information
     std::string id_;                  ///< Signal ID
-    std::map<std::string, std::string> metadata_; ///< Additional metadata
+    std::shared_ptr<MetadataMap> metadata_;     ///< Additional metadata (copy-on-write)
+    std::shared_ptr<ProvenanceLog> provenance_; ///< Processing steps (copy-on-write)
 };
 
 /**
@@ -4,12 +4,14 @@
  */
 
 #include "signal_factory.h"
+#include "sample_conversion.h"
 #include <cmath>
 #include <random>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <stdexcept>
+#include <cstring>
 
 namespace tdoa {
 namespace signal {
@@ -84,6 +86,56 @@ std::shared_ptr<Signal> SignalFactory::createSignalFromData(
     return signal;
 }
 
+// Create a signal by converting existing data
+std::shared_ptr<Signal> SignalFactory::createConvertedSignal(
+    const void* data,
+    DataFormat sourceFormat,
+    size_t sampleCount,
+    DataFormat format,
+    double sampleRate,
+    double centerFreq,
+    double bandwidth
+) {
+    // Convert straight into a pooled buffer
+    size_t dataSize = sampleCount * getSampleSize(format);
+    auto buffer = BufferPool::getInstance().acquire(dataSize);
+    if (!buffer && dataSize > 0) {
+        std::cerr << "Failed to allocate signal buffer" << std::endl;
+        return nullptr;
+    }
+    if (!convertSamples(data, sourceFormat, buffer.get(), format, sampleCount)) {
+        std::cerr << "Unsupported sample conversion" << std::endl;
+        return nullptr;
+    }
+    
+    return createSignalFromBuffer(std::move(buffer), dataSize, format, sampleCount,
+                                  sampleRate, centerFreq, bandwidth);
+}
+
+// Create a signal adopting a pooled buffer
+std::shared_ptr<Signal> SignalFactory::createSignalFromBuffer(
+    std::shared_ptr<uint8_t> buffer,
+    size_t dataSize,
+    DataFormat format,
+    size_t sampleCount,
+    double sampleRate,
+    double centerFreq,
+    double bandwidth
+) {
+    // Create the signal around the buffer
+    auto signal = std::make_shared<Signal>(std::move(buffer), dataSize, format, sampleCount);
+    
+    // Set parameters
+    signal->setSampleRate(sampleRate);
+    signal->setCenterFrequency(centerFreq);
+    signal->setBandwidth(bandwidth);
+    signal->setTimestamp(std::chrono::duration<double>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    signal->setId(generateSignalId());
+    
+    return signal;
+}
+
 // Create a signal with a sine wave
 std::shared_ptr<Signal> SignalFactory::createSineWaveSignal(
     DataFormat format,
@@ -102,8 +154,8 @@ std::shared_ptr<Signal> SignalFactory::createSineWaveSignal(
     // Create an empty signal
     auto signal = createEmptySignal(format, sampleCount, sampleRate, centerFreq, bandwidth);
     signal->setMetadata("signal_type", "sine_wave");
-    signal->setMetadata("signal_freq", std::to_string(signalFreq));
-    signal->setMetadata("amplitude", std::to_string(amplitude));
+    signal->setMetadataValue("signal_freq", signalFreq);
+    signal->setMetadataValue("amplitude", amplitude);
     
     // If the format is not ComplexFloat32, we need to convert
     std::shared_ptr<Signal> workSignal;
@@ -116,7 +168,7 @@ std::shared_ptr<Signal> SignalFactory::createSineWaveSignal(
     }
     
     // Generate the sine wave
-    auto* samples = workSignal->complexFloat();
+    auto* samples = workSignal->mutableComplexFloat();
     const double phaseIncrement = 2.0 * M_PI * signalFreq / sampleRate;
     double phase = 0.0;
     
@@ -135,13 +187,10 @@ std::shared_ptr<Signal> SignalFactory::createSineWaveSignal(
     
     // Convert to the target format if needed
     if (format != DataFormat::ComplexFloat32) {
-        // Convert and copy metadata
-        auto convertedSignal = workSignal->convertToFormat(format);
+        // Convert straight into the signal's buffer and record the conversion
+        workSignal->convertInto(*signal);
         signal->setMetadata("original_format", "ComplexFloat32");
         signal->setMetadata("converted_to", signal->getMetadata("format"));
-        
-        // Copy the converted data
-        std::memcpy(signal->data(), convertedSignal->data(), signal->getBufferSize());
     }
     
     return signal;
@@ -164,7 +213,7 @@ std::shared_ptr<Signal> SignalFactory::createNoiseSignal(
     // Create an empty signal
     auto signal = createEmptySignal(format, sampleCount, sampleRate, centerFreq, bandwidth);
     signal->setMetadata("signal_type", "noise");
-    signal->setMetadata("amplitude", std::to_string(amplitude));
+    signal->setMetadataValue("amplitude", amplitude);
     
     // If the format is not ComplexFloat32, we need to convert
     std::shared_ptr<Signal> workSignal;
@@ -177,7 +226,7 @@ std::shared_ptr<Signal> SignalFactory::createNoiseSignal(
     }
     
     // Generate white noise
-    auto* samples = workSignal->complexFloat();
+    auto* samples = workSignal->mutableComplexFloat();
     
     // Random number generators
     std::random_device rd;
@@ -190,13 +239,10 @@ std::shared_ptr<Signal> SignalFactory::createNoiseSignal(
     
     // Convert to the target format if needed
     if (format != DataFormat::ComplexFloat32) {
-        // Convert and copy metadata
-        auto convertedSignal = workSignal->convertToFormat(format);
+        // Convert straight into the signal's buffer and record the conversion
+        workSignal->convertInto(*signal);
         signal->setMetadata("original_format", "ComplexFloat32");
         signal->setMetadata("converted_to", signal->getMetadata("format"));
-        
-        // Copy the converted data
-        std::memcpy(signal->data(), convertedSignal->data(), signal->getBufferSize());
     }
     
     return signal;
@@ -221,9 +267,9 @@ std::shared_ptr<Signal> SignalFactory::createChirpSignal(
     // Create an empty signal
     auto signal = createEmptySignal(format, sampleCount, sampleRate, centerFreq, bandwidth);
     signal->setMetadata("signal_type", "chirp");
-    signal->setMetadata("start_freq", std::to_string(startFreq));
-    signal->setMetadata("end_freq", std::to_string(endFreq));
-    signal->setMetadata("amplitude", std::to_string(amplitude));
+    signal->setMetadataValue("start_freq", startFreq);
+    signal->setMetadataValue("end_freq", endFreq);
+    signal->setMetadataValue("amplitude", amplitude);
     
     // If the format is not ComplexFloat32, we need to convert
     std::shared_ptr<Signal> workSignal;
@@ -236,7 +282,7 @@ std::shared_ptr<Signal> SignalFactory::createChirpSignal(
     }
     
     // Generate the chirp signal
-    auto* samples = workSignal->complexFloat();
+    auto* samples = workSignal->mutableComplexFloat();
     
     // Time duration
     const double duration = static_cast<double>(sampleCount) / sampleRate;
@@ -274,13 +320,10 @@ std::shared_ptr<Signal> SignalFactory::createChirpSignal(
     
     // Convert to the target format if needed
     if (format != DataFormat::ComplexFloat32) {
-        // Convert and copy metadata
-        auto convertedSignal = workSignal->convertToFormat(format);
+        // Convert straight into the signal's buffer and record the conversion
+        workSignal->convertInto(*signal);
         signal->setMetadata("original_format", "ComplexFloat32");
         signal->setMetadata("converted_to", signal->getMetadata("format"));
-        
-        // Copy the converted data
-        std::memcpy(signal->data(), convertedSignal->data(), signal->getBufferSize());
     }
     
     return signal;
@@ -304,7 +347,7 @@ std::shared_ptr<Signal> SignalFactory::createMultiCarrierSignal(
     // Create an empty signal
     auto signal = createEmptySignal(format, sampleCount, sampleRate, centerFreq, bandwidth);
     signal->setMetadata("signal_type", "multi_carrier");
-    signal->setMetadata("carrier_count", std::to_string(carriers.size()));
+    signal->setMetadataValue("carrier_count", carriers.size());
     
     // If the format is not ComplexFloat32, we need to convert
     std::shared_ptr<Signal> workSignal;
@@ -317,7 +360,7 @@ std::shared_ptr<Signal> SignalFactory::createMultiCarrierSignal(
     }
     
     // Get samples pointer
-    auto* samples = workSignal->complexFloat();
+    auto* samples = workSignal->mutableComplexFloat();
     
     // Initialize samples to zero
     for (size_t i = 0; i < sampleCount; i++) {
@@ -327,8 +370,8 @@ std::shared_ptr<Signal> SignalFactory::createMultiCarrierSignal(
     // Add each carrier
     for (size_t c = 0; c < carriers.size(); c++) {
         // Store carrier info in metadata
-        signal->setMetadata("carrier_" + std::to_string(c) + "_freq", std::to_string(carriers[c]));
-        signal->setMetadata("carrier_" + std::to_string(c) + "_amplitude", std::to_string(amplitudes[c]));
+        signal->setMetadataValue("carrier_" + std::to_string(c) + "_freq", carriers[c]);
+        signal->setMetadataValue("carrier_" + std::to_string(c) + "_amplitude", amplitudes[c]);
         
         // Validate amplitude
         if (amplitudes[c] <= 0.0 || amplitudes[c] > 1.0) {
@@ -355,13 +398,10 @@ std::shared_ptr<Signal> SignalFactory::createMultiCarrierSignal(
     
     // Convert to the target format if needed
     if (format != DataFormat::ComplexFloat32) {
-        // Convert and copy metadata
-        auto convertedSignal = workSignal->convertToFormat(format);
+        // Convert straight into the signal's buffer and record the conversion
+        workSignal->convertInto(*signal);
         signal->setMetadata("original_format", "ComplexFloat32");
         signal->setMetadata("converted_to", signal->getMetadata("format"));
-        
-        // Copy the converted data
-        std::memcpy(signal->data(), convertedSignal->data(), signal->getBufferSize());
     }
     
     return signal;
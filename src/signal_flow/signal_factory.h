@@ -6,6 +6,7 @@
 #pragma once
 
 #include "signal.h"
+#include "buffer_pool.h"
 #include <random>
 #include <ctime>
 #include <string>
@@ -41,7 +42,7 @@ public:
     
     /**
      * @brief Create a signal from existing data
-     * @param data Raw data buffer (will be copied)
+     * @param data Raw data buffer (will be copied into a pooled buffer)
      * @param dataSize Size of data buffer in bytes
      * @param format Data format
      * @param sampleCount Number of complex samples in the data
@@ -60,6 +61,54 @@ public:
         double bandwidth
     );
     
+    /**
+     * @brief Create a signal by converting existing data to another format in one pass
+     * 
+     * Used on ingest to turn device samples (e.g. BB60C int16) into the
+     * processing format without an intermediate copy.
+     * @param data Source samples (converted, not retained)
+     * @param sourceFormat Format of the source samples
+     * @param sampleCount Number of complex samples in the data
+     * @param format Data format of the created signal
+     * @param sampleRate Sample rate in samples per second
+     * @param centerFreq Center frequency in Hz
+     * @param bandwidth Bandwidth in Hz
+     * @return Shared pointer to the created Signal, or nullptr if the conversion is unsupported
+     */
+    static std::shared_ptr<Signal> createConvertedSignal(
+        const void* data,
+        DataFormat sourceFormat,
+        size_t sampleCount,
+        DataFormat format,
+        double sampleRate,
+        double centerFreq,
+        double bandwidth
+    );
+    
+    /**
+     * @brief Create a signal that adopts a pooled buffer without copying
+     * 
+     * Intended for ingest paths that fetch samples straight into a buffer
+     * obtained from BufferPool::acquire.
+     * @param buffer Sample buffer (shared, not copied)
+     * @param dataSize Size of the samples in buffer in bytes
+     * @param format Data format
+     * @param sampleCount Number of complex samples in the data
+     * @param sampleRate Sample rate in samples per second
+     * @param centerFreq Center frequency in Hz
+     * @param bandwidth Bandwidth in Hz
+     * @return Shared pointer to the created Signal
+     */
+    static std::shared_ptr<Signal> createSignalFromBuffer(
+        std::shared_ptr<uint8_t> buffer,
+        size_t dataSize,
+        DataFormat format,
+        size_t sampleCount,
+        double sampleRate,
+        double centerFreq,
+        double bandwidth
+    );
+    
     /**
      * @brief Create a signal with a sine wave at a specified frequency
      * @param format Data format
@@ -4,6 +4,8 @@
  */
 
 #include "signal_flow.h"
+#include "parallel_signal_detector.h"
+#include <algorithm>
 #include <iostream>
 
 namespace tdoa {
@@ -17,7 +19,13 @@ SignalFlow& SignalFlow::getInstance() {
 
 // Private constructor for singleton
 SignalFlow::SignalFlow() {
-    // Initialize components will be done explicitly via initialize() method
+    // Initialize components will be done explicitly via initialize() method.
+    // Construct the singletons shutdown() uses now, so they are destroyed
+    // after this one and are still alive when the destructor calls it.
+    ResourceManager::getInstance();
+    ParallelEngine::getInstance();
+    ParallelEngine::getEngineNames();
+    SignalPrioritizer::getInstance();
 }
 
 // Private destructor for singleton
@@ -52,9 +60,10 @@ bool SignalFlow::initialize(size_t numThreads, size_t maxQueueSize) {
 
 // Shutdown the signal flow architecture
 void SignalFlow::shutdown() {
-    // Shutdown parallel engine
-    ParallelEngine& parallelEngine = ParallelEngine::getInstance();
-    parallelEngine.shutdown();
+    // Shutdown the default and all named parallel engines
+    for (const auto& name : ParallelEngine::getEngineNames()) {
+        ParallelEngine::getEngine(name).shutdown();
+    }
     
     // Reset resource manager
     ResourceManager& resourceManager = ResourceManager::getInstance();
@@ -192,5 +201,53 @@ ParallelEngine& SignalFlow::getParallelEngine() {
     return ParallelEngine::getInstance();
 }
 
+// Get a named parallel engine
+ParallelEngine& SignalFlow::getParallelEngine(const std::string& name) {
+    return ParallelEngine::getEngine(name);
+}
+
+// Link a detector into the ingest pipeline
+IngestFlow SignalFlow::connectIngest(
+    std::shared_ptr<ParallelSignalDetector> detector,
+    const IngestFlowConfig& config
+) {
+    IngestFlow flow;
+    if (!detector) {
+        std::cerr << "Error: Invalid detector for connectIngest" << std::endl;
+        return flow;
+    }
+    
+    flow.extractorChannel = CreditChannel::create("extractor", config.extractorCapacity);
+    flow.detectorChannel = CreditChannel::create("detector", config.detectorCapacity);
+    flow.detectorChannel->setDownstream(flow.extractorChannel);
+    std::shared_ptr<CreditChannel> extractorChannel = flow.extractorChannel;
+    flow.extractorAdmission = [extractorChannel]() { return extractorChannel->tryAcquireCredit(); };
+    detector->setInputChannel(flow.detectorChannel);
+    flow.shedController = std::make_shared<ShedController>(flow.detectorChannel, config.shed);
+    
+    // Narrow around the centre of the band the detector had when connected
+    const DetectionConfig connected = detector->getConfig();
+    const double fraction = std::min(1.0, std::max(0.0, config.reducedBandFraction));
+    const double centre = 0.5 * (connected.minFrequency + connected.maxFrequency);
+    const double halfWidth = 0.5 * fraction * (connected.maxFrequency - connected.minFrequency);
+    std::weak_ptr<ParallelSignalDetector> target = detector;
+    
+    flow.shedController->setLevelHandler([target, connected, centre, halfWidth](ShedLevel previous, ShedLevel level) {
+        const bool wasReduced = previous != ShedLevel::NONE;
+        const bool reduced = level != ShedLevel::NONE;
+        std::shared_ptr<ParallelSignalDetector> detector = target.lock();
+        if (!detector || wasReduced == reduced) {
+            return;
+        }
+        
+        DetectionConfig detection = detector->getConfig();
+        detection.minFrequency = reduced ? centre - halfWidth : connected.minFrequency;
+        detection.maxFrequency = reduced ? centre + halfWidth : connected.maxFrequency;
+        detector->updateConfig(detection);
+    });
+    
+    return flow;
+}
+
 } // namespace signal
-} // namespace tdoa 
\ No newline at end of file
+} // namespace tdoa
@@ -13,6 +13,7 @@
 #include "resource_manager.h"
 #include "signal_prioritizer.h"
 #include "parallel_engine.h"
+#include "flow_control.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -21,6 +22,46 @@
 namespace tdoa {
 namespace signal {
 
+class ParallelSignalDetector;
+
+/**
+ * @brief Credit capacities and shedding of the ingest pipeline
+ */
+struct IngestFlowConfig {
+    size_t detectorCapacity;        ///< Segments the detector holds at once
+    size_t extractorCapacity;       ///< Detection sets the extractor holds at once
+    double reducedBandFraction;     ///< Fraction of the detection band kept from REDUCE_BAND up (0-1]
+    ShedConfig shed;                ///< Shed thresholds at the source
+
+    /**
+     * @brief Constructor with default values
+     */
+    IngestFlowConfig()
+        : detectorCapacity(8)
+        , extractorCapacity(4)
+        , reducedBandFraction(0.5)
+    {}
+};
+
+/**
+ * @brief Credit channels and shed controller linking device, detector and extractor
+ *
+ * The device takes shedController with setShedController and hands each
+ * admitted block to the detector together with its credit (takeBlockCredit),
+ * so the block is charged to detectorChannel once. The time difference
+ * extractor takes extractorAdmission with setAdmissionHandler, so each
+ * detection set holds a credit of extractorChannel from correlation until the
+ * solver and database have consumed it in the extractor's callback, and sets
+ * arriving with no credit left are shed; a slow extractor then raises the
+ * pressure the source sheds on.
+ */
+struct IngestFlow {
+    std::shared_ptr<CreditChannel> detectorChannel;     ///< Input channel of the detector
+    std::shared_ptr<CreditChannel> extractorChannel;    ///< Input channel of the extractor, downstream of the detector
+    std::shared_ptr<ShedController> shedController;     ///< Source shedding on the detector channel
+    std::function<CreditChannel::Credit()> extractorAdmission; ///< Takes one extractorChannel credit (null if none left)
+};
+
 /**
  * @brief Signal flow architecture class
  * 
@@ -151,6 +192,31 @@ public:
      */
     ParallelEngine& getParallelEngine();
     
+    /**
+     * @brief Get a named parallel engine, creating it if needed
+     * @param name Engine name
+     * @return Reference to the parallel engine (initialize it before use)
+     */
+    ParallelEngine& getParallelEngine(const std::string& name);
+    
+    /**
+     * @brief Link a detector into the ingest pipeline with credit flow control
+     *
+     * Creates the detector and extractor channels, links them, sets the
+     * detector's input channel and returns a shed controller for the device
+     * and an admission handler for the time difference extractor.
+     * From REDUCE_BAND up the controller narrows the detector to the centre
+     * reducedBandFraction of the band it had when connected, and restores that
+     * band when shedding stops.
+     * @param detector Detector fed by the device
+     * @param config Capacities and shed thresholds
+     * @return Channels, shed controller and admission handler, all null if detector is null
+     */
+    IngestFlow connectIngest(
+        std::shared_ptr<ParallelSignalDetector> detector,
+        const IngestFlowConfig& config = IngestFlowConfig()
+    );
+    
 private:
     /**
      * @brief Private constructor for singleton
@@ -21,62 +21,37 @@ SignalMetadata::~SignalMetadata() {
 
 // Set a source information value
 void SignalMetadata::setSourceInfo(const std::string& key, const std::string& value) {
-    sourceInfo_[key] = value;
+    sourceInfo_.set(key, value);
 }
 
 // Get a source information value
 std::string SignalMetadata::getSourceInfo(const std::string& key) const {
-    auto it = sourceInfo_.find(key);
-    if (it != sourceInfo_.end()) {
-        return it->second;
-    }
-    return "";
+    return sourceInfo_.getString(key);
 }
 
 // Check if source information key exists
 bool SignalMetadata::hasSourceInfo(const std::string& key) const {
-    return sourceInfo_.find(key) != sourceInfo_.end();
+    return sourceInfo_.findByName(key) != nullptr;
 }
 
 // Set a quality metric value
 void SignalMetadata::setQualityMetric(const std::string& key, double value) {
-    qualityMetrics_[key] = value;
+    qualityMetrics_.set(key, value);
 }
 
 // Get a quality metric value
 double SignalMetadata::getQualityMetric(const std::string& key, double defaultValue) const {
-    auto it = qualityMetrics_.find(key);
-    if (it != qualityMetrics_.end()) {
-        return it->second;
-    }
-    return defaultValue;
+    return qualityMetrics_.getDouble(key, defaultValue);
 }
 
 // Check if quality metric key exists
 bool SignalMetadata::hasQualityMetric(const std::string& key) const {
-    return qualityMetrics_.find(key) != qualityMetrics_.end();
-}
-
-// ProcessingHistoryEntry default constructor
-SignalMetadata::ProcessingHistoryEntry::ProcessingHistoryEntry()
-    : timestamp(std::chrono::system_clock::now()) {
-}
-
-// ProcessingHistoryEntry parameterized constructor
-SignalMetadata::ProcessingHistoryEntry::ProcessingHistoryEntry(
-    const std::string& componentId,
-    const std::string& componentName,
-    const std::string& operation
-)
-    : componentId(componentId)
-    , componentName(componentName)
-    , operation(operation)
-    , timestamp(std::chrono::system_clock::now()) {
+    return qualityMetrics_.findByName(key) != nullptr;
 }
 
 // Add a processing history entry
 void SignalMetadata::addProcessingHistoryEntry(const ProcessingHistoryEntry& entry) {
-    processingHistory_.push_back(entry);
+    processingHistory_.push(entry);
 }
 
 // Add a processing history entry with core parameters
@@ -85,8 +60,7 @@ SignalMetadata::ProcessingHistoryEntry& SignalMetadata::addProcessingHistoryEntr
     const std::string& componentName,
     const std::string& operation
 ) {
-    processingHistory_.emplace_back(componentId, componentName, operation);
-    return processingHistory_.back();
+    return processingHistory_.push(componentId, componentName, operation);
 }
 
 // Add a classification tag
@@ -95,60 +69,38 @@ void SignalMetadata::addClassificationTag(const std::string& tag, double confide
     if (confidence < 0.0 || confidence > 1.0) {
         throw std::out_of_range("Classification tag confidence must be between 0.0 and 1.0");
     }
-    classificationTags_[tag] = confidence;
+    classificationTags_.set(tag, confidence);
 }
 
 // Remove a classification tag
 bool SignalMetadata::removeClassificationTag(const std::string& tag) {
-    auto it = classificationTags_.find(tag);
-    if (it != classificationTags_.end()) {
-        classificationTags_.erase(it);
-        return true;
-    }
-    return false;
+    MetadataKey key = MetadataKey::lookup(tag);
+    return !key.empty() && classificationTags_.erase(key);
 }
 
 // Check if a classification tag exists
 bool SignalMetadata::hasClassificationTag(const std::string& tag) const {
-    return classificationTags_.find(tag) != classificationTags_.end();
+    return classificationTags_.findByName(tag) != nullptr;
 }
 
 // Get the confidence value for a tag
 double SignalMetadata::getTagConfidence(const std::string& tag, double defaultValue) const {
-    auto it = classificationTags_.find(tag);
-    if (it != classificationTags_.end()) {
-        return it->second;
-    }
-    return defaultValue;
+    return classificationTags_.getDouble(tag, defaultValue);
 }
 
 // Merge metadata from another instance
 void SignalMetadata::merge(const SignalMetadata& other, bool overwrite) {
     // Merge source information
-    for (const auto& pair : other.sourceInfo_) {
-        if (overwrite || !hasSourceInfo(pair.first)) {
-            sourceInfo_[pair.first] = pair.second;
-        }
-    }
+    sourceInfo_.merge(other.sourceInfo_, overwrite);
     
     // Merge quality metrics
-    for (const auto& pair : other.qualityMetrics_) {
-        if (overwrite || !hasQualityMetric(pair.first)) {
-            qualityMetrics_[pair.first] = pair.second;
-        }
-    }
+    qualityMetrics_.merge(other.qualityMetrics_, overwrite);
     
-    // Append processing history (always append all entries)
-    for (const auto& entry : other.processingHistory_) {
-        processingHistory_.push_back(entry);
-    }
+    // Append processing history (always append all entries; the oldest drop out when full)
+    processingHistory_.append(other.processingHistory_);
     
     // Merge classification tags
-    for (const auto& pair : other.classificationTags_) {
-        if (overwrite || !hasClassificationTag(pair.first)) {
-            classificationTags_[pair.first] = pair.second;
-        }
-    }
+    classificationTags_.merge(other.classificationTags_, overwrite);
 }
 
 // Clone this metadata object
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "metadata_map.h"
 #include <string>
 #include <map>
 #include <vector>
@@ -19,7 +20,9 @@ namespace signal {
  * 
  * This class provides a structured way to store and access metadata
  * about signal processing, including source information, quality metrics,
- * processing history, and classification tags.
+ * processing history, and classification tags. Values are kept in flat
+ * interned-key maps and the history in a bounded ring, so copies are a few
+ * allocations regardless of how many stages a signal has passed through.
  */
 class SignalMetadata {
 public:
@@ -37,7 +40,7 @@ public:
      * @brief Get the signal source information
      * @return Map of source information key-value pairs
      */
-    const std::map<std::string, std::string>& getSourceInfo() const { return sourceInfo_; }
+    const MetadataMap& getSourceInfo() const { return sourceInfo_; }
     
     /**
      * @brief Set a source information value
@@ -64,7 +67,7 @@ public:
      * @brief Get the quality metrics
      * @return Map of quality metric key-value pairs
      */
-    const std::map<std::string, double>& getQualityMetrics() const { return qualityMetrics_; }
+    const MetadataMap& getQualityMetrics() const { return qualityMetrics_; }
     
     /**
      * @brief Set a quality metric value
@@ -91,20 +94,7 @@ public:
     /**
      * @brief Processing history entry structure
      */
-    struct ProcessingHistoryEntry {
-        std::string componentId;       ///< ID of the processing component
-        std::string componentName;     ///< Name of the processing component
-        std::string operation;         ///< Description of the operation performed
-        std::chrono::system_clock::time_point timestamp; ///< Timestamp of the operation
-        std::map<std::string, std::string> parameters;   ///< Parameters used for the operation
-        
-        ProcessingHistoryEntry();
-        ProcessingHistoryEntry(
-            const std::string& componentId,
-            const std::string& componentName,
-            const std::string& operation
-        );
-    };
+    using ProcessingHistoryEntry = ProvenanceEntry;
     
     /**
      * @brief Add a processing history entry
@@ -118,6 +108,7 @@ public:
      * @param componentName Name of the processing component
      * @param operation Description of the operation performed
      * @return Reference to the newly added entry for parameter setting
+     *         (valid until the entry is overwritten by newer history)
      */
     ProcessingHistoryEntry& addProcessingHistoryEntry(
         const std::string& componentId,
@@ -127,9 +118,9 @@ public:
     
     /**
      * @brief Get the processing history
-     * @return Vector of processing history entries
+     * @return Bounded log of processing history entries, oldest first
      */
-    const std::vector<ProcessingHistoryEntry>& getProcessingHistory() const { return processingHistory_; }
+    const ProvenanceLog& getProcessingHistory() const { return processingHistory_; }
     
     /**
      * @brief Add a classification tag
@@ -149,7 +140,7 @@ public:
      * @brief Get all classification tags
      * @return Map of tag names to confidence values
      */
-    const std::map<std::string, double>& getClassificationTags() const { return classificationTags_; }
+    const MetadataMap& getClassificationTags() const { return classificationTags_; }
     
     /**
      * @brief Check if a classification tag exists
@@ -180,10 +171,10 @@ public:
     std::shared_ptr<SignalMetadata> clone() const;
     
 private:
-    std::map<std::string, std::string> sourceInfo_;        ///< Source information
-    std::map<std::string, double> qualityMetrics_;         ///< Quality metrics
-    std::vector<ProcessingHistoryEntry> processingHistory_; ///< Processing history
-    std::map<std::string, double> classificationTags_;     ///< Classification tags
+    MetadataMap sourceInfo_;                ///< Source information
+    MetadataMap qualityMetrics_;            ///< Quality metrics
+    ProvenanceLog processingHistory_;       ///< Processing history (bounded)
+    MetadataMap classificationTags_;        ///< Classification tags
 };
 
 } // namespace signal
@@ -7,10 +7,284 @@
 #include <iostream>
 #include <algorithm>
 #include <cmath>
+#include <unordered_map>
 
 namespace tdoa {
 namespace signal {
 
+// Signal priorities in an indexed max-heap with a timer wheel for expiry
+struct SignalPrioritizer::PriorityIndex {
+    static constexpr uint32_t NONE = 0xffffffffu;
+    
+    /**
+     * @brief Pooled signal priority with its heap position and wheel links
+     */
+    struct Entry {
+        SignalPriority priority;
+        uint32_t heapPosition = NONE;   ///< Position in heap (NONE = free slot)
+        int64_t expiryTick = 0;         ///< Tick at which the signal expires
+        uint32_t wheelPrev = NONE;      ///< Previous entry in the wheel bucket
+        uint32_t wheelNext = NONE;      ///< Next entry in the wheel bucket, or next free slot
+    };
+    
+    std::vector<Entry> entries;                         ///< Entry pool, bounded by maxSignals
+    std::unordered_map<std::string, uint32_t> lookup;   ///< Signal ID to entry
+    std::vector<uint32_t> heap;                         ///< Entries ordered by priority, then score
+    std::vector<uint32_t> buckets;                      ///< Timer wheel: first entry per tick modulo size
+    std::vector<uint32_t> tails;                        ///< Last entry per bucket, so buckets stay in link order
+    uint32_t freeList = NONE;                           ///< First free entry
+    std::chrono::steady_clock::time_point epoch;        ///< Tick 0
+    std::chrono::nanoseconds tick;                      ///< Tick length
+    int64_t ttlTicks = 0;                               ///< TTL in ticks (0 = never expire)
+    int64_t currentTick = 0;                            ///< Last tick whose bucket was processed
+    size_t maxSignals = 0;                              ///< Entry limit (0 = unlimited)
+    
+    PriorityIndex()
+        : epoch(std::chrono::steady_clock::now()) {
+        configure(PrioritizerConfig());
+    }
+    
+    /**
+     * @brief Apply a configuration; tracked signals restart their TTL
+     */
+    void configure(const PrioritizerConfig& config) {
+        tick = std::max<std::chrono::nanoseconds>(config.tick, std::chrono::milliseconds(1));
+        ttlTicks = config.ttl.count() > 0 ? std::max<int64_t>(1, (config.ttl + tick - std::chrono::nanoseconds(1)) / tick) : 0;
+        maxSignals = config.maxSignals;
+        
+        // One bucket per tick of the TTL, so an expiry pass visits only due buckets
+        size_t size = 64;
+        while (size < static_cast<size_t>(ttlTicks) + 1 && size < (1u << 16)) {
+            size <<= 1;
+        }
+        buckets.assign(size, NONE);
+        tails.assign(size, NONE);
+        
+        currentTick = tickAt(std::chrono::steady_clock::now());
+        for (uint32_t slot : heap) {
+            link(slot, currentTick + expiryDelay());
+        }
+        if (maxSignals > 0) {
+            lookup.reserve(maxSignals);
+            while (heap.size() > maxSignals) {
+                evict();
+            }
+        }
+    }
+    
+    int64_t tickAt(std::chrono::steady_clock::time_point time) const {
+        return (time - epoch) / tick;
+    }
+    
+    int64_t expiryDelay() const {
+        // Without a TTL the wheel still orders signals by last update for eviction
+        return ttlTicks;
+    }
+    
+    bool isExpired(uint32_t slot, int64_t now) const {
+        return ttlTicks > 0 && entries[slot].expiryTick <= now;
+    }
+    
+    uint32_t find(const std::string& signalId) const {
+        auto it = lookup.find(signalId);
+        return it != lookup.end() ? it->second : NONE;
+    }
+    
+    /**
+     * @brief Whether entry a ranks above entry b
+     */
+    bool higher(uint32_t a, uint32_t b) const {
+        const SignalPriority& first = entries[a].priority;
+        const SignalPriority& second = entries[b].priority;
+        if (first.priority != second.priority) {
+            return static_cast<int>(first.priority) > static_cast<int>(second.priority);
+        }
+        return first.priorityScore > second.priorityScore;
+    }
+    
+    void place(size_t position, uint32_t slot) {
+        heap[position] = slot;
+        entries[slot].heapPosition = static_cast<uint32_t>(position);
+    }
+    
+    void siftUp(size_t position) {
+        uint32_t slot = heap[position];
+        while (position > 0) {
+            size_t parent = (position - 1) / 2;
+            if (!higher(slot, heap[parent])) {
+                break;
+            }
+            place(position, heap[parent]);
+            position = parent;
+        }
+        place(position, slot);
+    }
+    
+    void siftDown(size_t position) {
+        uint32_t slot = heap[position];
+        size_t size = heap.size();
+        while (true) {
+            size_t child = 2 * position + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && higher(heap[child + 1], heap[child])) {
+                child++;
+            }
+            if (!higher(heap[child], slot)) {
+                break;
+            }
+            place(position, heap[child]);
+            position = child;
+        }
+        place(position, slot);
+    }
+    
+    /**
+     * @brief Restore heap order after an entry's priority or score changed
+     */
+    void reorder(uint32_t slot) {
+        siftUp(entries[slot].heapPosition);
+        siftDown(entries[slot].heapPosition);
+    }
+    
+    /**
+     * @brief Append an entry to its bucket, so each bucket runs oldest first
+     */
+    void link(uint32_t slot, int64_t expiryTick) {
+        Entry& entry = entries[slot];
+        size_t bucket = static_cast<size_t>(expiryTick) & (buckets.size() - 1);
+        entry.expiryTick = expiryTick;
+        entry.wheelPrev = tails[bucket];
+        entry.wheelNext = NONE;
+        if (tails[bucket] != NONE) {
+            entries[tails[bucket]].wheelNext = slot;
+        } else {
+            buckets[bucket] = slot;
+        }
+        tails[bucket] = slot;
+    }
+    
+    void unlink(uint32_t slot) {
+        Entry& entry = entries[slot];
+        size_t bucket = static_cast<size_t>(entry.expiryTick) & (buckets.size() - 1);
+        if (entry.wheelPrev != NONE) {
+            entries[entry.wheelPrev].wheelNext = entry.wheelNext;
+        } else {
+            buckets[bucket] = entry.wheelNext;
+        }
+        if (entry.wheelNext != NONE) {
+            entries[entry.wheelNext].wheelPrev = entry.wheelPrev;
+        } else {
+            tails[bucket] = entry.wheelPrev;
+        }
+    }
+    
+    /**
+     * @brief Restart an entry's TTL
+     */
+    void touch(uint32_t slot) {
+        unlink(slot);
+        link(slot, currentTick + expiryDelay());
+    }
+    
+    /**
+     * @brief Add a signal that is not tracked yet
+     */
+    uint32_t insert(SignalPriority priority) {
+        if (maxSignals > 0 && heap.size() >= maxSignals) {
+            evict();
+        }
+        
+        uint32_t slot;
+        if (freeList != NONE) {
+            slot = freeList;
+            freeList = entries[slot].wheelNext;
+        } else {
+            slot = static_cast<uint32_t>(entries.size());
+            entries.emplace_back();
+        }
+        
+        lookup[priority.signalId] = slot;
+        entries[slot].priority = std::move(priority);
+        heap.push_back(slot);
+        siftUp(heap.size() - 1);
+        link(slot, currentTick + expiryDelay());
+        return slot;
+    }
+    
+    void remove(uint32_t slot) {
+        Entry& entry = entries[slot];
+        unlink(slot);
+        
+        size_t position = entry.heapPosition;
+        uint32_t last = heap.back();
+        heap.pop_back();
+        if (position < heap.size()) {
+            place(position, last);
+            reorder(last);
+        }
+        
+        lookup.erase(entry.priority.signalId);
+        entry.priority = SignalPriority();
+        entry.heapPosition = NONE;
+        entry.wheelNext = freeList;
+        freeList = slot;
+    }
+    
+    /**
+     * @brief Remove a signal from the next bucket to expire
+     *
+     * Within one turn of the wheel that is the signal closest to expiry;
+     * signals older than a turn share buckets with newer ones, so beyond
+     * that it is one of the least recently updated.
+     */
+    void evict() {
+        for (size_t i = 1; i <= buckets.size(); i++) {
+            uint32_t slot = buckets[static_cast<size_t>(currentTick + static_cast<int64_t>(i)) & (buckets.size() - 1)];
+            if (slot != NONE) {
+                remove(slot);
+                return;
+            }
+        }
+    }
+    
+    /**
+     * @brief Move the wheel to the current time, removing expired signals
+     * @return Number of signals removed
+     */
+    size_t advance(std::chrono::steady_clock::time_point now) {
+        int64_t target = tickAt(now);
+        size_t removed = 0;
+        if (ttlTicks > 0 && target > currentTick) {
+            // A full turn visits every bucket once
+            int64_t steps = std::min<int64_t>(target - currentTick, static_cast<int64_t>(buckets.size()));
+            for (int64_t step = 1; step <= steps; step++) {
+                uint32_t slot = buckets[static_cast<size_t>(currentTick + step) & (buckets.size() - 1)];
+                while (slot != NONE) {
+                    uint32_t next = entries[slot].wheelNext;
+                    if (entries[slot].expiryTick <= target) {
+                        remove(slot);
+                        removed++;
+                    }
+                    slot = next;
+                }
+            }
+        }
+        currentTick = std::max(currentTick, target);
+        return removed;
+    }
+    
+    void clear() {
+        entries.clear();
+        lookup.clear();
+        heap.clear();
+        std::fill(buckets.begin(), buckets.end(), NONE);
+        std::fill(tails.begin(), tails.end(), NONE);
+        freeList = NONE;
+    }
+};
+
 // Singleton instance accessor
 SignalPrioritizer& SignalPrioritizer::getInstance() {
     static SignalPrioritizer instance;
@@ -19,7 +293,8 @@ SignalPrioritizer& SignalPrioritizer::getInstance() {
 
 // Private constructor for singleton
 SignalPrioritizer::SignalPrioritizer()
-    : nextCallbackId_(0) {
+    : index_(new PriorityIndex())
+    , nextCallbackId_(0) {
     
     // Set the default policy
     setDefaultPolicy();
@@ -33,14 +308,14 @@ SignalPrioritizer::~SignalPrioritizer() {
 
 // Set the prioritization policy
 void SignalPrioritizer::setPrioritizationPolicy(PrioritizationPolicy policy) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    if (policy) {
-        policy_ = policy;
-    } else {
+    if (!policy) {
         // Set default policy if null
         setDefaultPolicy();
+        return;
     }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = policy;
 }
 
 // Set the default policy
@@ -52,20 +327,47 @@ void SignalPrioritizer::setDefaultPolicy() {
     };
 }
 
+// Set expiry and capacity
+void SignalPrioritizer::configure(const PrioritizerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    index_->configure(config);
+}
+
+// Get the configuration
+PrioritizerConfig SignalPrioritizer::getConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+// Remove signals whose TTL has passed
+size_t SignalPrioritizer::expireSignals() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_->advance(std::chrono::steady_clock::now());
+}
+
+// Get the number of tracked signals
+size_t SignalPrioritizer::getSignalCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return index_->heap.size();
+}
+
 // Prioritize a signal
 SignalPriority SignalPrioritizer::prioritize(std::shared_ptr<Signal> signal) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     
     if (!signal) {
         std::cerr << "Error: Cannot prioritize null signal" << std::endl;
         return SignalPriority();
     }
     
-    // Check if signal already has a priority
+    // Check if signal already has a priority; prioritizing again keeps it alive
+    index_->advance(std::chrono::steady_clock::now());
     const std::string& signalId = signal->getId();
-    auto it = priorities_.find(signalId);
-    if (it != priorities_.end()) {
-        return it->second;
+    uint32_t slot = index_->find(signalId);
+    if (slot != PriorityIndex::NONE) {
+        index_->touch(slot);
+        return index_->entries[slot].priority;
     }
     
     // Apply the policy
@@ -75,7 +377,8 @@ SignalPriority SignalPrioritizer::prioritize(std::shared_ptr<Signal> signal) {
     priority.signalId = signalId;
     
     // Store the priority
-    priorities_[signalId] = priority;
+    index_->insert(priority);
+    lock.unlock();
     
     // Notify callbacks
     notifyPriorityCallbacks(signalId, priority);
@@ -87,9 +390,10 @@ SignalPriority SignalPrioritizer::prioritize(std::shared_ptr<Signal> signal) {
 SignalPriority SignalPrioritizer::getPriority(const std::string& signalId) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = priorities_.find(signalId);
-    if (it != priorities_.end()) {
-        return it->second;
+    uint32_t slot = index_->find(signalId);
+    if (slot != PriorityIndex::NONE &&
+        !index_->isExpired(slot, index_->tickAt(std::chrono::steady_clock::now()))) {
+        return index_->entries[slot].priority;
     }
     
     // Return default priority if not found
@@ -99,24 +403,36 @@ SignalPriority SignalPrioritizer::getPriority(const std::string& signalId) const
 // Get all signal priorities
 std::map<std::string, SignalPriority> SignalPrioritizer::getAllPriorities() const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return priorities_;
+    
+    std::map<std::string, SignalPriority> priorities;
+    int64_t now = index_->tickAt(std::chrono::steady_clock::now());
+    for (uint32_t slot : index_->heap) {
+        if (!index_->isExpired(slot, now)) {
+            priorities[index_->entries[slot].priority.signalId] = index_->entries[slot].priority;
+        }
+    }
+    return priorities;
 }
 
 // Check if a signal has been prioritized
 bool SignalPrioritizer::hasPriority(const std::string& signalId) const {
     std::lock_guard<std::mutex> lock(mutex_);
-    return priorities_.find(signalId) != priorities_.end();
+    uint32_t slot = index_->find(signalId);
+    return slot != PriorityIndex::NONE &&
+           !index_->isExpired(slot, index_->tickAt(std::chrono::steady_clock::now()));
 }
 
 // Update priority for a signal
 bool SignalPrioritizer::updatePriority(const std::string& signalId, TaskPriority priority, double score) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     
-    auto it = priorities_.find(signalId);
-    if (it == priorities_.end()) {
+    index_->advance(std::chrono::steady_clock::now());
+    uint32_t slot = index_->find(signalId);
+    if (slot == PriorityIndex::NONE) {
         // Create a new priority entry
         SignalPriority newPriority(signalId, priority, score);
-        priorities_[signalId] = newPriority;
+        index_->insert(newPriority);
+        lock.unlock();
         
         // Notify callbacks
         notifyPriorityCallbacks(signalId, newPriority);
@@ -125,31 +441,39 @@ bool SignalPrioritizer::updatePriority(const std::string& signalId, TaskPriority
     }
     
     // Update existing priority
-    it->second.priority = priority;
+    SignalPriority& existing = index_->entries[slot].priority;
+    existing.priority = priority;
     
     // Update score if provided
     if (score > 0.0) {
-        it->second.priorityScore = score;
+        existing.priorityScore = score;
     } else {
         // Recalculate score based on factors
-        recalculatePriorityScore(it->second);
+        recalculatePriorityScore(existing);
     }
     
     // Update timestamp
-    it->second.timestamp = std::chrono::system_clock::now();
+    existing.timestamp = std::chrono::system_clock::now();
+    
+    // Restore heap order and restart the TTL
+    SignalPriority updated = existing;
+    index_->reorder(slot);
+    index_->touch(slot);
+    lock.unlock();
     
     // Notify callbacks
-    notifyPriorityCallbacks(signalId, it->second);
+    notifyPriorityCallbacks(signalId, updated);
     
     return true;
 }
 
 // Add a prioritization factor
 bool SignalPrioritizer::addPrioritizationFactor(const std::string& signalId, const std::string& factor, double value) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
     
-    auto it = priorities_.find(signalId);
-    if (it == priorities_.end()) {
+    index_->advance(std::chrono::steady_clock::now());
+    uint32_t slot = index_->find(signalId);
+    if (slot == PriorityIndex::NONE) {
         // Create a new priority entry with default priority
         SignalPriority newPriority(signalId);
         newPriority.factors[factor] = value;
@@ -157,7 +481,8 @@ bool SignalPrioritizer::addPrioritizationFactor(const std::string& signalId, con
         // Calculate score based on factors
         recalculatePriorityScore(newPriority);
         
-        priorities_[signalId] = newPriority;
+        index_->insert(newPriority);
+        lock.unlock();
         
         // Notify callbacks
         notifyPriorityCallbacks(signalId, newPriority);
@@ -166,16 +491,23 @@ bool SignalPrioritizer::addPrioritizationFactor(const std::string& signalId, con
     }
     
     // Update existing factor or add new one
-    it->second.factors[factor] = value;
+    SignalPriority& existing = index_->entries[slot].priority;
+    existing.factors[factor] = value;
     
     // Recalculate score based on factors
-    recalculatePriorityScore(it->second);
+    recalculatePriorityScore(existing);
     
     // Update timestamp
-    it->second.timestamp = std::chrono::system_clock::now();
+    existing.timestamp = std::chrono::system_clock::now();
+    
+    // Restore heap order and restart the TTL
+    SignalPriority updated = existing;
+    index_->reorder(slot);
+    index_->touch(slot);
+    lock.unlock();
     
     // Notify callbacks
-    notifyPriorityCallbacks(signalId, it->second);
+    notifyPriorityCallbacks(signalId, updated);
     
     return true;
 }
@@ -184,13 +516,13 @@ bool SignalPrioritizer::addPrioritizationFactor(const std::string& signalId, con
 bool SignalPrioritizer::removeSignal(const std::string& signalId) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    auto it = priorities_.find(signalId);
-    if (it == priorities_.end()) {
+    uint32_t slot = index_->find(signalId);
+    if (slot == PriorityIndex::NONE) {
         return false;
     }
     
     // Remove the signal
-    priorities_.erase(it);
+    index_->remove(slot);
     
     return true;
 }
@@ -199,28 +531,54 @@ bool SignalPrioritizer::removeSignal(const std::string& signalId) {
 std::vector<SignalPriority> SignalPrioritizer::getTopPriorities(size_t count) const {
     std::lock_guard<std::mutex> lock(mutex_);
     
+    const PriorityIndex& index = *index_;
+    int64_t now = index.tickAt(std::chrono::steady_clock::now());
     std::vector<SignalPriority> result;
     
-    // Convert map to vector
-    for (const auto& pair : priorities_) {
-        result.push_back(pair.second);
-    }
-    
-    // Sort by priority (highest first)
-    std::sort(result.begin(), result.end(),
-        [](const SignalPriority& a, const SignalPriority& b) {
-            // First sort by priority level
-            if (a.priority != b.priority) {
-                return static_cast<int>(a.priority) > static_cast<int>(b.priority);
+    if (count == 0) {
+        // Everything: copy and sort
+        result.reserve(index.heap.size());
+        for (uint32_t slot : index.heap) {
+            if (!index.isExpired(slot, now)) {
+                result.push_back(index.entries[slot].priority);
             }
-            
-            // Then sort by score
-            return a.priorityScore > b.priorityScore;
-        });
+        }
+        std::sort(result.begin(), result.end(),
+            [](const SignalPriority& a, const SignalPriority& b) {
+                // First sort by priority level
+                if (a.priority != b.priority) {
+                    return static_cast<int>(a.priority) > static_cast<int>(b.priority);
+                }
+                
+                // Then sort by score
+                return a.priorityScore > b.priorityScore;
+            });
+        return result;
+    }
     
-    // Limit to count if requested
-    if (count > 0 && count < result.size()) {
-        result.resize(count);
+    // Best-first walk of the heap: the next best entry is always a child of one already taken
+    std::vector<uint32_t> frontier;
+    auto lower = [&index](uint32_t a, uint32_t b) {
+        return index.higher(index.heap[b], index.heap[a]);
+    };
+    if (!index.heap.empty()) {
+        frontier.push_back(0);
+    }
+    result.reserve(std::min(count, index.heap.size()));
+    while (!frontier.empty() && result.size() < count) {
+        std::pop_heap(frontier.begin(), frontier.end(), lower);
+        uint32_t position = frontier.back();
+        frontier.pop_back();
+        
+        uint32_t slot = index.heap[position];
+        if (!index.isExpired(slot, now)) {
+            result.push_back(index.entries[slot].priority);
+        }
+        for (size_t child = 2 * static_cast<size_t>(position) + 1;
+             child <= 2 * static_cast<size_t>(position) + 2 && child < index.heap.size(); child++) {
+            frontier.push_back(static_cast<uint32_t>(child));
+            std::push_heap(frontier.begin(), frontier.end(), lower);
+        }
     }
     
     return result;
@@ -229,7 +587,7 @@ std::vector<SignalPriority> SignalPrioritizer::getTopPriorities(size_t count) co
 // Reset all priorities
 void SignalPrioritizer::reset() {
     std::lock_guard<std::mutex> lock(mutex_);
-    priorities_.clear();
+    index_->clear();
 }
 
 // Register a callback for priority changes
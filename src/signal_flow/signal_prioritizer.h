@@ -13,6 +13,7 @@
 #include <map>
 #include <functional>
 #include <mutex>
+#include <chrono>
 
 namespace tdoa {
 namespace signal {
@@ -54,6 +55,24 @@ struct SignalPriority {
     }
 };
 
+/**
+ * @brief Signal prioritizer configuration
+ */
+struct PrioritizerConfig {
+    std::chrono::milliseconds ttl;      ///< Signals not prioritized or updated for this long expire (0 = never)
+    std::chrono::milliseconds tick;     ///< Expiry resolution
+    size_t maxSignals;                  ///< Tracked signal limit; the signal closest to expiry is evicted beyond it (0 = unlimited)
+    
+    /**
+     * @brief Constructor with default values
+     */
+    PrioritizerConfig()
+        : ttl(60000)
+        , tick(100)
+        , maxSignals(100000)
+    {}
+};
+
 /**
  * @brief Prioritization policy type
  */
@@ -61,6 +80,12 @@ using PrioritizationPolicy = std::function<SignalPriority(std::shared_ptr<Signal
 
 /**
  * @brief Signal prioritizer for resource allocation
+ *
+ * Priorities are kept in an indexed binary heap ordered by priority level,
+ * then score, so updates, removals and top-K queries are O(log n). Signals
+ * expire a TTL after they were last prioritized or updated, tracked by a
+ * timer wheel, and the number of tracked signals is bounded, so memory stays
+ * constant however many signals come and go.
  */
 class SignalPrioritizer {
 public:
@@ -81,6 +106,33 @@ public:
      */
     void setDefaultPolicy();
     
+    /**
+     * @brief Set expiry and capacity; tracked signals restart their TTL
+     * @param config Prioritizer configuration
+     */
+    void configure(const PrioritizerConfig& config);
+    
+    /**
+     * @brief Get the configuration
+     * @return Current configuration
+     */
+    PrioritizerConfig getConfig() const;
+    
+    /**
+     * @brief Remove signals whose TTL has passed
+     *
+     * Expiry also runs on every update; call this to release memory while
+     * no signals are being prioritized.
+     * @return Number of signals removed
+     */
+    size_t expireSignals();
+    
+    /**
+     * @brief Get the number of tracked signals
+     * @return Signal count, including expired signals not yet removed
+     */
+    size_t getSignalCount() const;
+    
     /**
      * @brief Prioritize a signal
      * @param signal Signal to prioritize
@@ -135,6 +187,8 @@ public:
     
     /**
      * @brief Get the top N highest priority signals
+     *
+     * Visits O(N log N) heap entries for N > 0; expired signals are skipped.
      * @param count Number of signals to return (0 = all)
      * @return Vector of priority information sorted by priority (highest first)
      */
@@ -198,8 +252,11 @@ private:
      */
     void recalculatePriorityScore(SignalPriority& priority);
     
+    struct PriorityIndex;
+    
     PrioritizationPolicy policy_;                                          ///< Prioritization policy
-    std::map<std::string, SignalPriority> priorities_;                     ///< Signal priorities
+    PrioritizerConfig config_;                                             ///< Expiry and capacity
+    std::unique_ptr<PriorityIndex> index_;                                 ///< Signal priorities: heap, lookup and expiry wheel
     std::map<int, std::function<void(const std::string&, const SignalPriority&)>> priorityCallbacks_; ///< Priority callbacks
     
     std::atomic<int> nextCallbackId_;                                     ///< Next callback ID
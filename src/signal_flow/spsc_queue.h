@@ -0,0 +1,127 @@
+/**
+ * @file spsc_queue.h
+ * @brief Bounded lock-free single-producer single-consumer queue
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @class SpscQueue
+ * @brief Bounded lock-free FIFO between exactly one producer and one consumer thread
+ *
+ * The producer owns the tail and the consumer owns the head, so push and pop
+ * are a load and a store each with no compare-and-swap. Each side caches the
+ * other side's index and only reloads it when the ring looks full or empty,
+ * which keeps the shared cache lines from bouncing on every call. Values are
+ * moved in and out, so any movable type works. The capacity is rounded up to
+ * a power of two.
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of values the queue can hold
+     */
+    explicit SpscQueue(size_t capacity)
+        : mask_(roundUpToPowerOfTwo(capacity) - 1)
+        , slots_(new T[mask_ + 1])
+        , head_(0)
+        , cachedTail_(0)
+        , tail_(0)
+        , cachedHead_(0) {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Append a value; producer thread only
+     * @param value Value to append, moved from only on success
+     * @return True if the value was appended, false if the queue is full
+     */
+    bool push(T& value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ > mask_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value; consumer thread only
+     * @param value Receives the value
+     * @return True if a value was removed, false if the queue is empty
+     */
+    bool pop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        slots_[head & mask_] = T();
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether the queue is empty; exact on the consumer thread
+     * @return True if there is nothing to pop
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the number of values in the queue (approximate from other threads)
+     * @return Value count
+     */
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_acquire);
+        size_t tail = tail_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    /**
+     * @brief Get the capacity
+     * @return Maximum number of values
+     */
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t mask_;                         ///< Capacity minus one
+    std::unique_ptr<T[]> slots_;                ///< Ring of values
+    alignas(64) std::atomic<size_t> head_;      ///< Next position to pop, written by the consumer
+    size_t cachedTail_;                         ///< Consumer's copy of tail_
+    alignas(64) std::atomic<size_t> tail_;      ///< Next position to push, written by the producer
+    size_t cachedHead_;                         ///< Producer's copy of head_
+};
+
+} // namespace signal
+} // namespace tdoa
@@ -0,0 +1,320 @@
+/**
+ * @file system_load.cpp
+ * @brief Implementation of SystemLoadSampler class
+ */
+
+#include "system_load.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+#if defined(__linux__)
+
+const double BYTES_PER_MB = 1024.0 * 1024.0;
+
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+bool fileExists(const std::string& path) {
+    return access(path.c_str(), R_OK) == 0;
+}
+
+/**
+ * @brief Read a byte count file such as memory.max ("max" or a number)
+ * @return Bytes, or 0 if the file is missing or unlimited
+ */
+double readBytes(const std::string& path) {
+    std::string line = readFirstLine(path);
+    if (line.empty() || line == "max") {
+        return 0.0;
+    }
+    double bytes = std::strtod(line.c_str(), nullptr);
+    // cgroup v1 reports "unlimited" as a number near 2^63
+    return bytes > 1e18 ? 0.0 : bytes;
+}
+
+/**
+ * @brief Read a "key value" entry from a file such as memory.stat or cpu.stat
+ */
+double readKeyedValue(const std::string& path, const std::string& key) {
+    std::ifstream file(path);
+    std::string name;
+    double value;
+    while (file >> name >> value) {
+        if (name == key) {
+            return value;
+        }
+    }
+    return 0.0;
+}
+
+/**
+ * @brief Read /proc/meminfo, values in MB
+ */
+void readMeminfo(double& totalMB, double& availableMB) {
+    std::ifstream file("/proc/meminfo");
+    std::string line;
+    while (std::getline(file, line)) {
+        unsigned long long kb;
+        if (std::sscanf(line.c_str(), "MemTotal: %llu kB", &kb) == 1) {
+            totalMB = kb / 1024.0;
+        } else if (std::sscanf(line.c_str(), "MemAvailable: %llu kB", &kb) == 1) {
+            availableMB = kb / 1024.0;
+        }
+    }
+}
+
+/**
+ * @brief Read the avg10 figures of a PSI file
+ * @return True if the file exists
+ */
+bool readPressure(const std::string& path, double& some, double& full) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        double avg10;
+        if (std::sscanf(line.c_str(), "some avg10=%lf", &avg10) == 1) {
+            some = avg10;
+        } else if (std::sscanf(line.c_str(), "full avg10=%lf", &avg10) == 1) {
+            full = avg10;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Read the PSI avg10 figures, preferring the cgroup's own files
+ */
+void readPressure(const std::string& cgroupPath, const std::string& resource,
+                  double& some, double& full) {
+    some = 0.0;
+    full = 0.0;
+    if (cgroupPath.empty() || !readPressure(cgroupPath + "/" + resource + ".pressure", some, full)) {
+        readPressure("/proc/pressure/" + resource, some, full);
+    }
+}
+
+/**
+ * @brief Find the cgroup v2 directory of the process
+ */
+std::string findCgroupPath() {
+    std::ifstream file("/proc/self/cgroup");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.compare(0, 3, "0::") == 0) {
+            std::string path = "/sys/fs/cgroup" + line.substr(3);
+            if (!path.empty() && path.back() == '/') {
+                path.pop_back();
+            }
+            if (fileExists(path + "/cgroup.controllers")) {
+                return path;
+            }
+            // Namespaced cgroups see their own cgroup as the root of the mount
+            if (fileExists("/sys/fs/cgroup/cgroup.controllers")) {
+                return "/sys/fs/cgroup";
+            }
+        }
+    }
+    return std::string();
+}
+
+/**
+ * @brief Cores the affinity mask allows
+ */
+double affinityCores() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        return static_cast<double>(CPU_COUNT(&set));
+    }
+    return static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+#endif
+
+} // anonymous namespace
+
+// Private implementation
+struct SystemLoadSampler::Impl {
+    std::string cgroupPath;     ///< cgroup v2 directory, empty if none
+    bool hasPrevious = false;   ///< Whether the previous CPU counters are valid
+    double previousBusy = 0.0;  ///< Busy CPU time of the previous sample
+    double previousTotal = 0.0; ///< Total CPU time (or wall time for cgroups) of the previous sample
+
+    /**
+     * @brief Read busy and total CPU time; busy / total is the utilization
+     *
+     * In a cgroup with a quota the busy time is the cgroup's usage and the
+     * total is wall time multiplied by the quota, so a container using its
+     * whole quota reads as fully busy even if the host is idle.
+     */
+    bool readCpuTimes(double cpuLimit, double& busy, double& total) {
+#if defined(__linux__)
+        if (!cgroupPath.empty() && fileExists(cgroupPath + "/cpu.stat")) {
+            busy = readKeyedValue(cgroupPath + "/cpu.stat", "usage_usec") * 1e-6;
+            total = std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count() * cpuLimit;
+            return true;
+        }
+
+        std::ifstream file("/proc/stat");
+        std::string label;
+        file >> label;
+        if (label != "cpu") {
+            return false;
+        }
+        double fields[8] = {};
+        for (double& field : fields) {
+            file >> field;
+        }
+        // user nice system idle iowait irq softirq steal
+        double idle = fields[3] + fields[4];
+        total = 0.0;
+        for (double field : fields) {
+            total += field;
+        }
+        busy = total - idle;
+        return true;
+#else
+        (void)cpuLimit;
+        (void)busy;
+        (void)total;
+        return false;
+#endif
+    }
+};
+
+// Constructor
+SystemLoadSampler::SystemLoadSampler()
+    : pImpl(new Impl()) {
+#if defined(__linux__)
+    pImpl->cgroupPath = findCgroupPath();
+#endif
+}
+
+// Destructor
+SystemLoadSampler::~SystemLoadSampler() = default;
+
+// Take a sample
+SystemLoad SystemLoadSampler::sample() {
+    SystemLoad load;
+    load.timestamp = std::chrono::steady_clock::now();
+
+#if defined(__linux__)
+    const std::string& cgroup = pImpl->cgroupPath;
+
+    // CPU limit: cgroup quota if tighter than the affinity mask
+    load.cpuLimit = affinityCores();
+    if (!cgroup.empty()) {
+        std::istringstream cpuMax(readFirstLine(cgroup + "/cpu.max"));
+        std::string quota;
+        double period = 0.0;
+        if (cpuMax >> quota >> period && quota != "max" && period > 0.0) {
+            load.cpuLimit = std::min(load.cpuLimit, std::strtod(quota.c_str(), nullptr) / period);
+        }
+    }
+
+    // Memory: physical memory, tightened by the cgroup v2 or v1 limit
+    double totalMB = 0.0;
+    double availableMB = 0.0;
+    readMeminfo(totalMB, availableMB);
+    load.memoryLimitMB = totalMB;
+    load.memoryAvailableMB = availableMB;
+
+    double limitBytes = 0.0;
+    double usedBytes = 0.0;
+    if (!cgroup.empty()) {
+        limitBytes = readBytes(cgroup + "/memory.max");
+        // Page cache the kernel can drop is not pressure
+        usedBytes = readBytes(cgroup + "/memory.current") -
+                    readKeyedValue(cgroup + "/memory.stat", "inactive_file");
+    } else if (fileExists("/sys/fs/cgroup/memory/memory.limit_in_bytes")) {
+        limitBytes = readBytes("/sys/fs/cgroup/memory/memory.limit_in_bytes");
+        usedBytes = readBytes("/sys/fs/cgroup/memory/memory.usage_in_bytes") -
+                    readKeyedValue("/sys/fs/cgroup/memory/memory.stat", "total_inactive_file");
+    }
+    if (limitBytes > 0.0 && (totalMB == 0.0 || limitBytes / BYTES_PER_MB < totalMB)) {
+        load.memoryLimitMB = limitBytes / BYTES_PER_MB;
+        double cgroupAvailableMB = std::max(0.0, limitBytes - std::max(0.0, usedBytes)) / BYTES_PER_MB;
+        load.memoryAvailableMB = totalMB > 0.0 ? std::min(availableMB, cgroupAvailableMB)
+                                               : cgroupAvailableMB;
+    }
+
+    // Pressure stall information
+    double unused;
+    readPressure(cgroup, "cpu", load.cpuPressure, unused);
+    readPressure(cgroup, "memory", load.memoryPressure, load.memoryFullPressure);
+    readPressure(cgroup, "io", load.ioPressure, unused);
+
+    load.valid = totalMB > 0.0 || limitBytes > 0.0;
+#elif defined(_WIN32)
+    MEMORYSTATUSEX memory;
+    memory.dwLength = sizeof(memory);
+    if (GlobalMemoryStatusEx(&memory)) {
+        load.memoryLimitMB = memory.ullTotalPhys / (1024.0 * 1024.0);
+        load.memoryAvailableMB = memory.ullAvailPhys / (1024.0 * 1024.0);
+        load.valid = true;
+    }
+    load.cpuLimit = static_cast<double>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+
+    // CPU utilization since the previous sample
+    double busy = 0.0;
+    double total = 0.0;
+#if defined(_WIN32)
+    FILETIME idleTime, kernelTime, userTime;
+    bool haveTimes = GetSystemTimes(&idleTime, &kernelTime, &userTime) != 0;
+    if (haveTimes) {
+        auto toDouble = [](const FILETIME& time) {
+            return static_cast<double>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime);
+        };
+        // Kernel time includes idle time
+        total = toDouble(kernelTime) + toDouble(userTime);
+        busy = total - toDouble(idleTime);
+    }
+#else
+    bool haveTimes = pImpl->readCpuTimes(load.cpuLimit, busy, total);
+#endif
+    if (haveTimes) {
+        if (pImpl->hasPrevious && total > pImpl->previousTotal) {
+            load.cpuUtilization = std::min(1.0, std::max(0.0,
+                (busy - pImpl->previousBusy) / (total - pImpl->previousTotal)));
+        }
+        pImpl->previousBusy = busy;
+        pImpl->previousTotal = total;
+        pImpl->hasPrevious = true;
+    }
+
+    return load;
+}
+
+// Get the cgroup directory
+std::string SystemLoadSampler::getCgroupPath() const {
+    return pImpl->cgroupPath;
+}
+
+} // namespace signal
+} // namespace tdoa
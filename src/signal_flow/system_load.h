@@ -0,0 +1,93 @@
+/**
+ * @file system_load.h
+ * @brief Measured CPU and memory load, cgroup limits and pressure stall information
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Snapshot of the load on the resources available to this process
+ *
+ * Limits are the tighter of the machine and the process's cgroup. Pressure
+ * values are the Linux PSI avg10 figures: the percentage of the last ten
+ * seconds in which some (or, for "full", all) runnable tasks were stalled
+ * waiting for the resource.
+ */
+struct SystemLoad {
+    bool valid;                 ///< False if the platform offers no measurements
+    double cpuLimit;            ///< Cores the process may use (cgroup quota or affinity)
+    double cpuUtilization;      ///< Fraction of cpuLimit busy since the previous sample (0.0 to 1.0)
+    double memoryLimitMB;       ///< Memory the process may use: cgroup limit or physical memory
+    double memoryAvailableMB;   ///< Memory that can be allocated without reclaim or OOM pressure
+    double cpuPressure;         ///< PSI cpu some avg10 in percent
+    double memoryPressure;      ///< PSI memory some avg10 in percent
+    double memoryFullPressure;  ///< PSI memory full avg10 in percent
+    double ioPressure;          ///< PSI io some avg10 in percent
+    std::chrono::steady_clock::time_point timestamp; ///< When the sample was taken
+
+    /**
+     * @brief Constructor with default values
+     */
+    SystemLoad()
+        : valid(false)
+        , cpuLimit(0.0)
+        , cpuUtilization(0.0)
+        , memoryLimitMB(0.0)
+        , memoryAvailableMB(0.0)
+        , cpuPressure(0.0)
+        , memoryPressure(0.0)
+        , memoryFullPressure(0.0)
+        , ioPressure(0.0)
+    {}
+};
+
+/**
+ * @class SystemLoadSampler
+ * @brief Reads SystemLoad from procfs and the process's cgroup
+ *
+ * Uses the cgroup v2 files of the process's own cgroup (cpu.max,
+ * memory.max, memory.current, *.pressure) when present, the cgroup v1
+ * memory controller otherwise, and /proc/meminfo, /proc/stat and
+ * /proc/pressure for the machine. CPU utilization is a difference between
+ * two samples, so the first sample reports zero. Not thread-safe; use one
+ * sampler per thread.
+ */
+class SystemLoadSampler {
+public:
+    /**
+     * @brief Constructor, locates the process's cgroup
+     */
+    SystemLoadSampler();
+
+    /**
+     * @brief Destructor
+     */
+    ~SystemLoadSampler();
+
+    /**
+     * @brief Take a sample
+     * @return Current load (valid is false on platforms without procfs)
+     */
+    SystemLoad sample();
+
+    /**
+     * @brief Get the cgroup directory the sampler reads, if any
+     * @return Directory path, empty if the process is not in a readable cgroup
+     */
+    std::string getCgroupPath() const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
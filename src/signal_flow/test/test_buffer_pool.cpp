@@ -0,0 +1,131 @@
+#include "buffer_pool.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+BufferSizeClassStats sizeClass(size_t blockSize) {
+    for (const auto& entry : BufferPool::getInstance().getStats().sizeClasses) {
+        if (entry.blockSize == blockSize) {
+            return entry;
+        }
+    }
+    return BufferSizeClassStats{blockSize, 0, 0, 0, 0};
+}
+
+} // namespace
+
+int main() {
+    BufferPool& pool = BufferPool::getInstance();
+    BufferPoolConfig config;
+    config.minBlockSize = 4096;
+    config.maxBlockSize = 1024 * 1024;
+    config.maxCachedBytes = 8 * 1024 * 1024;
+    config.threadCacheBlocks = 4;
+    check(pool.setConfig(config), "configuration accepted");
+    BufferPoolConfig invalid = config;
+    invalid.minBlockSize = 0;
+    check(!pool.setConfig(invalid), "zero minimum block size rejected");
+
+    std::cout << "Size classes:" << std::endl;
+    {
+        auto small = pool.acquire(1);
+        auto exact = pool.acquire(4096);
+        auto rounded = pool.acquire(5000);
+        check(small && exact && rounded, "acquisitions succeed");
+        check(reinterpret_cast<uintptr_t>(small.get()) % BufferPool::ALIGNMENT == 0 &&
+              reinterpret_cast<uintptr_t>(rounded.get()) % BufferPool::ALIGNMENT == 0, "blocks are 64-byte aligned");
+        check(sizeClass(4096).inUse == 2, "1 and 4096 bytes share the 4 KB class");
+        check(sizeClass(8192).inUse == 1, "5000 bytes rounds up to the 8 KB class");
+        check(pool.getStats().sizeClasses.size() == 9, "classes from 4 KB to 1 MB are reported");
+
+        auto oversize = pool.acquire(2 * 1024 * 1024);
+        check(oversize && pool.getStats().oversizeInUse == 1, "requests above maxBlockSize bypass the pool");
+        check(!pool.acquire(0), "zero-size request returns nullptr");
+    }
+    check(pool.getStats().oversizeInUse == 0, "oversize block freed directly");
+
+    std::cout << "Reuse:" << std::endl;
+    uint8_t* first = nullptr;
+    {
+        auto buffer = pool.acquire(16384);
+        first = buffer.get();
+    }
+    BufferSizeClassStats before = sizeClass(16384);
+    check(before.cached == 1 && before.inUse == 0, "released block is cached");
+    {
+        auto buffer = pool.acquire(12000);
+        check(buffer.get() == first, "next acquire in the class reuses the block");
+        check(sizeClass(16384).hits == before.hits + 1, "reuse counted as a hit");
+        auto zeroed = pool.acquire(12000, true);
+        bool allZero = true;
+        for (size_t i = 0; i < 12000; ++i) {
+            allZero = allZero && zeroed.get()[i] == 0;
+        }
+        check(allZero, "zero requested bytes");
+    }
+
+    // Blocks released on another thread come back to this one through the shared lists
+    std::vector<std::shared_ptr<uint8_t>> handed;
+    for (int i = 0; i < 8; ++i) {
+        handed.push_back(pool.acquire(65536));
+    }
+    std::thread releaser([&handed]() { handed.clear(); });
+    releaser.join();
+    const uint64_t hitsBefore = sizeClass(65536).hits;
+    auto recycled = pool.acquire(65536);
+    check(sizeClass(65536).hits == hitsBefore + 1, "block released on an exited thread is reused");
+    recycled.reset();
+
+    std::cout << "Per-thread cache bound:" << std::endl;
+    config.maxCachedBytes = 1024 * 1024;
+    config.threadCacheBlocks = 16;
+    pool.setConfig(config);
+    std::thread bounded([&pool]() {
+        std::vector<std::shared_ptr<uint8_t>> blocks;
+        for (int i = 0; i < 8; ++i) {
+            blocks.push_back(pool.acquire(512 * 1024));
+        }
+        blocks.clear();
+        // Two blocks fit in this thread's cache, two in the shared lists, the rest are freed
+        check(sizeClass(512 * 1024).cached == 4, "thread cache bounded by maxCachedBytes");
+        check(pool.getStats().bytesCached <= 2 * 1024 * 1024, "cached bytes within both bounds");
+    });
+    bounded.join();
+
+    std::cout << "Generation invalidation:" << std::endl;
+    auto held = pool.acquire(4096);
+    {
+        auto cachedBlock = pool.acquire(4096);
+    }
+    check(sizeClass(4096).cached >= 1, "block cached before reconfiguration");
+    config.minBlockSize = 65536;
+    pool.setConfig(config);
+    check(sizeClass(4096).cached == 0, "reconfiguration drops cached blocks");
+    check(sizeClass(4096).inUse == 1, "block handed out under the old configuration still counted");
+    held.reset();
+    check(sizeClass(4096).inUse == 0 && sizeClass(4096).cached == 0,
+          "stale block freed on release instead of cached");
+    auto small = pool.acquire(100);
+    check(sizeClass(65536).inUse == 1, "small requests use the new minimum class");
+    small.reset();
+
+    pool.trim();
+    check(pool.getStats().bytesCached == 0, "trim frees every cached block on this thread and the shared lists");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
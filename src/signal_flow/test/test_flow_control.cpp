@@ -0,0 +1,142 @@
+#include "flow_control.h"
+#include "parallel_signal_detector.h"
+#include "signal_flow.h"
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+size_t inFlight(const std::shared_ptr<CreditChannel>& channel) {
+    return channel->getMetrics().inFlight;
+}
+
+// Run one segment through the detector and wait for its callback
+std::vector<DetectedSignal> detect(ParallelSignalDetector& detector, CreditChannel::Credit credit,
+                                   const std::shared_ptr<CreditChannel>& channel, size_t* heldInCallback) {
+    auto done = std::make_shared<std::promise<std::vector<DetectedSignal>>>();
+    auto future = done->get_future();
+    auto signal = std::make_shared<Signal>(DataFormat::ComplexFloat32, 256);
+    bool started = detector.processSegmentAsync(signal, [done, channel, heldInCallback](const std::vector<DetectedSignal>& found) {
+        *heldInCallback = inFlight(channel);
+        done->set_value(found);
+    }, std::move(credit));
+    if (!started || future.wait_for(std::chrono::seconds(5)) != std::future_status::ready) {
+        return {};
+    }
+    return future.get();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Credit channels:" << std::endl;
+    auto sink = CreditChannel::create("sink", 2);
+    auto stage = CreditChannel::create("stage", 4);
+    stage->setDownstream(sink);
+    {
+        auto credit = stage->tryAcquireCredit();
+        check(credit && inFlight(stage) == 1, "credit taken");
+        check(sink->tryAcquire(2) && !sink->tryAcquire(), "acquire refused beyond capacity");
+        check(stage->getLocalPressure() == 0.25 && stage->getPressure() == 1.0,
+              "pressure includes the downstream channel");
+        sink->release(2);
+    }
+    check(inFlight(stage) == 0 && sink->getMetrics().refused == 1, "credit returned when dropped");
+
+    std::cout << "No channel:" << std::endl;
+    ShedController open(nullptr);
+    bool allAdmitted = true;
+    for (int i = 0; i < 10; ++i) {
+        allAdmitted = allAdmitted && open.admit(100) != nullptr;
+    }
+    ShedMetrics openMetrics = open.getMetrics();
+    check(allAdmitted && openMetrics.blocksForwarded == 10 && openMetrics.blocksDropped == 0,
+          "controller without a channel forwards every block");
+
+    std::cout << "Ingest pipeline:" << std::endl;
+    SignalFlow& flow = SignalFlow::getInstance();
+    check(flow.initialize(2, 100), "signal flow initialized");
+
+    DetectionConfig detection;
+    detection.minFrequency = 100.0e6;
+    detection.maxFrequency = 200.0e6;
+    detection.enableSignalTracking = false;
+    auto detector = std::make_shared<ParallelSignalDetector>(detection);
+    check(detector->initialize(), "detector initialized");
+
+    IngestFlowConfig config;
+    config.detectorCapacity = 4;
+    config.extractorCapacity = 2;
+    config.reducedBandFraction = 0.5;
+    config.shed.minHoldMs = std::chrono::milliseconds(0);
+    IngestFlow ingest = flow.connectIngest(detector, config);
+    check(ingest.shedController && detector->getInputChannel() == ingest.detectorChannel &&
+          ingest.detectorChannel->getDownstream() == ingest.extractorChannel && ingest.extractorAdmission,
+          "device, detector and extractor channels linked");
+
+    // An admitted block carries its detector credit into the detector
+    size_t held = 0;
+    std::vector<DetectedSignal> found = detect(*detector, ingest.shedController->admit(256),
+                                               ingest.detectorChannel, &held);
+    check(!found.empty() && held == 1, "admitted block charged to the detector once");
+    // The continuation holding the credit is released just after the callback returns
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (inFlight(ingest.detectorChannel) != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    check(inFlight(ingest.detectorChannel) == 0, "detector credit returned after the callback");
+
+    // A slow extractor holding half its credits puts the source in REDUCE_BAND
+    auto extracting = ingest.extractorAdmission();
+    CreditChannel::Credit credit = ingest.shedController->admit(256);
+    check(credit && ingest.shedController->getLevel() == ShedLevel::REDUCE_BAND, "extractor pressure reaches the source");
+    DetectionConfig narrowed = detector->getConfig();
+    check(narrowed.minFrequency == 125.0e6 && narrowed.maxFrequency == 175.0e6,
+          "REDUCE_BAND narrows the detection band");
+    found = detect(*detector, std::move(credit), ingest.detectorChannel, &held);
+    bool inside = !found.empty();
+    for (const auto& signal : found) {
+        inside = inside && signal.centerFrequency >= 125.0e6 && signal.centerFrequency <= 175.0e6;
+    }
+    check(inside, "detections come from the narrowed band");
+
+    // A full extractor drops blocks at the source
+    auto extractingMore = ingest.extractorAdmission();
+    check(extracting && extractingMore && !ingest.extractorAdmission(), "extractor admits up to its capacity");
+    check(!ingest.shedController->admit(256) && ingest.shedController->getLevel() == ShedLevel::DROP,
+          "full extractor drops blocks at ingest");
+    check(detector->getConfig().minFrequency == 125.0e6, "band stays narrowed while shedding");
+
+    // Once the extractor drains the source steps down and restores the band
+    extracting.reset();
+    extractingMore.reset();
+    while (ingest.shedController->evaluate() != ShedLevel::NONE) {
+    }
+    DetectionConfig restored = detector->getConfig();
+    check(restored.minFrequency == 100.0e6 && restored.maxFrequency == 200.0e6, "band restored when shedding stops");
+    ShedMetrics metrics = ingest.shedController->getMetrics();
+    check(metrics.blocksOffered == 3 && metrics.blocksForwarded == 2 && metrics.blocksDropped == 1,
+          "blocks counted at the source");
+
+    check(!flow.connectIngest(nullptr).shedController, "null detector rejected");
+
+    flow.shutdown();
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
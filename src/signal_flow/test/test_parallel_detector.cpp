@@ -4,6 +4,8 @@
 #include <chrono>
 #include <thread>
 #include <iomanip>
+#include <atomic>
+#include <future>
 
 using namespace tdoa::signal;
 
@@ -113,10 +115,67 @@ int main() {
         // Print final statistics
         printStats(detector.getStats());
 
+        // Test segments dropped by backpressure
+        std::cout << "\nTesting dropped segments..." << std::endl;
+        bool passed = true;
+        ParallelEngine& engine = SignalFlow::getInstance().getParallelEngine();
+        const BackpressurePolicy oldPolicy = engine.getBackpressurePolicy();
+        const size_t oldQueueSize = engine.getMaxQueueSize();
+        const double droppedBefore = detector.getStats()["segments_dropped"];
+
+        // Occupy every worker, then fill the queue so new tasks are dropped
+        std::promise<void> gate;
+        std::shared_future<void> opened = gate.get_future().share();
+        std::vector<std::future<std::shared_ptr<Signal>>> blockers;
+        for (size_t i = 0; i < engine.getNumThreads(); ++i) {
+            blockers.push_back(engine.submitTask(signal, [opened, signal]() {
+                opened.wait();
+                return signal;
+            }, TaskPriority::CRITICAL));
+        }
+        while (engine.getStats().currentQueueSize > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        engine.setBackpressurePolicy(BackpressurePolicy::DROP_NEW);
+        engine.setMaxQueueSize(2);
+        for (int i = 0; i < 2; ++i) {
+            blockers.push_back(engine.submitTask(signal, [signal]() { return signal; }, TaskPriority::CRITICAL));
+        }
+
+        std::atomic<int> partialCallbacks(0);
+        if (!detector.processSegmentAsync(signal, [&](const std::vector<DetectedSignal>&) { partialCallbacks++; })) {
+            passed = false;
+        }
+        auto droppedSync = detector.processSegment(signal);
+
+        gate.set_value();
+        for (auto& blocker : blockers) {
+            blocker.wait();
+        }
+        engine.setBackpressurePolicy(oldPolicy);
+        engine.setMaxQueueSize(oldQueueSize);
+
+        // A complete segment is still delivered
+        std::promise<size_t> delivered;
+        detector.processSegmentAsync(signal, [&delivered](const std::vector<DetectedSignal>& signals) {
+            delivered.set_value(signals.size());
+        });
+        auto deliveredFuture = delivered.get_future();
+        const bool completed = deliveredFuture.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+
+        const double dropped = detector.getStats()["segments_dropped"] - droppedBefore;
+        std::cout << "Segments dropped: " << dropped << ", callbacks for dropped segments: " << partialCallbacks
+                  << ", complete segment delivered: " << (completed ? "yes" : "no") << std::endl;
+        if (dropped != 2 || partialCallbacks != 0 || !droppedSync.empty() || !completed ||
+            deliveredFuture.get() == 0) {
+            passed = false;
+        }
+        std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+
         // Shutdown signal flow
         SignalFlow::getInstance().shutdown();
 
-        return 0;
+        return passed ? 0 : 1;
     }
     catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
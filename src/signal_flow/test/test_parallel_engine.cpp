@@ -0,0 +1,349 @@
+#include "parallel_engine.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+using Result = std::future<std::shared_ptr<Signal>>;
+
+// Holds the engine's only worker in a task until opened, so tasks submitted
+// meanwhile stay queued
+class Stall {
+public:
+    explicit Stall(ParallelEngine& engine)
+        : released_(release_.get_future().share()) {
+        auto started = std::make_shared<std::promise<void>>();
+        std::future<void> running = started->get_future();
+        std::shared_future<void> released = released_;
+        done_ = engine.submitTask(nullptr, [started, released]() {
+            started->set_value();
+            released.wait();
+            return std::shared_ptr<Signal>();
+        }, TaskPriority::CRITICAL);
+        running.wait();
+    }
+
+    void open() {
+        release_.set_value();
+        done_.wait();
+    }
+
+private:
+    std::promise<void> release_;
+    std::shared_future<void> released_;
+    Result done_;
+};
+
+// Records the order tasks run in
+class Recorder {
+public:
+    std::function<std::shared_ptr<Signal>()> task(const std::string& name) {
+        return [this, name]() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            order_.push_back(name);
+            return std::make_shared<Signal>(DataFormat::ComplexFloat32, 1);
+        };
+    }
+
+    std::vector<std::string> order() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return order_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        order_.clear();
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+};
+
+bool ran(Result& result) {
+    return result.wait_for(std::chrono::seconds(5)) == std::future_status::ready && result.get() != nullptr;
+}
+
+bool discarded(Result& result) {
+    return result.wait_for(std::chrono::seconds(5)) == std::future_status::ready && result.get() == nullptr;
+}
+
+} // namespace
+
+int main() {
+    ParallelEngine& engine = ParallelEngine::getEngine("test");
+    check(engine.initialize(1, 16), "engine with one worker initialized");
+    Recorder recorder;
+
+    std::cout << "Priority lanes:" << std::endl;
+    {
+        Stall stall(engine);
+        std::vector<Result> results;
+        results.push_back(engine.submitTask(nullptr, recorder.task("low"), TaskPriority::LOW));
+        results.push_back(engine.submitTask(nullptr, recorder.task("normal-1"), TaskPriority::NORMAL));
+        results.push_back(engine.submitTask(nullptr, recorder.task("critical"), TaskPriority::CRITICAL));
+        results.push_back(engine.submitTask(nullptr, recorder.task("normal-2"), TaskPriority::NORMAL));
+        results.push_back(engine.submitTask(nullptr, recorder.task("high"), TaskPriority::HIGH));
+        check(engine.getStats().currentQueueSize == 5, "tasks queued behind the busy worker");
+        stall.open();
+        for (auto& result : results) {
+            ran(result);
+        }
+    }
+    check(recorder.order() == std::vector<std::string>({"critical", "high", "normal-1", "normal-2", "low"}),
+          "highest priority first, FIFO within a priority");
+
+    std::cout << "Cancel:" << std::endl;
+    {
+        Stall stall(engine);
+        recorder.clear();
+        Result kept = engine.submitTask(nullptr, recorder.task("kept"));
+        Result cancelled = engine.submitTask(nullptr, recorder.task("cancelled"));
+        const std::string id = engine.getLastSubmittedTaskId();
+        check(!id.empty() && ParallelEngine::getInstance().getLastSubmittedTaskId().empty(),
+              "last task ID belongs to the engine it was submitted to");
+        check(engine.cancelTask(id), "queued task cancelled");
+        check(!engine.cancelTask(id), "second cancel refused");
+        check(!engine.cancelTask("task-zz") && !engine.cancelTask("not-a-task"), "malformed IDs refused");
+        check(discarded(cancelled), "cancelled task resolves to null at once");
+        stall.open();
+        check(ran(kept), "other task still runs");
+        check(!engine.cancelTask(id), "ID of a finished task refused");
+    }
+    check(recorder.order() == std::vector<std::string>({"kept"}), "cancelled task never runs");
+
+    std::cout << "Backpressure:" << std::endl;
+    engine.setMaxQueueSize(2);
+    {
+        Stall stall(engine);
+        engine.setBackpressurePolicy(BackpressurePolicy::DROP_NEW);
+        const size_t droppedBefore = engine.getStats().totalDropped;
+        Result first = engine.submitTask(nullptr, recorder.task("first"));
+        Result second = engine.submitTask(nullptr, recorder.task("second"));
+        Result refused = engine.submitTask(nullptr, recorder.task("refused"));
+        check(discarded(refused) && engine.getLastSubmittedTaskId().empty(), "DROP_NEW refuses the new task");
+        check(engine.getStats().totalDropped == droppedBefore + 1, "refusal counted as a drop");
+
+        engine.setBackpressurePolicy(BackpressurePolicy::DROP_OLDEST);
+        Result third = engine.submitTask(nullptr, recorder.task("third"));
+        check(discarded(first) && engine.getStats().currentQueueSize == 2, "DROP_OLDEST drops the oldest queued task");
+        stall.open();
+        check(ran(second) && ran(third), "newer tasks run");
+    }
+    {
+        Stall stall(engine);
+        engine.setBackpressurePolicy(BackpressurePolicy::DROP_LOWEST_PRIORITY);
+        Result low = engine.submitTask(nullptr, recorder.task("low"), TaskPriority::LOW);
+        Result high = engine.submitTask(nullptr, recorder.task("high"), TaskPriority::HIGH);
+        Result normal = engine.submitTask(nullptr, recorder.task("normal"), TaskPriority::NORMAL);
+        check(discarded(low), "DROP_LOWEST_PRIORITY drops the lowest priority task");
+        stall.open();
+        check(ran(high) && ran(normal), "higher priority tasks run");
+    }
+    {
+        Stall stall(engine);
+        engine.setBackpressurePolicy(BackpressurePolicy::EXPAND_QUEUE);
+        std::vector<Result> results;
+        for (int i = 0; i < 6; ++i) {
+            results.push_back(engine.submitTask(nullptr, recorder.task("expanded")));
+        }
+        check(engine.getStats().currentQueueSize == 6, "EXPAND_QUEUE accepts past the limit");
+        stall.open();
+        bool allRan = true;
+        for (auto& result : results) {
+            allRan = allRan && ran(result);
+        }
+        check(allRan, "every expanded task runs");
+    }
+    engine.setBackpressurePolicy(BackpressurePolicy::BLOCK);
+    engine.setMaxQueueSize(16);
+
+    std::cout << "Task graphs:" << std::endl;
+    recorder.clear();
+    TaskHandle source = engine.submitAfter({}, recorder.task("source"));
+    TaskHandle left = engine.submitAfter({source}, recorder.task("left"));
+    TaskHandle right = engine.submitAfter({source}, recorder.task("right"), TaskPriority::HIGH);
+    std::vector<std::shared_ptr<Signal>> combined;
+    TaskHandle join = engine.whenAll({left, right}, [&](const std::vector<std::shared_ptr<Signal>>& inputs) {
+        combined = inputs;
+        return recorder.task("join")();
+    });
+    TaskHandle after = join.then([&](std::shared_ptr<Signal> input) {
+        recorder.task("then")();
+        return input;
+    });
+    std::shared_ptr<Signal> joined = after.get();
+    std::vector<std::string> order = recorder.order();
+    check(order.size() == 5 && order.front() == "source" && order[3] == "join" && order[4] == "then",
+          "fan-in runs once, after both branches");
+    check(combined.size() == 2 && combined[0] == left.get() && combined[1] == right.get(),
+          "whenAll receives the results in the order of its tasks");
+    check(joined && joined == join.get() && left.isReady() && right.isReady(), "continuation receives the join's result");
+
+    // A dependency refused by backpressure completes with a null result and
+    // its dependents still run
+    engine.setMaxQueueSize(1);
+    engine.setBackpressurePolicy(BackpressurePolicy::DROP_NEW);
+    {
+        Stall stall(engine);
+        TaskHandle queued = engine.submitAfter({}, recorder.task("queued"));
+        TaskHandle refused = engine.submitAfter({}, recorder.task("refused"));
+        check(refused.isReady() && !refused.get(), "refused graph task resolves to null");
+        engine.setBackpressurePolicy(BackpressurePolicy::EXPAND_QUEUE);
+        std::vector<std::shared_ptr<Signal>> partial;
+        TaskHandle merge = engine.whenAll({queued, refused}, [&](const std::vector<std::shared_ptr<Signal>>& inputs) {
+            partial = inputs;
+            return recorder.task("merge")();
+        });
+        stall.open();
+        check(merge.get() && partial.size() == 2 && partial[0] && !partial[1],
+              "dependents of a dropped task run with its null result");
+    }
+    engine.setBackpressurePolicy(BackpressurePolicy::BLOCK);
+    engine.setMaxQueueSize(16);
+
+    std::cout << "Deadlines:" << std::endl;
+    const auto now = std::chrono::steady_clock::now();
+    {
+        Stall stall(engine);
+        recorder.clear();
+        std::vector<Result> results;
+        results.push_back(engine.submitTask(nullptr, recorder.task("plain")));
+        results.push_back(engine.submitTask(nullptr, recorder.task("third"), TaskPriority::NORMAL, now + std::chrono::seconds(30)));
+        results.push_back(engine.submitTask(nullptr, recorder.task("first"), TaskPriority::NORMAL, now + std::chrono::seconds(10)));
+        results.push_back(engine.submitTask(nullptr, recorder.task("second"), TaskPriority::NORMAL, now + std::chrono::seconds(20)));
+        results.push_back(engine.submitTask(nullptr, recorder.task("low"), TaskPriority::LOW, now + std::chrono::seconds(1)));
+        stall.open();
+        for (auto& result : results) {
+            ran(result);
+        }
+    }
+    check(recorder.order() == std::vector<std::string>({"first", "second", "third", "plain", "low"}),
+          "earliest deadline first within a priority, ahead of tasks without one");
+
+    {
+        Stall stall(engine);
+        const size_t missesBefore = engine.getStats().deadlineMisses;
+        std::atomic<bool> notified(false);
+        Result expired = engine.submitTask(nullptr, recorder.task("expired"), TaskPriority::HIGH,
+                                           std::chrono::steady_clock::now() + std::chrono::milliseconds(20),
+                                           [&notified]() { notified = true; });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stall.open();
+        check(discarded(expired) && notified.load(), "task past its deadline is dropped and onDropped called");
+        check(engine.getStats().deadlineMisses == missesBefore + 1, "deadline miss counted");
+    }
+
+    // A full queue sheds expired work before applying the policy
+    engine.setMaxQueueSize(2);
+    engine.setBackpressurePolicy(BackpressurePolicy::DROP_NEW);
+    {
+        Stall stall(engine);
+        std::atomic<bool> notified(false);
+        Result stale = engine.submitTask(nullptr, recorder.task("stale"), TaskPriority::NORMAL,
+                                         std::chrono::steady_clock::now() + std::chrono::milliseconds(20),
+                                         [&notified]() { notified = true; });
+        Result plain = engine.submitTask(nullptr, recorder.task("plain"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        Result fresh = engine.submitTask(nullptr, recorder.task("fresh"));
+        check(discarded(stale) && notified.load(), "expired task shed to make room");
+        stall.open();
+        check(ran(plain) && ran(fresh), "new task accepted instead of refused");
+    }
+    engine.setBackpressurePolicy(BackpressurePolicy::BLOCK);
+    engine.setMaxQueueSize(16);
+
+    std::cout << "Parallel loops:" << std::endl;
+    const size_t count = 100000;
+    std::vector<std::atomic<int>> visits(count);
+    engine.parallelFor(0, count, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            visits[i]++;
+        }
+    }, 64);
+    bool once = true;
+    for (const auto& visit : visits) {
+        once = once && visit.load() == 1;
+    }
+    check(once, "parallelFor visits every index once");
+
+    std::atomic<size_t> covered(0);
+    std::string message;
+    try {
+        engine.parallelFor(0, count, [&](size_t first, size_t last) {
+            if (first <= 5000 && 5000 < last) {
+                throw std::runtime_error("index 5000");
+            }
+            covered += last - first;
+        }, 64);
+    } catch (const std::runtime_error& e) {
+        message = e.what();
+    }
+    check(message == "index 5000", "exception in the body is rethrown to the caller");
+    // The first chunks are a quarter of the range, so index 5000 throws at once
+    check(covered.load() < count / 2, "chunks after the exception are skipped");
+
+    std::atomic<size_t> afterwards(0);
+    engine.parallelFor(0, count, [&](size_t first, size_t last) {
+        afterwards += last - first;
+    }, 64);
+    check(afterwards.load() == count, "engine runs loops normally after an exception");
+
+    // Chunked partial sums are combined in index order, so the result is the
+    // same whether chunks run on the workers or inline
+    std::vector<double> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = 1.0 / static_cast<double>(i + 1);
+    }
+    auto partial = [&values](size_t first, size_t last) {
+        double sum = 0.0;
+        for (size_t i = first; i < last; ++i) {
+            sum += values[i];
+        }
+        return sum;
+    };
+    auto add = [](double a, double b) { return a + b; };
+    const double parallelSum = engine.parallelReduce(0, count, 0.0, partial, add, 1000);
+    ParallelEngine& idle = ParallelEngine::getEngine("idle");
+    const double inlineSum = idle.parallelReduce(0, count, 0.0, partial, add, 1000);
+    check(parallelSum == inlineSum, "parallelReduce result does not depend on scheduling");
+
+    std::vector<double> squares(count);
+    engine.parallelTransform(values.data(), squares.data(), count, [](double x) { return x * x; });
+    check(squares[0] == 1.0 && squares[count - 1] == values[count - 1] * values[count - 1], "parallelTransform maps every element");
+
+    engine.shutdown();
+    bool inlineThrown = false;
+    try {
+        engine.parallelFor(0, 10, [](size_t, size_t) { throw std::runtime_error("inline"); });
+    } catch (const std::runtime_error&) {
+        inlineThrown = true;
+    }
+    check(inlineThrown, "stopped engine runs the loop inline and still throws");
+
+    Result late = engine.submitTask(nullptr, recorder.task("late"));
+    check(discarded(late), "submission after shutdown resolves to null");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,186 @@
+#include "processing_chain.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+// Records the timestamp of its input and outputs a signal stamped with its own mark
+class Stamp : public ProcessingComponent {
+public:
+    Stamp(const std::string& id, double mark)
+        : ProcessingComponent(id, id)
+        , mark(mark)
+        , received(-1.0)
+        , fail(false) {
+    }
+
+    std::shared_ptr<Signal> process(std::shared_ptr<Signal> signal) override {
+        received = signal->getTimestamp();
+        if (fail) {
+            return nullptr;
+        }
+        auto output = std::make_shared<Signal>(DataFormat::ComplexFloat32, 1);
+        output->setTimestamp(mark);
+        return output;
+    }
+
+    std::shared_ptr<ProcessingComponent> clone() const override {
+        return std::make_shared<Stamp>(getId(), mark);
+    }
+
+    double mark;        ///< Timestamp of the output
+    double received;    ///< Timestamp of the last input, -1 before the first
+    bool fail;          ///< Return nullptr instead of an output
+};
+
+// Passes each signal on with its timestamp, failing every failEvery-th one (0 = never)
+class Relay : public ProcessingComponent {
+public:
+    Relay(const std::string& id, int failEvery)
+        : ProcessingComponent(id, id)
+        , failEvery(failEvery) {
+    }
+
+    std::shared_ptr<Signal> process(std::shared_ptr<Signal> signal) override {
+        int sequence = static_cast<int>(signal->getTimestamp());
+        if (failEvery > 0 && sequence % failEvery == 0) {
+            return nullptr;
+        }
+        auto output = std::make_shared<Signal>(DataFormat::ComplexFloat32, 1);
+        output->setTimestamp(signal->getTimestamp());
+        return output;
+    }
+
+    std::shared_ptr<ProcessingComponent> clone() const override {
+        return std::make_shared<Relay>(getId(), failEvery);
+    }
+
+    int failEvery;      ///< Fail signals whose sequence is a multiple of this
+};
+
+struct Graph {
+    std::shared_ptr<ProcessingChain> chain;
+    std::shared_ptr<Stamp> a, b, c, d;
+};
+
+// A -> B -> D and A -> C, plus B -> C or C -> D when asked
+Graph makeGraph(bool fanIn) {
+    Graph graph;
+    graph.chain = std::make_shared<ProcessingChain>("test");
+    graph.a = std::make_shared<Stamp>("A", 1.0);
+    graph.b = std::make_shared<Stamp>("B", 2.0);
+    graph.c = std::make_shared<Stamp>("C", 3.0);
+    graph.d = std::make_shared<Stamp>("D", 4.0);
+    for (const auto& component : {graph.a, graph.b, graph.c, graph.d}) {
+        graph.chain->addComponent(component);
+    }
+    graph.chain->connectComponents("A", "B");
+    graph.chain->connectComponents("B", "D");
+    graph.chain->connectComponents("A", "C");
+    if (fanIn) {
+        graph.chain->connectComponents("C", "D");
+    }
+    return graph;
+}
+
+std::shared_ptr<Signal> input() {
+    auto signal = std::make_shared<Signal>(DataFormat::ComplexFloat32, 1);
+    signal->setTimestamp(0.0);
+    return signal;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Fan-out:" << std::endl;
+    Graph fanOut = makeGraph(false);
+    auto result = fanOut.chain->process(input());
+    check(fanOut.a->received == 0.0, "source takes the input signal");
+    check(fanOut.b->received == 1.0 && fanOut.c->received == 1.0, "both branches take the source's output");
+    check(fanOut.d->received == 2.0, "D takes B's output, not C's");
+    check(result && result->getTimestamp() == 4.0, "result is the last sink's output");
+
+    fanOut.b->setEnabled(false);
+    fanOut.chain->process(input());
+    check(fanOut.d->received == 1.0, "disabled component passes its input through");
+    fanOut.b->setEnabled(true);
+
+    fanOut.chain->process(input(), "B");
+    check(fanOut.b->received == 0.0 && fanOut.d->received == 2.0, "start component takes the input signal");
+
+    std::cout << "Fan-in:" << std::endl;
+    Graph fanIn = makeGraph(true);
+    result = fanIn.chain->process(input());
+    check(fanIn.d->received == 3.0, "D takes the output of its last predecessor in plan order");
+    check(result && result->getTimestamp() == 4.0, "fan-in result is D's output");
+
+    std::cout << "Failures:" << std::endl;
+    fanIn.c->fail = true;
+    fanIn.d->received = -1.0;
+    check(!fanIn.chain->process(input()) && fanIn.d->received == -1.0, "failure stops the chain");
+    fanIn.c->fail = false;
+    result = fanIn.chain->process(input());
+    check(result && fanIn.b->received == 1.0 && fanIn.d->received == 3.0, "next signal runs normally after a failure");
+
+    std::cout << "Pipelining:" << std::endl;
+    check(!fanOut.chain->startPipeline([](std::shared_ptr<Signal>) {}), "branching chain refused");
+    auto linear = std::make_shared<ProcessingChain>("linear");
+    linear->addComponent(std::make_shared<Stamp>("first", 1.0));
+    linear->addComponent(std::make_shared<Stamp>("second", 2.0));
+    linear->connectComponents("first", "second");
+    check(linear->startPipeline([](std::shared_ptr<Signal>) {}), "linear chain pipelined");
+    linear->stopPipeline();
+
+    // Failures in either stage leave a null in the failed signal's place
+    auto relays = std::make_shared<ProcessingChain>("relays");
+    relays->addComponent(std::make_shared<Relay>("first", 5));
+    relays->addComponent(std::make_shared<Relay>("second", 0));
+    relays->addComponent(std::make_shared<Relay>("third", 7));
+    relays->connectComponents("first", "second");
+    relays->connectComponents("second", "third");
+    PipelineConfig config;
+    config.stageStarts = {"first", "third"};
+    config.queueCapacity = 2;
+    std::vector<double> outputs;
+    check(relays->startPipeline([&outputs](std::shared_ptr<Signal> signal) {
+        outputs.push_back(signal ? signal->getTimestamp() : -1.0);
+    }, config), "relay chain pipelined");
+    std::vector<PipelineStageStats> stats = relays->getPipelineStats();
+    check(stats.size() == 2 && stats[0].componentIds.size() == 2 && stats[1].componentIds.size() == 1,
+          "stages cut at the stage starts");
+
+    const int count = 2000;
+    bool submitted = true;
+    for (int i = 1; i <= count; ++i) {
+        auto signal = std::make_shared<Signal>(DataFormat::ComplexFloat32, 1);
+        signal->setTimestamp(i);
+        submitted = submitted && relays->submit(signal);
+    }
+    stats = relays->getPipelineStats();
+    relays->stopPipeline();
+    check(submitted && !relays->isPipelined(), "every signal submitted before the pipeline stopped");
+
+    bool ordered = outputs.size() == count;
+    for (int i = 1; ordered && i <= count; ++i) {
+        bool failed = i % 5 == 0 || i % 7 == 0;
+        ordered = failed ? outputs[i - 1] == -1.0 : outputs[i - 1] == i;
+    }
+    check(ordered, "outputs in submission order with nulls for failed signals");
+    check(stats.size() == 2 && stats[0].peakQueueDepth <= 2, "queues stay within their capacity");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
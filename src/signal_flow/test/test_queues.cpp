@@ -0,0 +1,171 @@
+#include "mpmc_queue.h"
+#include "spsc_queue.h"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+} // namespace
+
+int main() {
+    std::cout << "MpmcQueue:" << std::endl;
+    MpmcQueue<uint64_t> mpmc(5);
+    check(mpmc.capacity() == 8, "capacity rounded up to a power of two");
+    bool pushed = true;
+    for (uint64_t i = 0; i < 8; ++i) {
+        pushed = pushed && mpmc.push(i);
+    }
+    check(pushed && !mpmc.push(8) && mpmc.size() == 8, "push refused when full");
+    uint64_t value = 0;
+    check(mpmc.peek(value) && value == 0 && mpmc.size() == 8, "peek reads the oldest value without removing it");
+    bool ordered = true;
+    for (uint64_t i = 0; i < 8; ++i) {
+        ordered = ordered && mpmc.pop(value) && value == i;
+    }
+    check(ordered && !mpmc.pop(value) && !mpmc.peek(value), "values leave in order, pop refused when empty");
+
+    // Positions run many times round the ring
+    ordered = true;
+    uint64_t next = 0;
+    uint64_t expected = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            ordered = ordered && mpmc.push(next++);
+        }
+        for (int i = 0; i < 3; ++i) {
+            ordered = ordered && mpmc.pop(value) && value == expected++;
+        }
+    }
+    check(ordered && mpmc.size() == 0, "order kept across wrap-around");
+
+    // Each consumer sees every producer's values in the order they were pushed
+    const uint64_t perProducer = 20000;
+    const size_t producers = 3;
+    const size_t consumers = 3;
+    MpmcQueue<uint64_t> shared(64);
+    std::vector<std::thread> threads;
+    std::vector<uint64_t> counts(consumers, 0);
+    std::vector<uint64_t> sums(consumers, 0);
+    std::vector<char> inOrder(consumers, 1);
+    std::atomic<uint64_t> popped(0);
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&shared, p, perProducer]() {
+            for (uint64_t i = 0; i < perProducer; ++i) {
+                while (!shared.push((static_cast<uint64_t>(p) << 32) | i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c]() {
+            std::vector<int64_t> last(producers, -1);
+            uint64_t item = 0;
+            while (popped.load() < producers * perProducer) {
+                if (!shared.pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                popped++;
+                const size_t producer = static_cast<size_t>(item >> 32);
+                const int64_t sequence = static_cast<int64_t>(item & 0xFFFFFFFF);
+                if (sequence <= last[producer]) {
+                    inOrder[c] = 0;
+                }
+                last[producer] = sequence;
+                counts[c]++;
+                sums[c] += sequence;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    bool allInOrder = true;
+    for (size_t c = 0; c < consumers; ++c) {
+        total += counts[c];
+        sum += sums[c];
+        allInOrder = allInOrder && inOrder[c];
+    }
+    check(total == producers * perProducer && sum == producers * perProducer * (perProducer - 1) / 2,
+          "concurrent producers and consumers lose and duplicate nothing");
+    check(allInOrder, "per-producer order kept under contention");
+
+    std::cout << "SpscQueue:" << std::endl;
+    SpscQueue<std::unique_ptr<int>> spsc(3);
+    check(spsc.capacity() == 4 && spsc.empty(), "capacity rounded up to a power of two");
+    pushed = true;
+    for (int i = 0; i < 4; ++i) {
+        std::unique_ptr<int> item(new int(i));
+        pushed = pushed && spsc.push(item) && !item;
+    }
+    std::unique_ptr<int> extra(new int(4));
+    check(pushed && !spsc.push(extra) && extra && *extra == 4, "full queue refuses without moving from the value");
+    ordered = true;
+    for (int i = 0; i < 4; ++i) {
+        std::unique_ptr<int> item;
+        ordered = ordered && spsc.pop(item) && item && *item == i;
+    }
+    std::unique_ptr<int> none;
+    check(ordered && !spsc.pop(none) && spsc.empty(), "values leave in order, pop refused when empty");
+
+    ordered = true;
+    int written = 0;
+    int read = 0;
+    for (int round = 0; round < 1000; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            std::unique_ptr<int> item(new int(written++));
+            ordered = ordered && spsc.push(item);
+        }
+        for (int i = 0; i < 3; ++i) {
+            std::unique_ptr<int> item;
+            ordered = ordered && spsc.pop(item) && *item == read++;
+        }
+    }
+    check(ordered && spsc.size() == 0, "order kept across wrap-around");
+
+    // One producer and one consumer thread
+    SpscQueue<uint64_t> stream(16);
+    const uint64_t streamed = 100000;
+    bool streamOrdered = true;
+    std::thread consumer([&stream, &streamOrdered, streamed]() {
+        uint64_t item = 0;
+        for (uint64_t i = 0; i < streamed; ) {
+            if (!stream.pop(item)) {
+                std::this_thread::yield();
+                continue;
+            }
+            streamOrdered = streamOrdered && item == i;
+            ++i;
+        }
+    });
+    for (uint64_t i = 0; i < streamed; ++i) {
+        uint64_t item = i;
+        while (!stream.push(item)) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    check(streamOrdered && stream.empty(), "producer and consumer threads see one ordered stream");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
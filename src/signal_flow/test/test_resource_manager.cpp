@@ -0,0 +1,172 @@
+#include "resource_manager.h"
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+double reserved(ResourceType type) {
+    return ResourceManager::getInstance().getResourceUsage(type).reserved;
+}
+
+// Valid measurement on a 1000 MB limit with no pressure unless given
+SystemLoad measuredLoad(double cpuPressure, double availableMB = 1000.0) {
+    SystemLoad load;
+    load.valid = true;
+    load.cpuLimit = 4.0;
+    load.memoryLimitMB = 1000.0;
+    load.memoryAvailableMB = availableMB;
+    load.cpuPressure = cpuPressure;
+    return load;
+}
+
+LoadLevel levelAfter(const SystemLoad& load) {
+    ResourceManager::getInstance().updateSystemLoad(load);
+    return ResourceManager::getInstance().getLoadLevel();
+}
+
+} // namespace
+
+int main() {
+    ResourceManager& manager = ResourceManager::getInstance();
+    check(manager.initialize(4, 1024.0), "manager initialized with 4 cores");
+
+    std::cout << "Reserve and release:" << std::endl;
+    ReservationHandle first = manager.reserve(ResourceType::CPU, 3.0);
+    check(first != 0 && reserved(ResourceType::CPU) == 3.0, "reservation taken from the counter");
+    check(manager.reserve(ResourceType::CPU, 2.0) == 0, "reservation beyond the total refused");
+    ReservationHandle second = manager.reserve(ResourceType::CPU, 1.0);
+    check(second != 0 && manager.getReservationCount() == 2, "remaining capacity reserved");
+    check(manager.reserve({{ResourceType::NETWORK, 10.0}, {ResourceType::CPU, 1.0}}) == 0 &&
+          reserved(ResourceType::NETWORK) == 0.0, "multi-resource reservation is all or none");
+    check(manager.reserve(ResourceType::CUSTOM, 1.0) == 0, "custom resources cannot be reserved");
+
+    ResourceRequest request("request", {{ResourceType::CPU, 1.0}});
+    check(!manager.canAllocate(request), "allocations share capacity with reservations");
+
+    check(manager.release(first) && reserved(ResourceType::CPU) == 1.0, "release returns the amount");
+    check(!manager.release(first), "double release refused");
+    check(!manager.release(0), "null handle refused");
+
+    std::cout << "Generations:" << std::endl;
+    ReservationHandle reused = manager.reserve(ResourceType::CPU, 2.0);
+    const uint32_t slotMask = 0xFFF;
+    check(reused != 0 && (reused & slotMask) == (first & slotMask) && reused != first,
+          "freed slot reused under a new generation");
+    check(!manager.release(first) && manager.getReservationCount() == 2 && reserved(ResourceType::CPU) == 3.0,
+          "stale handle cannot release the slot's new reservation");
+    check(manager.release(reused) && manager.release(second) && manager.getReservationCount() == 0,
+          "live handles release");
+
+    bool distinct = true;
+    ReservationHandle previous = 0;
+    for (int i = 0; i < 10000; ++i) {
+        ReservationHandle handle = manager.reserve(ResourceType::DISK, 1.0);
+        distinct = distinct && handle != 0 && handle != previous;
+        distinct = distinct && manager.release(handle);
+        previous = handle;
+    }
+    check(distinct && reserved(ResourceType::DISK) == 0.0, "every reuse of a slot gets a new handle");
+
+    ReservationHandle beforeReset = manager.reserve(ResourceType::CPU, 1.0);
+    manager.reset();
+    check(!manager.release(beforeReset) && manager.getReservationCount() == 0, "reset invalidates live handles");
+    manager.initialize(4, 1024.0);
+
+    std::cout << "Handle pool:" << std::endl;
+    std::vector<ReservationHandle> handles;
+    for (;;) {
+        ReservationHandle handle = manager.reserve(ResourceType::NETWORK, 0.001);
+        if (handle == 0) {
+            break;
+        }
+        handles.push_back(handle);
+    }
+    check(handles.size() == 4096 && reserved(ResourceType::NETWORK) < 100.0, "pool of 4096 handles exhausted before the resource");
+    check(manager.reserve(ResourceType::NETWORK, 0.001) == 0 && reserved(ResourceType::NETWORK) == handles.size() * 0.001,
+          "exhausted pool leaves the counters untouched");
+    bool allReleased = true;
+    for (ReservationHandle handle : handles) {
+        allReleased = allReleased && manager.release(handle);
+    }
+    check(allReleased && manager.getReservationCount() == 0 && reserved(ResourceType::NETWORK) == 0.0,
+          "every pooled handle released");
+
+    std::cout << "Concurrent reservations:" << std::endl;
+    std::atomic<int> held(0);
+    std::atomic<int> peak(0);
+    std::atomic<int> granted(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 20000; ++i) {
+                ReservationHandle handle = manager.reserve(ResourceType::CPU, 1.5);
+                if (handle == 0) {
+                    continue;
+                }
+                int now = ++held;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {
+                }
+                granted++;
+                --held;
+                manager.release(handle);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    check(granted.load() > 0 && peak.load() <= 2, "never more reserved than the total");
+    check(reserved(ResourceType::CPU) == 0.0 && manager.getReservationCount() == 0, "counters return to zero");
+
+    // Default thresholds: CPU pressure 40 / 80, free memory 10% / 4%, recovery at 0.8 of each
+    std::cout << "Load thresholds:" << std::endl;
+    check(levelAfter(SystemLoad()) == LoadLevel::NORMAL && manager.getQueueScale() == 1.0,
+          "no measurements admit everything");
+    check(levelAfter(measuredLoad(39.0)) == LoadLevel::NORMAL, "CPU pressure below elevated is normal");
+    check(levelAfter(measuredLoad(40.0)) == LoadLevel::ELEVATED && manager.getQueueScale() == 0.5,
+          "CPU pressure at elevated threshold");
+    check(!manager.isAdmitted(TaskPriority::LOW) && manager.isAdmitted(TaskPriority::NORMAL),
+          "elevated refuses LOW only");
+    check(levelAfter(measuredLoad(80.0)) == LoadLevel::CRITICAL && manager.getQueueScale() == 0.25,
+          "CPU pressure at critical threshold");
+    check(!manager.isAdmitted(TaskPriority::NORMAL) && manager.isAdmitted(TaskPriority::HIGH),
+          "critical refuses NORMAL, admits HIGH");
+    levelAfter(SystemLoad());
+    check(levelAfter(measuredLoad(0.0, 100.0)) == LoadLevel::ELEVATED, "10% free memory is elevated");
+    check(levelAfter(measuredLoad(0.0, 40.0)) == LoadLevel::CRITICAL, "4% free memory is critical");
+    levelAfter(SystemLoad());
+    SystemLoad stalled = measuredLoad(0.0);
+    stalled.memoryFullPressure = 5.0;
+    check(levelAfter(stalled) == LoadLevel::CRITICAL, "memory full pressure goes straight to critical");
+
+    std::cout << "Load hysteresis:" << std::endl;
+    levelAfter(SystemLoad());
+    levelAfter(measuredLoad(85.0));
+    check(levelAfter(measuredLoad(70.0)) == LoadLevel::CRITICAL, "critical held above 0.8 of its threshold");
+    check(levelAfter(measuredLoad(60.0)) == LoadLevel::ELEVATED, "critical left below 0.8 of its threshold");
+    check(levelAfter(measuredLoad(35.0)) == LoadLevel::ELEVATED, "elevated held above 0.8 of its threshold");
+    check(levelAfter(measuredLoad(30.0)) == LoadLevel::NORMAL, "elevated left below 0.8 of its threshold");
+    levelAfter(measuredLoad(0.0, 90.0));
+    check(levelAfter(measuredLoad(0.0, 115.0)) == LoadLevel::ELEVATED, "free memory must exceed threshold / 0.8 to recover");
+    check(levelAfter(measuredLoad(0.0, 130.0)) == LoadLevel::NORMAL, "free memory above threshold / 0.8 recovers");
+    check(levelAfter(measuredLoad(35.0)) == LoadLevel::NORMAL, "rising load uses the unscaled thresholds");
+    levelAfter(SystemLoad());
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
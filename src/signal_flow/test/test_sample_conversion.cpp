@@ -0,0 +1,145 @@
+#include "sample_conversion.h"
+#include "signal_factory.h"
+#include <iostream>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+// Outputs of every kernel for one input set
+struct KernelOutputs {
+    std::vector<float> fromInt16;
+    std::vector<int16_t> toInt16;
+    std::vector<float> fromInt8;
+    std::vector<int8_t> toInt8;
+    std::vector<int8_t> int16ToInt8;
+    std::vector<int16_t> int8ToInt16;
+};
+
+// Run every kernel over the inputs, starting one element in so the
+// vector paths see unaligned pointers, for each length up to the input size
+KernelOutputs runKernels(const std::vector<int16_t>& int16In, const std::vector<int8_t>& int8In,
+                         const std::vector<float>& floatIn, const std::vector<size_t>& lengths) {
+    KernelOutputs out;
+    for (size_t length : lengths) {
+        std::vector<float> f(length + 1);
+        std::vector<int16_t> s(length + 1);
+        std::vector<int8_t> b(length + 1);
+
+        convertInt16ToFloat(int16In.data() + 1, f.data() + 1, length);
+        out.fromInt16.insert(out.fromInt16.end(), f.begin() + 1, f.end());
+        convertFloatToInt16(floatIn.data() + 1, s.data() + 1, length);
+        out.toInt16.insert(out.toInt16.end(), s.begin() + 1, s.end());
+        convertInt8ToFloat(int8In.data() + 1, f.data() + 1, length);
+        out.fromInt8.insert(out.fromInt8.end(), f.begin() + 1, f.end());
+        convertFloatToInt8(floatIn.data() + 1, b.data() + 1, length);
+        out.toInt8.insert(out.toInt8.end(), b.begin() + 1, b.end());
+        convertInt16ToInt8(int16In.data() + 1, b.data() + 1, length);
+        out.int16ToInt8.insert(out.int16ToInt8.end(), b.begin() + 1, b.end());
+        convertInt8ToInt16(int8In.data() + 1, s.data() + 1, length);
+        out.int8ToInt16.insert(out.int8ToInt16.end(), s.begin() + 1, s.end());
+    }
+    return out;
+}
+
+template <typename T>
+bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+} // namespace
+
+int main() {
+    const SimdLevel best = getSimdLevel();
+    std::cout << "Detected SIMD level: " << simdLevelToString(best) << std::endl;
+
+    // Every int16 and int8 value, and floats around the saturation and
+    // truncation boundaries plus the special values
+    const size_t size = 70000;
+    std::vector<int16_t> int16In(size);
+    std::vector<int8_t> int8In(size);
+    std::vector<float> floatIn(size);
+    for (size_t i = 0; i < size; ++i) {
+        int16In[i] = static_cast<int16_t>(static_cast<int>(i % 65536) - 32768);
+        int8In[i] = static_cast<int8_t>(static_cast<int>(i % 256) - 128);
+    }
+    const float specials[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 1.0000001f, -1.0000001f, 2.0f, -2.0f, 1.0e30f, -1.0e30f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min(),
+        0.5f / 32767.0f, 1.5f / 32767.0f, -0.5f / 127.0f, 126.5f / 127.0f, 32766.5f / 32767.0f
+    };
+    const size_t specialCount = sizeof(specials) / sizeof(specials[0]);
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> uniform(-1.2f, 1.2f);
+    for (size_t i = 0; i < size; ++i) {
+        floatIn[i] = (i % 7 == 0) ? specials[(i / 7) % specialCount] : uniform(gen);
+    }
+
+    // Every tail length of the widest kernel, and one long run
+    std::vector<size_t> lengths;
+    for (size_t length = 0; length <= 130; ++length) {
+        lengths.push_back(length);
+    }
+    lengths.push_back(size - 1);
+
+    setSimdLevelLimit(SimdLevel::Scalar);
+    check(getSimdLevel() == SimdLevel::Scalar, "limit to scalar");
+    const KernelOutputs reference = runKernels(int16In, int8In, floatIn, lengths);
+
+    std::cout << "Kernels against scalar:" << std::endl;
+    for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        const std::string name = simdLevelToString(level);
+        if (setSimdLevelLimit(level) != level) {
+            std::cout << "  skip  " << name << " not available on this CPU or build" << std::endl;
+            continue;
+        }
+        const KernelOutputs out = runKernels(int16In, int8In, floatIn, lengths);
+        check(sameBits(out.fromInt16, reference.fromInt16), name + " int16 -> float");
+        check(sameBits(out.toInt16, reference.toInt16), name + " float -> int16");
+        check(sameBits(out.fromInt8, reference.fromInt8), name + " int8 -> float");
+        check(sameBits(out.toInt8, reference.toInt8), name + " float -> int8");
+        check(sameBits(out.int16ToInt8, reference.int16ToInt8), name + " int16 -> int8");
+        check(sameBits(out.int8ToInt16, reference.int8ToInt16), name + " int8 -> int16");
+    }
+
+    // The limit caps but never raises the level
+    check(setSimdLevelLimit(SimdLevel::AVX512) == best, "limit restored to the detected level");
+
+    std::cout << "Scalar semantics:" << std::endl;
+    int16_t fullScale[2];
+    const float saturating[2] = {std::numeric_limits<float>::quiet_NaN(), -3.0f};
+    convertFloatToInt16(saturating, fullScale, 2);
+    check(fullScale[0] == 32767 && fullScale[1] == -32767, "NaN and overrange saturate to full scale");
+    float unit[2];
+    const int16_t extremes[2] = {32767, -32767};
+    convertInt16ToFloat(extremes, unit, 2);
+    check(unit[0] == 1.0f && unit[1] == -1.0f, "int16 full scale maps to +/-1");
+
+    std::cout << "Ingest conversion:" << std::endl;
+    auto converted = SignalFactory::createConvertedSignal(int16In.data(), DataFormat::ComplexInt16, 1024,
+                                                          DataFormat::ComplexFloat32, 1.0e6, 1.0e9, 1.0e6);
+    std::vector<float> direct(2048);
+    convertInt16ToFloat(int16In.data(), direct.data(), direct.size());
+    check(converted && converted->getFormat() == DataFormat::ComplexFloat32 &&
+          std::memcmp(converted->data(), direct.data(), direct.size() * sizeof(float)) == 0,
+          "createConvertedSignal matches the kernel");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
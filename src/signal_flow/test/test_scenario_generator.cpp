@@ -0,0 +1,132 @@
+#include "scenario_generator.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+// Lag in samples by which b trails a, from the correlation magnitude peak
+// refined with a parabola through its neighbours
+double measureLag(const Signal& a, const Signal& b, int maxLag) {
+    const std::complex<float>* x = a.complexFloat();
+    const std::complex<float>* y = b.complexFloat();
+    const int count = static_cast<int>(std::min(a.getSampleCount(), b.getSampleCount()));
+    std::vector<double> magnitude(2 * maxLag + 1);
+    for (int lag = -maxLag; lag <= maxLag; ++lag) {
+        std::complex<double> sum;
+        for (int n = std::max(0, -lag); n < count && n + lag < count; ++n) {
+            sum += std::complex<double>(x[n]) * std::conj(std::complex<double>(y[n + lag]));
+        }
+        magnitude[lag + maxLag] = std::abs(sum);
+    }
+    int peak = 1;
+    for (int i = 1; i + 1 < static_cast<int>(magnitude.size()); ++i) {
+        if (magnitude[i] > magnitude[peak]) {
+            peak = i;
+        }
+    }
+    const double left = magnitude[peak - 1];
+    const double centre = magnitude[peak];
+    const double right = magnitude[peak + 1];
+    const double offset = 0.5 * (left - right) / (left - 2.0 * centre + right);
+    return peak - maxLag + offset;
+}
+
+} // namespace
+
+int main() {
+    ScenarioConfig config;
+    config.sampleRate = 40e6;
+    config.startTime = 1000.0;
+    config.noisePower = 1e-6;
+    config.seed = 7;
+
+    ScenarioEmitter emitter;
+    emitter.id = "tx";
+    emitter.position = tdoa::utils::EnuPosition(120.0, -80.0, 0.0);
+    emitter.bandwidth = 20e6;
+    emitter.snrDb = 30.0;
+
+    // Receiver 2's clock runs 250 ns ahead of true time
+    std::vector<ScenarioReceiver> receivers(3);
+    receivers[0].id = "r0";
+    receivers[0].position = tdoa::utils::EnuPosition(-400.0, -300.0, 0.0);
+    receivers[1].id = "r1";
+    receivers[1].position = tdoa::utils::EnuPosition(450.0, -250.0, 0.0);
+    receivers[2].id = "r2";
+    receivers[2].position = tdoa::utils::EnuPosition(0.0, 500.0, 0.0);
+    receivers[2].clockOffset = 250e-9;
+
+    ScenarioGenerator generator(config);
+    check(generator.addEmitter(emitter), "emitter added");
+    bool added = true;
+    for (const auto& receiver : receivers) {
+        added = added && generator.addReceiver(receiver);
+    }
+    check(added, "receivers added");
+
+    std::cout << "Propagation delays:" << std::endl;
+    const double c = 299792458.0;
+    bool delaysMatch = true;
+    for (size_t r = 0; r < receivers.size(); ++r) {
+        const double range = std::hypot(emitter.position.east - receivers[r].position.east,
+                                        emitter.position.north - receivers[r].position.north);
+        delaysMatch = delaysMatch && std::fabs(generator.getPropagationDelay(0, r, config.startTime) - range / c) < 1e-12;
+    }
+    check(delaysMatch, "static delays are range / c");
+    check(generator.getPropagationDelay(1, 0, config.startTime) < 0.0 &&
+          generator.getPropagationDelay(0, 3, config.startTime) < 0.0, "out-of-range indices report a negative delay");
+
+    std::cout << "Time differences:" << std::endl;
+    const size_t blockSize = 8192;
+    generator.generate(blockSize);  // Let every delay line fill before measuring
+    std::vector<std::shared_ptr<Signal>> block = generator.generate(blockSize);
+    check(block.size() == receivers.size() && block[0]->getSampleCount() == blockSize, "one block per receiver");
+
+    const double blockTime = config.startTime + blockSize / config.sampleRate;
+    const double reference = generator.getPropagationDelay(0, 0, blockTime);
+    for (size_t r = 1; r < receivers.size(); ++r) {
+        // Receiver clocks read the same at the first sample, so a clock offset adds to the lag
+        const double expected = (generator.getPropagationDelay(0, r, blockTime) - reference + receivers[r].clockOffset)
+                              * config.sampleRate;
+        const double measured = measureLag(*block[0], *block[r], 200);
+        std::cout << "  " << receivers[r].id << " - r0: " << measured << " samples (expected " << expected << ")" << std::endl;
+        check(std::fabs(measured - expected) < 0.1, receivers[r].id + " lag matches the expected TDOA within 0.1 sample");
+    }
+
+    std::cout << "Timestamps:" << std::endl;
+    check(block[0]->getTimestamp() == blockTime && block[2]->getTimestamp() == blockTime,
+          "timestamps are receiver clock readings");
+    check(std::fabs(block[2]->getMetadata().getDouble("true_timestamp") - (blockTime - receivers[2].clockOffset)) < 1e-12,
+          "true timestamp removes the clock offset");
+    check(generator.getSamplePosition() == 2 * blockSize, "sample position advances by block");
+
+    std::cout << "Determinism:" << std::endl;
+    generator.reset();
+    generator.generate(blockSize);
+    std::vector<std::shared_ptr<Signal>> again = generator.generate(blockSize);
+    bool same = again.size() == block.size();
+    for (size_t r = 0; same && r < block.size(); ++r) {
+        for (size_t i = 0; same && i < blockSize; ++i) {
+            same = again[r]->complexFloat()[i] == block[r]->complexFloat()[i];
+        }
+    }
+    check(same, "reset reproduces the same samples");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include "sigmf_recorder.h"
+#include <cmath>
+#include <complex>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+const double kSampleRate = 1.0e6;
+const size_t kBlock = 1000;
+
+// Block of ComplexInt16 samples numbered from first, so every sample in the recording is distinct
+std::shared_ptr<Signal> makeBlock(int first, double frequency, double timestamp) {
+    auto signal = std::make_shared<Signal>(DataFormat::ComplexInt16, kBlock);
+    std::complex<int16_t>* samples = signal->mutableComplexInt16();
+    for (size_t i = 0; i < kBlock; ++i) {
+        const int value = first + static_cast<int>(i);
+        samples[i] = std::complex<int16_t>(static_cast<int16_t>(value), static_cast<int16_t>(-value));
+    }
+    signal->setSampleRate(kSampleRate);
+    signal->setCenterFrequency(frequency);
+    signal->setTimestamp(timestamp);
+    return signal;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// Values of every occurrence of "key": <number> in the metadata
+std::vector<double> numbers(const std::string& json, const std::string& key) {
+    std::vector<double> values;
+    std::regex pattern("\"" + key + "\": ([-0-9.eE+]+)");
+    for (auto it = std::sregex_iterator(json.begin(), json.end(), pattern); it != std::sregex_iterator(); ++it) {
+        values.push_back(std::stod((*it)[1].str()));
+    }
+    return values;
+}
+
+} // namespace
+
+int main() {
+    std::filesystem::path directory = std::filesystem::temp_directory_path() /
+                                      ("test_sigmf_recorder_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+
+    // One page per segment so every block straddles a segment boundary
+    SigMFRecorderConfig config;
+    config.directory = directory.string();
+    config.nodeId = "node-1";
+    config.segmentSize = 4096;
+    config.segmentsAhead = 8;
+    config.dropPageCache = false;
+    SigMFRecorder recorder(config);
+
+    std::cout << "Recording:" << std::endl;
+    check(!recorder.record(*makeBlock(0, 915.0e6, 1000.0)), "record before open refused");
+    check(recorder.open("roundtrip") && recorder.isOpen(), "recording opened");
+
+    const double start = 1000.0;
+    const double blockSeconds = kBlock / kSampleRate;
+    bool recorded = true;
+    recorded = recorded && recorder.record(*makeBlock(0, 915.0e6, start));
+    recorded = recorded && recorder.record(*makeBlock(1000, 915.0e6, start + blockSeconds));
+    recorded = recorded && recorder.record(*makeBlock(2000, 915.0e6, start + 2 * blockSeconds));
+    // Retune: new capture at sample 3000
+    recorded = recorded && recorder.record(*makeBlock(3000, 2.4e9, start + 3 * blockSeconds));
+    // Timestamp gap: new capture at sample 4000
+    recorded = recorded && recorder.record(*makeBlock(4000, 2.4e9, start + 10 * blockSeconds));
+    check(recorded, "contiguous, retuned and late blocks recorded");
+
+    auto otherRate = makeBlock(5000, 2.4e9, start + 11 * blockSeconds);
+    otherRate->setSampleRate(2.0 * kSampleRate);
+    check(!recorder.record(*otherRate), "block at another sample rate rejected");
+
+    SigMFRecorderStats stats = recorder.getStats();
+    check(stats.samplesWritten == 5 * kBlock && stats.samplesDropped == 0 && stats.signalsRejected == 1,
+          "stats count written and rejected samples");
+    check(stats.captureCount == 3, "three captures");
+    check(recorder.close() && !recorder.isOpen(), "recording closed");
+
+    std::cout << "Data file:" << std::endl;
+    std::string data = readFile(recorder.getDataPath());
+    check(data.size() == 5 * kBlock * sizeof(std::complex<int16_t>), "data file truncated to the recorded length");
+    bool samplesMatch = data.size() == 5 * kBlock * sizeof(std::complex<int16_t>);
+    for (size_t i = 0; samplesMatch && i < 5 * kBlock; ++i) {
+        std::complex<int16_t> sample;
+        std::memcpy(&sample, data.data() + i * sizeof(sample), sizeof(sample));
+        samplesMatch = sample.real() == static_cast<int16_t>(i) && sample.imag() == static_cast<int16_t>(-static_cast<int>(i));
+    }
+    check(samplesMatch, "samples read back in order across segment boundaries");
+
+    std::cout << "Metadata:" << std::endl;
+    std::string meta = readFile(recorder.getMetaPath());
+    check(meta.find("\"core:datatype\": \"ci16_le\"") != std::string::npos, "datatype ci16_le");
+    std::vector<double> rates = numbers(meta, "core:sample_rate");
+    check(rates.size() == 1 && rates[0] == kSampleRate, "sample rate");
+    check(meta.find("\"tdoa:node_id\": \"node-1\"") != std::string::npos, "node ID");
+
+    std::vector<double> starts = numbers(meta, "core:sample_start");
+    check(starts == std::vector<double>({0.0, 3000.0, 4000.0}), "capture sample starts at 0, 3000 and 4000");
+    std::vector<double> frequencies = numbers(meta, "core:frequency");
+    check(frequencies == std::vector<double>({915.0e6, 2.4e9, 2.4e9}), "capture frequencies");
+    std::vector<double> timestamps = numbers(meta, "tdoa:timestamp");
+    check(timestamps.size() == 3 && timestamps[0] == start &&
+          std::fabs(timestamps[1] - (start + 3 * blockSeconds)) < 1e-9 &&
+          std::fabs(timestamps[2] - (start + 10 * blockSeconds)) < 1e-9,
+          "capture timestamps");
+    check(meta.find("\"core:datetime\"") != std::string::npos, "captures carry core:datetime");
+
+    std::filesystem::remove_all(directory);
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+#include "signal.h"
+#include <iostream>
+#include <complex>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+std::shared_ptr<Signal> makeRamp(size_t count) {
+    auto signal = std::make_shared<Signal>(DataFormat::ComplexFloat32, count);
+    std::complex<float>* samples = signal->mutableComplexFloat();
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = std::complex<float>(static_cast<float>(i), -static_cast<float>(i));
+    }
+    signal->setSampleRate(1000.0);
+    signal->setTimestamp(10.0);
+    return signal;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Slices share storage:" << std::endl;
+    auto parent = makeRamp(64);
+    const Signal& constParent = *parent;
+    auto slice = parent->slice(16, 8);
+    check(slice->isStorageShared() && parent->isStorageShared(), "slice and parent share storage");
+    check(slice->complexFloat() == constParent.complexFloat() + 16, "slice window points into parent storage");
+    check(slice->getSliceOffset() == 16 && slice->getSampleCount() == 8, "slice offset and count");
+    check(std::abs(slice->getTimestamp() - 10.016) < 1e-9, "slice timestamp advanced to first sample");
+    check(slice->sampleAt(0) == std::complex<float>(16.0f, -16.0f), "slice reads parent samples");
+
+    // Reads never detach, even through a non-const signal
+    const void* before = parent->data();
+    parent->complexFloat();
+    parent->sampleAt(3);
+    check(parent->data() == before && parent->isStorageShared(), "reads do not copy shared storage");
+
+    std::cout << "Copy on write:" << std::endl;
+    std::complex<float>* writable = slice->mutableComplexFloat();
+    check(!slice->isStorageShared() && !parent->isStorageShared(), "mutable access detaches the slice");
+    check(writable != constParent.complexFloat() + 16, "detached slice has its own window");
+    writable[0] = std::complex<float>(-1.0f, -1.0f);
+    check(parent->sampleAt(16) == std::complex<float>(16.0f, -16.0f), "write to slice does not reach parent");
+    check(slice->sampleAt(1) == std::complex<float>(17.0f, -17.0f), "detached slice kept its samples");
+    check(slice->getBufferSize() == 8 * sizeof(std::complex<float>), "detach copies only the slice window");
+
+    auto copy = std::make_shared<Signal>(*parent);
+    check(copy->isStorageShared(), "copy shares storage");
+    parent->mutableComplexFloat()[0] = std::complex<float>(42.0f, 0.0f);
+    check(copy->sampleAt(0) == std::complex<float>(0.0f, 0.0f), "write to original does not reach copy");
+    check(!copy->isStorageShared(), "original detached, copy is sole owner");
+
+    // A mutable pointer is only private until the signal is shared again;
+    // calling the accessor after slicing detaches before writing
+    std::cout << "Mutable pointers after slicing:" << std::endl;
+    auto source = makeRamp(32);
+    std::complex<float>* early = source->mutableComplexFloat();
+    auto later = source->slice(0, 4);
+    check(early == later->complexFloat(), "pointer taken before slice() still aliases the slice");
+    std::complex<float>* fresh = source->mutableComplexFloat();
+    fresh[0] = std::complex<float>(7.0f, 7.0f);
+    check(fresh != early && later->sampleAt(0) == std::complex<float>(0.0f, 0.0f),
+          "mutable access after slice() detaches before writing");
+
+    std::cout << "Concurrent readers:" << std::endl;
+    auto shared = makeRamp(4096);
+    auto sharedSlice = shared->slice(1024, 1024);
+    std::vector<std::thread> readers;
+    std::vector<double> sums(4, 0.0);
+    for (size_t t = 0; t < sums.size(); ++t) {
+        readers.emplace_back([&, t]() {
+            const auto& target = (t % 2) ? sharedSlice : shared;
+            for (int round = 0; round < 100; ++round) {
+                const std::complex<float>* samples = target->complexFloat();
+                double sum = 0.0;
+                for (size_t i = 0; i < target->getSampleCount(); ++i) {
+                    sum += samples[i].real();
+                }
+                sums[t] = sum;
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    check(sums[0] == 4095.0 * 4096.0 / 2.0 && sums[1] == (1024.0 + 2047.0) * 1024.0 / 2.0,
+          "readers see consistent data");
+    check(shared->isStorageShared(), "concurrent reads leave storage shared");
+
+    std::cout << "convertInto:" << std::endl;
+    auto target = std::make_shared<Signal>(DataFormat::ComplexFloat32, 8);
+    auto targetView = target->slice(0, 8);
+    check(slice->convertInto(*target), "convert into a signal whose storage is shared");
+    check(target->sampleAt(0) == std::complex<float>(-1.0f, -1.0f), "destination written");
+    check(targetView->sampleAt(0) == std::complex<float>(0.0f, 0.0f), "destination's other view untouched");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
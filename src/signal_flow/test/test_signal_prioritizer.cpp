@@ -0,0 +1,144 @@
+#include "signal_prioritizer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+// Level first, then score; ties in both are allowed to come out in any order
+bool ranksAtLeast(const SignalPriority& a, const SignalPriority& b) {
+    if (a.priority != b.priority) {
+        return static_cast<int>(a.priority) > static_cast<int>(b.priority);
+    }
+    return a.priorityScore >= b.priorityScore;
+}
+
+bool sorted(const std::vector<SignalPriority>& priorities) {
+    for (size_t i = 1; i < priorities.size(); ++i) {
+        if (!ranksAtLeast(priorities[i - 1], priorities[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool sameRanking(const std::vector<SignalPriority>& a, const std::vector<SignalPriority>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].priority != b[i].priority || a[i].priorityScore != b[i].priorityScore) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    SignalPrioritizer& prioritizer = SignalPrioritizer::getInstance();
+    PrioritizerConfig config;
+    config.ttl = std::chrono::milliseconds(0);
+    prioritizer.configure(config);
+
+    std::cout << "Top-K:" << std::endl;
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> level(0, 3);
+    std::uniform_real_distribution<double> score(0.01, 1.0);
+    for (int i = 0; i < 1000; ++i) {
+        prioritizer.updatePriority("signal-" + std::to_string(i), static_cast<TaskPriority>(level(random)), score(random));
+    }
+    std::vector<SignalPriority> all = prioritizer.getTopPriorities();
+    check(all.size() == 1000 && sorted(all), "all priorities sorted by level, then score");
+    bool prefixes = true;
+    for (size_t count : {1, 2, 10, 100, 999, 1000, 5000}) {
+        std::vector<SignalPriority> top = prioritizer.getTopPriorities(count);
+        std::vector<SignalPriority> expected(all.begin(), all.begin() + std::min<size_t>(count, all.size()));
+        prefixes = prefixes && sameRanking(top, expected);
+    }
+    check(prefixes, "top-K matches the head of the full ranking");
+
+    // Updates and removals move entries inside the heap
+    for (int i = 0; i < 1000; i += 3) {
+        prioritizer.updatePriority("signal-" + std::to_string(i), static_cast<TaskPriority>(level(random)), score(random));
+    }
+    for (int i = 1; i < 1000; i += 7) {
+        prioritizer.removeSignal("signal-" + std::to_string(i));
+    }
+    all = prioritizer.getTopPriorities();
+    check(all.size() == prioritizer.getSignalCount() && sorted(all) &&
+          sameRanking(prioritizer.getTopPriorities(50), std::vector<SignalPriority>(all.begin(), all.begin() + 50)),
+          "ranking kept after updates and removals");
+
+    prioritizer.updatePriority("urgent", TaskPriority::CRITICAL, 2.0);
+    std::vector<SignalPriority> top = prioritizer.getTopPriorities(1);
+    check(top.size() == 1 && top[0].signalId == "urgent", "raised signal moves to the top");
+    prioritizer.updatePriority("urgent", TaskPriority::LOW, 0.001);
+    all = prioritizer.getTopPriorities();
+    check(!all.empty() && all.back().signalId == "urgent", "lowered signal moves to the bottom");
+    check(!prioritizer.removeSignal("missing"), "removing an unknown signal refused");
+
+    std::cout << "Capacity:" << std::endl;
+    prioritizer.reset();
+    config.maxSignals = 100;
+    prioritizer.configure(config);
+    for (int i = 0; i < 250; ++i) {
+        prioritizer.updatePriority("bounded-" + std::to_string(i), TaskPriority::NORMAL, 1.0 + i);
+    }
+    check(prioritizer.getSignalCount() == 100, "tracked signals bounded by maxSignals");
+    check(prioritizer.hasPriority("bounded-249") && !prioritizer.hasPriority("bounded-0"),
+          "least recently updated signals evicted first");
+
+    std::cout << "Expiry:" << std::endl;
+    prioritizer.reset();
+    config.ttl = std::chrono::milliseconds(100);
+    config.tick = std::chrono::milliseconds(10);
+    config.maxSignals = 100000;
+    prioritizer.configure(config);
+    for (int i = 0; i < 20; ++i) {
+        prioritizer.updatePriority("stale-" + std::to_string(i), TaskPriority::HIGH, 1.0 + i);
+    }
+    check(prioritizer.getTopPriorities(5).size() == 5 && prioritizer.hasPriority("stale-0"), "fresh signals visible");
+
+    // Keep one signal alive by updating it while the rest age out
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < deadline) {
+        prioritizer.updatePriority("kept", TaskPriority::LOW, 1.0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    check(!prioritizer.hasPriority("stale-0") && prioritizer.getPriority("stale-0").priority == TaskPriority::NORMAL,
+          "expired signal no longer reported");
+    top = prioritizer.getTopPriorities(5);
+    check(top.size() == 1 && top[0].signalId == "kept", "top-K skips expired signals");
+    check(prioritizer.getSignalCount() == 1, "updates remove expired signals");
+
+    for (int i = 0; i < 20; ++i) {
+        prioritizer.updatePriority("idle-" + std::to_string(i), TaskPriority::NORMAL, 1.0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    check(prioritizer.getSignalCount() == 21 && prioritizer.getTopPriorities().empty(),
+          "expired signals hidden before they are removed");
+    check(prioritizer.expireSignals() == 21 && prioritizer.getSignalCount() == 0, "expiry pass releases idle signals");
+
+    prioritizer.reset();
+    prioritizer.configure(PrioritizerConfig());
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#include "thread_placement.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace tdoa::signal;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ok    " : "  FAIL  ") << what << std::endl;
+    if (!condition) {
+        failures++;
+    }
+}
+
+bool parses(const std::string& text, const std::vector<int>& expected) {
+    std::vector<int> cores;
+    return ThreadPlacement::parseCoreList(text, cores) && cores == expected;
+}
+
+bool rejects(const std::string& text) {
+    std::vector<int> cores(1, 0);
+    return !ThreadPlacement::parseCoreList(text, cores) && cores.empty();
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Parsing:" << std::endl;
+    check(parses("0-3,8,10-11", {0, 1, 2, 3, 8, 10, 11}), "ranges and single cores");
+    check(parses("5", {5}), "single core");
+    check(parses(" 3, 1-2\n", {1, 2, 3}), "whitespace and newline ignored, cores sorted");
+    check(parses("2,1-3,2-2", {1, 2, 3}), "overlapping ranges deduplicated");
+    check(parses("1,,2,", {1, 2}), "empty fields skipped");
+
+    std::cout << "Malformed lists:" << std::endl;
+    check(rejects(""), "empty list");
+    check(rejects("\n"), "blank line");
+    check(rejects("3-1"), "descending range");
+    check(rejects("-1"), "negative core");
+    check(rejects("1-"), "open range");
+    check(rejects("1-2x"), "trailing characters");
+    check(rejects("0,a"), "non-numeric field clears earlier cores");
+    check(rejects("1:3"), "wrong separator");
+
+    std::cout << "Formatting:" << std::endl;
+    check(ThreadPlacement::formatCoreList({11, 0, 1, 2, 3, 8, 10, 3}) == "0-3,8,10-11", "runs collapsed into ranges");
+    check(ThreadPlacement::formatCoreList({}).empty(), "no cores formats as empty");
+    std::vector<int> roundTrip;
+    check(ThreadPlacement::parseCoreList(ThreadPlacement::formatCoreList({7, 4, 5, 0}), roundTrip) &&
+          roundTrip == std::vector<int>({0, 4, 5, 7}), "format then parse round trips");
+
+    std::cout << (failures == 0 ? "PASSED" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
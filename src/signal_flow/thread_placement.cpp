@@ -0,0 +1,475 @@
+/**
+ * @file thread_placement.cpp
+ * @brief Implementation of ThreadPlacement class
+ */
+
+#include "thread_placement.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tdoa {
+namespace signal {
+
+namespace {
+
+#if defined(__linux__)
+
+std::string readFirstLine(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+uint64_t currentThreadId() {
+    return static_cast<uint64_t>(syscall(SYS_gettid));
+}
+
+std::vector<int> getAffinity() {
+    std::vector<int> cores;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int core = 0; core < CPU_SETSIZE; core++) {
+            if (CPU_ISSET(core, &set)) {
+                cores.push_back(core);
+            }
+        }
+    }
+    return cores;
+}
+
+bool isThreadAlive(uint64_t threadId) {
+    return access(("/proc/self/task/" + std::to_string(threadId)).c_str(), F_OK) == 0;
+}
+
+/**
+ * @brief Map each core to its NUMA node from sysfs (empty on single-node machines)
+ */
+std::map<int, int> readCoreNodes() {
+    std::map<int, int> coreNodes;
+    DIR* directory = opendir("/sys/devices/system/node");
+    if (!directory) {
+        return coreNodes;
+    }
+    while (dirent* entry = readdir(directory)) {
+        int node;
+        char trailing;
+        if (std::sscanf(entry->d_name, "node%d%c", &node, &trailing) != 1) {
+            continue;
+        }
+        std::vector<int> cores;
+        std::string path = std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist";
+        if (ThreadPlacement::parseCoreList(readFirstLine(path), cores)) {
+            for (int core : cores) {
+                coreNodes[core] = node;
+            }
+        }
+    }
+    closedir(directory);
+
+    std::set<int> nodes;
+    for (const auto& entry : coreNodes) {
+        nodes.insert(entry.second);
+    }
+    if (nodes.size() < 2) {
+        coreNodes.clear();
+    }
+    return coreNodes;
+}
+
+#elif defined(_WIN32)
+
+uint64_t currentThreadId() {
+    return static_cast<uint64_t>(GetCurrentThreadId());
+}
+
+std::vector<int> getAffinity() {
+    std::vector<int> cores;
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        for (int core = 0; core < static_cast<int>(sizeof(DWORD_PTR) * 8); core++) {
+            if (processMask & (static_cast<DWORD_PTR>(1) << core)) {
+                cores.push_back(core);
+            }
+        }
+    }
+    return cores;
+}
+
+#else
+
+uint64_t currentThreadId() {
+    return 0;
+}
+
+std::vector<int> getAffinity() {
+    return std::vector<int>();
+}
+
+#endif
+
+const char* threadClassName(ThreadClass threadClass) {
+    switch (threadClass) {
+        case ThreadClass::Ingest: return "ingest";
+        case ThreadClass::Dsp: return "dsp";
+        case ThreadClass::Io: return "io";
+        case ThreadClass::Ui: return "ui";
+        default: return "unknown";
+    }
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// ThreadPlacement Implementation
+//-----------------------------------------------------------------------------
+
+struct ThreadPlacement::Impl {
+    mutable std::mutex mutex;                       ///< Protects everything below
+    ThreadPlacementConfig config;                   ///< Current configuration
+    std::map<ThreadClass, size_t> nextCore;         ///< Round-robin position per class for pinEach
+    std::vector<ThreadPlacementInfo> placements;    ///< Placed threads, pruned when they exit
+    std::vector<int> usableCores;                   ///< Cores a thread may be placed on
+    std::map<int, int> coreNodes;                   ///< NUMA node per core (empty = single node)
+
+    Impl() {
+        usableCores = getAffinity();
+#if defined(__linux__)
+        // Isolated cores are outside the default affinity but may still be requested
+        std::vector<int> isolated;
+        if (parseCoreList(readFirstLine("/sys/devices/system/cpu/isolated"), isolated)) {
+            usableCores.insert(usableCores.end(), isolated.begin(), isolated.end());
+            std::sort(usableCores.begin(), usableCores.end());
+            usableCores.erase(std::unique(usableCores.begin(), usableCores.end()), usableCores.end());
+        }
+        coreNodes = readCoreNodes();
+#endif
+    }
+
+    /**
+     * @brief Get the NUMA node shared by all cores, or -1 if they span nodes
+     */
+    int commonNode(const std::vector<int>& cores) const {
+        int node = -1;
+        for (int core : cores) {
+            auto it = coreNodes.find(core);
+            if (it == coreNodes.end() || (node >= 0 && it->second != node)) {
+                return -1;
+            }
+            node = it->second;
+        }
+        return node;
+    }
+
+    /**
+     * @brief Apply affinity, scheduling and memory policy to the calling thread
+     */
+    void apply(const ThreadClassPlacement& rules, const std::vector<int>& cores, ThreadPlacementInfo& info) {
+        std::ostringstream errors;
+#if defined(__linux__)
+        if (!cores.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int core : cores) {
+                CPU_SET(core, &set);
+            }
+            if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+                errors << "affinity " << formatCoreList(cores) << ": " << std::strerror(errno) << "; ";
+            }
+        }
+
+        if (rules.realtime) {
+            sched_param param;
+            std::memset(&param, 0, sizeof(param));
+            param.sched_priority = std::min(std::max(rules.realtimePriority, sched_get_priority_min(SCHED_FIFO)),
+                                            sched_get_priority_max(SCHED_FIFO));
+            int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (result != 0) {
+                errors << "SCHED_FIFO: " << std::strerror(result) << "; ";
+            }
+        }
+
+        // Pages are placed on first touch, so buffers the thread allocates from now on are local
+        int node = rules.numaLocal ? commonNode(cores) : -1;
+        if (node >= 0) {
+            unsigned long mask[16] = {};
+            const size_t bits = sizeof(unsigned long) * 8;
+            if (static_cast<size_t>(node) < sizeof(mask) * 8) {
+                mask[node / bits] |= 1UL << (node % bits);
+                if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask, sizeof(mask) * 8) == 0) {
+                    info.numaNode = node;
+                } else {
+                    errors << "NUMA node " << node << ": " << std::strerror(errno) << "; ";
+                }
+            }
+        }
+
+        // Report what the OS actually granted
+        info.cores = getAffinity();
+        int policy = SCHED_OTHER;
+        sched_param param;
+        if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 &&
+            (policy == SCHED_FIFO || policy == SCHED_RR)) {
+            info.realtime = true;
+            info.priority = param.sched_priority;
+        }
+#elif defined(_WIN32)
+        if (!cores.empty()) {
+            DWORD_PTR mask = 0;
+            for (int core : cores) {
+                if (core < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+                    mask |= static_cast<DWORD_PTR>(1) << core;
+                }
+            }
+            if (SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+                errors << "affinity " << formatCoreList(cores) << ": error " << GetLastError() << "; ";
+            }
+        }
+        if (rules.realtime) {
+            if (SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+                info.realtime = true;
+                info.priority = THREAD_PRIORITY_TIME_CRITICAL;
+            } else {
+                errors << "time-critical priority: error " << GetLastError() << "; ";
+            }
+        }
+        info.cores = cores.empty() ? getAffinity() : cores;
+#else
+        if (!cores.empty() || rules.realtime) {
+            errors << "thread placement is not supported on this platform; ";
+        }
+#endif
+        info.errors = errors.str();
+        if (!info.errors.empty()) {
+            info.errors.resize(info.errors.size() - 2);
+        }
+    }
+};
+
+// Get the singleton instance
+ThreadPlacement& ThreadPlacement::getInstance() {
+    static ThreadPlacement instance;
+    return instance;
+}
+
+// Private constructor for singleton
+ThreadPlacement::ThreadPlacement()
+    : pImpl(std::make_unique<Impl>()) {
+}
+
+// Private destructor for singleton
+ThreadPlacement::~ThreadPlacement() {
+}
+
+// Set the configuration
+bool ThreadPlacement::configure(const ThreadPlacementConfig& config) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    for (const auto& entry : config.classes) {
+        for (int core : entry.second.cores) {
+            if (!std::binary_search(pImpl->usableCores.begin(), pImpl->usableCores.end(), core)) {
+                std::cerr << "Error: Core " << core << " for " << threadClassName(entry.first)
+                          << " threads is not available to this process" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    pImpl->config = config;
+    pImpl->nextCore.clear();
+    return true;
+}
+
+// Get the configuration
+ThreadPlacementConfig ThreadPlacement::getConfig() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->config;
+}
+
+// Apply the rules of a thread class to the calling thread
+bool ThreadPlacement::placeCurrentThread(ThreadClass threadClass, const std::string& name) {
+    ThreadPlacementInfo info;
+    info.name = name;
+    info.threadClass = threadClass;
+    info.threadId = currentThreadId();
+    info.realtime = false;
+    info.priority = 0;
+    info.numaNode = -1;
+
+#if defined(__linux__)
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+
+    // Pick the cores under the lock, then apply them without it
+    ThreadClassPlacement rules;
+    {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        auto it = pImpl->config.classes.find(threadClass);
+        if (pImpl->config.enabled && it != pImpl->config.classes.end()) {
+            rules = it->second;
+        }
+    }
+    if (rules.pinEach && !rules.cores.empty()) {
+        std::lock_guard<std::mutex> lock(pImpl->mutex);
+        size_t position = pImpl->nextCore[threadClass]++;
+        rules.cores = {rules.cores[position % rules.cores.size()]};
+    }
+    info.requestedCores = rules.cores;
+
+    pImpl->apply(rules, rules.cores, info);
+
+    if (!info.errors.empty()) {
+        std::cerr << "Warning: Thread " << name << " (" << threadClassName(threadClass)
+                  << ") placement incomplete: " << info.errors << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+#if defined(__linux__)
+    pImpl->placements.erase(std::remove_if(pImpl->placements.begin(), pImpl->placements.end(),
+        [&info](const ThreadPlacementInfo& placement) {
+            return placement.threadId == info.threadId || !isThreadAlive(placement.threadId);
+        }), pImpl->placements.end());
+#endif
+    pImpl->placements.push_back(info);
+    return info.errors.empty();
+}
+
+// Get the number of cores configured for a thread class
+size_t ThreadPlacement::getCoreCount(ThreadClass threadClass) const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->config.classes.find(threadClass);
+    if (!pImpl->config.enabled || it == pImpl->config.classes.end()) {
+        return 0;
+    }
+    return it->second.cores.size();
+}
+
+// Get the placements of the live placed threads
+std::vector<ThreadPlacementInfo> ThreadPlacement::getPlacements() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::vector<ThreadPlacementInfo> placements;
+    for (const auto& placement : pImpl->placements) {
+#if defined(__linux__)
+        if (!isThreadAlive(placement.threadId)) {
+            continue;
+        }
+#endif
+        placements.push_back(placement);
+    }
+    return placements;
+}
+
+// Build a profile that isolates ingest from the other thread classes
+ThreadPlacementConfig ThreadPlacement::createIsolatedProfile() {
+    ThreadPlacementConfig config;
+    std::vector<int> available = getAffinity();
+    std::vector<int> isolated;
+#if defined(__linux__)
+    parseCoreList(readFirstLine("/sys/devices/system/cpu/isolated"), isolated);
+#endif
+
+    ThreadClassPlacement ingest;
+    ingest.realtime = true;
+    ingest.pinEach = true;
+    if (!isolated.empty()) {
+        ingest.cores = isolated;
+    } else if (available.size() >= 4) {
+        ingest.cores.push_back(available.back());
+        available.pop_back();
+    }
+
+    // The other classes are only confined when ingest has cores of its own
+    if (!ingest.cores.empty() && available.size() >= 3) {
+        ThreadClassPlacement background;
+        background.cores.push_back(available.front());
+        config.classes[ThreadClass::Io] = background;
+        config.classes[ThreadClass::Ui] = background;
+
+        ThreadClassPlacement dsp;
+        dsp.cores.assign(available.begin() + 1, available.end());
+        dsp.pinEach = true;
+        config.classes[ThreadClass::Dsp] = dsp;
+    }
+    config.classes[ThreadClass::Ingest] = ingest;
+
+    return config;
+}
+
+// Parse a Linux cpulist
+bool ThreadPlacement::parseCoreList(const std::string& text, std::vector<int>& cores) {
+    cores.clear();
+    std::istringstream stream(text);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) {
+            continue;
+        }
+        int first = 0;
+        int last = 0;
+        char dash = 0;
+        char trailing = 0;
+        int fields = std::sscanf(range.c_str(), "%d%c%d%c", &first, &dash, &last, &trailing);
+        if (fields == 1) {
+            last = first;
+        } else if (fields != 3 || dash != '-') {
+            cores.clear();
+            return false;
+        }
+        if (first < 0 || last < first) {
+            cores.clear();
+            return false;
+        }
+        for (int core = first; core <= last; core++) {
+            cores.push_back(core);
+        }
+    }
+    std::sort(cores.begin(), cores.end());
+    cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+    return !cores.empty();
+}
+
+// Format cores as a cpulist
+std::string ThreadPlacement::formatCoreList(const std::vector<int>& cores) {
+    std::vector<int> sorted(cores);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::ostringstream text;
+    for (size_t i = 0; i < sorted.size();) {
+        size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+            j++;
+        }
+        text << (i > 0 ? "," : "") << sorted[i];
+        if (j > i) {
+            text << "-" << sorted[j];
+        }
+        i = j + 1;
+    }
+    return text.str();
+}
+
+} // namespace signal
+} // namespace tdoa
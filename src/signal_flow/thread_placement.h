@@ -0,0 +1,180 @@
+/**
+ * @file thread_placement.h
+ * @brief CPU affinity, scheduling class and NUMA placement per thread class
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tdoa {
+namespace signal {
+
+/**
+ * @brief Thread class enumeration
+ */
+enum class ThreadClass {
+    Ingest,     ///< Device streaming threads that must never miss a read
+    Dsp,        ///< ParallelEngine workers and other compute threads
+    Io,         ///< Disk, network and GPS threads
+    Ui          ///< User interface and map tile threads
+};
+
+/**
+ * @brief Placement rules for one thread class
+ */
+struct ThreadClassPlacement {
+    std::vector<int> cores;     ///< Cores the threads may run on (empty = any core)
+    bool pinEach;               ///< Pin each thread to one core of the set, round robin
+    bool realtime;              ///< Request SCHED_FIFO (time-critical priority on Windows)
+    int realtimePriority;       ///< SCHED_FIFO priority (1-99)
+    bool numaLocal;             ///< Prefer memory from the NUMA node of the cores
+
+    /**
+     * @brief Constructor with default values
+     */
+    ThreadClassPlacement()
+        : pinEach(false)
+        , realtime(false)
+        , realtimePriority(50)
+        , numaLocal(true)
+    {}
+};
+
+/**
+ * @brief Thread placement configuration
+ */
+struct ThreadPlacementConfig {
+    std::map<ThreadClass, ThreadClassPlacement> classes; ///< Rules per thread class (missing = unrestricted)
+    bool enabled;               ///< Apply the rules (false = only name and report threads)
+
+    /**
+     * @brief Constructor with default values
+     */
+    ThreadPlacementConfig()
+        : enabled(true)
+    {}
+};
+
+/**
+ * @brief Placement a thread actually received
+ */
+struct ThreadPlacementInfo {
+    std::string name;           ///< Thread name
+    ThreadClass threadClass;    ///< Thread class
+    uint64_t threadId;          ///< OS thread ID
+    std::vector<int> requestedCores; ///< Cores requested (empty = any)
+    std::vector<int> cores;     ///< Cores the OS allows the thread to run on
+    bool realtime;              ///< Whether the thread runs with a real-time policy
+    int priority;               ///< Real-time priority (0 if not real-time)
+    int numaNode;               ///< Preferred NUMA node (-1 = none)
+    std::string errors;         ///< Requests the OS refused, empty if all took effect
+};
+
+/**
+ * @class ThreadPlacement
+ * @brief Places long-running threads on cores according to their class
+ *
+ * Threads call placeCurrentThread() once at startup. Each class can be
+ * confined to a core set, with each thread optionally pinned to one core of
+ * it, can ask for SCHED_FIFO, and can prefer memory from the NUMA node its
+ * cores belong to, so buffers first touched by the thread are local. A
+ * request the OS refuses (SCHED_FIFO without CAP_SYS_NICE, a core outside
+ * the process's cpuset) is reported and the thread runs as well as it can.
+ * The placements threads actually received are available from
+ * getPlacements().
+ *
+ * With the default configuration nothing is restricted. createIsolatedProfile()
+ * builds a profile that keeps ingest off the cores the other classes use.
+ */
+class ThreadPlacement {
+public:
+    /**
+     * @brief Get the singleton instance
+     * @return Reference to the singleton instance
+     */
+    static ThreadPlacement& getInstance();
+
+    /**
+     * @brief Set the configuration; threads placed earlier keep their placement
+     * @param config Placement configuration
+     * @return True if every configured core exists and is available to the process
+     */
+    bool configure(const ThreadPlacementConfig& config);
+
+    /**
+     * @brief Get the configuration
+     * @return Current configuration
+     */
+    ThreadPlacementConfig getConfig() const;
+
+    /**
+     * @brief Apply the rules of a thread class to the calling thread
+     * @param threadClass Class of the calling thread
+     * @param name Thread name, shown by the OS (truncated to 15 characters on Linux)
+     * @return True if every requested setting took effect
+     */
+    bool placeCurrentThread(ThreadClass threadClass, const std::string& name);
+
+    /**
+     * @brief Get the number of cores configured for a thread class
+     * @param threadClass Thread class
+     * @return Core count, or 0 if the class may use any core
+     */
+    size_t getCoreCount(ThreadClass threadClass) const;
+
+    /**
+     * @brief Get the placements of the live placed threads
+     * @return Placements in the order the threads were placed
+     */
+    std::vector<ThreadPlacementInfo> getPlacements() const;
+
+    /**
+     * @brief Build a profile that isolates ingest from the other thread classes
+     *
+     * Ingest threads get SCHED_FIFO and are pinned to the cores isolated with
+     * isolcpus, or else to the last available core if there are at least
+     * four. If ingest has cores of its own and at least three others remain,
+     * I/O and UI share the first of them and DSP workers are pinned one per
+     * remaining core; otherwise the other classes are unrestricted.
+     * @return Placement configuration
+     */
+    static ThreadPlacementConfig createIsolatedProfile();
+
+    /**
+     * @brief Parse a Linux cpulist such as "0-3,8,10-11"
+     * @param text Core list
+     * @param cores Receives the cores in ascending order
+     * @return True if the list is well formed
+     */
+    static bool parseCoreList(const std::string& text, std::vector<int>& cores);
+
+    /**
+     * @brief Format cores as a cpulist
+     * @param cores Cores
+     * @return Core list such as "0-3,8"
+     */
+    static std::string formatCoreList(const std::vector<int>& cores);
+
+private:
+    /**
+     * @brief Private constructor for singleton
+     */
+    ThreadPlacement();
+
+    /**
+     * @brief Private destructor for singleton
+     */
+    ~ThreadPlacement();
+
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace signal
+} // namespace tdoa
@@ -25,10 +25,11 @@ std::vector<double> directCrossCorrelation(
     
     std::vector<double> result(resultSize, 0.0);
     
-    // Cross-correlation: r[k] = sum(x[n] * y[n+k]) for all valid n
+    // Cross-correlation: r[k] = sum(x[n] * y[n+k-(n1-1)]) for all valid n,
+    // so index n1-1 is zero lag and later indices mean signal2 lags signal1
     for (int k = 0; k < resultSize; ++k) {
         for (int n = 0; n < n1; ++n) {
-            const int index = k - n + n2 - 1;
+            const int index = n + k - (n1 - 1);
             if (index >= 0 && index < n2) {
                 result[k] += signal1[n] * signal2[index];
             }
@@ -49,10 +50,10 @@ std::vector<double> directCrossCorrelation(
     
     std::vector<double> result(resultSize, 0.0);
     
-    // Cross-correlation: r[k] = sum(x[n] * conj(y[n+k])) for all valid n
+    // Cross-correlation: r[k] = sum(x[n] * conj(y[n+k-(n1-1)])) for all valid n
     for (int k = 0; k < resultSize; ++k) {
         for (int n = 0; n < n1; ++n) {
-            const int index = k - n + n2 - 1;
+            const int index = n + k - (n1 - 1);
             if (index >= 0 && index < n2) {
                 // Complex conjugate of signal2
                 std::complex<double> conj_s2 = std::conj(signal2[index]);
@@ -110,6 +111,7 @@ CorrelationResult crossCorrelate(
     // Prepare result
     CorrelationResult result;
     result.correlation = correlation;
+    result.zeroLag = static_cast<int>(signal1.size()) - 1;
     result.peaks = peaks;
     result.sampleRate = config.sampleRate;
     
@@ -154,6 +156,7 @@ CorrelationResult crossCorrelate(
     // Prepare result
     CorrelationResult result;
     result.correlation = correlation;
+    result.zeroLag = static_cast<int>(signal1.size()) - 1;
     result.peaks = peaks;
     result.sampleRate = config.sampleRate;
     
@@ -56,6 +56,7 @@ struct CorrelationPeak {
  */
 struct CorrelationResult {
     std::vector<double> correlation;        ///< Full correlation result
+    int zeroLag;                            ///< Index of zero lag in correlation (peak.delay - zeroLag is the lag of signal2 behind signal1)
     std::vector<CorrelationPeak> peaks;     ///< Detected peaks
     double sampleRate;                      ///< Sample rate in Hz
     double maxPeakConfidence;               ///< Maximum peak confidence
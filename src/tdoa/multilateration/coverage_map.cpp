@@ -0,0 +1,488 @@
+/**
+ * @file coverage_map.cpp
+ * @brief Implementation of tiled GDOP/HDOP/CEP coverage maps
+ */
+
+#include "coverage_map.h"
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <array>
+
+namespace tdoa {
+namespace multilateration {
+
+namespace {
+
+// Information matrix terms stored per cell. The (bias, bias) term is the
+// receiver count and is the same for every cell.
+enum InfoTerm { kXX = 0, kXY, kYY, kXB, kYB, kNumInfoTerms };
+
+// CEP50 ~= 0.5887 * (sigma1 + sigma2), accurate for axis ratios up to ~3
+constexpr double kCepScale = 0.5887;
+
+// Same singularity threshold as MultilaterationSolver::calculateGDOP
+constexpr double kMinDeterminant = 1e-10;
+
+using Point = std::array<double, 2>;
+
+/**
+ * @brief One tile plus the information matrix it was derived from
+ */
+struct TileState {
+    CoverageTile tile;
+    std::vector<double> info;       ///< kNumInfoTerms planes of width*height cells
+    std::vector<Point> basis;       ///< Receiver positions the information matrix reflects
+};
+
+/**
+ * @brief Complete map for one receiver geometry
+ */
+struct MapState {
+    std::vector<std::string> receiverIds;
+    std::vector<Point> receivers;
+    std::vector<TileState> tiles;
+    int tilesX = 0;
+    int tilesY = 0;
+};
+
+/**
+ * @brief Add (sign = 1) or remove (sign = -1) one receiver's rows from a tile
+ *
+ * Each receiver contributes the outer product of [ux, uy, 1], where u is the
+ * unit vector from the receiver to the cell.
+ */
+void accumulateReceiver(TileState& state, const CoverageMapConfig& config,
+                        const Point& receiver, double sign)
+{
+    const CoverageTile& tile = state.tile;
+    const size_t cells = static_cast<size_t>(tile.width) * tile.height;
+    double* xx = state.info.data() + kXX * cells;
+    double* xy = state.info.data() + kXY * cells;
+    double* yy = state.info.data() + kYY * cells;
+    double* xb = state.info.data() + kXB * cells;
+    double* yb = state.info.data() + kYB * cells;
+
+    const double x0 = config.minX + (tile.originCellX + 0.5) * config.resolution;
+    for (int row = 0; row < tile.height; ++row) {
+        const double dy = config.minY + (tile.originCellY + row + 0.5) * config.resolution - receiver[1];
+        const size_t offset = static_cast<size_t>(row) * tile.width;
+        for (int col = 0; col < tile.width; ++col) {
+            const double dx = x0 + col * config.resolution - receiver[0];
+            const double distance = std::sqrt(dx * dx + dy * dy);
+            const double inv = distance > 1e-10 ? 1.0 / distance : 0.0;
+            const double ux = dx * inv;
+            const double uy = dy * inv;
+            const size_t i = offset + col;
+            xx[i] += sign * ux * ux;
+            xy[i] += sign * ux * uy;
+            yy[i] += sign * uy * uy;
+            xb[i] += sign * ux;
+            yb[i] += sign * uy;
+        }
+    }
+}
+
+/**
+ * @brief Derive GDOP, HDOP and CEP for every cell of a tile from its information matrix
+ */
+void deriveAccuracy(TileState& state, const CoverageMapConfig& config, double receiverCount)
+{
+    CoverageTile& tile = state.tile;
+    const size_t cells = static_cast<size_t>(tile.width) * tile.height;
+    const double* xx = state.info.data() + kXX * cells;
+    const double* xy = state.info.data() + kXY * cells;
+    const double* yy = state.info.data() + kYY * cells;
+    const double* xb = state.info.data() + kXB * cells;
+    const double* yb = state.info.data() + kYB * cells;
+    const double bb = receiverCount;
+    const double rangeSigma = config.speedOfLight * config.timingUncertainty;
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    for (size_t i = 0; i < cells; ++i) {
+        // Cofactors of the symmetric 3x3 information matrix
+        const double c00 = yy[i] * bb - yb[i] * yb[i];
+        const double c01 = xb[i] * yb[i] - xy[i] * bb;
+        const double c02 = xy[i] * yb[i] - yy[i] * xb[i];
+        const double c11 = xx[i] * bb - xb[i] * xb[i];
+        const double c22 = xx[i] * yy[i] - xy[i] * xy[i];
+        const double det = xx[i] * c00 + xy[i] * c01 + xb[i] * c02;
+
+        if (std::abs(det) <= kMinDeterminant) {
+            tile.gdop[i] = infinity;
+            tile.hdop[i] = infinity;
+            tile.cep[i] = infinity;
+            continue;
+        }
+
+        const double varX = c00 / det;
+        const double varY = c11 / det;
+        const double covXY = c01 / det;
+        const double varB = c22 / det;
+
+        tile.gdop[i] = static_cast<float>(std::sqrt(varX + varY + varB));
+        tile.hdop[i] = static_cast<float>(std::sqrt(varX + varY));
+
+        // Principal standard deviations of the horizontal covariance
+        const double mean = 0.5 * (varX + varY);
+        const double spread = std::sqrt(0.25 * (varX - varY) * (varX - varY) + covXY * covXY);
+        const double sigma1 = std::sqrt(std::max(mean + spread, 0.0));
+        const double sigma2 = std::sqrt(std::max(mean - spread, 0.0));
+        tile.cep[i] = static_cast<float>(kCepScale * rangeSigma * (sigma1 + sigma2));
+    }
+}
+
+/**
+ * @brief Distance from a point to the closest point of a tile's cell centers
+ */
+double distanceToTile(const CoverageTile& tile, const CoverageMapConfig& config, const Point& p)
+{
+    const double minX = config.minX + (tile.originCellX + 0.5) * config.resolution;
+    const double minY = config.minY + (tile.originCellY + 0.5) * config.resolution;
+    const double maxX = minX + (tile.width - 1) * config.resolution;
+    const double maxY = minY + (tile.height - 1) * config.resolution;
+    const double dx = std::max({minX - p[0], 0.0, p[0] - maxX});
+    const double dy = std::max({minY - p[1], 0.0, p[1] - maxY});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * @brief Run func(index) for every index in [0, count), pulling work from a shared counter
+ */
+template <typename Func>
+void parallelFor(size_t count, int numThreads, Func&& func) {
+    size_t threads = numThreads > 0 ? static_cast<size_t>(numThreads)
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            func(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+} // namespace
+
+/**
+ * @struct CoverageMap::Impl
+ * @brief Private implementation of CoverageMap
+ */
+struct CoverageMap::Impl {
+    CoverageMapConfig config;
+    CoverageMapStats stats;
+
+    // Current geometry; also the front entry of the cache
+    std::shared_ptr<MapState> current;
+    std::string currentKey;
+
+    // Set while current is the cached map for a geometry passed to setReceivers;
+    // the first receiver update then works on a copy so that entry stays intact
+    bool currentShared = false;
+
+    // Most recently used geometry first
+    std::list<std::pair<std::string, std::shared_ptr<MapState>>> cache;
+
+    std::set<std::pair<int, int>> dirtyTiles;
+    mutable std::mutex mutex;
+
+    // Cache key from receiver IDs and positions quantized to a tenth of a cell
+    std::string makeKey(const std::vector<std::string>& ids, const std::vector<Point>& positions) const {
+        const double quantum = config.resolution * 0.1;
+        std::ostringstream key;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            key << ids[i] << ':' << std::llround(positions[i][0] / quantum)
+                << ':' << std::llround(positions[i][1] / quantum) << ';';
+        }
+        return key.str();
+    }
+
+    int cellsX() const {
+        return std::max(1, static_cast<int>(std::ceil((config.maxX - config.minX) / config.resolution)));
+    }
+
+    int cellsY() const {
+        return std::max(1, static_cast<int>(std::ceil((config.maxY - config.minY) / config.resolution)));
+    }
+
+    std::shared_ptr<MapState> buildMap(const std::vector<std::string>& ids, const std::vector<Point>& positions) {
+        auto state = std::make_shared<MapState>();
+        state->receiverIds = ids;
+        state->receivers = positions;
+
+        const int width = cellsX();
+        const int height = cellsY();
+        state->tilesX = (width + config.tileSize - 1) / config.tileSize;
+        state->tilesY = (height + config.tileSize - 1) / config.tileSize;
+        state->tiles.resize(static_cast<size_t>(state->tilesX) * state->tilesY);
+
+        const double receiverCount = static_cast<double>(positions.size());
+        parallelFor(state->tiles.size(), config.numThreads, [&](size_t index) {
+            TileState& ts = state->tiles[index];
+            CoverageTile& tile = ts.tile;
+            tile.tileX = static_cast<int>(index % state->tilesX);
+            tile.tileY = static_cast<int>(index / state->tilesX);
+            tile.originCellX = tile.tileX * config.tileSize;
+            tile.originCellY = tile.tileY * config.tileSize;
+            tile.width = std::min(config.tileSize, width - tile.originCellX);
+            tile.height = std::min(config.tileSize, height - tile.originCellY);
+
+            const size_t cells = static_cast<size_t>(tile.width) * tile.height;
+            tile.gdop.resize(cells);
+            tile.hdop.resize(cells);
+            tile.cep.resize(cells);
+            ts.info.assign(kNumInfoTerms * cells, 0.0);
+            ts.basis = positions;
+
+            for (const auto& receiver : positions) {
+                accumulateReceiver(ts, config, receiver, 1.0);
+            }
+            deriveAccuracy(ts, config, receiverCount);
+        });
+
+        return state;
+    }
+
+    void markAllDirty() {
+        for (const auto& ts : current->tiles) {
+            dirtyTiles.insert({ts.tile.tileX, ts.tile.tileY});
+        }
+    }
+
+    void insertCache(const std::string& key, const std::shared_ptr<MapState>& state) {
+        cache.remove_if([&](const auto& entry) { return entry.first == key || entry.second == state; });
+        cache.emplace_front(key, state);
+        while (cache.size() > std::max<size_t>(1, config.maxCachedGeometries)) {
+            cache.pop_back();
+        }
+    }
+};
+
+CoverageMap::CoverageMap(const CoverageMapConfig& config)
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->config = config;
+}
+
+CoverageMap::~CoverageMap() = default;
+
+bool CoverageMap::setReceivers(const std::map<std::string, time_difference::SignalSource>& receivers)
+{
+    // Need at least 3 receivers for a 2D TDOA fix
+    if (receivers.size() < 3 || pImpl->config.resolution <= 0.0 || pImpl->config.tileSize <= 0) {
+        return false;
+    }
+
+    std::vector<std::string> ids;
+    std::vector<Point> positions;
+    for (const auto& entry : receivers) {
+        ids.push_back(entry.first);
+        positions.push_back({entry.second.position.x, entry.second.position.y});
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    std::string key = pImpl->makeKey(ids, positions);
+    if (pImpl->current && key == pImpl->currentKey) {
+        return true;
+    }
+
+    auto cached = std::find_if(pImpl->cache.begin(), pImpl->cache.end(),
+                               [&](const auto& entry) { return entry.first == key; });
+    if (cached != pImpl->cache.end()) {
+        pImpl->current = cached->second;
+        pImpl->stats.cacheHits++;
+    } else {
+        pImpl->current = pImpl->buildMap(ids, positions);
+        pImpl->stats.cacheMisses++;
+    }
+    pImpl->currentKey = key;
+    pImpl->currentShared = true;
+    pImpl->insertCache(key, pImpl->current);
+    pImpl->markAllDirty();
+
+    pImpl->stats.lastUpdateMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool CoverageMap::updateReceiver(const std::string& receiverId, const time_difference::SignalSource& receiver)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    if (!pImpl->current) {
+        return false;
+    }
+
+    auto it = std::find(pImpl->current->receiverIds.begin(), pImpl->current->receiverIds.end(), receiverId);
+    if (it == pImpl->current->receiverIds.end()) {
+        return false;
+    }
+    const size_t k = static_cast<size_t>(it - pImpl->current->receiverIds.begin());
+
+    if (pImpl->currentShared) {
+        pImpl->current = std::make_shared<MapState>(*pImpl->current);
+        pImpl->currentShared = false;
+    }
+    MapState& state = *pImpl->current;
+    const Point target = {receiver.position.x, receiver.position.y};
+    state.receivers[k] = target;
+
+    // Pick tiles whose bearing to the receiver moved by more than the tolerance.
+    // The bearing change seen from distance d is at most |move| / (d - |move|).
+    const CoverageMapConfig& config = pImpl->config;
+    std::vector<size_t> affected;
+    for (size_t t = 0; t < state.tiles.size(); ++t) {
+        const Point& previous = state.tiles[t].basis[k];
+        const double moved = std::hypot(target[0] - previous[0], target[1] - previous[1]);
+        if (moved == 0.0) {
+            continue;
+        }
+        const double clearance = distanceToTile(state.tiles[t].tile, config, previous) - moved;
+        if (clearance <= 0.0 || moved / clearance > config.bearingTolerance) {
+            affected.push_back(t);
+        }
+    }
+
+    const double receiverCount = static_cast<double>(state.receivers.size());
+    parallelFor(affected.size(), config.numThreads, [&](size_t index) {
+        TileState& ts = state.tiles[affected[index]];
+        accumulateReceiver(ts, config, ts.basis[k], -1.0);
+        accumulateReceiver(ts, config, target, 1.0);
+        ts.basis[k] = target;
+        deriveAccuracy(ts, config, receiverCount);
+        ts.tile.revision++;
+    });
+
+    for (size_t t : affected) {
+        pImpl->dirtyTiles.insert({state.tiles[t].tile.tileX, state.tiles[t].tile.tileY});
+    }
+    pImpl->stats.tilesRecomputed += affected.size();
+    pImpl->stats.tilesSkipped += state.tiles.size() - affected.size();
+
+    // Re-key the map under its new geometry
+    pImpl->currentKey = pImpl->makeKey(state.receiverIds, state.receivers);
+    pImpl->insertCache(pImpl->currentKey, pImpl->current);
+
+    pImpl->stats.lastUpdateMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+CoverageSample CoverageMap::getSample(double x, double y) const
+{
+    CoverageSample sample;
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    if (!pImpl->current) {
+        return sample;
+    }
+
+    const CoverageMapConfig& config = pImpl->config;
+    const int cellX = static_cast<int>(std::floor((x - config.minX) / config.resolution));
+    const int cellY = static_cast<int>(std::floor((y - config.minY) / config.resolution));
+    if (cellX < 0 || cellY < 0 || cellX >= pImpl->cellsX() || cellY >= pImpl->cellsY()) {
+        return sample;
+    }
+
+    const MapState& state = *pImpl->current;
+    const CoverageTile& tile = state.tiles[
+        static_cast<size_t>(cellY / config.tileSize) * state.tilesX + cellX / config.tileSize].tile;
+    const size_t i = static_cast<size_t>(cellY - tile.originCellY) * tile.width + (cellX - tile.originCellX);
+
+    sample.gdop = tile.gdop[i];
+    sample.hdop = tile.hdop[i];
+    sample.cep = tile.cep[i];
+    sample.valid = std::isfinite(sample.gdop);
+    return sample;
+}
+
+CoverageTile CoverageMap::getTile(int tileX, int tileY) const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    if (!pImpl->current || tileX < 0 || tileY < 0 ||
+        tileX >= pImpl->current->tilesX || tileY >= pImpl->current->tilesY) {
+        return CoverageTile();
+    }
+    return pImpl->current->tiles[static_cast<size_t>(tileY) * pImpl->current->tilesX + tileX].tile;
+}
+
+std::vector<std::pair<int, int>> CoverageMap::takeDirtyTiles()
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::vector<std::pair<int, int>> dirty(pImpl->dirtyTiles.begin(), pImpl->dirtyTiles.end());
+    pImpl->dirtyTiles.clear();
+    return dirty;
+}
+
+std::pair<int, int> CoverageMap::getTileCount() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    if (!pImpl->current) {
+        return {0, 0};
+    }
+    return {pImpl->current->tilesX, pImpl->current->tilesY};
+}
+
+CoverageMapStats CoverageMap::getStats() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->stats;
+}
+
+void CoverageMap::clearCache()
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->cache.clear();
+    if (pImpl->current) {
+        pImpl->cache.emplace_front(pImpl->currentKey, pImpl->current);
+    }
+}
+
+CoverageMapConfig CoverageMap::getConfig() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->config;
+}
+
+void CoverageMap::setConfig(const CoverageMapConfig& config)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->config = config;
+    pImpl->current.reset();
+    pImpl->currentKey.clear();
+    pImpl->currentShared = false;
+    pImpl->cache.clear();
+    pImpl->dirtyTiles.clear();
+}
+
+} // namespace multilateration
+} // namespace tdoa
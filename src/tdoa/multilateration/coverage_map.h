@@ -0,0 +1,225 @@
+/**
+ * @file coverage_map.h
+ * @brief Tiled GDOP/HDOP/CEP coverage maps for a receiver deployment
+ */
+
+#pragma once
+
+#include "../time_difference/time_difference_extractor.h"
+#include <vector>
+#include <memory>
+#include <map>
+#include <string>
+#include <utility>
+
+namespace tdoa {
+namespace multilateration {
+
+/**
+ * @struct CoverageMapConfig
+ * @brief Configuration for coverage map generation
+ */
+struct CoverageMapConfig {
+    double minX;                        ///< Map minimum X coordinate in meters
+    double maxX;                        ///< Map maximum X coordinate in meters
+    double minY;                        ///< Map minimum Y coordinate in meters
+    double maxY;                        ///< Map maximum Y coordinate in meters
+    double resolution;                  ///< Cell size in meters
+    int tileSize;                       ///< Cells per tile along each axis
+    double timingUncertainty;           ///< TDOA standard deviation in seconds used for CEP
+    double speedOfLight;                ///< Speed of light in m/s
+    double bearingTolerance;            ///< Bearing change in radians below which a tile is not recomputed
+    size_t maxCachedGeometries;         ///< Number of receiver geometries kept in the cache
+    int numThreads;                     ///< Worker threads for tile computation (0 = auto-detect)
+
+    /**
+     * @brief Constructor with default values
+     */
+    CoverageMapConfig()
+        : minX(-1000.0)                 // Default map is 2km x 2km
+        , maxX(1000.0)
+        , minY(-1000.0)
+        , maxY(1000.0)
+        , resolution(10.0)              // 10 m
+        , tileSize(32)
+        , timingUncertainty(10.0e-9)    // 10 ns, ~3 m in range difference
+        , speedOfLight(299792458.0)
+        , bearingTolerance(1.0e-3)      // ~0.06 degrees
+        , maxCachedGeometries(8)
+        , numThreads(0)
+    {}
+};
+
+/**
+ * @struct CoverageSample
+ * @brief Accuracy prediction at a single map cell
+ */
+struct CoverageSample {
+    double gdop;                ///< Geometric dilution of precision
+    double hdop;                ///< Horizontal dilution of precision
+    double cep;                 ///< Predicted 50% circular error probable in meters
+    bool valid;                 ///< False outside the map or where geometry is singular
+
+    /**
+     * @brief Constructor with default values
+     */
+    CoverageSample()
+        : gdop(0.0)
+        , hdop(0.0)
+        , cep(0.0)
+        , valid(false)
+    {}
+};
+
+/**
+ * @struct CoverageTile
+ * @brief Row-major accuracy values for one tile of the map
+ *
+ * Cells with singular geometry hold infinity.
+ */
+struct CoverageTile {
+    int tileX;                  ///< Tile column
+    int tileY;                  ///< Tile row
+    int originCellX;            ///< Map column of the first cell
+    int originCellY;            ///< Map row of the first cell
+    int width;                  ///< Cells in X (smaller at the map edge)
+    int height;                 ///< Cells in Y (smaller at the map edge)
+    std::vector<float> gdop;    ///< GDOP per cell
+    std::vector<float> hdop;    ///< HDOP per cell
+    std::vector<float> cep;     ///< CEP per cell in meters
+    uint64_t revision;          ///< Incremented whenever the tile is recomputed
+
+    /**
+     * @brief Constructor with default values
+     */
+    CoverageTile()
+        : tileX(0)
+        , tileY(0)
+        , originCellX(0)
+        , originCellY(0)
+        , width(0)
+        , height(0)
+        , revision(0)
+    {}
+};
+
+/**
+ * @struct CoverageMapStats
+ * @brief Counters for cache and incremental update behaviour
+ */
+struct CoverageMapStats {
+    uint64_t cacheHits;         ///< Geometries served from the cache
+    uint64_t cacheMisses;       ///< Geometries computed from scratch
+    uint64_t tilesRecomputed;   ///< Tiles recomputed by receiver updates
+    uint64_t tilesSkipped;      ///< Tiles left untouched by receiver updates
+    double lastUpdateMs;        ///< Duration of the last map build or update
+
+    /**
+     * @brief Constructor with default values
+     */
+    CoverageMapStats()
+        : cacheHits(0)
+        , cacheMisses(0)
+        , tilesRecomputed(0)
+        , tilesSkipped(0)
+        , lastUpdateMs(0.0)
+    {}
+};
+
+/**
+ * @class CoverageMap
+ * @brief Predicted positioning accuracy over a tiled grid
+ *
+ * The map keeps the 3x3 TDOA information matrix (x, y, clock bias; the same
+ * model as MultilaterationSolver::calculateGDOP) for every cell. A moving
+ * receiver only needs its old contribution removed and the new one added, and
+ * only in tiles whose bearing to that receiver changed by more than
+ * bearingTolerance. Complete maps are cached by receiver geometry so switching
+ * between known deployments is free.
+ */
+class CoverageMap {
+public:
+    /**
+     * @brief Constructor
+     * @param config Configuration for the coverage map
+     */
+    CoverageMap(const CoverageMapConfig& config = CoverageMapConfig());
+
+    /**
+     * @brief Destructor
+     */
+    ~CoverageMap();
+
+    /**
+     * @brief Build the map for a receiver set, reusing a cached map if available
+     * @param receivers Map of receiver IDs to receivers
+     * @return True if the map was built
+     */
+    bool setReceivers(const std::map<std::string, time_difference::SignalSource>& receivers);
+
+    /**
+     * @brief Move a single receiver and update the affected tiles
+     * @param receiverId Receiver ID
+     * @param receiver Receiver with its new position
+     * @return True if the receiver is part of the current geometry
+     */
+    bool updateReceiver(const std::string& receiverId, const time_difference::SignalSource& receiver);
+
+    /**
+     * @brief Get the accuracy prediction at a position
+     * @param x X coordinate in meters
+     * @param y Y coordinate in meters
+     * @return Coverage sample for the enclosing cell
+     */
+    CoverageSample getSample(double x, double y) const;
+
+    /**
+     * @brief Get a copy of a tile
+     * @param tileX Tile column
+     * @param tileY Tile row
+     * @return Tile data (empty if out of range)
+     */
+    CoverageTile getTile(int tileX, int tileY) const;
+
+    /**
+     * @brief Get tiles changed since the last call and clear the list
+     * @return (tileX, tileY) pairs to redraw
+     */
+    std::vector<std::pair<int, int>> takeDirtyTiles();
+
+    /**
+     * @brief Get the number of tiles along each axis
+     * @return (columns, rows)
+     */
+    std::pair<int, int> getTileCount() const;
+
+    /**
+     * @brief Get cache and update statistics
+     * @return Coverage map statistics
+     */
+    CoverageMapStats getStats() const;
+
+    /**
+     * @brief Drop all cached geometries except the current one
+     */
+    void clearCache();
+
+    /**
+     * @brief Get configuration
+     * @return Current configuration
+     */
+    CoverageMapConfig getConfig() const;
+
+    /**
+     * @brief Set configuration; invalidates the current map and the cache
+     * @param config New configuration
+     */
+    void setConfig(const CoverageMapConfig& config);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace multilateration
+} // namespace tdoa
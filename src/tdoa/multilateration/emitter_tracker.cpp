@@ -0,0 +1,319 @@
+/**
+ * @file emitter_tracker.cpp
+ * @brief Implementation of sequential EKF emitter tracking
+ */
+
+#include "emitter_tracker.h"
+#include <cmath>
+#include <algorithm>
+#include <mutex>
+#include <Eigen/Dense>
+
+namespace tdoa {
+namespace multilateration {
+
+namespace {
+
+using StateVector = Eigen::Matrix<double, 4, 1>;
+using StateMatrix = Eigen::Matrix<double, 4, 4>;
+
+/**
+ * @brief Chi-square quantile for k degrees of freedom at gateSigma standard deviations
+ *
+ * Wilson-Hilferty approximation; within a few percent of the exact value for k >= 1.
+ */
+double chiSquareGate(int k, double gateSigma) {
+    const double a = 2.0 / (9.0 * k);
+    const double root = 1.0 - a + gateSigma * std::sqrt(a);
+    return k * root * root * root;
+}
+
+} // namespace
+
+/**
+ * @struct EmitterTracker::Impl
+ * @brief Private implementation of EmitterTracker
+ */
+struct EmitterTracker::Impl {
+    /**
+     * @brief Filter state of one track in Eigen form
+     */
+    struct Track {
+        StateVector x;
+        StateMatrix P;
+        uint64_t lastUpdate = 0;
+        int updates = 0;
+        int gateFailures = 0;
+    };
+
+    TrackerConfig config;
+    MultilaterationSolver solver;
+    std::map<std::string, Track> tracks;
+    TrackerStats stats;
+    mutable std::mutex mutex;
+
+    // Start (or restart) a track from a full multilateration solve
+    void initiate(Track& track, const MultilaterationResult& fix, uint64_t timestamp) {
+        const double minStd = config.solverConfig.speedOfLight * config.solverConfig.timingUncertainty;
+        const double stdX = std::max(fix.position.uncertaintyX, minStd);
+        const double stdY = std::max(fix.position.uncertaintyY, minStd);
+
+        track.x << fix.position.x, fix.position.y, 0.0, 0.0;
+        track.P = StateMatrix::Zero();
+        track.P(0, 0) = stdX * stdX;
+        track.P(1, 1) = stdY * stdY;
+        track.P(2, 2) = config.initialVelocityStd * config.initialVelocityStd;
+        track.P(3, 3) = config.initialVelocityStd * config.initialVelocityStd;
+        track.lastUpdate = timestamp;
+        track.updates = 0;
+        track.gateFailures = 0;
+        stats.tracksInitiated++;
+    }
+
+    // Constant-velocity prediction with white acceleration noise
+    void predict(Track& track, uint64_t timestamp) {
+        if (track.lastUpdate == 0 || timestamp <= track.lastUpdate) {
+            return;
+        }
+        const double dt = static_cast<double>(timestamp - track.lastUpdate) * 1.0e-9;
+
+        StateMatrix F = StateMatrix::Identity();
+        F(0, 2) = dt;
+        F(1, 3) = dt;
+
+        const double q = config.processNoise;
+        const double dt2 = dt * dt;
+        const double dt3 = dt2 * dt;
+        StateMatrix Q = StateMatrix::Zero();
+        Q(0, 0) = Q(1, 1) = q * dt3 / 3.0;
+        Q(0, 2) = Q(2, 0) = Q(1, 3) = Q(3, 1) = q * dt2 / 2.0;
+        Q(2, 2) = Q(3, 3) = q * dt;
+
+        track.x = F * track.x;
+        track.P = F * track.P * F.transpose() + Q;
+        track.lastUpdate = timestamp;
+    }
+
+    // Result for the current track state
+    MultilaterationResult makeResult(
+        const Track& track, double normalizedInnovation, uint64_t timestamp,
+        const std::map<std::string, time_difference::SignalSource>& sources) {
+
+        MultilaterationResult result;
+        result.position = Position2D(
+            track.x(0), track.x(1),
+            std::sqrt(track.P(0, 0)), std::sqrt(track.P(1, 1)),
+            std::exp(-0.5 * normalizedInnovation), timestamp);
+
+        std::array<std::array<double, 2>, 2> covariance = {{
+            {track.P(0, 0), track.P(0, 1)},
+            {track.P(1, 0), track.P(1, 1)}
+        }};
+        result.confidence = MultilaterationSolver::covarianceToEllipse(
+            covariance, result.position, config.solverConfig.confidenceLevel);
+        result.gdop = MultilaterationSolver::calculateGDOP(sources, result.position);
+        result.iterations = 1;
+        result.residualError = std::sqrt(normalizedInnovation);
+        result.valid = true;
+        result.diagnosticMessage = "Track update";
+        return result;
+    }
+
+    // Full solve used on initiation and gate failure
+    MultilaterationResult fullSolve(
+        const time_difference::TimeDifferenceSet& timeDiffs,
+        const std::map<std::string, time_difference::SignalSource>& sources) {
+        stats.fullSolves++;
+        MultilaterationResult result = solver.calculatePosition(timeDiffs, sources);
+        result.position.timestamp = timeDiffs.timestamp;
+        return result;
+    }
+};
+
+EmitterTracker::EmitterTracker(const TrackerConfig& config)
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->config = config;
+    pImpl->solver.setConfig(config.solverConfig);
+}
+
+EmitterTracker::~EmitterTracker() = default;
+
+MultilaterationResult EmitterTracker::update(
+    const std::string& emitterId,
+    const time_difference::TimeDifferenceSet& timeDiffs,
+    const std::map<std::string, time_difference::SignalSource>& sources)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    const TrackerConfig& config = pImpl->config;
+    const uint64_t timestamp = timeDiffs.timestamp;
+
+    // Drop tracks that have not been updated for too long
+    const uint64_t timeoutNs = static_cast<uint64_t>(config.trackTimeout * 1.0e9);
+    for (auto it = pImpl->tracks.begin(); it != pImpl->tracks.end();) {
+        const uint64_t last = it->second.lastUpdate;
+        if (last != 0 && timestamp > last && timestamp - last > timeoutNs) {
+            it = pImpl->tracks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto trackIt = pImpl->tracks.find(emitterId);
+    if (trackIt == pImpl->tracks.end()) {
+        MultilaterationResult fix = pImpl->fullSolve(timeDiffs, sources);
+        if (fix.valid) {
+            pImpl->initiate(pImpl->tracks[emitterId], fix, timestamp);
+            fix.diagnosticMessage = "Track initiated";
+        }
+        return fix;
+    }
+
+    Impl::Track& track = trackIt->second;
+    pImpl->predict(track, timestamp);
+
+    // Linearize the range differences about the predicted position
+    const double c = config.solverConfig.speedOfLight;
+    const size_t maxRows = timeDiffs.timeDifferences.size();
+    Eigen::MatrixXd H = Eigen::MatrixXd::Zero(maxRows, 4);
+    Eigen::VectorXd innovation(maxRows);
+    Eigen::VectorXd variance(maxRows);
+
+    int rows = 0;
+    for (const auto& td : timeDiffs.timeDifferences) {
+        auto sourceIt = sources.find(td.sourceId);
+        auto refIt = sources.find(td.referenceId);
+        if (sourceIt == sources.end() || refIt == sources.end()) {
+            continue;
+        }
+        const auto& source = sourceIt->second.position;
+        const auto& reference = refIt->second.position;
+
+        const double dxs = track.x(0) - source.x;
+        const double dys = track.x(1) - source.y;
+        const double dxr = track.x(0) - reference.x;
+        const double dyr = track.x(1) - reference.y;
+        const double d1 = std::max(std::sqrt(dxs * dxs + dys * dys), 1e-6);
+        const double d2 = std::max(std::sqrt(dxr * dxr + dyr * dyr), 1e-6);
+
+        const double sigma = td.uncertainty > 0.0 ? td.uncertainty
+                                                  : config.solverConfig.timingUncertainty;
+        H(rows, 0) = dxs / d1 - dxr / d2;
+        H(rows, 1) = dys / d1 - dyr / d2;
+        innovation(rows) = c * td.timeDifference - (d1 - d2);
+        variance(rows) = (c * sigma) * (c * sigma);
+        rows++;
+    }
+
+    if (rows == 0) {
+        MultilaterationResult result;
+        result.diagnosticMessage = "No usable time differences for track update";
+        return result;
+    }
+
+    H.conservativeResize(rows, 4);
+    innovation.conservativeResize(rows);
+    variance.conservativeResize(rows);
+
+    Eigen::MatrixXd PHt = track.P * H.transpose();
+    Eigen::MatrixXd S = H * PHt;
+    S.diagonal() += variance;
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(S);
+    const double nis = innovation.dot(ldlt.solve(innovation));
+
+    // Innovation gate: fall back to a full solve, and re-initiate after repeated misses
+    if (!std::isfinite(nis) || nis > chiSquareGate(rows, config.gateSigma)) {
+        pImpl->stats.gateFailures++;
+        track.gateFailures++;
+        MultilaterationResult fix = pImpl->fullSolve(timeDiffs, sources);
+        if (fix.valid && track.gateFailures >= config.maxGateFailures) {
+            pImpl->initiate(track, fix, timestamp);
+            fix.diagnosticMessage = "Track re-initiated after gate failures";
+        } else {
+            fix.diagnosticMessage = "Innovation gate failed; full solve";
+        }
+        return fix;
+    }
+
+    // Kalman update, Joseph form for a symmetric positive covariance
+    Eigen::MatrixXd K = ldlt.solve(PHt.transpose()).transpose();
+    track.x += K * innovation;
+    StateMatrix IKH = StateMatrix::Identity() - K * H;
+    track.P = IKH * track.P * IKH.transpose() + K * variance.asDiagonal() * K.transpose();
+    track.updates++;
+    track.gateFailures = 0;
+    pImpl->stats.filterUpdates++;
+
+    return pImpl->makeResult(track, nis / rows, timestamp, sources);
+}
+
+bool EmitterTracker::getTrack(const std::string& emitterId, TrackState& state) const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->tracks.find(emitterId);
+    if (it == pImpl->tracks.end()) {
+        return false;
+    }
+
+    const Impl::Track& track = it->second;
+    state.emitterId = emitterId;
+    state.x = track.x(0);
+    state.y = track.x(1);
+    state.vx = track.x(2);
+    state.vy = track.x(3);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            state.covariance[i][j] = track.P(i, j);
+        }
+    }
+    state.lastUpdate = track.lastUpdate;
+    state.updates = track.updates;
+    state.gateFailures = track.gateFailures;
+    return true;
+}
+
+std::vector<std::string> EmitterTracker::getTrackIds() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::vector<std::string> ids;
+    ids.reserve(pImpl->tracks.size());
+    for (const auto& entry : pImpl->tracks) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+bool EmitterTracker::dropTrack(const std::string& emitterId)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->tracks.erase(emitterId) > 0;
+}
+
+void EmitterTracker::reset()
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->tracks.clear();
+    pImpl->stats = TrackerStats();
+}
+
+TrackerStats EmitterTracker::getStats() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->stats;
+}
+
+TrackerConfig EmitterTracker::getConfig() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->config;
+}
+
+void EmitterTracker::setConfig(const TrackerConfig& config)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->config = config;
+    pImpl->solver.setConfig(config.solverConfig);
+}
+
+} // namespace multilateration
+} // namespace tdoa
@@ -0,0 +1,176 @@
+/**
+ * @file emitter_tracker.h
+ * @brief Sequential EKF tracking of emitter positions from TDOA measurements
+ */
+
+#pragma once
+
+#include "multilateration_solver.h"
+#include <vector>
+#include <memory>
+#include <map>
+#include <string>
+#include <array>
+
+namespace tdoa {
+namespace multilateration {
+
+/**
+ * @struct TrackerConfig
+ * @brief Configuration for the emitter tracker
+ */
+struct TrackerConfig {
+    MultilaterationConfig solverConfig;     ///< Solver used for track initiation and gate failures
+    double processNoise;                    ///< Acceleration noise spectral density in m^2/s^3
+    double initialVelocityStd;              ///< Velocity standard deviation at initiation in m/s
+    double gateSigma;                       ///< Innovation gate width in standard deviations
+    int maxGateFailures;                    ///< Consecutive gate failures before re-initiating the track
+    double trackTimeout;                    ///< Seconds without an update before a track is dropped
+
+    /**
+     * @brief Constructor with default values
+     */
+    TrackerConfig()
+        : processNoise(1.0)             // Slowly manoeuvring ground emitter
+        , initialVelocityStd(30.0)      // 30 m/s
+        , gateSigma(3.0)
+        , maxGateFailures(3)
+        , trackTimeout(10.0)            // 10 s
+    {}
+};
+
+/**
+ * @struct TrackState
+ * @brief Filter state of a single emitter track
+ */
+struct TrackState {
+    std::string emitterId;                              ///< Emitter identifier
+    double x;                                           ///< X coordinate in meters
+    double y;                                           ///< Y coordinate in meters
+    double vx;                                          ///< X velocity in m/s
+    double vy;                                          ///< Y velocity in m/s
+    std::array<std::array<double, 4>, 4> covariance;    ///< Covariance of [x, y, vx, vy]
+    uint64_t lastUpdate;                                ///< Timestamp of the last update (ns since epoch)
+    int updates;                                        ///< Number of filter updates since initiation
+    int gateFailures;                                   ///< Consecutive gate failures
+
+    /**
+     * @brief Constructor with default values
+     */
+    TrackState()
+        : x(0.0)
+        , y(0.0)
+        , vx(0.0)
+        , vy(0.0)
+        , covariance{}
+        , lastUpdate(0)
+        , updates(0)
+        , gateFailures(0)
+    {}
+};
+
+/**
+ * @struct TrackerStats
+ * @brief Counters for tracker behaviour
+ */
+struct TrackerStats {
+    uint64_t filterUpdates;     ///< Fixes produced by an EKF update
+    uint64_t fullSolves;        ///< Fixes produced by the multilateration solver
+    uint64_t gateFailures;      ///< Measurement sets rejected by the innovation gate
+    uint64_t tracksInitiated;   ///< Tracks started or re-initiated
+
+    /**
+     * @brief Constructor with default values
+     */
+    TrackerStats()
+        : filterUpdates(0)
+        , fullSolves(0)
+        , gateFailures(0)
+        , tracksInitiated(0)
+    {}
+};
+
+/**
+ * @class EmitterTracker
+ * @brief Per-emitter constant-velocity extended Kalman filter
+ *
+ * Each TimeDifferenceSet updates the emitter's track with one EKF step on the
+ * range differences. The multilateration solver only runs when a track is
+ * started or when the measurements fall outside the innovation gate.
+ */
+class EmitterTracker {
+public:
+    /**
+     * @brief Constructor
+     * @param config Configuration for the tracker
+     */
+    EmitterTracker(const TrackerConfig& config = TrackerConfig());
+
+    /**
+     * @brief Destructor
+     */
+    ~EmitterTracker();
+
+    /**
+     * @brief Update an emitter track with a new set of time differences
+     * @param emitterId Emitter identifier
+     * @param timeDiffs Set of time differences
+     * @param sources Map of source IDs to signal sources
+     * @return Multilateration result for the updated track
+     */
+    MultilaterationResult update(
+        const std::string& emitterId,
+        const time_difference::TimeDifferenceSet& timeDiffs,
+        const std::map<std::string, time_difference::SignalSource>& sources);
+
+    /**
+     * @brief Get the state of a track
+     * @param emitterId Emitter identifier
+     * @param state Output track state
+     * @return True if the track exists
+     */
+    bool getTrack(const std::string& emitterId, TrackState& state) const;
+
+    /**
+     * @brief Get the IDs of all active tracks
+     * @return Vector of emitter identifiers
+     */
+    std::vector<std::string> getTrackIds() const;
+
+    /**
+     * @brief Drop a track
+     * @param emitterId Emitter identifier
+     * @return True if the track existed
+     */
+    bool dropTrack(const std::string& emitterId);
+
+    /**
+     * @brief Drop all tracks and reset statistics
+     */
+    void reset();
+
+    /**
+     * @brief Get tracker statistics
+     * @return Tracker statistics
+     */
+    TrackerStats getStats() const;
+
+    /**
+     * @brief Get configuration
+     * @return Current configuration
+     */
+    TrackerConfig getConfig() const;
+
+    /**
+     * @brief Set configuration
+     * @param config New configuration
+     */
+    void setConfig(const TrackerConfig& config);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace multilateration
+} // namespace tdoa
@@ -6,12 +6,142 @@
 #include "multilateration_solver.h"
 #include <cmath>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <vector>
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
 
 namespace tdoa {
 namespace multilateration {
 
+namespace {
+
+// Number of grid cells evaluated together so the per-receiver range table stays in L1
+constexpr size_t kGridBlockSize = 256;
+
+// Below this many cells a grid level is evaluated on the calling thread
+constexpr size_t kParallelCellThreshold = 8192;
+
+/**
+ * @brief Grid cells of one Bayesian search level, stored as structure-of-arrays
+ *        so the range and likelihood loops vectorize
+ */
+struct GridCells {
+    std::vector<double> x;              ///< Cell center X coordinates in meters
+    std::vector<double> y;              ///< Cell center Y coordinates in meters
+    std::vector<double> logPosterior;   ///< Unnormalized log posterior per cell
+    
+    size_t size() const { return x.size(); }
+    
+    void clear() {
+        x.clear();
+        y.clear();
+        logPosterior.clear();
+    }
+    
+    void push(double cx, double cy) {
+        x.push_back(cx);
+        y.push_back(cy);
+    }
+};
+
+/**
+ * @brief TDOA measurement resolved to receiver indices, in range-difference units
+ */
+struct RangeDifference {
+    size_t sourceIndex;     ///< Index of the measuring receiver
+    size_t referenceIndex;  ///< Index of the reference receiver
+    double rangeDiff;       ///< Measured range difference in meters
+    double variance;        ///< Measurement variance in square meters
+};
+
+/**
+ * @brief Evaluate the log posterior for cells [begin, end) block by block
+ * 
+ * For each block a range table (receiver x cell) is filled first, then every
+ * measurement accumulates its Gaussian log-likelihood over the block. Both
+ * inner loops run over contiguous arrays without branches.
+ */
+void evaluateLogPosterior(
+    GridCells& cells, size_t begin, size_t end,
+    const std::vector<double>& receiverX,
+    const std::vector<double>& receiverY,
+    const std::vector<RangeDifference>& measurements,
+    double cellVariance)
+{
+    const size_t numReceivers = receiverX.size();
+    std::vector<double> ranges(numReceivers * kGridBlockSize);
+    
+    // Per-measurement weights do not depend on the cell
+    std::vector<double> weights(measurements.size());
+    for (size_t m = 0; m < measurements.size(); ++m) {
+        weights[m] = -0.5 / (measurements[m].variance + cellVariance);
+    }
+    
+    for (size_t blockStart = begin; blockStart < end; blockStart += kGridBlockSize) {
+        const size_t n = std::min(kGridBlockSize, end - blockStart);
+        const double* xs = cells.x.data() + blockStart;
+        const double* ys = cells.y.data() + blockStart;
+        double* logPost = cells.logPosterior.data() + blockStart;
+        
+        for (size_t k = 0; k < numReceivers; ++k) {
+            const double rx = receiverX[k];
+            const double ry = receiverY[k];
+            double* range = ranges.data() + k * kGridBlockSize;
+            for (size_t i = 0; i < n; ++i) {
+                const double dx = xs[i] - rx;
+                const double dy = ys[i] - ry;
+                range[i] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+        
+        std::fill(logPost, logPost + n, 0.0);
+        for (size_t m = 0; m < measurements.size(); ++m) {
+            const double* rs = ranges.data() + measurements[m].sourceIndex * kGridBlockSize;
+            const double* rr = ranges.data() + measurements[m].referenceIndex * kGridBlockSize;
+            const double measured = measurements[m].rangeDiff;
+            const double weight = weights[m];
+            for (size_t i = 0; i < n; ++i) {
+                const double error = measured - (rs[i] - rr[i]);
+                logPost[i] += weight * error * error;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Split [0, count) into contiguous chunks and run them on worker threads
+ */
+template <typename Func>
+void parallelChunks(size_t count, int numThreads, Func&& func) {
+    size_t threads = numThreads > 0 ? static_cast<size_t>(numThreads)
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    if (count < kParallelCellThreshold || threads <= 1) {
+        func(size_t(0), count);
+        return;
+    }
+    
+    threads = std::min(threads, count / kGridBlockSize + 1);
+    const size_t chunk = ((count / threads) / kGridBlockSize + 1) * kGridBlockSize;
+    
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (size_t start = chunk; start < count; start += chunk) {
+        workers.emplace_back(func, start, std::min(count, start + chunk));
+    }
+    func(size_t(0), std::min(count, chunk));
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace
+
 /**
  * @struct MultilaterationSolver::Impl
  * @brief Private implementation of MultilaterationSolver
@@ -20,6 +150,35 @@ struct MultilaterationSolver::Impl {
     MultilaterationConfig config;
     PositionCallback positionCallback;
     
+    // Full covariance of the last solution, when the solver produces one
+    std::array<std::array<double, 2>, 2> solutionCovariance;
+    bool hasSolutionCovariance = false;
+    
+    // Iterations (or grid levels) used by the last solve
+    int lastIterations = 0;
+    
+    // Geodetic receivers converted to the last frame used, reused while unchanged
+    std::map<std::string, utils::GeodeticPosition> geodeticReceivers;
+    utils::GeodeticPosition geodeticFrameOrigin;
+    std::map<std::string, time_difference::SignalSource> localReceivers;
+    double localReceiverHeight = 0.0;
+    
+    // Refresh localReceivers if the receivers or frame changed since the last call
+    void updateLocalReceivers(
+        const std::map<std::string, utils::GeodeticPosition>& receivers,
+        const utils::LocalFrame& frame);
+    
+    // Mean receiver position
+    Position2D receiverCentroid(const std::map<std::string, time_difference::SignalSource>& sources);
+    
+    // Exact linear TDOA fix on a few receivers, the first being the reference;
+    // false if a receiver has no measurement against it or the fix is not physical
+    bool solveClosedForm(
+        const time_difference::TimeDifferenceSet& timeDiffs,
+        const std::map<std::string, time_difference::SignalSource>& sources,
+        const std::vector<std::string>& receivers,
+        Position2D& position);
+    
     // Least squares solution
     Position2D solveLeastSquares(
         const time_difference::TimeDifferenceSet& timeDiffs,
@@ -84,30 +243,69 @@ MultilaterationResult MultilaterationSolver::calculatePosition(
         return result;
     }
     
+    // Restrict large deployments to the best-conditioned receivers. The
+    // geometry is evaluated at a hint from this call's measurements, since an
+    // earlier fix may belong to a different emitter: a closed-form fix on the
+    // best quad as seen from the receiver centroid, or the centroid itself.
+    const time_difference::TimeDifferenceSet* activeDiffs = &timeDiffs;
+    const std::map<std::string, time_difference::SignalSource>* activeSources = &sources;
+    time_difference::TimeDifferenceSet selectedDiffs;
+    std::map<std::string, time_difference::SignalSource> selectedSources;
+    const int maxReceivers = pImpl->config.maxReceivers;
+    if (maxReceivers >= 3 && sources.size() > static_cast<size_t>(maxReceivers)) {
+        Position2D hint = pImpl->receiverCentroid(sources);
+        Position2D quadFix;
+        if (pImpl->solveClosedForm(timeDiffs, sources, selectReceivers(timeDiffs, sources, hint, 4), quadFix)) {
+            hint = quadFix;
+        }
+        for (const auto& id : selectReceivers(timeDiffs, sources, hint, maxReceivers)) {
+            selectedSources[id] = sources.at(id);
+        }
+        selectedDiffs.timestamp = timeDiffs.timestamp;
+        selectedDiffs.referenceId = timeDiffs.referenceId;
+        for (const auto& td : timeDiffs.timeDifferences) {
+            if (selectedSources.count(td.sourceId) && selectedSources.count(td.referenceId)) {
+                selectedDiffs.timeDifferences.push_back(td);
+            }
+        }
+        if (pImpl->hasEnoughSources(selectedSources, selectedDiffs)) {
+            activeDiffs = &selectedDiffs;
+            activeSources = &selectedSources;
+        }
+    }
+    
     // Calculate position based on selected method
+    pImpl->hasSolutionCovariance = false;
+    pImpl->lastIterations = 0;
     Position2D position;
     switch (pImpl->config.method) {
         case SolverMethod::LeastSquares:
-            position = pImpl->solveLeastSquares(timeDiffs, sources);
+            position = pImpl->solveLeastSquares(*activeDiffs, *activeSources);
             break;
         case SolverMethod::TaylorSeries:
-            position = pImpl->solveTaylorSeries(timeDiffs, sources);
+            position = pImpl->solveTaylorSeries(*activeDiffs, *activeSources);
             break;
         case SolverMethod::Bayesian:
-            position = pImpl->solveBayesian(timeDiffs, sources);
+            position = pImpl->solveBayesian(*activeDiffs, *activeSources);
             break;
         case SolverMethod::GradientDescent:
-            position = pImpl->solveGradientDescent(timeDiffs, sources);
+            position = pImpl->solveGradientDescent(*activeDiffs, *activeSources);
             break;
         default:
-            position = pImpl->solveTaylorSeries(timeDiffs, sources);
+            position = pImpl->solveTaylorSeries(*activeDiffs, *activeSources);
             break;
     }
     
     // Calculate uncertainty metrics
     result.position = position;
-    result.gdop = calculateGDOP(sources, position);
-    result.confidence = calculateConfidenceEllipse(position, pImpl->config.confidenceLevel);
+    result.iterations = pImpl->lastIterations;
+    result.gdop = calculateGDOP(*activeSources, position);
+    if (pImpl->hasSolutionCovariance) {
+        result.confidence = covarianceToEllipse(
+            pImpl->solutionCovariance, position, pImpl->config.confidenceLevel);
+    } else {
+        result.confidence = calculateConfidenceEllipse(position, pImpl->config.confidenceLevel);
+    }
     result.valid = true;
     
     // Call position callback if set
@@ -118,6 +316,297 @@ MultilaterationResult MultilaterationSolver::calculatePosition(
     return result;
 }
 
+MultilaterationResult MultilaterationSolver::calculatePosition(
+    const time_difference::TimeDifferenceSet& timeDiffs,
+    const std::map<std::string, utils::GeodeticPosition>& receivers,
+    const utils::LocalFrame& frame,
+    utils::GeodeticPosition& geodetic)
+{
+    pImpl->updateLocalReceivers(receivers, frame);
+    
+    MultilaterationResult result = calculatePosition(timeDiffs, pImpl->localReceivers);
+    if (result.valid) {
+        // 2D solution, placed at the mean receiver height
+        geodetic = frame.enuToGeodetic(utils::EnuPosition(
+            result.position.x, result.position.y, pImpl->localReceiverHeight));
+    }
+    return result;
+}
+
+Position2D MultilaterationSolver::Impl::receiverCentroid(
+    const std::map<std::string, time_difference::SignalSource>& sources)
+{
+    Position2D centroid;
+    if (sources.empty()) {
+        return centroid;
+    }
+    for (const auto& entry : sources) {
+        centroid.x += entry.second.position.x;
+        centroid.y += entry.second.position.y;
+    }
+    centroid.x /= sources.size();
+    centroid.y /= sources.size();
+    return centroid;
+}
+
+bool MultilaterationSolver::Impl::solveClosedForm(
+    const time_difference::TimeDifferenceSet& timeDiffs,
+    const std::map<std::string, time_difference::SignalSource>& sources,
+    const std::vector<std::string>& receivers,
+    Position2D& position)
+{
+    if (receivers.size() < 4) {
+        return false;
+    }
+    
+    // With q = p - p0, a_i = p_i - p0 and d_i = r_i - r0 the range equations
+    // become linear in (q, r0): 2 a_i . q + 2 d_i r0 = |a_i|^2 - d_i^2
+    const auto& reference = sources.at(receivers[0]).position;
+    Eigen::MatrixXd A(receivers.size() - 1, 3);
+    Eigen::VectorXd b(receivers.size() - 1);
+    for (size_t i = 1; i < receivers.size(); ++i) {
+        double rangeDifference = std::numeric_limits<double>::quiet_NaN();
+        for (const auto& td : timeDiffs.timeDifferences) {
+            if (td.sourceId == receivers[i] && td.referenceId == receivers[0]) {
+                rangeDifference = td.timeDifference * config.speedOfLight;
+                break;
+            }
+            if (td.sourceId == receivers[0] && td.referenceId == receivers[i]) {
+                rangeDifference = -td.timeDifference * config.speedOfLight;
+                break;
+            }
+        }
+        if (!std::isfinite(rangeDifference)) {
+            return false;
+        }
+        
+        const double ax = sources.at(receivers[i]).position.x - reference.x;
+        const double ay = sources.at(receivers[i]).position.y - reference.y;
+        A(i - 1, 0) = 2.0 * ax;
+        A(i - 1, 1) = 2.0 * ay;
+        A(i - 1, 2) = 2.0 * rangeDifference;
+        b(i - 1) = ax * ax + ay * ay - rangeDifference * rangeDifference;
+    }
+    
+    const Eigen::Vector3d solution = A.colPivHouseholderQr().solve(b);
+    if (!solution.allFinite() || solution(2) < 0.0) {
+        return false;
+    }
+    position.x = reference.x + solution(0);
+    position.y = reference.y + solution(1);
+    return true;
+}
+
+void MultilaterationSolver::Impl::updateLocalReceivers(
+    const std::map<std::string, utils::GeodeticPosition>& receivers,
+    const utils::LocalFrame& frame)
+{
+    auto samePosition = [](const utils::GeodeticPosition& a, const utils::GeodeticPosition& b) {
+        return a.latitude == b.latitude && a.longitude == b.longitude && a.altitude == b.altitude;
+    };
+    
+    if (!localReceivers.empty() &&
+        samePosition(geodeticFrameOrigin, frame.getOrigin()) &&
+        std::equal(receivers.begin(), receivers.end(), geodeticReceivers.begin(), geodeticReceivers.end(),
+                   [&](const auto& a, const auto& b) {
+                       return a.first == b.first && samePosition(a.second, b.second);
+                   })) {
+        return;
+    }
+    
+    const size_t count = receivers.size();
+    std::vector<double> lat, lon, alt;
+    lat.reserve(count);
+    lon.reserve(count);
+    alt.reserve(count);
+    for (const auto& entry : receivers) {
+        lat.push_back(entry.second.latitude);
+        lon.push_back(entry.second.longitude);
+        alt.push_back(entry.second.altitude);
+    }
+    
+    std::vector<double> east(count), north(count), up(count);
+    frame.geodeticToEnu(lat.data(), lon.data(), alt.data(), east.data(), north.data(), up.data(), count);
+    
+    localReceivers.clear();
+    localReceiverHeight = 0.0;
+    size_t i = 0;
+    for (const auto& entry : receivers) {
+        time_difference::SignalSource source;
+        source.id = entry.first;
+        source.position.x = east[i];
+        source.position.y = north[i];
+        source.position.z = up[i];
+        localReceivers[entry.first] = source;
+        localReceiverHeight += up[i] / count;
+        ++i;
+    }
+    
+    geodeticReceivers = receivers;
+    geodeticFrameOrigin = frame.getOrigin();
+}
+
+std::vector<std::string> MultilaterationSolver::selectReceivers(
+    const time_difference::TimeDifferenceSet& timeDiffs,
+    const std::map<std::string, time_difference::SignalSource>& sources,
+    const Position2D& position,
+    int count) const
+{
+    const MultilaterationConfig& config = pImpl->config;
+    
+    // Reference: the requested one, else the receiver in the most measurements
+    std::map<std::string, int> participation;
+    for (const auto& td : timeDiffs.timeDifferences) {
+        if (sources.count(td.sourceId) && sources.count(td.referenceId)) {
+            participation[td.sourceId]++;
+            participation[td.referenceId]++;
+        }
+    }
+    std::string referenceId = timeDiffs.referenceId;
+    if (!participation.count(referenceId)) {
+        referenceId.clear();
+        int most = 0;
+        for (const auto& entry : participation) {
+            if (entry.second > most) {
+                most = entry.second;
+                referenceId = entry.first;
+            }
+        }
+    }
+    if (referenceId.empty()) {
+        return {};
+    }
+    
+    // Fisher information contribution of each receiver's pair with the
+    // reference: w * g * g^T with g = u(receiver) - u(reference), where u is
+    // the unit vector from a receiver to the position and w = confidence / sigma^2
+    auto unitVector = [&](const time_difference::SignalSource& source, double& ux, double& uy) {
+        const double dx = position.x - source.position.x;
+        const double dy = position.y - source.position.y;
+        const double distance = std::max(std::sqrt(dx * dx + dy * dy), 1e-6);
+        ux = dx / distance;
+        uy = dy / distance;
+    };
+    
+    double refUx, refUy;
+    unitVector(sources.at(referenceId), refUx, refUy);
+    
+    struct Contribution {
+        std::string id;
+        double xx = 0.0, xy = 0.0, yy = 0.0;
+    };
+    std::vector<Contribution> candidates;
+    std::map<std::string, size_t> candidateIndex;
+    for (const auto& td : timeDiffs.timeDifferences) {
+        std::string other;
+        if (td.referenceId == referenceId) {
+            other = td.sourceId;
+        } else if (td.sourceId == referenceId) {
+            other = td.referenceId;
+        }
+        auto otherIt = sources.find(other);
+        if (otherIt == sources.end() || other == referenceId) {
+            continue;
+        }
+        
+        const double sigma = (td.uncertainty > 0.0 ? td.uncertainty : config.timingUncertainty)
+                           * config.speedOfLight;
+        const double weight = std::max(td.confidence, 0.0) / (sigma * sigma);
+        double ux, uy;
+        unitVector(otherIt->second, ux, uy);
+        const double gx = ux - refUx;
+        const double gy = uy - refUy;
+        
+        auto inserted = candidateIndex.emplace(other, candidates.size());
+        if (inserted.second) {
+            candidates.push_back(Contribution{other});
+        }
+        Contribution& c = candidates[inserted.first->second];
+        c.xx += weight * gx * gx;
+        c.xy += weight * gx * gy;
+        c.yy += weight * gy * gy;
+    }
+    
+    const size_t pick = std::min(candidates.size(), static_cast<size_t>(std::max(count - 1, 0)));
+    std::vector<std::string> selected = {referenceId};
+    if (pick == candidates.size()) {
+        for (const auto& c : candidates) {
+            selected.push_back(c.id);
+        }
+        return selected;
+    }
+    
+    // Predicted horizontal variance, trace(J^-1), of a 2x2 information matrix;
+    // a tiny ridge keeps partial sets with singular J comparable
+    const double ridge = 1e-12 * std::accumulate(candidates.begin(), candidates.end(), 0.0,
+        [](double sum, const Contribution& c) { return sum + c.xx + c.yy; });
+    auto horizontalVariance = [ridge](double xx, double xy, double yy) {
+        xx += ridge;
+        yy += ridge;
+        const double det = xx * yy - xy * xy;
+        return det > 0.0 ? (xx + yy) / det : std::numeric_limits<double>::infinity();
+    };
+    
+    // Number of subsets, saturating at the exhaustive search limit
+    double combinations = 1.0;
+    for (size_t i = 0; i < pick; ++i) {
+        combinations = combinations * (candidates.size() - i) / (i + 1);
+    }
+    
+    std::vector<size_t> best;
+    if (combinations <= static_cast<double>(config.exhaustiveSelectionLimit)) {
+        // Exhaustive search; the running information matrix makes each step O(1)
+        std::vector<size_t> current;
+        double bestVariance = std::numeric_limits<double>::infinity();
+        std::function<void(size_t, double, double, double)> search =
+            [&](size_t start, double xx, double xy, double yy) {
+                if (current.size() == pick) {
+                    const double variance = horizontalVariance(xx, xy, yy);
+                    if (variance < bestVariance) {
+                        bestVariance = variance;
+                        best = current;
+                    }
+                    return;
+                }
+                for (size_t i = start; i + (pick - current.size()) <= candidates.size(); ++i) {
+                    current.push_back(i);
+                    search(i + 1, xx + candidates[i].xx, xy + candidates[i].xy, yy + candidates[i].yy);
+                    current.pop_back();
+                }
+            };
+        search(0, 0.0, 0.0, 0.0);
+    } else {
+        // Greedy forward selection
+        std::vector<bool> used(candidates.size(), false);
+        double xx = 0.0, xy = 0.0, yy = 0.0;
+        for (size_t step = 0; step < pick; ++step) {
+            size_t bestIndex = candidates.size();
+            double bestVariance = std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (used[i]) {
+                    continue;
+                }
+                const double variance = horizontalVariance(
+                    xx + candidates[i].xx, xy + candidates[i].xy, yy + candidates[i].yy);
+                if (bestIndex == candidates.size() || variance < bestVariance) {
+                    bestIndex = i;
+                    bestVariance = variance;
+                }
+            }
+            used[bestIndex] = true;
+            best.push_back(bestIndex);
+            xx += candidates[bestIndex].xx;
+            xy += candidates[bestIndex].xy;
+            yy += candidates[bestIndex].yy;
+        }
+    }
+    
+    for (size_t i : best) {
+        selected.push_back(candidates[i].id);
+    }
+    return selected;
+}
+
 void MultilaterationSolver::setPositionCallback(PositionCallback callback)
 {
     pImpl->positionCallback = callback;
@@ -546,6 +1035,7 @@ Position2D MultilaterationSolver::Impl::solveTaylorSeries(
     // Calculate confidence from residuals and convergence
     double normalizedResidual = std::sqrt(residualSumSquares / row) / config.speedOfLight;
     double iterationPenalty = static_cast<double>(iterations) / config.maxIterations;
+    lastIterations = iterations;
     position.confidence = std::exp(-normalizedResidual / 1.0e-6) * (1.0 - 0.5 * iterationPenalty);
     position.confidence = std::max(0.0, std::min(1.0, position.confidence)); // Clamp to [0,1]
     
@@ -558,11 +1048,164 @@ Position2D MultilaterationSolver::Impl::solveBayesian(
 {
     Position2D position;
     
-    // Implementation of Bayesian solution will be added later
-    // For now, return a position with high uncertainty
-    position.uncertaintyX = 100.0;
-    position.uncertaintyY = 100.0;
-    position.confidence = 0.1;
+    // Need at least 3 sources for a 2D solution
+    if (sources.size() < 3) {
+        position.uncertaintyX = 1000.0;
+        position.uncertaintyY = 1000.0;
+        position.confidence = 0.0;
+        return position;
+    }
+    
+    // Index receivers so the range tables can be addressed by integer
+    std::vector<double> receiverX;
+    std::vector<double> receiverY;
+    std::map<std::string, size_t> receiverIndex;
+    for (const auto& sourceEntry : sources) {
+        receiverIndex[sourceEntry.first] = receiverX.size();
+        receiverX.push_back(sourceEntry.second.position.x);
+        receiverY.push_back(sourceEntry.second.position.y);
+    }
+    
+    // Convert measurements to range differences
+    std::vector<RangeDifference> measurements;
+    for (const auto& td : timeDiffs.timeDifferences) {
+        auto sourceIt = receiverIndex.find(td.sourceId);
+        auto refIt = receiverIndex.find(td.referenceId);
+        if (sourceIt == receiverIndex.end() || refIt == receiverIndex.end()) {
+            continue;
+        }
+        
+        double sigma = td.uncertainty > 0.0 ? td.uncertainty : config.timingUncertainty;
+        double sigmaRange = sigma * config.speedOfLight;
+        measurements.push_back({sourceIt->second, refIt->second,
+                                td.timeDifference * config.speedOfLight,
+                                sigmaRange * sigmaRange});
+    }
+    
+    if (measurements.size() < 2) {
+        position.uncertaintyX = 1000.0;
+        position.uncertaintyY = 1000.0;
+        position.confidence = 0.0;
+        return position;
+    }
+    
+    // Coarsest level covers the configured region with square cells
+    const double width = config.regionMaxX - config.regionMinX;
+    const double height = config.regionMaxY - config.regionMinY;
+    const int coarseCells = std::max(2, config.gridCoarseCells);
+    const int refineFactor = std::max(2, config.gridRefineFactor);
+    double cellSize = std::max(width, height) / coarseCells;
+    
+    GridCells cells;
+    const int nx = std::max(1, static_cast<int>(std::ceil(width / cellSize)));
+    const int ny = std::max(1, static_cast<int>(std::ceil(height / cellSize)));
+    for (int iy = 0; iy < ny; ++iy) {
+        for (int ix = 0; ix < nx; ++ix) {
+            cells.push(config.regionMinX + (ix + 0.5) * cellSize,
+                       config.regionMinY + (iy + 0.5) * cellSize);
+        }
+    }
+    
+    std::vector<double> mass;
+    std::vector<size_t> selected;
+    GridCells children;
+    
+    while (true) {
+        lastIterations++;
+        
+        // Inflate the likelihood by the cell size so narrow hyperbolae are not
+        // missed between coarse cell centers
+        const double cellVariance = cellSize * cellSize;
+        cells.logPosterior.resize(cells.size());
+        parallelChunks(cells.size(), config.numThreads, [&](size_t begin, size_t end) {
+            evaluateLogPosterior(cells, begin, end, receiverX, receiverY,
+                                 measurements, cellVariance);
+        });
+        
+        // Normalize to posterior mass over the evaluated cells
+        const double maxLogPost = *std::max_element(
+            cells.logPosterior.begin(), cells.logPosterior.end());
+        mass.resize(cells.size());
+        double totalMass = 0.0;
+        for (size_t i = 0; i < cells.size(); ++i) {
+            mass[i] = std::exp(cells.logPosterior[i] - maxLogPost);
+            totalMass += mass[i];
+        }
+        for (auto& m : mass) {
+            m /= totalMass;
+        }
+        
+        if (cellSize <= config.gridFinalResolution) {
+            break;
+        }
+        
+        // Keep only cells carrying significant posterior mass
+        selected.clear();
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (mass[i] >= config.posteriorMassThreshold) {
+                selected.push_back(i);
+            }
+        }
+        if (selected.empty()) {
+            selected.push_back(std::max_element(mass.begin(), mass.end()) - mass.begin());
+        }
+        const size_t maxActive = static_cast<size_t>(std::max(1, config.gridMaxActiveCells));
+        if (selected.size() > maxActive) {
+            std::nth_element(selected.begin(), selected.begin() + maxActive, selected.end(),
+                [&mass](size_t a, size_t b) { return mass[a] > mass[b]; });
+            selected.resize(maxActive);
+        }
+        
+        // Subdivide the selected cells
+        const double childSize = cellSize / refineFactor;
+        children.clear();
+        for (size_t index : selected) {
+            const double originX = cells.x[index] - 0.5 * cellSize;
+            const double originY = cells.y[index] - 0.5 * cellSize;
+            for (int cy = 0; cy < refineFactor; ++cy) {
+                for (int cx = 0; cx < refineFactor; ++cx) {
+                    children.push(originX + (cx + 0.5) * childSize,
+                                  originY + (cy + 0.5) * childSize);
+                }
+            }
+        }
+        std::swap(cells, children);
+        cellSize = childSize;
+    }
+    
+    // MAP estimate is the most probable cell at the finest level
+    const size_t mapIndex = std::max_element(mass.begin(), mass.end()) - mass.begin();
+    position.x = cells.x[mapIndex];
+    position.y = cells.y[mapIndex];
+    
+    // Posterior covariance about the MAP, including the cell quantization
+    double cxx = cellSize * cellSize / 12.0;
+    double cyy = cxx;
+    double cxy = 0.0;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const double dx = cells.x[i] - position.x;
+        const double dy = cells.y[i] - position.y;
+        cxx += mass[i] * dx * dx;
+        cyy += mass[i] * dy * dy;
+        cxy += mass[i] * dx * dy;
+    }
+    solutionCovariance = {{{cxx, cxy}, {cxy, cyy}}};
+    hasSolutionCovariance = true;
+    position.uncertaintyX = std::sqrt(cxx);
+    position.uncertaintyY = std::sqrt(cyy);
+    
+    // Calculate confidence from residuals at the MAP position
+    double residualSumSquares = 0.0;
+    for (const auto& m : measurements) {
+        double ds = calculateDistance(position.x, position.y,
+                                      receiverX[m.sourceIndex], receiverY[m.sourceIndex]);
+        double dr = calculateDistance(position.x, position.y,
+                                      receiverX[m.referenceIndex], receiverY[m.referenceIndex]);
+        residualSumSquares += std::pow(m.rangeDiff - (ds - dr), 2);
+    }
+    double normalizedResidual = std::sqrt(residualSumSquares / measurements.size()) / config.speedOfLight;
+    position.confidence = std::exp(-normalizedResidual / 1.0e-6);
+    position.confidence = std::max(0.0, std::min(1.0, position.confidence)); // Clamp to [0,1]
     
     return position;
 }
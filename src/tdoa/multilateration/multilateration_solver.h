@@ -6,6 +6,7 @@
 #pragma once
 
 #include "../time_difference/time_difference_extractor.h"
+#include "../utils/geodetic.h"
 #include <vector>
 #include <memory>
 #include <functional>
@@ -106,6 +107,15 @@ struct MultilaterationConfig {
     double regionMaxX;                  ///< Region maximum X coordinate
     double regionMinY;                  ///< Region minimum Y coordinate
     double regionMaxY;                  ///< Region maximum Y coordinate
+    double timingUncertainty;           ///< Default TDOA standard deviation in seconds
+    int gridCoarseCells;                ///< Cells per axis on the coarsest Bayesian grid
+    int gridRefineFactor;               ///< Per-axis subdivision between Bayesian grid levels
+    double gridFinalResolution;         ///< Bayesian grid cell size to stop refining at, in meters
+    double posteriorMassThreshold;      ///< Minimum posterior mass for a cell to be refined
+    int gridMaxActiveCells;             ///< Maximum number of cells refined per grid level
+    int numThreads;                     ///< Worker threads for grid evaluation (0 = auto-detect)
+    int maxReceivers;                   ///< Receivers used per fix, chosen by geometry (0 = use all)
+    int exhaustiveSelectionLimit;       ///< Largest number of receiver subsets searched exhaustively
     
     /**
      * @brief Constructor with default values
@@ -123,6 +133,15 @@ struct MultilaterationConfig {
         , regionMaxX(1000.0)
         , regionMinY(-1000.0)
         , regionMaxY(1000.0)
+        , timingUncertainty(10.0e-9)  // 10 ns, ~3 m in range difference
+        , gridCoarseCells(64)
+        , gridRefineFactor(4)
+        , gridFinalResolution(1.0)   // 1 m
+        , posteriorMassThreshold(1.0e-4)
+        , gridMaxActiveCells(2048)
+        , numThreads(0)
+        , maxReceivers(0)
+        , exhaustiveSelectionLimit(5000)
     {}
 };
 
@@ -209,6 +228,24 @@ public:
         const time_difference::TimeDifferenceSet& timeDiffs,
         const std::map<std::string, time_difference::SignalSource>& sources);
     
+    /**
+     * @brief Calculate position from time differences with geodetic receivers
+     * 
+     * Receivers are converted into the local frame once and reused for as long
+     * as the receiver set and frame origin stay the same, so repeated fixes
+     * only pay for converting the solution back.
+     * @param timeDiffs Set of time differences
+     * @param receivers Map of receiver IDs to geodetic positions
+     * @param frame Local frame the solution is expressed in (x = east, y = north)
+     * @param geodetic Output geodetic position of the solution
+     * @return Multilateration result in the local frame
+     */
+    MultilaterationResult calculatePosition(
+        const time_difference::TimeDifferenceSet& timeDiffs,
+        const std::map<std::string, utils::GeodeticPosition>& receivers,
+        const utils::LocalFrame& frame,
+        utils::GeodeticPosition& geodetic);
+    
     /**
      * @brief Set position callback
      * @param callback Function to call when new position is calculated
@@ -237,6 +274,25 @@ public:
         const std::map<std::string, time_difference::SignalSource>& sources,
         const Position2D& position);
     
+    /**
+     * @brief Select the receivers that minimize predicted horizontal error
+     * 
+     * Each receiver's pair with the reference adds a rank-one term, weighted
+     * by confidence / variance, to a 2x2 Fisher information matrix evaluated
+     * at position. Subsets are searched exhaustively when there are at most
+     * exhaustiveSelectionLimit of them, otherwise greedily.
+     * @param timeDiffs Set of time differences
+     * @param sources Map of source IDs to signal sources
+     * @param position Approximate emitter position to evaluate geometry at
+     * @param count Number of receivers to select, including the reference
+     * @return Selected receiver IDs, reference first
+     */
+    std::vector<std::string> selectReceivers(
+        const time_difference::TimeDifferenceSet& timeDiffs,
+        const std::map<std::string, time_difference::SignalSource>& sources,
+        const Position2D& position,
+        int count) const;
+    
     /**
      * @brief Calculate confidence ellipse for a position
      * @param position 2D position with uncertainties
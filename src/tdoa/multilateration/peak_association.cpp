@@ -0,0 +1,438 @@
+/**
+ * @file peak_association.cpp
+ * @brief Implementation of multi-hypothesis correlation peak association
+ */
+
+#include "peak_association.h"
+#include <cmath>
+#include <algorithm>
+#include <set>
+#include <mutex>
+#include <utility>
+
+namespace tdoa {
+namespace multilateration {
+
+namespace {
+
+/**
+ * @brief One peak, oriented as t(receiver) - t(other)
+ */
+struct Candidate {
+    double tau;                 ///< Time difference in seconds
+    double sigma;               ///< Standard deviation in seconds
+    double confidence;          ///< Peak confidence
+    std::pair<size_t, size_t> key; ///< (pair index, peak index) in the input
+};
+
+/**
+ * @brief Complete assignment of one peak per reference pair
+ */
+struct Hypothesis {
+    std::vector<const Candidate*> referencePeaks;  ///< Per non-reference receiver
+    std::vector<std::pair<size_t, size_t>> closurePeaks; ///< (receiver a, receiver b) index pairs
+    std::vector<const Candidate*> closureMatches;  ///< Matched closure peak per entry above
+};
+
+} // namespace
+
+PairCandidates PairCandidates::fromCorrelation(
+    const std::string& source,
+    const std::string& reference,
+    const correlation::CorrelationResult& result,
+    double uncertainty)
+{
+    PairCandidates pair;
+    pair.sourceId = source;
+    pair.referenceId = reference;
+    if (result.sampleRate <= 0.0) {
+        return pair;
+    }
+
+    for (const auto& peak : result.peaks) {
+        time_difference::TimeDifference td;
+        td.sourceId = source;
+        td.referenceId = reference;
+        td.timeDifference = (peak.delay - result.zeroLag) / result.sampleRate;
+        td.uncertainty = uncertainty;
+        td.confidence = peak.confidence;
+        pair.candidates.push_back(td);
+    }
+    return pair;
+}
+
+/**
+ * @struct PeakAssociator::Impl
+ * @brief Private implementation of PeakAssociator
+ */
+struct PeakAssociator::Impl {
+    AssociationConfig config;
+    AssociationStats stats;
+    MultilaterationSolver solver;
+
+    // Receivers taking part in this call; index 0 is the reference
+    std::vector<std::string> receivers;
+
+    // Peaks of (receiver, reference), indexed by receiver
+    std::vector<std::vector<Candidate>> referencePairs;
+
+    // Peaks of (a, b) with a < b, oriented as t(a) - t(b)
+    std::map<std::pair<size_t, size_t>, std::vector<Candidate>> closurePairs;
+
+    std::vector<Hypothesis> hypotheses;
+    mutable std::mutex mutex;
+
+    double sigmaOf(const time_difference::TimeDifference& td) const {
+        return td.uncertainty > 0.0 ? td.uncertainty : config.solverConfig.timingUncertainty;
+    }
+
+    // Sort the input into reference and closure pairs; returns false if too few receivers
+    bool organize(const std::vector<PairCandidates>& pairs,
+                  const std::map<std::string, time_difference::SignalSource>& sources);
+
+    // Depth-first enumeration over reference pairs with closure pruning
+    void enumerate(const std::vector<size_t>& order, size_t depth,
+                   std::vector<const Candidate*>& assigned, Hypothesis& partial);
+
+    // Solve a hypothesis; returns false if it fails the residual gate
+    bool solve(const Hypothesis& hypothesis,
+               const std::map<std::string, time_difference::SignalSource>& sources,
+               uint64_t timestamp, EmitterHypothesis& emitter);
+
+    time_difference::TimeDifference toTimeDifference(
+        size_t a, size_t b, const Candidate& candidate, uint64_t timestamp) const {
+        time_difference::TimeDifference td;
+        td.sourceId = receivers[a];
+        td.referenceId = receivers[b];
+        td.timeDifference = candidate.tau;
+        td.uncertainty = candidate.sigma;
+        td.confidence = candidate.confidence;
+        td.timestamp = timestamp;
+        return td;
+    }
+};
+
+bool PeakAssociator::Impl::organize(
+    const std::vector<PairCandidates>& pairs,
+    const std::map<std::string, time_difference::SignalSource>& sources)
+{
+    receivers.clear();
+    referencePairs.clear();
+    closurePairs.clear();
+
+    // The receiver in the most pairs becomes the reference
+    std::map<std::string, int> participation;
+    for (const auto& pair : pairs) {
+        if (sources.count(pair.sourceId) && sources.count(pair.referenceId) &&
+            pair.sourceId != pair.referenceId && !pair.candidates.empty()) {
+            participation[pair.sourceId]++;
+            participation[pair.referenceId]++;
+        }
+    }
+    if (participation.size() < 3) {
+        return false;
+    }
+
+    auto reference = std::max_element(participation.begin(), participation.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    receivers.push_back(reference->first);
+    for (const auto& entry : participation) {
+        if (entry.first != reference->first) {
+            receivers.push_back(entry.first);
+        }
+    }
+
+    std::map<std::string, size_t> index;
+    for (size_t i = 0; i < receivers.size(); ++i) {
+        index[receivers[i]] = i;
+    }
+    referencePairs.resize(receivers.size());
+
+    const double c = config.solverConfig.speedOfLight;
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        const auto& pair = pairs[p];
+        auto sourceIt = index.find(pair.sourceId);
+        auto refIt = index.find(pair.referenceId);
+        if (sourceIt == index.end() || refIt == index.end() || sourceIt->second == refIt->second) {
+            continue;
+        }
+
+        // Orient so that a < b and tau = t(a) - t(b)
+        size_t a = sourceIt->second;
+        size_t b = refIt->second;
+        const double sign = a < b ? 1.0 : -1.0;
+        if (a > b) {
+            std::swap(a, b);
+        }
+
+        const auto& posA = sources.at(receivers[a]).position;
+        const auto& posB = sources.at(receivers[b]).position;
+        const double baseline = std::sqrt(std::pow(posA.x - posB.x, 2) +
+                                          std::pow(posA.y - posB.y, 2) +
+                                          std::pow(posA.z - posB.z, 2)) / c;
+
+        for (size_t k = 0; k < pair.candidates.size(); ++k) {
+            const auto& td = pair.candidates[k];
+            Candidate candidate{sign * td.timeDifference, sigmaOf(td), td.confidence, {p, k}};
+
+            // A real emitter cannot produce a lag longer than the baseline
+            if (std::abs(candidate.tau) > baseline + config.closureSigma * candidate.sigma) {
+                stats.prunedByBounds++;
+                continue;
+            }
+
+            if (a == 0) {
+                // Pair with the reference: store as t(b) - t(reference)
+                candidate.tau = -candidate.tau;
+                referencePairs[b].push_back(candidate);
+            } else {
+                closurePairs[{a, b}].push_back(candidate);
+            }
+        }
+    }
+
+    return true;
+}
+
+void PeakAssociator::Impl::enumerate(
+    const std::vector<size_t>& order, size_t depth,
+    std::vector<const Candidate*>& assigned, Hypothesis& partial)
+{
+    if (hypotheses.size() >= static_cast<size_t>(config.maxHypotheses)) {
+        return;
+    }
+    if (depth == order.size()) {
+        partial.referencePeaks = assigned;
+        hypotheses.push_back(partial);
+        return;
+    }
+
+    const size_t receiver = order[depth];
+    const size_t closureMark = partial.closurePeaks.size();
+
+    for (const Candidate& candidate : referencePairs[receiver]) {
+        bool consistent = true;
+
+        // Closure against every receiver assigned so far: tau_ab = tau_ar - tau_br
+        for (size_t d = 0; d < depth && consistent; ++d) {
+            const size_t other = order[d];
+            const size_t a = std::min(receiver, other);
+            const size_t b = std::max(receiver, other);
+            auto closure = closurePairs.find({a, b});
+            if (closure == closurePairs.end()) {
+                continue;
+            }
+
+            const Candidate* tauA = a == receiver ? &candidate : assigned[other];
+            const Candidate* tauB = b == receiver ? &candidate : assigned[other];
+            const double predicted = tauA->tau - tauB->tau;
+
+            const Candidate* best = nullptr;
+            double bestError = 0.0;
+            for (const Candidate& peak : closure->second) {
+                const double tolerance = config.closureSigma * std::sqrt(
+                    tauA->sigma * tauA->sigma + tauB->sigma * tauB->sigma + peak.sigma * peak.sigma);
+                const double error = std::abs(peak.tau - predicted);
+                if (error <= tolerance && (!best || error < bestError)) {
+                    best = &peak;
+                    bestError = error;
+                }
+            }
+
+            if (!best) {
+                consistent = false;
+            } else {
+                partial.closurePeaks.push_back({a, b});
+                partial.closureMatches.push_back(best);
+            }
+        }
+
+        if (consistent) {
+            assigned[receiver] = &candidate;
+            enumerate(order, depth + 1, assigned, partial);
+            assigned[receiver] = nullptr;
+        } else {
+            stats.prunedByClosure++;
+        }
+
+        partial.closurePeaks.resize(closureMark);
+        partial.closureMatches.resize(closureMark);
+    }
+}
+
+bool PeakAssociator::Impl::solve(
+    const Hypothesis& hypothesis,
+    const std::map<std::string, time_difference::SignalSource>& sources,
+    uint64_t timestamp, EmitterHypothesis& emitter)
+{
+    emitter.measurements = time_difference::TimeDifferenceSet();
+    emitter.measurements.timestamp = timestamp;
+    emitter.measurements.referenceId = receivers[0];
+    emitter.score = 0.0;
+
+    for (size_t r = 1; r < receivers.size(); ++r) {
+        const Candidate* candidate = hypothesis.referencePeaks[r];
+        if (candidate) {
+            emitter.measurements.timeDifferences.push_back(toTimeDifference(r, 0, *candidate, timestamp));
+            emitter.score += candidate->confidence;
+        }
+    }
+    for (size_t i = 0; i < hypothesis.closurePeaks.size(); ++i) {
+        const Candidate& candidate = *hypothesis.closureMatches[i];
+        emitter.measurements.timeDifferences.push_back(toTimeDifference(
+            hypothesis.closurePeaks[i].first, hypothesis.closurePeaks[i].second, candidate, timestamp));
+        emitter.score += candidate.confidence;
+    }
+
+    stats.hypothesesSolved++;
+    emitter.result = solver.calculatePosition(emitter.measurements, sources);
+    if (!emitter.result.valid) {
+        return false;
+    }
+
+    // Residual chi-square over every assigned peak
+    const double c = config.solverConfig.speedOfLight;
+    const auto& position = emitter.result.position;
+    double chiSquare = 0.0;
+    for (const auto& td : emitter.measurements.timeDifferences) {
+        const auto& s = sources.at(td.sourceId).position;
+        const auto& r = sources.at(td.referenceId).position;
+        const double predicted = (std::sqrt(std::pow(position.x - s.x, 2) + std::pow(position.y - s.y, 2)) -
+                                  std::sqrt(std::pow(position.x - r.x, 2) + std::pow(position.y - r.y, 2))) / c;
+        const double error = (td.timeDifference - predicted) / td.uncertainty;
+        chiSquare += error * error;
+    }
+
+    const int dof = static_cast<int>(emitter.measurements.timeDifferences.size()) - 2;
+    emitter.normalizedResidual = dof > 0 ? chiSquare / dof : 0.0;
+    if (emitter.normalizedResidual > config.maxNormalizedResidual) {
+        stats.rejectedByResidual++;
+        return false;
+    }
+    return true;
+}
+
+PeakAssociator::PeakAssociator(const AssociationConfig& config)
+    : pImpl(std::make_unique<Impl>())
+{
+    pImpl->config = config;
+    pImpl->solver.setConfig(config.solverConfig);
+}
+
+PeakAssociator::~PeakAssociator() = default;
+
+std::vector<EmitterHypothesis> PeakAssociator::associate(
+    const std::vector<PairCandidates>& pairs,
+    const std::map<std::string, time_difference::SignalSource>& sources,
+    uint64_t timestamp)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->stats = AssociationStats();
+    pImpl->hypotheses.clear();
+
+    std::vector<EmitterHypothesis> emitters;
+    if (!pImpl->organize(pairs, sources)) {
+        return emitters;
+    }
+
+    // Receivers with no reference-pair peak cannot be placed in a hypothesis.
+    // Visit the most constrained receivers first so closure prunes early.
+    std::vector<size_t> order;
+    for (size_t r = 1; r < pImpl->receivers.size(); ++r) {
+        if (!pImpl->referencePairs[r].empty()) {
+            order.push_back(r);
+        }
+    }
+    if (order.size() < 2) {
+        return emitters;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return pImpl->referencePairs[a].size() < pImpl->referencePairs[b].size();
+    });
+
+    std::vector<const Candidate*> assigned(pImpl->receivers.size(), nullptr);
+    Hypothesis partial;
+    pImpl->enumerate(order, 0, assigned, partial);
+
+    std::vector<EmitterHypothesis> solved;
+    std::vector<const Hypothesis*> solvedFrom;
+    for (const auto& hypothesis : pImpl->hypotheses) {
+        EmitterHypothesis emitter;
+        if (pImpl->solve(hypothesis, sources, timestamp, emitter)) {
+            solved.push_back(std::move(emitter));
+            solvedFrom.push_back(&hypothesis);
+        }
+    }
+
+    // Best residual first, more confident peaks breaking ties
+    std::vector<size_t> ranking(solved.size());
+    for (size_t i = 0; i < ranking.size(); ++i) {
+        ranking[i] = i;
+    }
+    std::sort(ranking.begin(), ranking.end(), [&](size_t a, size_t b) {
+        if (solved[a].normalizedResidual != solved[b].normalizedResidual) {
+            return solved[a].normalizedResidual < solved[b].normalizedResidual;
+        }
+        return solved[a].score > solved[b].score;
+    });
+
+    // Greedy acceptance: each peak normally explains a single emitter
+    std::set<std::pair<size_t, size_t>> usedPeaks;
+    for (size_t i : ranking) {
+        if (emitters.size() >= static_cast<size_t>(pImpl->config.maxEmitters)) {
+            break;
+        }
+        const Hypothesis& hypothesis = *solvedFrom[i];
+        const auto& position = solved[i].result.position;
+
+        int shared = 0;
+        for (const Candidate* candidate : hypothesis.referencePeaks) {
+            if (candidate && usedPeaks.count(candidate->key)) {
+                shared++;
+            }
+        }
+        if (shared > pImpl->config.maxSharedPeaks) {
+            continue;
+        }
+
+        bool separated = std::all_of(emitters.begin(), emitters.end(), [&](const EmitterHypothesis& e) {
+            return std::hypot(e.result.position.x - position.x,
+                              e.result.position.y - position.y) >= pImpl->config.minSeparation;
+        });
+        if (!separated) {
+            continue;
+        }
+
+        for (const Candidate* candidate : hypothesis.referencePeaks) {
+            if (candidate) {
+                usedPeaks.insert(candidate->key);
+            }
+        }
+        emitters.push_back(std::move(solved[i]));
+    }
+
+    pImpl->stats.emitters = emitters.size();
+    return emitters;
+}
+
+AssociationStats PeakAssociator::getStats() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->stats;
+}
+
+AssociationConfig PeakAssociator::getConfig() const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->config;
+}
+
+void PeakAssociator::setConfig(const AssociationConfig& config)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->config = config;
+    pImpl->solver.setConfig(config.solverConfig);
+}
+
+} // namespace multilateration
+} // namespace tdoa
@@ -0,0 +1,172 @@
+/**
+ * @file peak_association.h
+ * @brief Multi-hypothesis association of correlation peaks for co-channel emitters
+ */
+
+#pragma once
+
+#include "multilateration_solver.h"
+#include "../correlation/cross_correlation.h"
+#include <vector>
+#include <memory>
+#include <map>
+#include <string>
+
+namespace tdoa {
+namespace multilateration {
+
+/**
+ * @struct PairCandidates
+ * @brief Candidate time differences for one receiver pair
+ *
+ * Each candidate uses the pair's IDs; timeDifference is t(source) - t(reference).
+ */
+struct PairCandidates {
+    std::string sourceId;                                   ///< Measuring receiver
+    std::string referenceId;                                ///< Reference receiver
+    std::vector<time_difference::TimeDifference> candidates; ///< One entry per correlation peak
+
+    /**
+     * @brief Build candidates from a pair's correlation peaks
+     * @param source Measuring receiver ID
+     * @param reference Reference receiver ID
+     * @param result Correlation with the reference as signal1 and the source as signal2
+     * @param uncertainty Timing standard deviation to assign in seconds (0 = solver default)
+     * @return Pair candidates
+     */
+    static PairCandidates fromCorrelation(
+        const std::string& source,
+        const std::string& reference,
+        const correlation::CorrelationResult& result,
+        double uncertainty = 0.0);
+};
+
+/**
+ * @struct AssociationConfig
+ * @brief Configuration for peak association
+ */
+struct AssociationConfig {
+    MultilaterationConfig solverConfig;     ///< Solver used for each surviving hypothesis
+    double closureSigma;                    ///< Closure tolerance in combined standard deviations
+    double maxNormalizedResidual;           ///< Maximum residual chi-square per degree of freedom
+    int maxSharedPeaks;                     ///< Peaks an emitter may share with an earlier, better emitter
+    double minSeparation;                   ///< Minimum distance between reported emitters in meters
+    int maxHypotheses;                      ///< Upper bound on hypotheses solved per call
+    int maxEmitters;                        ///< Upper bound on emitters reported per call
+
+    /**
+     * @brief Constructor with default values
+     */
+    AssociationConfig()
+        : closureSigma(3.0)
+        , maxNormalizedResidual(9.0)
+        , maxSharedPeaks(1)
+        , minSeparation(10.0)   // 10 m
+        , maxHypotheses(256)
+        , maxEmitters(4)
+    {}
+};
+
+/**
+ * @struct EmitterHypothesis
+ * @brief Accepted emitter position and the peaks it was built from
+ */
+struct EmitterHypothesis {
+    MultilaterationResult result;                   ///< Position solution
+    time_difference::TimeDifferenceSet measurements; ///< Time differences assigned to this emitter
+    double normalizedResidual;                      ///< Residual chi-square per degree of freedom
+    double score;                                   ///< Sum of peak confidences
+
+    /**
+     * @brief Constructor with default values
+     */
+    EmitterHypothesis()
+        : normalizedResidual(0.0)
+        , score(0.0)
+    {}
+};
+
+/**
+ * @struct AssociationStats
+ * @brief Counters from the last association call
+ */
+struct AssociationStats {
+    size_t prunedByBounds;      ///< Peaks outside the physical lag bound of their pair
+    size_t prunedByClosure;     ///< Partial hypotheses rejected by closure checks
+    size_t hypothesesSolved;    ///< Complete hypotheses passed to the solver
+    size_t rejectedByResidual;  ///< Solutions rejected by the residual gate
+    size_t emitters;            ///< Emitters reported
+
+    /**
+     * @brief Constructor with default values
+     */
+    AssociationStats()
+        : prunedByBounds(0)
+        , prunedByClosure(0)
+        , hypothesesSolved(0)
+        , rejectedByResidual(0)
+        , emitters(0)
+    {}
+};
+
+/**
+ * @class PeakAssociator
+ * @brief Resolves co-channel emitters from multi-peak pairwise correlations
+ *
+ * The receiver in the most pairs becomes the reference. Hypotheses pick one
+ * peak per reference pair, depth first; peaks beyond the pair's baseline are
+ * dropped up front, and every new assignment must agree with already-assigned
+ * receivers on their direct pair (closure: tau_ab = tau_ar - tau_br). Each
+ * complete hypothesis is solved, gated on its residual, and accepted greedily
+ * in order of residual while it does not reuse too many accepted peaks.
+ */
+class PeakAssociator {
+public:
+    /**
+     * @brief Constructor
+     * @param config Configuration for association
+     */
+    PeakAssociator(const AssociationConfig& config = AssociationConfig());
+
+    /**
+     * @brief Destructor
+     */
+    ~PeakAssociator();
+
+    /**
+     * @brief Associate peaks into emitter positions for one frequency channel
+     * @param pairs Candidate time differences per receiver pair
+     * @param sources Map of source IDs to signal sources
+     * @param timestamp Timestamp assigned to the output sets
+     * @return Emitters, best first
+     */
+    std::vector<EmitterHypothesis> associate(
+        const std::vector<PairCandidates>& pairs,
+        const std::map<std::string, time_difference::SignalSource>& sources,
+        uint64_t timestamp = 0);
+
+    /**
+     * @brief Get counters from the last association call
+     * @return Association statistics
+     */
+    AssociationStats getStats() const;
+
+    /**
+     * @brief Get configuration
+     * @return Current configuration
+     */
+    AssociationConfig getConfig() const;
+
+    /**
+     * @brief Set configuration
+     * @param config New configuration
+     */
+    void setConfig(const AssociationConfig& config);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace multilateration
+} // namespace tdoa
@@ -0,0 +1,198 @@
+/**
+ * @file test_coverage_map.cpp
+ * @brief Test program for the tiled coverage map and its geometry cache
+ */
+
+#include "../multilateration/coverage_map.h"
+#include "../multilateration/multilateration_solver.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <cmath>
+
+using namespace tdoa::time_difference;
+using namespace tdoa::multilateration;
+
+namespace {
+
+// Build receivers from a list of (x, y) coordinates
+std::map<std::string, SignalSource> makeReceivers(const std::vector<std::pair<double, double>>& coords) {
+    std::map<std::string, SignalSource> receivers;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        SignalSource source("r" + std::to_string(i), coords[i].first, coords[i].second);
+        receivers[source.id] = source;
+    }
+    return receivers;
+}
+
+// Worst relative HDOP difference between two maps over a set of probe points
+double worstHdopDifference(const CoverageMap& a, const CoverageMap& b,
+                           const std::vector<std::pair<double, double>>& probes) {
+    double worst = 0.0;
+    for (const auto& probe : probes) {
+        CoverageSample sa = a.getSample(probe.first, probe.second);
+        CoverageSample sb = b.getSample(probe.first, probe.second);
+        if (sa.valid != sb.valid) {
+            return INFINITY;
+        }
+        if (sa.valid) {
+            worst = std::max(worst, std::abs(sa.hdop - sb.hdop) / sb.hdop);
+        }
+    }
+    return worst;
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(4);
+
+    CoverageMapConfig config;
+    config.resolution = 20.0;
+    config.tileSize = 16;
+    config.numThreads = 2;
+
+    auto square = makeReceivers({{-800.0, -800.0}, {800.0, -800.0}, {800.0, 800.0}, {-800.0, 800.0}});
+    auto line = makeReceivers({{-900.0, 0.0}, {-300.0, 100.0}, {300.0, -100.0}, {900.0, 0.0}});
+
+    std::vector<std::pair<double, double>> probes;
+    for (double y = -990.0; y < 1000.0; y += 110.0) {
+        for (double x = -990.0; x < 1000.0; x += 110.0) {
+            probes.emplace_back(x, y);
+        }
+    }
+
+    // Cell values must match the solver's GDOP model at the cell center
+    std::cout << "Map vs. MultilaterationSolver::calculateGDOP:" << std::endl;
+    std::cout << "---------------------------------------------" << std::endl;
+    CoverageMap map(config);
+    if (!map.setReceivers(square)) {
+        std::cout << "setReceivers failed" << std::endl;
+        passed = false;
+    }
+    double worstModel = 0.0;
+    for (const auto& probe : probes) {
+        Position2D center;
+        center.x = config.minX + (std::floor((probe.first - config.minX) / config.resolution) + 0.5) * config.resolution;
+        center.y = config.minY + (std::floor((probe.second - config.minY) / config.resolution) + 0.5) * config.resolution;
+        GDOPInfo expected = MultilaterationSolver::calculateGDOP(square, center);
+        CoverageSample sample = map.getSample(probe.first, probe.second);
+        if (!sample.valid) {
+            passed = false;
+            continue;
+        }
+        worstModel = std::max(worstModel, std::abs(sample.hdop - expected.hdop) / expected.hdop);
+    }
+    std::cout << "Worst relative HDOP difference: " << worstModel << std::endl;
+    // Tiles store floats
+    if (worstModel > 1e-4) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // Switching back to a known geometry is served from the cache unchanged
+    std::cout << "Geometry cache:" << std::endl;
+    std::cout << "---------------" << std::endl;
+    CoverageTile before = map.getTile(1, 1);
+    map.takeDirtyTiles();
+    map.setReceivers(line);
+    map.setReceivers(square);
+    CoverageMapStats stats = map.getStats();
+    CoverageTile after = map.getTile(1, 1);
+    std::cout << "Hits: " << stats.cacheHits << ", misses: " << stats.cacheMisses << std::endl;
+    auto tiles = map.getTileCount();
+    if (stats.cacheHits != 1 || stats.cacheMisses != 2 || after.revision != before.revision ||
+        after.hdop != before.hdop) {
+        passed = false;
+    }
+    // A geometry change redraws every tile
+    if (map.takeDirtyTiles().size() != static_cast<size_t>(tiles.first * tiles.second)) {
+        passed = false;
+    }
+    // Setting the same geometry again is free
+    map.setReceivers(square);
+    if (map.getStats().cacheHits != 1 || !map.takeDirtyTiles().empty()) {
+        passed = false;
+    }
+
+    // The cache is bounded by maxCachedGeometries
+    CoverageMapConfig small = config;
+    small.maxCachedGeometries = 1;
+    CoverageMap bounded(small);
+    bounded.setReceivers(square);
+    bounded.setReceivers(line);
+    bounded.setReceivers(square);
+    std::cout << "Bounded cache misses: " << bounded.getStats().cacheMisses << std::endl;
+    if (bounded.getStats().cacheHits != 0 || bounded.getStats().cacheMisses != 3) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // Moving a receiver only recomputes tiles whose bearing to it changed, and
+    // the result matches a map built from scratch
+    std::cout << "Incremental receiver update:" << std::endl;
+    std::cout << "----------------------------" << std::endl;
+    map.takeDirtyTiles();
+    SignalSource moved = square["r0"];
+    moved.position.x -= 50.0;
+    moved.position.y += 30.0;
+    if (!map.updateReceiver("r0", moved)) {
+        passed = false;
+    }
+    stats = map.getStats();
+    std::cout << "Tiles recomputed: " << stats.tilesRecomputed << ", skipped: " << stats.tilesSkipped << std::endl;
+    if (stats.tilesRecomputed == 0 || stats.tilesRecomputed != map.takeDirtyTiles().size()) {
+        passed = false;
+    }
+
+    auto movedSquare = square;
+    movedSquare["r0"] = moved;
+    CoverageMap fresh(config);
+    fresh.setReceivers(movedSquare);
+    double worstUpdate = worstHdopDifference(map, fresh, probes);
+    std::cout << "Worst relative HDOP difference to a fresh map: " << worstUpdate << std::endl;
+    if (worstUpdate > 1e-3) {
+        passed = false;
+    }
+
+    // A small move leaves tiles far from the receiver untouched
+    map.takeDirtyTiles();
+    moved.position.x += 0.3;
+    map.updateReceiver("r0", moved);
+    CoverageMapStats nudged = map.getStats();
+    const uint64_t skipped = nudged.tilesSkipped - stats.tilesSkipped;
+    const uint64_t recomputed = nudged.tilesRecomputed - stats.tilesRecomputed;
+    std::cout << "After a 0.3 m move, recomputed: " << recomputed << ", skipped: " << skipped << std::endl;
+    if (skipped == 0 || recomputed == 0 || recomputed != map.takeDirtyTiles().size()) {
+        passed = false;
+    }
+    movedSquare["r0"] = moved;
+    fresh.setReceivers(movedSquare);
+    worstUpdate = worstHdopDifference(map, fresh, probes);
+    std::cout << "Worst relative HDOP difference to a fresh map: " << worstUpdate << std::endl;
+    // Skipped tiles keep a contribution within bearingTolerance of the new one
+    if (worstUpdate > 1e-2) {
+        passed = false;
+    }
+
+    // The updates worked on a copy, so the cached square geometry is still intact
+    map.setReceivers(line);
+    map.setReceivers(square);
+    CoverageMap original(config);
+    original.setReceivers(square);
+    if (worstHdopDifference(map, original, probes) > 1e-6) {
+        std::cout << "Cached geometry was modified by the update" << std::endl;
+        passed = false;
+    }
+
+    // Unknown receivers are rejected
+    if (map.updateReceiver("r9", moved)) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -116,7 +116,7 @@ int main() {
     
     for (const auto& peak : result.peaks) {
         // Convert delay to correct reference frame
-        const double adjustedDelay = peak.delay - (signal1.size() + signal2.size() - 1) / 2.0;
+        const double adjustedDelay = peak.delay - result.zeroLag;
         
         std::cout << std::fixed << std::setprecision(2);
         std::cout << std::setw(10) << adjustedDelay
@@ -136,7 +136,7 @@ int main() {
             [](const auto& a, const auto& b) { return a.confidence < b.confidence; });
         
         // Convert to the correct reference frame
-        estimatedDelay = bestPeak.delay - (signal1.size() + signal2.size() - 1) / 2.0;
+        estimatedDelay = bestPeak.delay - result.zeroLag;
     }
     
     const double error = estimatedDelay - trueDelay;
@@ -177,7 +177,7 @@ int main() {
                 result.peaks.begin(), result.peaks.end(),
                 [](const auto& a, const auto& b) { return a.confidence < b.confidence; });
             
-            methodEstimatedDelay = bestPeak.delay - (signal1.size() + signal2.size() - 1) / 2.0;
+            methodEstimatedDelay = bestPeak.delay - result.zeroLag;
         }
         
         const double methodError = methodEstimatedDelay - trueDelay;
@@ -224,7 +224,7 @@ int main() {
                 result.peaks.begin(), result.peaks.end(),
                 [](const auto& a, const auto& b) { return a.confidence < b.confidence; });
             
-            snrEstimatedDelay = bestPeak.delay - (signal1.size() + signal2.size() - 1) / 2.0;
+            snrEstimatedDelay = bestPeak.delay - result.zeroLag;
             peakConfidence = bestPeak.confidence;
         }
         
@@ -284,7 +284,7 @@ int main() {
                 segResult.peaks.begin(), segResult.peaks.end(),
                 [](const auto& a, const auto& b) { return a.confidence < b.confidence; });
             
-            segEstimatedDelay = bestPeak.delay - (segmentSignal1.size() + segmentSignal2.size() - 1) / 2.0;
+            segEstimatedDelay = bestPeak.delay - segResult.zeroLag;
         }
         
         std::cout << "Segment " << segment << ": "
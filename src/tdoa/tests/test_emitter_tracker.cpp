@@ -0,0 +1,159 @@
+/**
+ * @file test_emitter_tracker.cpp
+ * @brief Test program for the EKF emitter tracker and its innovation gate
+ */
+
+#include "../multilateration/emitter_tracker.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <random>
+#include <cmath>
+
+using namespace tdoa::time_difference;
+using namespace tdoa::multilateration;
+
+namespace {
+
+const double kSpeedOfLight = 299792458.0;
+const uint64_t kSecond = 1000000000ULL;
+
+// Build receivers from a list of (x, y) coordinates
+std::map<std::string, SignalSource> makeReceivers(const std::vector<std::pair<double, double>>& coords) {
+    std::map<std::string, SignalSource> receivers;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        SignalSource source("r" + std::to_string(i), coords[i].first, coords[i].second);
+        receivers[source.id] = source;
+    }
+    return receivers;
+}
+
+// Simulate TDOA measurements against the first receiver
+TimeDifferenceSet simulateTdoa(
+    const std::map<std::string, SignalSource>& receivers,
+    double txX, double txY, double noiseSeconds, uint64_t timestamp, std::mt19937& gen) {
+
+    std::normal_distribution<double> noise(0.0, noiseSeconds);
+    TimeDifferenceSet result;
+    result.timestamp = timestamp;
+
+    const auto& ref = receivers.begin()->second;
+    result.referenceId = ref.id;
+    const double refRange = std::hypot(txX - ref.position.x, txY - ref.position.y);
+
+    for (const auto& entry : receivers) {
+        if (entry.first == ref.id) {
+            continue;
+        }
+        const double range = std::hypot(txX - entry.second.position.x, txY - entry.second.position.y);
+        result.timeDifferences.emplace_back(entry.first, ref.id,
+                                            (range - refRange) / kSpeedOfLight + noise(gen),
+                                            noiseSeconds, 0.95, timestamp);
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(11);
+    const double noise = 3.0e-9;
+    bool passed = true;
+
+    auto receivers = makeReceivers({{-500.0, -500.0}, {500.0, -500.0}, {500.0, 500.0}, {-500.0, 500.0}});
+
+    TrackerConfig config;
+    config.solverConfig.method = SolverMethod::TaylorSeries;
+    config.solverConfig.regionMinX = -1000.0;
+    config.solverConfig.regionMaxX = 1000.0;
+    config.solverConfig.regionMinY = -1000.0;
+    config.solverConfig.regionMaxY = 1000.0;
+    config.solverConfig.timingUncertainty = noise;
+    EmitterTracker tracker(config);
+
+    // A constant-velocity emitter is tracked by the filter alone after initiation
+    std::cout << "Constant-velocity track:" << std::endl;
+    std::cout << "------------------------" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    double x = -200.0, y = -100.0;
+    const double vx = 10.0, vy = 5.0;
+    uint64_t timestamp = 100 * kSecond;
+    MultilaterationResult fix;
+    for (int step = 0; step < 30; ++step) {
+        fix = tracker.update("tx", simulateTdoa(receivers, x, y, noise, timestamp, gen), receivers);
+        if (!fix.valid) {
+            passed = false;
+        }
+        x += vx;
+        y += vy;
+        timestamp += kSecond;
+    }
+    TrackState state;
+    TrackerStats stats = tracker.getStats();
+    const double trackError = std::hypot(fix.position.x - (x - vx), fix.position.y - (y - vy));
+    tracker.getTrack("tx", state);
+    std::cout << "Initiated: " << stats.tracksInitiated << ", filter updates: " << stats.filterUpdates
+              << ", full solves: " << stats.fullSolves << ", gate failures: " << stats.gateFailures << std::endl;
+    std::cout << "Position error (m): " << trackError << ", velocity: " << state.vx << ", " << state.vy << std::endl;
+    if (stats.tracksInitiated != 1 || stats.fullSolves != 1 || stats.filterUpdates != 29 || stats.gateFailures != 0 ||
+        trackError > 3.0 || std::abs(state.vx - vx) > 1.0 || std::abs(state.vy - vy) > 1.0) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // A jump far outside the gate is served by a full solve and does not move
+    // the track until maxGateFailures consecutive misses re-initiate it
+    std::cout << "Innovation gate:" << std::endl;
+    std::cout << "----------------" << std::endl;
+    const double jumpX = 300.0, jumpY = 350.0;
+    for (int miss = 1; miss <= config.maxGateFailures; ++miss) {
+        fix = tracker.update("tx", simulateTdoa(receivers, jumpX, jumpY, noise, timestamp, gen), receivers);
+        timestamp += kSecond;
+        tracker.getTrack("tx", state);
+        stats = tracker.getStats();
+        std::cout << "Miss " << miss << ": " << fix.diagnosticMessage << ", fix error "
+                  << std::hypot(fix.position.x - jumpX, fix.position.y - jumpY)
+                  << " m, track at " << state.x << ", " << state.y << std::endl;
+        if (!fix.valid || stats.gateFailures != static_cast<uint64_t>(miss) ||
+            std::hypot(fix.position.x - jumpX, fix.position.y - jumpY) > 5.0) {
+            passed = false;
+        }
+        const bool reinitiated = miss == config.maxGateFailures;
+        if (reinitiated != (std::hypot(state.x - jumpX, state.y - jumpY) < 5.0) ||
+            stats.tracksInitiated != (reinitiated ? 2u : 1u)) {
+            passed = false;
+        }
+    }
+
+    // After re-initiation the filter takes over again
+    fix = tracker.update("tx", simulateTdoa(receivers, jumpX, jumpY, noise, timestamp, gen), receivers);
+    timestamp += kSecond;
+    if (tracker.getStats().filterUpdates != 30 || fix.diagnosticMessage != "Track update") {
+        passed = false;
+    }
+
+    // A single outlier is rejected and the next good set resets the miss count
+    fix = tracker.update("tx", simulateTdoa(receivers, -jumpX, -jumpY, noise, timestamp, gen), receivers);
+    timestamp += kSecond;
+    fix = tracker.update("tx", simulateTdoa(receivers, jumpX, jumpY, noise, timestamp, gen), receivers);
+    timestamp += kSecond;
+    tracker.getTrack("tx", state);
+    std::cout << "After one outlier, gate failures on track: " << state.gateFailures << std::endl;
+    if (state.gateFailures != 0 || std::hypot(state.x - jumpX, state.y - jumpY) > 5.0) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // Tracks time out when other emitters keep updating
+    tracker.update("other", simulateTdoa(receivers, 0.0, 0.0, noise, timestamp + 60 * kSecond, gen), receivers);
+    std::vector<std::string> ids = tracker.getTrackIds();
+    std::cout << "Tracks after timeout: " << ids.size() << std::endl;
+    if (ids.size() != 1 || ids[0] != "other") {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
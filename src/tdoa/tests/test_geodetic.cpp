@@ -0,0 +1,142 @@
+/**
+ * @file test_geodetic.cpp
+ * @brief Test program for the WGS-84 / ECEF / ENU conversions and frame registry
+ */
+
+#include "../utils/geodetic.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <random>
+#include <cmath>
+
+using namespace tdoa::utils;
+
+namespace {
+
+// Smallest difference between two longitudes in degrees
+double longitudeDelta(double a, double b) {
+    double delta = std::fmod(std::abs(a - b), 360.0);
+    return delta > 180.0 ? 360.0 - delta : delta;
+}
+
+} // namespace
+
+int main() {
+    bool passed = true;
+    std::cout << std::fixed << std::setprecision(9);
+
+    // Geodetic -> ECEF -> geodetic round trips, poles and antimeridian included
+    std::cout << "Geodetic round trips:" << std::endl;
+    std::cout << "---------------------" << std::endl;
+    std::vector<GeodeticPosition> points = {
+        {0.0, 0.0, 0.0}, {51.4779, -0.0015, 45.0}, {-33.8568, 151.2153, 5.0},
+        {89.9999, 10.0, 100.0}, {-89.9999, -120.0, 2000.0}, {0.0, 179.9999, 0.0},
+        {0.0, -179.9999, 0.0}, {27.9881, 86.9250, 8848.0}, {90.0, 0.0, 0.0}
+    };
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> latDist(-90.0, 90.0);
+    std::uniform_real_distribution<double> lonDist(-180.0, 180.0);
+    std::uniform_real_distribution<double> altDist(-500.0, 20000.0);
+    for (int i = 0; i < 1000; ++i) {
+        points.emplace_back(latDist(gen), lonDist(gen), altDist(gen));
+    }
+
+    double worstAngle = 0.0;
+    double worstAltitude = 0.0;
+    for (const auto& point : points) {
+        GeodeticPosition back = ecefToGeodetic(geodeticToEcef(point));
+        double angle = std::abs(back.latitude - point.latitude);
+        // Longitude is undefined at the poles
+        if (std::abs(point.latitude) < 90.0) {
+            angle = std::max(angle, longitudeDelta(back.longitude, point.longitude));
+        }
+        worstAngle = std::max(worstAngle, angle);
+        worstAltitude = std::max(worstAltitude, std::abs(back.altitude - point.altitude));
+    }
+    std::cout << "Worst angle error (deg): " << worstAngle << std::endl;
+    std::cout << "Worst altitude error (m): " << worstAltitude << std::endl;
+    // 1e-8 degrees is about a millimeter on the ground
+    if (worstAngle > 1e-8 || worstAltitude > 1e-3) {
+        passed = false;
+    }
+
+    // The batched conversions must agree with the scalar ones
+    const size_t count = points.size();
+    std::vector<double> lat(count), lon(count), alt(count), x(count), y(count), z(count);
+    for (size_t i = 0; i < count; ++i) {
+        lat[i] = points[i].latitude;
+        lon[i] = points[i].longitude;
+        alt[i] = points[i].altitude;
+    }
+    geodeticToEcef(lat.data(), lon.data(), alt.data(), x.data(), y.data(), z.data(), count);
+    double worstBatch = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        EcefPosition single = geodeticToEcef(points[i]);
+        worstBatch = std::max(worstBatch, std::abs(single.x - x[i]) + std::abs(single.y - y[i]) + std::abs(single.z - z[i]));
+    }
+    std::cout << "Worst batch/scalar ECEF difference (m): " << worstBatch << std::endl;
+    if (worstBatch > 1e-6) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // ENU round trips in a local frame
+    std::cout << "Local frame round trips:" << std::endl;
+    std::cout << "------------------------" << std::endl;
+    LocalFrame frame(GeodeticPosition(47.3769, 8.5417, 408.0));
+    std::uniform_real_distribution<double> offsetDist(-50000.0, 50000.0);
+    double worstEnu = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        EnuPosition enu(offsetDist(gen), offsetDist(gen), offsetDist(gen) * 0.01);
+        EnuPosition back = frame.geodeticToEnu(frame.enuToGeodetic(enu));
+        worstEnu = std::max(worstEnu, std::abs(back.east - enu.east) + std::abs(back.north - enu.north) + std::abs(back.up - enu.up));
+    }
+    EnuPosition atOrigin = frame.geodeticToEnu(frame.getOrigin());
+    std::cout << "Worst ENU round-trip error (m): " << worstEnu << std::endl;
+    std::cout << "Origin in its own frame (m): " << atOrigin.east << ", " << atOrigin.north << ", " << atOrigin.up << std::endl;
+    if (worstEnu > 1e-3 || std::abs(atOrigin.east) + std::abs(atOrigin.north) + std::abs(atOrigin.up) > 1e-6) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // A deployment across the antimeridian must be anchored between its receivers,
+    // not on the far side of the planet
+    std::cout << "Frame registry centroid:" << std::endl;
+    std::cout << "------------------------" << std::endl;
+    FrameRegistry registry;
+    std::map<std::string, GeodeticPosition> receivers = {
+        {"r0", GeodeticPosition(-17.70, 179.99, 10.0)},
+        {"r1", GeodeticPosition(-17.80, -179.99, 20.0)},
+        {"r2", GeodeticPosition(-17.75, 179.98, 30.0)},
+        {"r3", GeodeticPosition(-17.75, -179.98, 40.0)}
+    };
+    auto deploymentFrame = registry.setReceivers("fiji", receivers);
+    const GeodeticPosition& origin = deploymentFrame->getOrigin();
+    std::cout << "Origin: " << origin.latitude << ", " << origin.longitude << ", " << origin.altitude << std::endl;
+    if (std::abs(origin.latitude + 17.75) > 1e-3 || longitudeDelta(origin.longitude, 180.0) > 1e-3 ||
+        std::abs(origin.altitude - 25.0) > 1e-9) {
+        passed = false;
+    }
+
+    double worstReceiver = 0.0;
+    for (const auto& entry : registry.getLocalReceivers("fiji")) {
+        worstReceiver = std::max(worstReceiver, std::hypot(entry.second.east, entry.second.north));
+    }
+    std::cout << "Farthest receiver from origin (m): " << worstReceiver << std::endl;
+    if (worstReceiver > 10000.0) {
+        passed = false;
+    }
+
+    // The frame stays fixed when receivers move
+    receivers["r0"].latitude += 0.01;
+    if (registry.setReceivers("fiji", receivers) != deploymentFrame || !registry.removeDeployment("fiji") ||
+        registry.getFrame("fiji")) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file test_multilateration_solver.cpp
+ * @brief Test program for the multilateration solvers
+ */
+
+#include "../multilateration/multilateration_solver.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+using namespace tdoa::time_difference;
+using namespace tdoa::multilateration;
+
+namespace {
+
+const double kSpeedOfLight = 299792458.0;
+
+// Build receivers from a list of (x, y) coordinates
+std::map<std::string, SignalSource> makeReceivers(const std::vector<std::pair<double, double>>& coords) {
+    std::map<std::string, SignalSource> receivers;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        SignalSource source;
+        source.id = "r" + std::to_string(i);
+        source.position.x = coords[i].first;
+        source.position.y = coords[i].second;
+        source.position.z = 0.0;
+        receivers[source.id] = source;
+    }
+    return receivers;
+}
+
+// Simulate TDOA measurements against the first receiver
+TimeDifferenceSet simulateTdoa(
+    const std::map<std::string, SignalSource>& receivers,
+    double txX, double txY, double noiseSeconds, std::mt19937& gen) {
+
+    std::normal_distribution<double> noise(0.0, noiseSeconds);
+    TimeDifferenceSet result;
+
+    const auto& ref = receivers.begin()->second;
+    const double refRange = std::hypot(txX - ref.position.x, txY - ref.position.y);
+
+    for (const auto& entry : receivers) {
+        if (entry.first == ref.id) {
+            continue;
+        }
+        const double range = std::hypot(txX - entry.second.position.x, txY - entry.second.position.y);
+
+        TimeDifference td;
+        td.sourceId = entry.first;
+        td.referenceId = ref.id;
+        td.timeDifference = (range - refRange) / kSpeedOfLight + noise(gen);
+        td.uncertainty = noiseSeconds;
+        td.confidence = 0.95;
+        result.timeDifferences.push_back(td);
+    }
+
+    return result;
+}
+
+// Simulate TDOA measurements with per-receiver noise and confidence
+TimeDifferenceSet simulateMixedTdoa(
+    const std::map<std::string, SignalSource>& receivers,
+    const std::map<std::string, std::pair<double, double>>& quality,
+    double txX, double txY, std::mt19937& gen) {
+
+    TimeDifferenceSet result = simulateTdoa(receivers, txX, txY, 0.0, gen);
+    for (auto& td : result.timeDifferences) {
+        const auto& q = quality.at(td.sourceId);
+        std::normal_distribution<double> noise(0.0, q.first);
+        td.timeDifference += noise(gen);
+        td.uncertainty = q.first;
+        td.confidence = q.second;
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(42);
+    const double noise = 3.0e-9;  // 3 ns, ~1 m range difference
+
+    // 1 km x 1 km region with receivers near the corners
+    auto receivers = makeReceivers({{-500.0, -500.0}, {500.0, -500.0}, {0.0, 500.0}, {-250.0, 250.0}});
+
+    MultilaterationConfig config;
+    config.regionMinX = -500.0;
+    config.regionMaxX = 500.0;
+    config.regionMinY = -500.0;
+    config.regionMaxY = 500.0;
+    config.gridFinalResolution = 1.0;
+
+    MultilaterationSolver solver(config);
+
+    std::cout << "Bayesian grid solver vs. Taylor series:" << std::endl;
+    std::cout << "--------------------------------------" << std::endl;
+    std::cout << std::setw(20) << "True (m)"
+              << std::setw(15) << "Bayes err (m)"
+              << std::setw(15) << "Taylor err (m)"
+              << std::setw(15) << "Ellipse (m)"
+              << std::setw(12) << "Time (ms)"
+              << std::endl;
+
+    bool passed = true;
+    const std::vector<std::pair<double, double>> emitters = {
+        {123.4, -87.6}, {-300.0, 350.0}, {450.0, 400.0}, {0.0, 0.0}
+    };
+
+    for (const auto& emitter : emitters) {
+        auto tdoa = simulateTdoa(receivers, emitter.first, emitter.second, noise, gen);
+
+        config.method = SolverMethod::Bayesian;
+        solver.setConfig(config);
+        auto start = std::chrono::high_resolution_clock::now();
+        auto bayes = solver.calculatePosition(tdoa, receivers);
+        auto end = std::chrono::high_resolution_clock::now();
+        double elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+        config.method = SolverMethod::TaylorSeries;
+        solver.setConfig(config);
+        auto taylor = solver.calculatePosition(tdoa, receivers);
+
+        double bayesError = std::hypot(bayes.position.x - emitter.first, bayes.position.y - emitter.second);
+        double taylorError = std::hypot(taylor.position.x - emitter.first, taylor.position.y - emitter.second);
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << std::setw(9) << emitter.first << "," << std::setw(10) << emitter.second
+                  << std::setw(15) << bayesError
+                  << std::setw(15) << taylorError
+                  << std::setw(15) << bayes.confidence.semiMajorAxis
+                  << std::setw(12) << elapsedMs
+                  << std::endl;
+
+        // The MAP estimate should land within a few meters at 1 m resolution
+        if (!bayes.valid || bayesError > 10.0) {
+            passed = false;
+        }
+    }
+    std::cout << std::endl;
+
+    // 16 sites on a grid, a quarter of them low-confidence and noisy
+    std::cout << "Receiver selection, 16 sites:" << std::endl;
+    std::cout << "-----------------------------" << std::endl;
+    std::vector<std::pair<double, double>> grid;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 4; ++col) {
+            grid.emplace_back(-450.0 + 300.0 * col, -450.0 + 300.0 * row);
+        }
+    }
+    auto sites = makeReceivers(grid);
+    std::map<std::string, std::pair<double, double>> quality;
+    int index = 0;
+    for (const auto& entry : sites) {
+        quality[entry.first] = (index++ % 4 == 3) ? std::make_pair(30.0e-9, 0.3) : std::make_pair(3.0e-9, 0.95);
+    }
+
+    config.method = SolverMethod::TaylorSeries;
+    config.maxReceivers = 0;
+    MultilaterationSolver allSolver(config);
+    config.maxReceivers = 6;
+    MultilaterationSolver selectSolver(config);
+
+    std::uniform_real_distribution<double> place(-400.0, 400.0);
+    double allSq = 0.0, selectSq = 0.0;
+    const int trials = 200;
+    for (int trial = 0; trial < trials; ++trial) {
+        const double tx = place(gen);
+        const double ty = place(gen);
+        auto tdoa = simulateMixedTdoa(sites, quality, tx, ty, gen);
+        auto all = allSolver.calculatePosition(tdoa, sites);
+        auto selected = selectSolver.calculatePosition(tdoa, sites);
+        allSq += std::pow(all.position.x - tx, 2) + std::pow(all.position.y - ty, 2);
+        selectSq += std::pow(selected.position.x - tx, 2) + std::pow(selected.position.y - ty, 2);
+    }
+    const double allRms = std::sqrt(allSq / trials);
+    const double selectRms = std::sqrt(selectSq / trials);
+    std::cout << "RMS error, all 16 receivers (m): " << allRms << std::endl;
+    std::cout << "RMS error, 6 selected (m):       " << selectRms << std::endl;
+    if (selectRms >= allRms) {
+        passed = false;
+    }
+
+    // Selection must not depend on earlier calls: alternating emitters give
+    // the same fix as a fresh solver
+    const double ax = 310.0, ay = -220.0, bx = -280.0, by = 260.0;
+    auto tdoaA = simulateMixedTdoa(sites, quality, ax, ay, gen);
+    auto tdoaB = simulateMixedTdoa(sites, quality, bx, by, gen);
+    MultilaterationSolver freshSolver(config);
+    auto freshB = freshSolver.calculatePosition(tdoaB, sites);
+    selectSolver.calculatePosition(tdoaA, sites);
+    auto afterA = selectSolver.calculatePosition(tdoaB, sites);
+    std::cout << "Fix for B after A vs. fresh (m): "
+              << std::hypot(afterA.position.x - freshB.position.x, afterA.position.y - freshB.position.y) << std::endl;
+    if (afterA.position.x != freshB.position.x || afterA.position.y != freshB.position.y) {
+        passed = false;
+    }
+
+    // The selected set keeps the reference and favours the good receivers
+    Position2D hintB;
+    hintB.x = bx;
+    hintB.y = by;
+    auto chosen = selectSolver.selectReceivers(tdoaB, sites, hintB, 6);
+    int noisyChosen = 0;
+    for (const auto& id : chosen) {
+        if (quality[id].second < 0.5) {
+            noisyChosen++;
+        }
+    }
+    std::cout << "Selected: " << chosen.size() << " receivers, " << noisyChosen << " noisy" << std::endl;
+    if (chosen.size() != 6 || chosen.front() != tdoaB.timeDifferences.front().referenceId || noisyChosen > 1) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_peak_association.cpp
+ * @brief Test program for multi-hypothesis peak association of co-channel emitters
+ */
+
+#include "../multilateration/peak_association.h"
+#include "../correlation/cross_correlation.h"
+#include "../time_difference/time_difference_extractor.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cmath>
+
+using namespace tdoa::time_difference;
+using namespace tdoa::multilateration;
+
+namespace {
+
+const double kSpeedOfLight = 299792458.0;
+
+// Build receivers from a list of (x, y) coordinates
+std::map<std::string, SignalSource> makeReceivers(const std::vector<std::pair<double, double>>& coords) {
+    std::map<std::string, SignalSource> receivers;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        SignalSource source("r" + std::to_string(i), coords[i].first, coords[i].second);
+        receivers[source.id] = source;
+    }
+    return receivers;
+}
+
+// Time difference t(source) - t(reference) for an emitter
+double trueDifference(const SignalSource& source, const SignalSource& reference, double txX, double txY) {
+    const double range = std::hypot(txX - source.position.x, txY - source.position.y);
+    const double refRange = std::hypot(txX - reference.position.x, txY - reference.position.y);
+    return (range - refRange) / kSpeedOfLight;
+}
+
+// Every receiver pair with one peak per emitter plus one spurious peak
+std::vector<PairCandidates> simulatePairs(
+    const std::map<std::string, SignalSource>& receivers,
+    const std::vector<std::pair<double, double>>& emitters,
+    double noiseSeconds, std::mt19937& gen) {
+
+    std::normal_distribution<double> noise(0.0, noiseSeconds);
+    std::uniform_real_distribution<double> spurious(-4.0e-6, 4.0e-6);
+    std::vector<PairCandidates> pairs;
+
+    for (auto a = receivers.begin(); a != receivers.end(); ++a) {
+        for (auto b = std::next(a); b != receivers.end(); ++b) {
+            PairCandidates pair;
+            pair.sourceId = b->first;
+            pair.referenceId = a->first;
+            for (const auto& emitter : emitters) {
+                pair.candidates.emplace_back(b->first, a->first,
+                                             trueDifference(b->second, a->second, emitter.first, emitter.second) + noise(gen),
+                                             noiseSeconds, 0.9);
+            }
+            pair.candidates.emplace_back(b->first, a->first, spurious(gen), noiseSeconds, 0.5);
+            pairs.push_back(pair);
+        }
+    }
+    return pairs;
+}
+
+// Distance from a position to the closest emitter
+double closestEmitter(const Position2D& position, const std::vector<std::pair<double, double>>& emitters) {
+    double best = INFINITY;
+    for (const auto& emitter : emitters) {
+        best = std::min(best, std::hypot(position.x - emitter.first, position.y - emitter.second));
+    }
+    return best;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 gen(5);
+    const double noise = 2.0e-9;
+    bool passed = true;
+
+    auto receivers = makeReceivers({{-600.0, -500.0}, {550.0, -450.0}, {500.0, 600.0}, {-450.0, 550.0}, {50.0, 0.0}});
+    const std::vector<std::pair<double, double>> emitters = {{-210.0, 140.0}, {320.0, -260.0}};
+
+    AssociationConfig config;
+    config.solverConfig.method = SolverMethod::TaylorSeries;
+    config.solverConfig.timingUncertainty = noise;
+    PeakAssociator associator(config);
+
+    // 5 receivers x 3 peaks on all 10 pairs: closure leaves the true combinations
+    std::cout << "Two co-channel emitters, 5 receivers, 3 peaks per pair:" << std::endl;
+    std::cout << "--------------------------------------------------------" << std::endl;
+    auto pairs = simulatePairs(receivers, emitters, noise, gen);
+    auto start = std::chrono::high_resolution_clock::now();
+    auto found = associator.associate(pairs, receivers, 42);
+    auto end = std::chrono::high_resolution_clock::now();
+    AssociationStats stats = associator.getStats();
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Pruned by bounds: " << stats.prunedByBounds
+              << ", by closure: " << stats.prunedByClosure
+              << ", solved: " << stats.hypothesesSolved
+              << ", rejected by residual: " << stats.rejectedByResidual << std::endl;
+    std::cout << "Time (ms): " << std::chrono::duration<double, std::milli>(end - start).count() << std::endl;
+    for (const auto& emitter : found) {
+        std::cout << "Emitter at " << emitter.result.position.x << ", " << emitter.result.position.y
+                  << " (error " << closestEmitter(emitter.result.position, emitters) << " m, "
+                  << emitter.measurements.timeDifferences.size() << " differences)" << std::endl;
+        if (closestEmitter(emitter.result.position, emitters) > 5.0 || emitter.measurements.timestamp != 42) {
+            passed = false;
+        }
+    }
+    if (found.size() != emitters.size() || stats.emitters != emitters.size() ||
+        stats.prunedByClosure == 0 || stats.hypothesesSolved > 4 ||
+        std::hypot(found[0].result.position.x - found[1].result.position.x,
+                   found[0].result.position.y - found[1].result.position.y) < config.minSeparation) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    // Only the reference pairs: no closure, so only the residual gate separates hypotheses
+    std::cout << "Reference pairs only:" << std::endl;
+    std::cout << "---------------------" << std::endl;
+    std::vector<PairCandidates> referenceOnly;
+    for (const auto& pair : pairs) {
+        if (pair.referenceId == "r0") {
+            referenceOnly.push_back(pair);
+        }
+    }
+    auto foundReference = associator.associate(referenceOnly, receivers);
+    stats = associator.getStats();
+    std::cout << "Solved: " << stats.hypothesesSolved << ", emitters: " << foundReference.size() << std::endl;
+    if (stats.prunedByClosure != 0 || stats.hypothesesSolved <= 4 || foundReference.empty()) {
+        passed = false;
+    }
+    for (const auto& emitter : foundReference) {
+        if (closestEmitter(emitter.result.position, emitters) > 5.0) {
+            passed = false;
+        }
+    }
+    std::cout << std::endl;
+
+    // Concurrent calls on one associator give the same answer as a serial call
+    std::cout << "Concurrent association:" << std::endl;
+    std::cout << "-----------------------" << std::endl;
+    std::vector<std::vector<EmitterHypothesis>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 20; ++i) {
+                results[t] = associator.associate(pairs, receivers, 42);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    bool consistent = true;
+    for (const auto& result : results) {
+        if (result.size() != found.size()) {
+            consistent = false;
+            continue;
+        }
+        for (size_t i = 0; i < result.size(); ++i) {
+            if (result[i].result.position.x != found[i].result.position.x ||
+                result[i].result.position.y != found[i].result.position.y) {
+                consistent = false;
+            }
+        }
+    }
+    std::cout << (consistent ? "Consistent" : "Inconsistent") << std::endl;
+    passed = passed && consistent;
+    std::cout << std::endl;
+
+    // Correlation peaks become time differences measured from the zero-lag index
+    std::cout << "Candidates from a correlation:" << std::endl;
+    std::cout << "------------------------------" << std::endl;
+    std::normal_distribution<double> sample(0.0, 1.0);
+    std::vector<double> base(2048);
+    for (auto& value : base) {
+        value = sample(gen);
+    }
+    const int knownShift = 7;
+    std::vector<double> referenceSignal(base.begin() + 600, base.begin() + 1624);
+    std::vector<double> delayedSignal(base.begin() + 600 - knownShift, base.begin() + 1624 - knownShift);
+    tdoa::correlation::CorrelationConfig correlationConfig;
+    correlationConfig.sampleRate = 1.0e6;
+    auto correlated = tdoa::correlation::crossCorrelate(referenceSignal, delayedSignal, correlationConfig);
+    PairCandidates fromPeaks = PairCandidates::fromCorrelation("r1", "r0", correlated, noise);
+    const double knownDifference = knownShift / correlationConfig.sampleRate;
+    bool shiftFound = false;
+    for (const auto& candidate : fromPeaks.candidates) {
+        std::cout << "Candidate: " << candidate.timeDifference * 1e6 << " us (truth "
+                  << knownDifference * 1e6 << " us)" << std::endl;
+        if (std::abs(candidate.timeDifference - knownDifference) < 0.5 / correlationConfig.sampleRate &&
+            candidate.sourceId == "r1" && candidate.referenceId == "r0") {
+            shiftFound = true;
+        }
+    }
+    passed = passed && shiftFound;
+    std::cout << std::endl;
+
+    // The extractor only associates when enablePeakAssociation is set. Each
+    // receiver sees the same waveform delayed by its range to the emitter,
+    // rounded to whole samples at 100 MHz.
+    std::cout << "TimeDifferenceExtractor integration:" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    TimeDifferenceConfig extractorConfig;
+    extractorConfig.correlationConfig.sampleRate = 100.0e6;
+    extractorConfig.correlationConfig.maxPeaks = 3;
+    TimeDifferenceExtractor extractor(extractorConfig);
+    for (const auto& entry : receivers) {
+        extractor.addSource(entry.second);
+    }
+    extractor.setAssociationConfig(config);
+    int callbacks = 0;
+    extractor.setTimeDifferenceCallback([&](const TimeDifferenceSet&) { callbacks++; });
+
+    const double sampleRate = extractorConfig.correlationConfig.sampleRate;
+    std::map<std::string, int> delays;
+    std::map<std::string, std::vector<double>> signals;
+    for (const auto& entry : receivers) {
+        const double range = std::hypot(emitters[0].first - entry.second.position.x,
+                                        emitters[0].second - entry.second.position.y);
+        delays[entry.first] = static_cast<int>(std::lround(range / kSpeedOfLight * sampleRate));
+        signals[entry.first] = std::vector<double>(base.begin() + 600 - delays[entry.first],
+                                                   base.begin() + 1624 - delays[entry.first]);
+    }
+
+    extractor.processSignals(signals, 1000);
+    const bool singlePeakEmpty = extractor.getAssociatedSets().empty();
+
+    extractorConfig.enablePeakAssociation = true;
+    extractor.setConfig(extractorConfig);
+    callbacks = 0;
+    TimeDifferenceSet best = extractor.processSignals(signals, 2000);
+    auto associated = extractor.getAssociatedSets();
+    std::cout << "Emitters: " << associated.size() << ", callbacks: " << callbacks << std::endl;
+    if (!singlePeakEmpty || associated.size() < 1 || callbacks != static_cast<int>(associated.size()) ||
+        best.timeDifferences.size() != associated.front().timeDifferences.size() ||
+        best.timestamp != 2000) {
+        passed = false;
+    }
+    double worstError = associated.empty() ? INFINITY : 0.0;
+    for (const auto& set : associated) {
+        for (const auto& td : set.timeDifferences) {
+            const double truth = (delays[td.sourceId] - delays[td.referenceId]) / sampleRate;
+            worstError = std::max(worstError, std::abs(td.timeDifference - truth));
+        }
+    }
+    std::cout << "Worst time difference error (ns): " << worstError * 1e9 << std::endl;
+    if (!(worstError < 1.0 / sampleRate)) {
+        passed = false;
+    }
+    std::cout << std::endl;
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -8,6 +8,7 @@
 #include <iomanip>
 #include <vector>
 #include <map>
+#include <memory>
 #include <random>
 #include <chrono>
 #include <thread>
@@ -148,7 +149,7 @@ int main() {
     
     // Register callback for time differences
     extractor.setTimeDifferenceCallback([](const TimeDifferenceSet& tdSet) {
-        std::cout << "Callback received " << tdSet.differences.size() 
+        std::cout << "Callback received " << tdSet.timeDifferences.size() 
                   << " time differences" << std::endl;
     });
     
@@ -163,7 +164,7 @@ int main() {
     
     // Print results
     std::cout << "Processing time: " << duration << " ms" << std::endl;
-    std::cout << "Number of time differences: " << result.differences.size() << std::endl;
+    std::cout << "Number of time differences: " << result.timeDifferences.size() << std::endl;
     std::cout << std::endl;
     
     // Print extracted time differences
@@ -176,9 +177,9 @@ int main() {
               << std::setw(15) << "Confidence"
               << std::endl;
     
-    for (const auto& diff : result.differences) {
-        const std::string& sourceId = diff.sourceId2;
-        const double measuredOffset = diff.timeDiff;
+    for (const auto& diff : result.timeDifferences) {
+        const std::string& sourceId = diff.sourceId;
+        const double measuredOffset = diff.timeDifference;
         const double trueOffset = trueOffsets[sourceId];
         const double error = measuredOffset - trueOffset;
         
@@ -217,9 +218,9 @@ int main() {
               << std::setw(15) << "Confidence"
               << std::endl;
     
-    for (const auto& diff : result.differences) {
-        const std::string& sourceId = diff.sourceId2;
-        const double measuredOffset = diff.timeDiff;
+    for (const auto& diff : result.timeDifferences) {
+        const std::string& sourceId = diff.sourceId;
+        const double measuredOffset = diff.timeDifference;
         const double trueOffset = trueOffsets[sourceId];
         const double error = measuredOffset - trueOffset;
         
@@ -266,9 +267,9 @@ int main() {
         double r1Error = 0.0, r2Error = 0.0, r3Error = 0.0;
         double avgConf = 0.0;
         
-        for (const auto& diff : result.differences) {
-            const std::string& sourceId = diff.sourceId2;
-            const double measuredOffset = diff.timeDiff;
+        for (const auto& diff : result.timeDifferences) {
+            const std::string& sourceId = diff.sourceId;
+            const double measuredOffset = diff.timeDifference;
             const double trueOffset = trueOffsets[sourceId];
             const double error = measuredOffset - trueOffset;
             
@@ -279,7 +280,7 @@ int main() {
             avgConf += diff.confidence;
         }
         
-        avgConf /= result.differences.size();
+        avgConf /= result.timeDifferences.size();
         
         std::cout << std::fixed << std::setprecision(3);
         std::cout << std::setw(10) << testSnr
@@ -290,5 +291,41 @@ int main() {
                   << std::endl;
     }
     
+    // Test admission: one token at a time, held until the callback has run
+    std::cout << std::endl;
+    std::cout << "Testing admission:" << std::endl;
+    std::cout << "-----------------" << std::endl;
+    
+    std::weak_ptr<void> issued;
+    bool heldInCallback = false;
+    extractor.setAdmissionHandler([&issued]() -> std::shared_ptr<void> {
+        if (!issued.expired()) {
+            return nullptr;
+        }
+        std::shared_ptr<void> token = std::make_shared<int>(0);
+        issued = token;
+        return token;
+    });
+    extractor.setTimeDifferenceCallback([&](const TimeDifferenceSet&) {
+        heldInCallback = !issued.expired();
+    });
+    
+    const size_t admittedCount = extractor.processSignals(signals, timestamp).timeDifferences.size();
+    const bool released = issued.expired();
+    
+    // A set arriving while another holds the only token is shed
+    std::shared_ptr<void> busy = std::make_shared<int>(0);
+    issued = busy;
+    const size_t shedCount = extractor.processSignals(signals, timestamp).timeDifferences.size();
+    
+    std::cout << "Admitted set: " << admittedCount << " time differences, token held in callback: "
+              << (heldInCallback ? "yes" : "no") << ", released after: " << (released ? "yes" : "no") << std::endl;
+    std::cout << "Shed set: " << shedCount << " time differences, shed count: " << extractor.getShedCount() << std::endl;
+    
+    if (admittedCount == 0 || !heldInCallback || !released || shedCount != 0 || extractor.getShedCount() != 1) {
+        std::cout << "Admission test FAILED" << std::endl;
+        return 1;
+    }
+    
     return 0;
 } 
\ No newline at end of file
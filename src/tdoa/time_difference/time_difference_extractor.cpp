@@ -5,6 +5,7 @@
 
 #include "time_difference_extractor.h"
 #include "../correlation/cross_correlation.h"
+#include "../multilateration/peak_association.h"
 #include <vector>
 #include <map>
 #include <unordered_map>
@@ -44,6 +45,14 @@ struct TimeDifferenceExtractor::Impl {
     // Callback function
     TimeDifferenceCallback timeDifferenceCallback;
     
+    // Admission hook and the sets it refused
+    AdmissionHandler admissionHandler;
+    uint64_t shedCount;
+    
+    // Peak association for co-channel emitters
+    multilateration::PeakAssociator associator;
+    std::vector<TimeDifferenceSet> associatedSets;
+    
     // Mutex for thread safety
     mutable std::mutex mutex;
     
@@ -57,6 +66,7 @@ struct TimeDifferenceExtractor::Impl {
      */
     Impl(const TimeDifferenceConfig& config)
         : config(config)
+        , shedCount(0)
         , calibrationRunning(false)
     {
     }
@@ -222,6 +232,20 @@ struct TimeDifferenceExtractor::Impl {
             return TimeDifferenceSet();  // No reference signal
         }
         
+        // Hold the admission token until the set has been handed on
+        std::shared_ptr<void> token;
+        if (admissionHandler) {
+            token = admissionHandler();
+            if (!token) {
+                shedCount++;
+                return TimeDifferenceSet();  // Shed
+            }
+        }
+        
+        if (config.enablePeakAssociation) {
+            return associateSignals(signals, timestamp);
+        }
+        
         const std::vector<double>& refSignal = refIt->second;
         
         // Create result set
@@ -278,8 +302,8 @@ struct TimeDifferenceExtractor::Impl {
             // Calculate time difference in seconds
             double timeDiff = correlation::samplesToTime(bestPeak->delay, config.correlationConfig.sampleRate);
             
-            // Adjust time delay based on correlation lag window
-            timeDiff -= (refSignal.size() + signal.size() - 1) / 2.0 / config.correlationConfig.sampleRate;
+            // Measure the delay from the zero-lag index
+            timeDiff -= correlation::samplesToTime(corrResult.zeroLag, config.correlationConfig.sampleRate);
             
             // Apply clock correction if enabled
             if (config.clockCorrectionMethod != ClockCorrectionMethod::None) {
@@ -290,7 +314,7 @@ struct TimeDifferenceExtractor::Impl {
             double uncertainty = (1.0 - bestPeak->confidence) * 1.0e-6;  // Scale to typical range
             
             // Create time difference object
-            TimeDifference diff(referenceSourceId, sourceId, timeDiff, uncertainty, 
+            TimeDifference diff(sourceId, referenceSourceId, timeDiff, uncertainty, 
                                bestPeak->confidence, timestamp);
             
             // Add to history
@@ -310,11 +334,11 @@ struct TimeDifferenceExtractor::Impl {
             }
             
             // Add to result
-            result.differences.push_back(diff);
+            result.timeDifferences.push_back(diff);
         }
         
         // Call callback if registered
-        if (!result.differences.empty() && timeDifferenceCallback) {
+        if (!result.timeDifferences.empty() && timeDifferenceCallback) {
             timeDifferenceCallback(result);
         }
         
@@ -344,6 +368,20 @@ struct TimeDifferenceExtractor::Impl {
             return TimeDifferenceSet();  // No reference signal
         }
         
+        // Hold the admission token until the set has been handed on
+        std::shared_ptr<void> token;
+        if (admissionHandler) {
+            token = admissionHandler();
+            if (!token) {
+                shedCount++;
+                return TimeDifferenceSet();  // Shed
+            }
+        }
+        
+        if (config.enablePeakAssociation) {
+            return associateSignals(signals, timestamp);
+        }
+        
         const std::vector<std::complex<double>>& refSignal = refIt->second;
         
         // Create result set
@@ -400,8 +438,8 @@ struct TimeDifferenceExtractor::Impl {
             // Calculate time difference in seconds
             double timeDiff = correlation::samplesToTime(bestPeak->delay, config.correlationConfig.sampleRate);
             
-            // Adjust time delay based on correlation lag window
-            timeDiff -= (refSignal.size() + signal.size() - 1) / 2.0 / config.correlationConfig.sampleRate;
+            // Measure the delay from the zero-lag index
+            timeDiff -= correlation::samplesToTime(corrResult.zeroLag, config.correlationConfig.sampleRate);
             
             // Apply clock correction if enabled
             if (config.clockCorrectionMethod != ClockCorrectionMethod::None) {
@@ -412,7 +450,7 @@ struct TimeDifferenceExtractor::Impl {
             double uncertainty = (1.0 - bestPeak->confidence) * 1.0e-6;  // Scale to typical range
             
             // Create time difference object
-            TimeDifference diff(referenceSourceId, sourceId, timeDiff, uncertainty, 
+            TimeDifference diff(sourceId, referenceSourceId, timeDiff, uncertainty, 
                                bestPeak->confidence, timestamp);
             
             // Add to history
@@ -432,11 +470,11 @@ struct TimeDifferenceExtractor::Impl {
             }
             
             // Add to result
-            result.differences.push_back(diff);
+            result.timeDifferences.push_back(diff);
         }
         
         // Call callback if registered
-        if (!result.differences.empty() && timeDifferenceCallback) {
+        if (!result.timeDifferences.empty() && timeDifferenceCallback) {
             timeDifferenceCallback(result);
         }
         
@@ -445,6 +483,98 @@ struct TimeDifferenceExtractor::Impl {
 
     // Helper methods
     
+    /**
+     * @brief Correlate every receiver pair and associate all peaks into emitters
+     * @param signals Map of source ID to signal segment
+     * @param timestamp Timestamp for the signals
+     * @return Set of the best emitter (empty if none was found)
+     */
+    template <typename Sample>
+    TimeDifferenceSet associateSignals(
+        const std::map<std::string, std::vector<Sample>>& signals,
+        uint64_t timestamp) {
+        
+        TimeDifferenceSet best;
+        best.timestamp = timestamp;
+        best.referenceId = referenceSourceId;
+        associatedSets.clear();
+        
+        // Known sources with data, reference first so its pairs keep their orientation
+        std::vector<std::string> ids;
+        ids.push_back(referenceSourceId);
+        std::map<std::string, SignalSource> present;
+        present[referenceSourceId] = sources[referenceSourceId];
+        for (const auto& pair : signals) {
+            auto sourceIt = sources.find(pair.first);
+            if (pair.first != referenceSourceId && sourceIt != sources.end()) {
+                ids.push_back(pair.first);
+                present[pair.first] = sourceIt->second;
+            }
+        }
+        
+        // The solver needs at least three receivers
+        if (ids.size() < 3) {
+            return best;
+        }
+        
+        std::vector<multilateration::PairCandidates> pairs;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            for (size_t j = i + 1; j < ids.size(); ++j) {
+                const std::string& referenceId = ids[i];
+                const std::string& sourceId = ids[j];
+                const std::vector<Sample>& refSignal = signals.at(referenceId);
+                const std::vector<Sample>& signal = signals.at(sourceId);
+                
+                const std::string pairKey = getPairKey(referenceId, sourceId);
+                auto correlatorIt = correlators.find(pairKey);
+                if (correlatorIt == correlators.end()) {
+                    correlatorIt = correlators.emplace(
+                        pairKey, correlation::SegmentedCorrelator(config.correlationConfig)).first;
+                }
+                correlation::CorrelationResult corrResult = correlatorIt->second.processSegment(refSignal, signal);
+                
+                multilateration::PairCandidates candidates;
+                candidates.sourceId = sourceId;
+                candidates.referenceId = referenceId;
+                for (const auto& peak : corrResult.peaks) {
+                    if (peak.confidence < config.detectionThreshold) {
+                        continue;
+                    }
+                    
+                    // Same conversion as the single-peak path
+                    double timeDiff = correlation::samplesToTime(peak.delay, config.correlationConfig.sampleRate);
+                    timeDiff -= correlation::samplesToTime(corrResult.zeroLag, config.correlationConfig.sampleRate);
+                    
+                    // Both ends of a pair may carry delays when neither is the reference
+                    if (config.clockCorrectionMethod != ClockCorrectionMethod::None) {
+                        timeDiff = applyClockCorrection(timeDiff, present[sourceId], timestamp)
+                                 - applyClockCorrection(0.0, present[referenceId], timestamp);
+                    }
+                    
+                    double uncertainty = (1.0 - peak.confidence) * 1.0e-6;
+                    candidates.candidates.emplace_back(sourceId, referenceId, timeDiff, uncertainty,
+                                                       peak.confidence, timestamp);
+                }
+                if (!candidates.candidates.empty()) {
+                    pairs.push_back(std::move(candidates));
+                }
+            }
+        }
+        
+        for (auto& emitter : associator.associate(pairs, present, timestamp)) {
+            emitter.measurements.timestamp = timestamp;
+            associatedSets.push_back(std::move(emitter.measurements));
+        }
+        
+        if (timeDifferenceCallback) {
+            for (const auto& set : associatedSets) {
+                timeDifferenceCallback(set);
+            }
+        }
+        
+        return associatedSets.empty() ? best : associatedSets.front();
+    }
+    
     /**
      * @brief Generate a unique key for a source pair
      * @param id1 First source ID
@@ -498,7 +628,7 @@ struct TimeDifferenceExtractor::Impl {
         // Calculate mean and standard deviation of recent measurements
         std::vector<double> recentDiffs;
         for (auto it = history.rbegin(); it != history.rend() && recentDiffs.size() < 5; ++it) {
-            recentDiffs.push_back(it->timeDiff);
+            recentDiffs.push_back(it->timeDifference);
         }
         
         double mean = std::accumulate(recentDiffs.begin(), recentDiffs.end(), 0.0) / 
@@ -514,7 +644,7 @@ struct TimeDifferenceExtractor::Impl {
         stdDev = std::max(stdDev, 1e-9);
         
         // Calculate Z-score
-        double zScore = std::abs(diff.timeDiff - mean) / stdDev;
+        double zScore = std::abs(diff.timeDifference - mean) / stdDev;
         
         // Check if measurement is an outlier
         return zScore <= config.outlierThreshold;
@@ -579,6 +709,16 @@ void TimeDifferenceExtractor::setTimeDifferenceCallback(TimeDifferenceCallback c
     pImpl->timeDifferenceCallback = callback;
 }
 
+void TimeDifferenceExtractor::setAdmissionHandler(AdmissionHandler handler) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->admissionHandler = handler;
+}
+
+uint64_t TimeDifferenceExtractor::getShedCount() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->shedCount;
+}
+
 TimeDifferenceConfig TimeDifferenceExtractor::getConfig() const {
     std::lock_guard<std::mutex> lock(pImpl->mutex);
     return pImpl->config;
@@ -604,6 +744,8 @@ void TimeDifferenceExtractor::reset() {
     
     // Clear history
     pImpl->timeDifferenceHistory.clear();
+    pImpl->associatedSets.clear();
+    pImpl->shedCount = 0;
 }
 
 bool TimeDifferenceExtractor::setCableDelay(const std::string& sourceId, double delay) {
@@ -669,6 +811,16 @@ std::vector<TimeDifference> TimeDifferenceExtractor::getRecentTimeDifferences()
     return result;
 }
 
+std::vector<TimeDifferenceSet> TimeDifferenceExtractor::getAssociatedSets() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->associatedSets;
+}
+
+void TimeDifferenceExtractor::setAssociationConfig(const multilateration::AssociationConfig& config) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->associator.setConfig(config);
+}
+
 bool TimeDifferenceExtractor::addCalibrationMeasurement(const TimeDifference& timeDiff) {
     // This would be implemented for manual calibration
     return false;
@@ -14,17 +14,39 @@
 #include <mutex>
 
 namespace tdoa {
+
+namespace multilateration {
+struct AssociationConfig;
+} // namespace multilateration
+
 namespace time_difference {
 
+/**
+ * @struct SourcePosition
+ * @brief Cartesian position of a receiver in meters
+ */
+struct SourcePosition {
+    double x;                  ///< X position in meters
+    double y;                  ///< Y position in meters
+    double z;                  ///< Z position in meters
+    
+    /**
+     * @brief Constructor with default values
+     */
+    SourcePosition()
+        : x(0.0)
+        , y(0.0)
+        , z(0.0)
+    {}
+};
+
 /**
  * @struct SignalSource
  * @brief Structure to represent a signal source (receiver)
  */
 struct SignalSource {
     std::string id;            ///< Unique identifier
-    double x;                  ///< X position in meters
-    double y;                  ///< Y position in meters
-    double z;                  ///< Z position in meters
+    SourcePosition position;   ///< Position in meters
     double clockOffset;        ///< Clock offset in seconds
     double clockDrift;         ///< Clock drift in seconds/second
     double cableDelay;         ///< Cable delay in seconds
@@ -35,9 +57,6 @@ struct SignalSource {
      */
     SignalSource()
         : id("")
-        , x(0.0)
-        , y(0.0)
-        , z(0.0)
         , clockOffset(0.0)
         , clockDrift(0.0)
         , cableDelay(0.0)
@@ -49,24 +68,27 @@ struct SignalSource {
      */
     SignalSource(const std::string& sourceId, double xPos, double yPos, double zPos = 0.0)
         : id(sourceId)
-        , x(xPos)
-        , y(yPos)
-        , z(zPos)
         , clockOffset(0.0)
         , clockDrift(0.0)
         , cableDelay(0.0)
         , antennaDelay(0.0)
-    {}
+    {
+        position.x = xPos;
+        position.y = yPos;
+        position.z = zPos;
+    }
 };
 
 /**
  * @struct TimeDifference
  * @brief Structure to represent a time difference between two receivers
+ *
+ * timeDifference is t(source) - t(reference).
  */
 struct TimeDifference {
-    std::string sourceId1;     ///< First source ID
-    std::string sourceId2;     ///< Second source ID
-    double timeDiff;           ///< Time difference in seconds
+    std::string sourceId;      ///< Measuring source ID
+    std::string referenceId;   ///< Reference source ID
+    double timeDifference;     ///< Time difference in seconds
     double uncertainty;        ///< Uncertainty in seconds
     double confidence;         ///< Confidence value (0-1)
     uint64_t timestamp;        ///< Timestamp when measurement was taken (ns since epoch)
@@ -75,9 +97,9 @@ struct TimeDifference {
      * @brief Constructor with default values
      */
     TimeDifference()
-        : sourceId1("")
-        , sourceId2("")
-        , timeDiff(0.0)
+        : sourceId("")
+        , referenceId("")
+        , timeDifference(0.0)
         , uncertainty(0.0)
         , confidence(0.0)
         , timestamp(0)
@@ -87,15 +109,15 @@ struct TimeDifference {
      * @brief Constructor with source IDs and time difference
      */
     TimeDifference(
-        const std::string& id1,
-        const std::string& id2,
+        const std::string& source,
+        const std::string& reference,
         double diff,
         double uncert = 0.0,
         double conf = 1.0,
         uint64_t time = 0)
-        : sourceId1(id1)
-        , sourceId2(id2)
-        , timeDiff(diff)
+        : sourceId(source)
+        , referenceId(reference)
+        , timeDifference(diff)
         , uncertainty(uncert)
         , confidence(conf)
         , timestamp(time)
@@ -107,9 +129,16 @@ struct TimeDifference {
  * @brief Structure to represent a set of time differences from multiple receivers
  */
 struct TimeDifferenceSet {
-    std::vector<TimeDifference> differences;  ///< Vector of time differences
-    uint64_t timestamp;                       ///< Timestamp for the set
-    std::string referenceId;                  ///< Reference source ID
+    std::vector<TimeDifference> timeDifferences;  ///< Vector of time differences
+    uint64_t timestamp;                           ///< Timestamp for the set
+    std::string referenceId;                      ///< Reference source ID
+    
+    /**
+     * @brief Constructor with default values
+     */
+    TimeDifferenceSet()
+        : timestamp(0)
+    {}
 };
 
 /**
@@ -146,6 +175,7 @@ struct TimeDifferenceConfig {
     double outlierThreshold;                          ///< Outlier threshold (sigmas)
     int historySize;                                  ///< Number of measurements to keep in history
     bool enableStatisticalValidation;                 ///< Whether to validate measurements statistically
+    bool enablePeakAssociation;                       ///< Correlate every receiver pair and resolve co-channel emitters from all peaks
     
     /**
      * @brief Constructor with default values
@@ -158,6 +188,7 @@ struct TimeDifferenceConfig {
         , outlierThreshold(3.0)
         , historySize(100)
         , enableStatisticalValidation(true)
+        , enablePeakAssociation(false)
     {}
 };
 
@@ -168,6 +199,18 @@ struct TimeDifferenceConfig {
  * This class handles the extraction of time differences between signals from
  * different receivers, including clock synchronization, calibration, and 
  * statistical validation.
+ *
+ * With enablePeakAssociation set, every receiver pair is correlated and all
+ * peaks above the detection threshold are passed to a
+ * multilateration::PeakAssociator. processSignals then returns the best
+ * emitter's set, the callback is called once per emitter, and
+ * getAssociatedSets returns all of them. The association's residual gate
+ * takes the place of the per-pair statistical validation in this mode.
+ *
+ * With an admission handler set, processSignals asks it for a token before
+ * correlating and holds the token until the set has been returned, so work
+ * done synchronously in the callback (solving, storing) is covered too. A
+ * null token sheds the set: nothing is correlated and an empty set returned.
  */
 class TimeDifferenceExtractor {
 public:
@@ -176,6 +219,11 @@ public:
      */
     using TimeDifferenceCallback = std::function<void(const TimeDifferenceSet&)>;
     
+    /**
+     * @brief Admission handler, returns a token held while a set is processed (null = shed)
+     */
+    using AdmissionHandler = std::function<std::shared_ptr<void>()>;
+    
     /**
      * @brief Constructor
      * @param config Configuration for time difference extraction
@@ -241,6 +289,18 @@ public:
         const std::map<std::string, std::vector<std::complex<double>>>& signals,
         uint64_t timestamp);
     
+    /**
+     * @brief Get the emitter sets found by the last association
+     * @return One set per emitter, best first (empty unless enablePeakAssociation is set)
+     */
+    std::vector<TimeDifferenceSet> getAssociatedSets() const;
+    
+    /**
+     * @brief Set the configuration used for peak association
+     * @param config Association configuration
+     */
+    void setAssociationConfig(const multilateration::AssociationConfig& config);
+    
     /**
      * @brief Add a known time difference for calibration
      * @param timeDiff Time difference
@@ -260,6 +320,18 @@ public:
      */
     void setTimeDifferenceCallback(TimeDifferenceCallback callback);
     
+    /**
+     * @brief Set the admission handler consulted before each set is processed
+     * @param handler Handler, or nullptr to process every set
+     */
+    void setAdmissionHandler(AdmissionHandler handler);
+    
+    /**
+     * @brief Get the number of sets shed because the admission handler refused them
+     * @return Shed set count since construction or reset
+     */
+    uint64_t getShedCount() const;
+    
     /**
      * @brief Get configuration
      * @return Current configuration
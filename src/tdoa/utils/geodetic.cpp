@@ -0,0 +1,319 @@
+/**
+ * @file geodetic.cpp
+ * @brief Implementation of WGS-84 geodetic, ECEF and local ENU conversions
+ */
+
+#include "geodetic.h"
+#include <cmath>
+#include <mutex>
+
+namespace tdoa {
+namespace utils {
+
+namespace {
+
+// WGS-84 ellipsoid
+constexpr double kSemiMajorAxis = 6378137.0;
+constexpr double kFlattening = 1.0 / 298.257223563;
+constexpr double kSemiMinorAxis = kSemiMajorAxis * (1.0 - kFlattening);
+constexpr double kEccentricitySq = kFlattening * (2.0 - kFlattening);
+constexpr double kSecondEccentricitySq = kEccentricitySq / (1.0 - kEccentricitySq);
+
+// M_PI is not standard C++ (MSVC only defines it with _USE_MATH_DEFINES)
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kDegToRad = kPi / 180.0;
+constexpr double kRadToDeg = 180.0 / kPi;
+
+inline void toEcef(double latDeg, double lonDeg, double alt, double& x, double& y, double& z) {
+    const double lat = latDeg * kDegToRad;
+    const double lon = lonDeg * kDegToRad;
+    const double sinLat = std::sin(lat);
+    const double cosLat = std::cos(lat);
+    const double n = kSemiMajorAxis / std::sqrt(1.0 - kEccentricitySq * sinLat * sinLat);
+    x = (n + alt) * cosLat * std::cos(lon);
+    y = (n + alt) * cosLat * std::sin(lon);
+    z = (n * (1.0 - kEccentricitySq) + alt) * sinLat;
+}
+
+// Zhu's closed-form solution; branch-free apart from the poles, millimeter accurate
+inline void toGeodetic(double x, double y, double z, double& latDeg, double& lonDeg, double& alt) {
+    const double a2 = kSemiMajorAxis * kSemiMajorAxis;
+    const double b2 = kSemiMinorAxis * kSemiMinorAxis;
+    const double e4 = kEccentricitySq * kEccentricitySq;
+
+    const double p2 = x * x + y * y;
+    const double p = std::sqrt(p2);
+    const double z2 = z * z;
+
+    const double F = 54.0 * b2 * z2;
+    const double G = p2 + (1.0 - kEccentricitySq) * z2 - kEccentricitySq * (a2 - b2);
+    const double c = e4 * F * p2 / (G * G * G);
+    const double s = std::cbrt(1.0 + c + std::sqrt(c * c + 2.0 * c));
+    const double k = s + 1.0 / s + 1.0;
+    const double P = F / (3.0 * k * k * G * G);
+    const double Q = std::sqrt(1.0 + 2.0 * e4 * P);
+    const double r0 = -(P * kEccentricitySq * p) / (1.0 + Q)
+                    + std::sqrt(0.5 * a2 * (1.0 + 1.0 / Q)
+                                - P * (1.0 - kEccentricitySq) * z2 / (Q * (1.0 + Q))
+                                - 0.5 * P * p2);
+    const double t = p - kEccentricitySq * r0;
+    const double U = std::sqrt(t * t + z2);
+    const double V = std::sqrt(t * t + (1.0 - kEccentricitySq) * z2);
+    const double z0 = b2 * z / (kSemiMajorAxis * V);
+
+    alt = U * (1.0 - b2 / (kSemiMajorAxis * V));
+    latDeg = std::atan2(z + kSecondEccentricitySq * z0, p) * kRadToDeg;
+    lonDeg = std::atan2(y, x) * kRadToDeg;
+}
+
+} // namespace
+
+EcefPosition geodeticToEcef(const GeodeticPosition& geodetic)
+{
+    EcefPosition ecef;
+    toEcef(geodetic.latitude, geodetic.longitude, geodetic.altitude, ecef.x, ecef.y, ecef.z);
+    return ecef;
+}
+
+GeodeticPosition ecefToGeodetic(const EcefPosition& ecef)
+{
+    // The closed form divides by p at the poles
+    if (std::abs(ecef.x) < 1e-9 && std::abs(ecef.y) < 1e-9) {
+        return GeodeticPosition(ecef.z >= 0.0 ? 90.0 : -90.0, 0.0, std::abs(ecef.z) - kSemiMinorAxis);
+    }
+    GeodeticPosition geodetic;
+    toGeodetic(ecef.x, ecef.y, ecef.z, geodetic.latitude, geodetic.longitude, geodetic.altitude);
+    return geodetic;
+}
+
+void geodeticToEcef(const double* latitude, const double* longitude, const double* altitude,
+                    double* x, double* y, double* z, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        toEcef(latitude[i], longitude[i], altitude[i], x[i], y[i], z[i]);
+    }
+}
+
+void ecefToGeodetic(const double* x, const double* y, const double* z,
+                    double* latitude, double* longitude, double* altitude, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (std::abs(x[i]) < 1e-9 && std::abs(y[i]) < 1e-9) {
+            GeodeticPosition pole = ecefToGeodetic(EcefPosition(x[i], y[i], z[i]));
+            latitude[i] = pole.latitude;
+            longitude[i] = pole.longitude;
+            altitude[i] = pole.altitude;
+            continue;
+        }
+        toGeodetic(x[i], y[i], z[i], latitude[i], longitude[i], altitude[i]);
+    }
+}
+
+LocalFrame::LocalFrame(const GeodeticPosition& origin)
+    : origin_(origin)
+    , originEcef_(geodeticToEcef(origin))
+{
+    const double lat = origin.latitude * kDegToRad;
+    const double lon = origin.longitude * kDegToRad;
+    const double sinLat = std::sin(lat);
+    const double cosLat = std::cos(lat);
+    const double sinLon = std::sin(lon);
+    const double cosLon = std::cos(lon);
+
+    // East
+    rotation_[0][0] = -sinLon;
+    rotation_[0][1] = cosLon;
+    rotation_[0][2] = 0.0;
+    // North
+    rotation_[1][0] = -sinLat * cosLon;
+    rotation_[1][1] = -sinLat * sinLon;
+    rotation_[1][2] = cosLat;
+    // Up
+    rotation_[2][0] = cosLat * cosLon;
+    rotation_[2][1] = cosLat * sinLon;
+    rotation_[2][2] = sinLat;
+}
+
+EnuPosition LocalFrame::ecefToEnu(const EcefPosition& ecef) const
+{
+    EnuPosition enu;
+    ecefToEnu(&ecef.x, &ecef.y, &ecef.z, &enu.east, &enu.north, &enu.up, 1);
+    return enu;
+}
+
+EcefPosition LocalFrame::enuToEcef(const EnuPosition& enu) const
+{
+    EcefPosition ecef;
+    enuToEcef(&enu.east, &enu.north, &enu.up, &ecef.x, &ecef.y, &ecef.z, 1);
+    return ecef;
+}
+
+EnuPosition LocalFrame::geodeticToEnu(const GeodeticPosition& geodetic) const
+{
+    return ecefToEnu(geodeticToEcef(geodetic));
+}
+
+GeodeticPosition LocalFrame::enuToGeodetic(const EnuPosition& enu) const
+{
+    return ecefToGeodetic(enuToEcef(enu));
+}
+
+void LocalFrame::ecefToEnu(const double* x, const double* y, const double* z,
+                           double* east, double* north, double* up, size_t count) const
+{
+    const double (&r)[3][3] = rotation_;
+    for (size_t i = 0; i < count; ++i) {
+        const double dx = x[i] - originEcef_.x;
+        const double dy = y[i] - originEcef_.y;
+        const double dz = z[i] - originEcef_.z;
+        east[i] = r[0][0] * dx + r[0][1] * dy;
+        north[i] = r[1][0] * dx + r[1][1] * dy + r[1][2] * dz;
+        up[i] = r[2][0] * dx + r[2][1] * dy + r[2][2] * dz;
+    }
+}
+
+void LocalFrame::enuToEcef(const double* east, const double* north, const double* up,
+                           double* x, double* y, double* z, size_t count) const
+{
+    // Inverse rotation is the transpose
+    const double (&r)[3][3] = rotation_;
+    for (size_t i = 0; i < count; ++i) {
+        const double e = east[i];
+        const double n = north[i];
+        const double u = up[i];
+        x[i] = originEcef_.x + r[0][0] * e + r[1][0] * n + r[2][0] * u;
+        y[i] = originEcef_.y + r[0][1] * e + r[1][1] * n + r[2][1] * u;
+        z[i] = originEcef_.z + r[1][2] * n + r[2][2] * u;
+    }
+}
+
+void LocalFrame::geodeticToEnu(const double* latitude, const double* longitude, const double* altitude,
+                               double* east, double* north, double* up, size_t count) const
+{
+    utils::geodeticToEcef(latitude, longitude, altitude, east, north, up, count);
+    ecefToEnu(east, north, up, east, north, up, count);
+}
+
+void LocalFrame::enuToGeodetic(const double* east, const double* north, const double* up,
+                               double* latitude, double* longitude, double* altitude, size_t count) const
+{
+    std::vector<double> x(count), y(count), z(count);
+    enuToEcef(east, north, up, x.data(), y.data(), z.data(), count);
+    utils::ecefToGeodetic(x.data(), y.data(), z.data(), latitude, longitude, altitude, count);
+}
+
+/**
+ * @struct FrameRegistry::Impl
+ * @brief Private implementation of FrameRegistry
+ */
+struct FrameRegistry::Impl {
+    struct Deployment {
+        std::shared_ptr<const LocalFrame> frame;
+        std::map<std::string, EnuPosition> receivers;
+    };
+
+    std::map<std::string, Deployment> deployments;
+    mutable std::mutex mutex;
+};
+
+FrameRegistry::FrameRegistry()
+    : pImpl(std::make_unique<Impl>())
+{
+}
+
+FrameRegistry::~FrameRegistry() = default;
+
+std::shared_ptr<const LocalFrame> FrameRegistry::setReceivers(
+    const std::string& deploymentId,
+    const std::map<std::string, GeodeticPosition>& receivers)
+{
+    const size_t count = receivers.size();
+    std::vector<double> lat, lon, alt;
+    lat.reserve(count);
+    lon.reserve(count);
+    alt.reserve(count);
+    for (const auto& entry : receivers) {
+        lat.push_back(entry.second.latitude);
+        lon.push_back(entry.second.longitude);
+        alt.push_back(entry.second.altitude);
+    }
+
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Deployment& deployment = pImpl->deployments[deploymentId];
+
+    if (!deployment.frame) {
+        // Average the ellipsoid normals rather than the angles, so that a
+        // deployment straddling the antimeridian or near a pole gets an origin
+        // between its receivers
+        double nx = 0.0, ny = 0.0, nz = 0.0;
+        GeodeticPosition centroid;
+        for (size_t i = 0; i < count; ++i) {
+            const double latRad = lat[i] * kDegToRad;
+            const double lonRad = lon[i] * kDegToRad;
+            nx += std::cos(latRad) * std::cos(lonRad);
+            ny += std::cos(latRad) * std::sin(lonRad);
+            nz += std::sin(latRad);
+            centroid.altitude += alt[i];
+        }
+        if (count > 0) {
+            const double horizontal = std::sqrt(nx * nx + ny * ny);
+            centroid.latitude = std::atan2(nz, horizontal) * kRadToDeg;
+            centroid.longitude = horizontal > 0.0 ? std::atan2(ny, nx) * kRadToDeg : 0.0;
+            centroid.altitude /= count;
+        }
+        deployment.frame = std::make_shared<const LocalFrame>(centroid);
+    }
+
+    std::vector<double> east(count), north(count), up(count);
+    deployment.frame->geodeticToEnu(lat.data(), lon.data(), alt.data(),
+                                    east.data(), north.data(), up.data(), count);
+
+    deployment.receivers.clear();
+    size_t i = 0;
+    for (const auto& entry : receivers) {
+        deployment.receivers[entry.first] = EnuPosition(east[i], north[i], up[i]);
+        ++i;
+    }
+
+    return deployment.frame;
+}
+
+std::shared_ptr<const LocalFrame> FrameRegistry::setOrigin(
+    const std::string& deploymentId, const GeodeticPosition& origin)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    Impl::Deployment& deployment = pImpl->deployments[deploymentId];
+    auto frame = std::make_shared<const LocalFrame>(origin);
+
+    // Re-express known receivers in the new frame
+    if (deployment.frame) {
+        for (auto& entry : deployment.receivers) {
+            entry.second = frame->ecefToEnu(deployment.frame->enuToEcef(entry.second));
+        }
+    }
+    deployment.frame = frame;
+    return frame;
+}
+
+std::shared_ptr<const LocalFrame> FrameRegistry::getFrame(const std::string& deploymentId) const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->deployments.find(deploymentId);
+    return it != pImpl->deployments.end() ? it->second.frame : nullptr;
+}
+
+std::map<std::string, EnuPosition> FrameRegistry::getLocalReceivers(const std::string& deploymentId) const
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    auto it = pImpl->deployments.find(deploymentId);
+    return it != pImpl->deployments.end() ? it->second.receivers : std::map<std::string, EnuPosition>();
+}
+
+bool FrameRegistry::removeDeployment(const std::string& deploymentId)
+{
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->deployments.erase(deploymentId) > 0;
+}
+
+} // namespace utils
+} // namespace tdoa
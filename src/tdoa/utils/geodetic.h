@@ -0,0 +1,250 @@
+/**
+ * @file geodetic.h
+ * @brief WGS-84 geodetic, ECEF and local ENU coordinate conversions
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tdoa {
+namespace utils {
+
+/**
+ * @struct GeodeticPosition
+ * @brief WGS-84 geodetic coordinates
+ */
+struct GeodeticPosition {
+    double latitude;            ///< Latitude in degrees (positive is North)
+    double longitude;           ///< Longitude in degrees (positive is East)
+    double altitude;            ///< Height above the WGS-84 ellipsoid in meters
+
+    /**
+     * @brief Constructor with position
+     */
+    GeodeticPosition(double lat = 0.0, double lon = 0.0, double alt = 0.0)
+        : latitude(lat)
+        , longitude(lon)
+        , altitude(alt)
+    {}
+};
+
+/**
+ * @struct EcefPosition
+ * @brief Earth-centered, earth-fixed coordinates
+ */
+struct EcefPosition {
+    double x;                   ///< X coordinate in meters
+    double y;                   ///< Y coordinate in meters
+    double z;                   ///< Z coordinate in meters
+
+    /**
+     * @brief Constructor with position
+     */
+    EcefPosition(double xPos = 0.0, double yPos = 0.0, double zPos = 0.0)
+        : x(xPos)
+        , y(yPos)
+        , z(zPos)
+    {}
+};
+
+/**
+ * @struct EnuPosition
+ * @brief East-north-up coordinates in a local tangent plane
+ */
+struct EnuPosition {
+    double east;                ///< East offset in meters
+    double north;               ///< North offset in meters
+    double up;                  ///< Up offset in meters
+
+    /**
+     * @brief Constructor with position
+     */
+    EnuPosition(double e = 0.0, double n = 0.0, double u = 0.0)
+        : east(e)
+        , north(n)
+        , up(u)
+    {}
+};
+
+/**
+ * @brief Convert geodetic coordinates to ECEF
+ * @param geodetic Geodetic position
+ * @return ECEF position
+ */
+EcefPosition geodeticToEcef(const GeodeticPosition& geodetic);
+
+/**
+ * @brief Convert ECEF coordinates to geodetic (closed form, no iteration)
+ * @param ecef ECEF position
+ * @return Geodetic position
+ */
+GeodeticPosition ecefToGeodetic(const EcefPosition& ecef);
+
+/**
+ * @brief Convert arrays of geodetic coordinates to ECEF
+ *
+ * All arrays hold count elements. Input and output arrays may not alias.
+ */
+void geodeticToEcef(const double* latitude, const double* longitude, const double* altitude,
+                    double* x, double* y, double* z, size_t count);
+
+/**
+ * @brief Convert arrays of ECEF coordinates to geodetic
+ *
+ * All arrays hold count elements. Input and output arrays may not alias.
+ */
+void ecefToGeodetic(const double* x, const double* y, const double* z,
+                    double* latitude, double* longitude, double* altitude, size_t count);
+
+/**
+ * @class LocalFrame
+ * @brief East-north-up tangent plane anchored at a geodetic origin
+ *
+ * The origin's ECEF position and rotation are computed once, so ECEF <-> ENU
+ * is a translation plus a 3x3 rotation with no trigonometry. Over a typical
+ * deployment (tens of km) ENU east/north can be used directly as the solver's
+ * local x/y.
+ */
+class LocalFrame {
+public:
+    /**
+     * @brief Constructor
+     * @param origin Geodetic origin of the frame
+     */
+    explicit LocalFrame(const GeodeticPosition& origin = GeodeticPosition());
+
+    /**
+     * @brief Get the frame origin
+     * @return Geodetic origin
+     */
+    const GeodeticPosition& getOrigin() const { return origin_; }
+
+    /**
+     * @brief Convert ECEF to ENU
+     * @param ecef ECEF position
+     * @return ENU position
+     */
+    EnuPosition ecefToEnu(const EcefPosition& ecef) const;
+
+    /**
+     * @brief Convert ENU to ECEF
+     * @param enu ENU position
+     * @return ECEF position
+     */
+    EcefPosition enuToEcef(const EnuPosition& enu) const;
+
+    /**
+     * @brief Convert geodetic to ENU
+     * @param geodetic Geodetic position
+     * @return ENU position
+     */
+    EnuPosition geodeticToEnu(const GeodeticPosition& geodetic) const;
+
+    /**
+     * @brief Convert ENU to geodetic
+     * @param enu ENU position
+     * @return Geodetic position
+     */
+    GeodeticPosition enuToGeodetic(const EnuPosition& enu) const;
+
+    /**
+     * @brief Convert arrays of ECEF coordinates to ENU (may be done in place)
+     */
+    void ecefToEnu(const double* x, const double* y, const double* z,
+                   double* east, double* north, double* up, size_t count) const;
+
+    /**
+     * @brief Convert arrays of ENU coordinates to ECEF (may be done in place)
+     */
+    void enuToEcef(const double* east, const double* north, const double* up,
+                   double* x, double* y, double* z, size_t count) const;
+
+    /**
+     * @brief Convert arrays of geodetic coordinates to ENU
+     */
+    void geodeticToEnu(const double* latitude, const double* longitude, const double* altitude,
+                       double* east, double* north, double* up, size_t count) const;
+
+    /**
+     * @brief Convert arrays of ENU coordinates to geodetic
+     */
+    void enuToGeodetic(const double* east, const double* north, const double* up,
+                       double* latitude, double* longitude, double* altitude, size_t count) const;
+
+private:
+    GeodeticPosition origin_;   ///< Geodetic origin
+    EcefPosition originEcef_;   ///< Origin in ECEF
+    double rotation_[3][3];     ///< ECEF -> ENU rotation, rows are east, north, up
+};
+
+/**
+ * @class FrameRegistry
+ * @brief Thread-safe cache of local frames and converted receiver positions per deployment
+ *
+ * A deployment's frame is anchored at the centroid of its receivers the first
+ * time they are registered, and stays fixed while receivers are updated so
+ * that positions and tracks remain comparable.
+ */
+class FrameRegistry {
+public:
+    /**
+     * @brief Constructor
+     */
+    FrameRegistry();
+
+    /**
+     * @brief Destructor
+     */
+    ~FrameRegistry();
+
+    /**
+     * @brief Register or update a deployment's receivers
+     * @param deploymentId Deployment identifier
+     * @param receivers Map of receiver IDs to geodetic positions
+     * @return Frame for the deployment
+     */
+    std::shared_ptr<const LocalFrame> setReceivers(
+        const std::string& deploymentId,
+        const std::map<std::string, GeodeticPosition>& receivers);
+
+    /**
+     * @brief Set an explicit origin for a deployment, replacing any existing frame
+     * @param deploymentId Deployment identifier
+     * @param origin Geodetic origin
+     * @return Frame for the deployment
+     */
+    std::shared_ptr<const LocalFrame> setOrigin(const std::string& deploymentId, const GeodeticPosition& origin);
+
+    /**
+     * @brief Get a deployment's frame
+     * @param deploymentId Deployment identifier
+     * @return Frame, or nullptr if the deployment is unknown
+     */
+    std::shared_ptr<const LocalFrame> getFrame(const std::string& deploymentId) const;
+
+    /**
+     * @brief Get a deployment's receivers in its local frame
+     * @param deploymentId Deployment identifier
+     * @return Map of receiver IDs to ENU positions (empty if unknown)
+     */
+    std::map<std::string, EnuPosition> getLocalReceivers(const std::string& deploymentId) const;
+
+    /**
+     * @brief Remove a deployment
+     * @param deploymentId Deployment identifier
+     * @return True if the deployment existed
+     */
+    bool removeDeployment(const std::string& deploymentId);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace utils
+} // namespace tdoa
@@ -513,6 +513,10 @@ void MapDisplay::setView(double lat, double lon, int zoom) {
     js_setMapView(lat, lon, zoom);
 }
 
+void MapDisplay::setView(const tdoa::utils::GeodeticPosition& position, int zoom) {
+    setView(position.latitude, position.longitude, zoom);
+}
+
 void MapDisplay::setStyle(const std::string& style) {
     js_setMapStyle(pImpl->config.mapboxToken.c_str(), style.c_str());
 }
@@ -536,6 +540,16 @@ int MapDisplay::addMarker(double lat, double lon, const std::string& label, cons
     return js_addMarker(lat, lon, label.c_str(), color.c_str());
 }
 
+int MapDisplay::addMarker(const tdoa::utils::GeodeticPosition& position,
+                          const std::string& label, const std::string& color) {
+    return addMarker(position.latitude, position.longitude, label, color);
+}
+
+int MapDisplay::addMarker(const tdoa::utils::LocalFrame& frame, const tdoa::utils::EnuPosition& position,
+                          const std::string& label, const std::string& color) {
+    return addMarker(frame.enuToGeodetic(position), label, color);
+}
+
 bool MapDisplay::removeMarker(int markerId) {
     return js_removeMarker(markerId);
 }
@@ -550,6 +564,15 @@ int MapDisplay::addConfidenceEllipse(double centerLat, double centerLon,
                                   fillOpacity);
 }
 
+int MapDisplay::addConfidenceEllipse(const tdoa::utils::GeodeticPosition& center,
+                                   double semiMajorAxis, double semiMinorAxis,
+                                   double rotationAngle, const std::string& color,
+                                   double fillOpacity) {
+    return addConfidenceEllipse(center.latitude, center.longitude,
+                                semiMajorAxis, semiMinorAxis,
+                                rotationAngle, color, fillOpacity);
+}
+
 bool MapDisplay::removeConfidenceEllipse(int ellipseId) {
     return js_removeConfidenceEllipse(ellipseId);
 }
@@ -728,6 +751,35 @@ int MapDisplay::addTrack(const std::vector<std::tuple<double, double, int64_t>>&
     return js_addTrack(pointsJson.dump().c_str(), color.c_str(), width);
 }
 
+int MapDisplay::addTrack(const tdoa::utils::LocalFrame& frame,
+                        const std::vector<std::pair<tdoa::utils::EnuPosition, int64_t>>& points,
+                        const std::string& color,
+                        double width) {
+    if (points.empty()) {
+        return -1;
+    }
+
+    // Convert the whole track through the frame in one batch
+    const size_t count = points.size();
+    std::vector<double> enu(3 * count);
+    std::vector<double> geodetic(3 * count);
+    for (size_t i = 0; i < count; ++i) {
+        enu[i] = points[i].first.east;
+        enu[count + i] = points[i].first.north;
+        enu[2 * count + i] = points[i].first.up;
+    }
+    frame.enuToGeodetic(enu.data(), enu.data() + count, enu.data() + 2 * count,
+                        geodetic.data(), geodetic.data() + count, geodetic.data() + 2 * count, count);
+
+    std::vector<std::tuple<double, double, int64_t>> trackPoints;
+    trackPoints.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        trackPoints.emplace_back(geodetic[i], geodetic[count + i], points[i].second);
+    }
+
+    return addTrack(trackPoints, color, width);
+}
+
 bool MapDisplay::removeTrack(int trackId) {
     return js_removeTrack(trackId);
 }
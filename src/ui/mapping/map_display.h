@@ -9,6 +9,7 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include "signal_marker.h"
+#include "tdoa/utils/geodetic.h"
 
 namespace df {
 namespace ui {
@@ -80,6 +81,14 @@ public:
      */
     void setView(double lat, double lon, int zoom = -1);
 
+    /**
+     * @brief Set the map center and zoom level
+     * 
+     * @param position Geodetic position of the center
+     * @param zoom Zoom level (optional)
+     */
+    void setView(const tdoa::utils::GeodeticPosition& position, int zoom = -1);
+
     /**
      * @brief Set the map style
      * 
@@ -106,6 +115,29 @@ public:
      */
     int addMarker(double lat, double lon, const std::string& label = "", const std::string& color = "#FF0000");
 
+    /**
+     * @brief Add a marker at a geodetic position
+     * 
+     * @param position Geodetic position
+     * @param label Label text
+     * @param color Marker color (hex format: #RRGGBB)
+     * @return int Marker ID
+     */
+    int addMarker(const tdoa::utils::GeodeticPosition& position,
+                  const std::string& label = "", const std::string& color = "#FF0000");
+
+    /**
+     * @brief Add a marker at a position in a local frame
+     * 
+     * @param frame Local frame the position is expressed in
+     * @param position East/north/up position in meters
+     * @param label Label text
+     * @param color Marker color (hex format: #RRGGBB)
+     * @return int Marker ID
+     */
+    int addMarker(const tdoa::utils::LocalFrame& frame, const tdoa::utils::EnuPosition& position,
+                  const std::string& label = "", const std::string& color = "#FF0000");
+
     /**
      * @brief Remove a marker from the map
      * 
@@ -131,6 +163,22 @@ public:
                             double rotationAngle, const std::string& color = "#FF0000",
                             double fillOpacity = 0.2);
 
+    /**
+     * @brief Add a confidence ellipse around a geodetic position
+     * 
+     * @param center Geodetic position of the center
+     * @param semiMajorAxis Semi-major axis in meters
+     * @param semiMinorAxis Semi-minor axis in meters
+     * @param rotationAngle Rotation angle in radians
+     * @param color Ellipse color (hex format: #RRGGBB)
+     * @param fillOpacity Fill opacity (0.0-1.0)
+     * @return int Ellipse ID
+     */
+    int addConfidenceEllipse(const tdoa::utils::GeodeticPosition& center,
+                            double semiMajorAxis, double semiMinorAxis,
+                            double rotationAngle, const std::string& color = "#FF0000",
+                            double fillOpacity = 0.2);
+
     /**
      * @brief Remove a confidence ellipse from the map
      * 
@@ -238,6 +286,22 @@ public:
                  const std::string& color = "#0000FF",
                  double width = 2.0);
 
+    /**
+     * @brief Add a historical track of positions in a local frame
+     *
+     * The positions are converted to latitude and longitude in one batch
+     * through the frame, so long tracks cost no per-point trigonometry.
+     * @param frame Local frame the positions are expressed in
+     * @param points Vector of {position, timestamp} points
+     * @param color Track color in hex format (#RRGGBB)
+     * @param width Track line width in pixels
+     * @return int Track ID
+     */
+    int addTrack(const tdoa::utils::LocalFrame& frame,
+                 const std::vector<std::pair<tdoa::utils::EnuPosition, int64_t>>& points,
+                 const std::string& color = "#0000FF",
+                 double width = 2.0);
+
     /**
      * @brief Remove a track from the map
      * @param trackId ID of track to remove
@@ -1,4 +1,5 @@
 #include "tile_server.h"
+#include "signal_flow/thread_placement.h"
 #include <httplib.h>
 #include <zlib.h>
 #include <json.hpp>
@@ -176,18 +177,24 @@ struct TileServer::Impl {
         // Start server
         running = true;
         serverThread = std::thread([this, port]() {
+            tdoa::signal::ThreadPlacement::getInstance().placeCurrentThread(
+                tdoa::signal::ThreadClass::Ui, "tile-server");
             server->listen("localhost", port);
         });
         
         // Start download threads
         for (size_t i = 0; i < maxConcurrentDownloads; ++i) {
-            downloadThreads.emplace_back([this]() {
+            downloadThreads.emplace_back([this, i]() {
+                tdoa::signal::ThreadPlacement::getInstance().placeCurrentThread(
+                    tdoa::signal::ThreadClass::Io, "tile-dl-" + std::to_string(i));
                 downloadWorker();
             });
         }
         
         // Start update thread
         updateThread = std::thread([this]() {
+            tdoa::signal::ThreadPlacement::getInstance().placeCurrentThread(
+                tdoa::signal::ThreadClass::Ui, "tile-update");
             updateWorker();
         });
         